@@ -27,6 +27,10 @@ IF(UNIT_TESTS)
 		target_compile_options(${target} PRIVATE -coverage)
 		target_link_options(${target} PRIVATE -coverage)
 		
+		IF(${file} IN_LIST CXX20Tests)
+			SET_TARGET_PROPERTIES(${target} PROPERTIES CXX_STANDARD 20)
+		ENDIF()
+		
 		ADD_TEST(NAME ${file} WORKING_DIRECTORY ${CMAKE_TESTING_DIRECTORY}/Runtime COMMAND  ${CMAKE_TESTING_DIRECTORY}/Tests/Unit/${target})
 	ENDFOREACH()
 ENDIF()
@@ -55,6 +59,10 @@ FOREACH(file ${ManualTests})
 		target_compile_options(${target} PRIVATE -coverage)
 		target_link_options(${target} PRIVATE -coverage)
 		
+		IF(${file} IN_LIST CXX20Tests)
+			SET_TARGET_PROPERTIES(${target} PROPERTIES CXX_STANDARD 20)
+		ENDIF()
+		
 		ADD_CUSTOM_COMMAND(TARGET manualtest COMMAND ${CMAKE_TESTING_DIRECTORY}/Tests/Manual/${target})
 	ENDIF()
 ENDFOREACH()
@@ -1,4 +1,5 @@
 #include "Controllers.h"
+#include "Mixer.h"
 
 namespace Gorgon { namespace Audio {
     
@@ -16,6 +17,21 @@ namespace Gorgon { namespace Audio {
         std::lock_guard<std::mutex> guard(internal::ControllerMtx);
         
         internal::Controllers.Remove(this);
+        
+        //mixer should stop using this controller before it is destroyed
+        if(published) {
+            published = false;
+            internal::PublishControllers();
+        }
+    }
+    
+    void Controller::PublishMe() {
+        std::lock_guard<std::mutex> guard(internal::ControllerMtx);
+        
+        if(!published) {
+            published = true;
+            internal::PublishControllers(false);
+        }
     }
 
     void BasicController::ReleaseData() {
@@ -23,6 +39,9 @@ namespace Gorgon { namespace Audio {
         
         wavedata = nullptr;
         datachanged();
+        
+        if(published)
+            internal::PublishControllers();
     }
     
     void BasicController::SetData(const Source &wavedata) {
@@ -38,6 +57,10 @@ namespace Gorgon { namespace Audio {
         }
         
         datachanged();
+        
+        //previous data might be destroyed after this function returns
+        if(published)
+            internal::PublishControllers();
     }
     
     BasicController &BasicController::Play() {
@@ -50,6 +73,8 @@ namespace Gorgon { namespace Audio {
             Seek(0);
         }
         
+        PublishMe();
+        
         playing = true;
         looping = false;
         
@@ -13,7 +13,9 @@ namespace Gorgon { namespace Audio {
     
 namespace internal {
     
-    class Loop;
+    class Mixer;
+    
+    void PublishControllers(bool wait);
     
 }
 
@@ -30,6 +32,7 @@ namespace internal {
     */
     class Controller {
         friend void AudioLoop();
+        friend void internal::PublishControllers(bool);
     public:
         /// Default constructor
         Controller();
@@ -42,6 +45,13 @@ namespace internal {
     protected:
         
         void RemoveMe();
+        
+        /// Makes this controller visible to the audio mixer. Controllers are published when
+        /// they are first played.
+        void PublishMe();
+        
+        /// Whether this controller is visible to the mixer
+        bool published = false;
     };
     
     /**
@@ -49,7 +59,8 @@ namespace internal {
     */
     class BasicController : public Controller {
         friend void AudioLoop();
-        friend class internal::Loop;
+        friend void internal::PublishControllers(bool);
+        friend class internal::Mixer;
     public:
         
         /// Default constructor
@@ -153,7 +164,7 @@ namespace internal {
     */
     class PositionalController : public BasicController {
         friend void AudioLoop();
-        friend class internal::Loop;
+        friend class internal::Mixer;
     public:
         
         /// Default constructor
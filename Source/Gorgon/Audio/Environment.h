@@ -6,7 +6,7 @@
 
 namespace Gorgon { namespace Audio {
 namespace internal {
-    class Loop;
+    class Mixer;
 }
     
     class Environment;
@@ -20,7 +20,7 @@ namespace internal {
     class Listener {
         friend void AudioLoop();
         friend class Environment;
-        friend class internal::Loop;
+        friend class internal::Mixer;
     public:
         
         Listener(Environment &env) : env(&env) { 
@@ -83,7 +83,7 @@ namespace internal {
     class Environment {
         friend void AudioLoop();
         friend class Listener;
-        friend class internal::Loop;
+        friend class internal::Mixer;
     public:
         Environment() : listener(*this) {
             init();
@@ -0,0 +1,756 @@
+#include "Mixer.h"
+#include "Controllers.h"
+#include "Environment.h"
+
+#include "../Multimedia/Wave.h"
+#include "../Multimedia/AudioStream.h"
+#include "../Utils/Compiler.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#ifdef GORGON_SSE2
+#   include <emmintrin.h>
+#endif
+
+#ifdef GORGON_X86
+#   include <immintrin.h>
+#endif
+
+namespace Gorgon { namespace Audio { namespace internal {
+
+    namespace {
+        const int maxmixers = 4;
+
+        /// Controller list that is used by the mixers. Replaced as a whole when controllers
+        /// change, lists are never modified after they are published.
+        std::atomic<std::vector<Voice>*> published{nullptr};
+
+        /// The list that each mixer is currently using, a list is not deleted while a mixer
+        /// is using it.
+        std::atomic<const std::vector<Voice>*> inuse[maxmixers];
+        std::atomic<bool> slots[maxmixers];
+
+        /// Lists that are replaced but might still be in use, guarded by ControllerMtx
+        std::vector<std::vector<Voice>*> retired;
+
+        bool isinuse(const std::vector<Voice> *list) {
+            for(auto &h : inuse)
+                if(h.load() == list)
+                    return true;
+
+            return false;
+        }
+
+        float channelvolume(int channel) {
+            return channel < (int)volume.size() ? volume[channel] : 1.f;
+        }
+
+        //Linear interpolation of a single channel from interleaved frames. Source position of
+        //the output i is pos + i * step, which should stay at least one frame before the end
+        //of the input.
+        void resamplescalar(const float *in, int channels, int ch, float pos, float step, float *out, int begin, int end) {
+            for(int i=begin; i<end; i++) {
+                float p = pos + i * step;
+                int   x = (int)p;
+                float f = p - x;
+
+                const float *s = in + x * channels + ch;
+                out[i] = s[0] + f * (s[channels] - s[0]);
+            }
+        }
+
+#ifdef GORGON_SSE2
+        //Sources with the same sample rate have a constant fraction, consecutive frames are
+        //loaded directly. Only mono and stereo sources are handled.
+        int resamplesse2(const float *in, int channels, int ch, float pos, float *out, int count) {
+            int i = 0;
+            __m128 f = _mm_set1_ps(pos);
+
+            if(channels == 1) {
+                for(; i + 4 <= count; i += 4) {
+                    __m128 a = _mm_loadu_ps(in + i), b = _mm_loadu_ps(in + i + 1);
+
+                    _mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(f, _mm_sub_ps(b, a))));
+                }
+            }
+            else if(channels == 2) {
+                for(; i + 4 <= count; i += 4) {
+                    const float *p = in + i * 2;
+                    __m128 lo = _mm_loadu_ps(p),     hi = _mm_loadu_ps(p + 4);
+                    __m128 nl = _mm_loadu_ps(p + 2), nh = _mm_loadu_ps(p + 6);
+
+                    __m128 a, b;
+                    if(ch == 0) {
+                        a = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+                        b = _mm_shuffle_ps(nl, nh, _MM_SHUFFLE(2, 0, 2, 0));
+                    }
+                    else {
+                        a = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+                        b = _mm_shuffle_ps(nl, nh, _MM_SHUFFLE(3, 1, 3, 1));
+                    }
+
+                    _mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(f, _mm_sub_ps(b, a))));
+                }
+            }
+
+            return i;
+        }
+
+        int mixrampsse2(float *dest, const float *src, float gain, float step, int count) {
+            __m128 g = _mm_add_ps(_mm_set1_ps(gain), _mm_mul_ps(_mm_set1_ps(step), _mm_setr_ps(0, 1, 2, 3)));
+            __m128 s = _mm_set1_ps(step * 4);
+            int i = 0;
+
+            for(; i + 4 <= count; i += 4) {
+                _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+                g = _mm_add_ps(g, s);
+            }
+
+            return i;
+        }
+
+        int interleavesse2(const float *left, const float *right, float *out, int count) {
+            int i = 0;
+
+            for(; i + 4 <= count; i += 4) {
+                __m128 l = _mm_loadu_ps(left + i), r = _mm_loadu_ps(right + i);
+
+                _mm_storeu_ps(out + i * 2,     _mm_unpacklo_ps(l, r));
+                _mm_storeu_ps(out + i * 2 + 4, _mm_unpackhi_ps(l, r));
+            }
+
+            return i;
+        }
+#endif
+
+#ifdef GORGON_X86
+        //Any step and channel count, frames are gathered
+        TARGET_AVX2 int resampleavx2(const float *in, int channels, int ch, float pos, float step, float *out, int count) {
+            __m256 offsets = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+            __m256 s = _mm256_set1_ps(step);
+            __m256i c = _mm256_set1_epi32(channels);
+            const float *base = in + ch;
+            int i = 0;
+
+            for(; i + 8 <= count; i += 8) {
+                __m256 p  = _mm256_fmadd_ps(_mm256_add_ps(_mm256_set1_ps((float)i), offsets), s, _mm256_set1_ps(pos));
+                __m256i x = _mm256_cvttps_epi32(p);
+                __m256 f  = _mm256_sub_ps(p, _mm256_cvtepi32_ps(x));
+
+                __m256i ind = _mm256_mullo_epi32(x, c);
+                __m256 a = _mm256_i32gather_ps(base, ind, 4);
+                __m256 b = _mm256_i32gather_ps(base, _mm256_add_epi32(ind, c), 4);
+
+                _mm256_storeu_ps(out + i, _mm256_fmadd_ps(f, _mm256_sub_ps(b, a), a));
+            }
+
+            return i;
+        }
+
+        TARGET_AVX2 int mixrampavx2(float *dest, const float *src, float gain, float step, int count) {
+            __m256 s = _mm256_set1_ps(step);
+            __m256 g = _mm256_fmadd_ps(s, _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_ps(gain));
+            s = _mm256_set1_ps(step * 8);
+            int i = 0;
+
+            for(; i + 8 <= count; i += 8) {
+                _mm256_storeu_ps(dest + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), g, _mm256_loadu_ps(dest + i)));
+                g = _mm256_add_ps(g, s);
+            }
+
+            return i;
+        }
+#endif
+
+        const bool useavx2 = Utils::SupportsAVX2();
+
+        void resample(const float *in, int channels, int ch, float pos, float step, float *out, int count) {
+            int i = 0;
+
+#ifdef GORGON_SSE2
+            if(step == 1.f)
+                i = resamplesse2(in, channels, ch, pos, out, count);
+#endif
+#ifdef GORGON_X86
+            if(i == 0 && useavx2)
+                i = resampleavx2(in, channels, ch, pos, step, out, count);
+#endif
+
+            resamplescalar(in, channels, ch, pos, step, out, i, count);
+        }
+
+        //Adds src to dest, gain changes linearly by step for every sample
+        void mixramp(float *dest, const float *src, float gain, float step, int count) {
+            int i = 0;
+
+#ifdef GORGON_X86
+            if(useavx2)
+                i = mixrampavx2(dest, src, gain, step, count);
+#endif
+#ifdef GORGON_SSE2
+            i += mixrampsse2(dest + i, src + i, gain + step * i, step, count - i);
+#endif
+
+            for(; i<count; i++)
+                dest[i] += src[i] * (gain + step * i);
+        }
+    }
+
+    void PublishControllers(bool wait) {
+        auto list = new std::vector<Voice>;
+
+        for(auto &controller : Controllers) {
+            if(!controller.published)
+                continue;
+
+            //both controller types are basic controllers
+            auto &basic = static_cast<BasicController&>(controller);
+
+            if(!basic.wavedata)
+                continue;
+
+            Voice voice = {
+                &basic,
+                basic.wavedata,
+                dynamic_cast<const Multimedia::Wave*>(basic.wavedata),
+                dynamic_cast<const Multimedia::AudioStream*>(basic.wavedata),
+                controller.Type() == ControllerType::Positional
+            };
+
+            if(!voice.wave && !voice.stream) {
+                basic.wavedata = nullptr;
+                basic.datachanged();
+                Log << "Unknown source type";
+
+                continue;
+            }
+
+            list->push_back(voice);
+        }
+
+        auto prev = published.exchange(list);
+        if(prev)
+            retired.push_back(prev);
+
+        //once a mixer is not using a retired list, it cannot get it back
+        for(auto it = retired.begin(); it != retired.end();) {
+            while(wait && isinuse(*it))
+                std::this_thread::yield();
+
+            if(isinuse(*it)) {
+                ++it;
+            }
+            else {
+                delete *it;
+                it = retired.erase(it);
+            }
+        }
+    }
+
+    Mixer::Mixer(const Device &device, int buffersize) :
+        device(device), freq(device.GetSampleRate()), channels(device.GetChannelCount()), buffersize(buffersize)
+    {
+        slot = -1;
+        for(int i=0; i<maxmixers; i++) {
+            bool expected = false;
+
+            if(slots[i].compare_exchange_strong(expected, true)) {
+                slot = i;
+                break;
+            }
+        }
+
+        if(slot == -1)
+            throw std::runtime_error("Too many audio mixers");
+
+        Environment::Current.init();
+
+        if(this->buffersize == 0)
+            this->buffersize = int(freq * BufferDuration);
+
+        bus.resize(channels * this->buffersize);
+        data.resize(channels * this->buffersize);
+
+        frontleft  = device.FindChannel(Channel::FrontLeft);
+        frontright = device.FindChannel(Channel::FrontRight);
+        backleft   = device.FindChannel(Channel::BackLeft);
+        backright  = device.FindChannel(Channel::BackRight);
+        lowfreq    = device.FindChannel(Channel::LowFreq);
+    }
+
+    Mixer::~Mixer() {
+        inuse[slot] = nullptr;
+        slots[slot] = false;
+    }
+
+    const float *Mixer::Mix(int size) {
+        std::fill(bus.begin(), bus.end(), 0.f);
+
+        //the list is marked as used before it is checked again, if it is replaced in between,
+        //the publisher might not have seen the mark
+        const std::vector<Voice> *list;
+        do {
+            list = published.load();
+            inuse[slot] = list;
+        } while(list != published.load());
+
+        if(list) {
+            matchgains(*list);
+
+            auto &env = Environment::Current;
+            for(int i=0; i<4; i++)
+                boost[i] = std::exp(env.attuniationfactor * env.speaker_boost[i]);
+
+            for(size_t i=0; i<list->size(); i++) {
+                auto &voice = (*list)[i];
+                auto &basic = *voice.controller;
+
+                if(!basic.playing)
+                    continue;
+
+                const Source *source = voice.source;
+                if(source->IsSeeking() && source->IsSeekComplete()) {
+                    basic.position = (double)source->SeekTarget()/source->GetSampleRate();
+                    source->SeekingDone();
+                }
+
+                if(basic.position == std::numeric_limits<double>::max())
+                    continue;
+
+                int count;
+                if(voice.wave) {
+                    if(!voice.wave->HasData())
+                        continue;
+
+                    count = render(voice, voice.wave, size);
+                }
+                else {
+                    count = render(voice, voice.stream, size);
+                }
+
+                if(!count)
+                    continue;
+
+                int srcchannels = (int)voice.source->GetChannelCount();
+
+                matrix.assign(channels * srcchannels, 0.f);
+
+                if(voice.positional)
+                    spatialize(voice, &matrix[0]);
+                else
+                    route(voice, &matrix[0]);
+
+                apply(voicegains[i], &matrix[0], srcchannels, count);
+            }
+        }
+
+        inuse[slot] = nullptr;
+
+        //interleave
+        if(channels == 2) {
+            int i = 0;
+#ifdef GORGON_SSE2
+            i = interleavesse2(&bus[0], &bus[buffersize], &data[0], size);
+#endif
+            for(; i<size; i++) {
+                data[i*2]   = bus[i];
+                data[i*2+1] = bus[buffersize + i];
+            }
+        }
+        else {
+            for(int c=0; c<channels; c++) {
+                const float *b = &bus[c * buffersize];
+
+                for(int i=0; i<size; i++)
+                    data[i*channels + c] = b[i];
+            }
+        }
+
+        return &data[0];
+    }
+
+    //Resamples the source to the scratch buffer, channels are planar. Returns the number of
+    //samples that are rendered, which is less than size if the playback is finished.
+    template<class S_>
+    int Mixer::render(const Voice &voice, const S_ *src, int size) {
+        auto &basic = *voice.controller;
+
+        unsigned long total = src->GetSize();
+        int    srcchannels  = (int)src->GetChannelCount();
+        double rate         = src->GetSampleRate();
+        double step         = rate / freq;
+        double pos          = basic.position * rate;
+
+        if(scratch.size() < size_t(srcchannels * buffersize))
+            scratch.resize(srcchannels * buffersize);
+
+        //frames closer to the end than this are handled one by one, as the next frame
+        //might be the first frame
+        const double margin = 1.0 + 1.0/64;
+
+        int s = 0;
+        while(s < size) {
+            if(total == 0 || (unsigned long)pos >= total) {
+                if(total && basic.looping) {
+                    pos = std::fmod(pos, (double)total);
+                }
+                else {
+                    pos = (double)total;
+                    basic.playing = false;
+
+                    break;
+                }
+            }
+
+            int n = 0;
+            if(pos + margin < total)
+                n = (int)std::min<double>(size - s, std::ceil((total - margin - pos) / step));
+
+            while(n > 0 && pos + (n - 1) * step + margin >= total)
+                n--;
+
+            if(n > 0) {
+                unsigned long first = (unsigned long)pos;
+                float frac = float(pos - first);
+
+                int count = std::min<int>(int(frac + (n - 1) * step) + 2, int(total - first));
+                const float *in = getframes(src, first, count);
+
+                for(int ch=0; ch<srcchannels; ch++)
+                    resample(in, srcchannels, ch, frac, (float)step, &scratch[ch * buffersize + s], n);
+
+                pos += n * step;
+                s   += n;
+            }
+            else {
+                unsigned long x1 = (unsigned long)pos;
+                unsigned long x2 = x1 + 1;
+                float f = float(pos - x1);
+
+                for(int ch=0; ch<srcchannels; ch++) {
+                    float a = get(src, x1, ch), b;
+
+                    if(x2 < total)
+                        b = get(src, x2, ch);
+                    else
+                        b = basic.looping ? get(src, 0, ch) : 0.f;
+
+                    scratch[ch * buffersize + s] = (1 - f) * a + f * b;
+                }
+
+                pos += step;
+                s++;
+            }
+        }
+
+        basic.position = pos / rate;
+
+        return s;
+    }
+
+    //Basic controllers route each source channel to the matching speakers
+    void Mixer::route(const Voice &voice, float *matrix) {
+        auto &basic = *voice.controller;
+        auto src    = voice.source;
+        int  srcchannels = (int)src->GetChannelCount();
+        float gain  = mastervolume * basic.volume;
+
+        auto sendto = [&](int ch, int dest) {
+            if(dest != -1)
+                matrix[dest * srcchannels + ch] += gain * channelvolume(dest);
+        };
+
+        auto distributetoall = [&](int ch) {
+            for(int c=0; c<channels; c++)
+                sendto(ch, c);
+        };
+
+        for(int ch=0; ch<srcchannels; ch++) {
+            auto channel = src->GetChannelType(ch);
+
+            if(channel == Channel::Mono) { //* Mono is distributed to all channels
+                distributetoall(ch);
+
+                continue;
+            }
+
+            int ind = device.FindChannel(channel);
+
+            if(channel == Channel::FrontLeft) {
+                sendto(ch, ind);
+
+                if(src->FindChannel(Channel::BackLeft) == -1)
+                    sendto(ch, backleft);
+            }
+            else if(channel == Channel::FrontRight) {
+                sendto(ch, ind);
+
+                if(src->FindChannel(Channel::BackRight) == -1)
+                    sendto(ch, backright);
+            }
+            else if(channel == Channel::Center) {
+                if(ind != -1) {
+                    sendto(ch, ind);
+                }
+                else {
+                    sendto(ch, frontleft);
+                    sendto(ch, frontright);
+                }
+            }
+            else if(channel == Channel::BackLeft) {
+                sendto(ch, ind != -1 ? ind : frontleft);
+            }
+            else if(channel == Channel::BackRight) {
+                sendto(ch, ind != -1 ? ind : frontright);
+            }
+            else if(channel == Channel::LowFreq) {
+                if(ind != -1)
+                    sendto(ch, ind);
+                else
+                    distributetoall(ch);
+            }
+            else {
+                Log << "Unknown channel type: " << String::From(channel);
+            }
+        }
+    }
+
+    //Positional controllers mix the source to mono, except for the low frequency channel, and
+    //distribute it to the speakers depending on the direction and the distance of the source
+    void Mixer::spatialize(const Voice &voice, float *matrix) {
+        auto &controller = static_cast<PositionalController&>(*voice.controller);
+        auto src   = voice.source;
+        auto &env  = Environment::Current;
+        auto &lis  = env.listener;
+        int  srcchannels = (int)src->GetChannelCount();
+        float gain = mastervolume * controller.volume;
+
+        //speaker gains for the mono mix
+        float speakers[4] = {0, 0, 0, 0};
+
+        //distribute to headphones
+        if(device.IsHeadphones()) {
+            auto loc = controller.location;
+
+            auto leftvec  = (loc - lis.leftpos);
+            auto rightvec = (loc - lis.rightpos);
+
+            float leftvol  = (leftvec.Normalize()  * env.left  + 1) / 2;
+            float rightvol = (rightvec.Normalize() * env.right + 1) / 2;
+
+            auto total = (leftvol + rightvol);
+
+            speakers[0] = (leftvol  / total * (1 - env.nonblocked) + env.nonblocked) * std::exp(-env.attuniationfactor * leftvec.Distance());
+            speakers[1] = (rightvol / total * (1 - env.nonblocked) + env.nonblocked) * std::exp(-env.attuniationfactor * rightvec.Distance());
+        }
+
+        //stereo
+        else if(backleft == -1) {
+            auto diff = controller.location - lis.location;
+            auto w = diff.Normalize();
+            auto attenuation = std::exp(-env.attuniationfactor * diff.Distance());
+
+            float leftvol  = (w * env.speaker_vectors[0] + 1) / 2;
+            float rightvol = (w * env.speaker_vectors[1] + 1) / 2;
+
+            auto total = leftvol + rightvol;
+
+            speakers[0] = leftvol  / total * attenuation * boost[0];
+            speakers[1] = rightvol / total * attenuation * boost[1];
+        }
+
+        //surround
+        else {
+            auto diff = controller.location - lis.location;
+            auto w = diff.Normalize();
+            auto attenuation = std::exp(-env.attuniationfactor * diff.Distance());
+
+            float total = 0;
+            for(int i=0; i<4; i++) {
+                speakers[i] = std::max(w * env.speaker_vectors[i], 0.f);
+                total      += speakers[i];
+            }
+
+            for(int i=0; i<4; i++)
+                speakers[i] = speakers[i] / total * attenuation * boost[i];
+        }
+
+        const int targets[] = {frontleft, frontright, backleft, backright};
+
+        auto spread = [&](int ch) {
+            for(int i=0; i<4; i++)
+                if(targets[i] != -1)
+                    matrix[targets[i] * srcchannels + ch] += gain * speakers[i];
+        };
+
+        int mono = src->FindChannel(Channel::Mono);
+        int lfe  = src->FindChannel(Channel::LowFreq);
+
+        if(mono != -1) { //preferred way, no additional cost
+            spread(mono);
+        }
+        else {
+            for(int ch=0; ch<srcchannels; ch++)
+                if(ch != lfe)
+                    spread(ch);
+        }
+
+        //low frequency goes to its own speaker if it exists, otherwise it is mixed with the rest
+        if(lfe != -1) {
+            if(lowfreq != -1) {
+                auto factor = std::exp(-env.attuniationfactor * (controller.location - lis.location).Distance());
+
+                matrix[lowfreq * srcchannels + lfe] += factor * gain * channelvolume(lowfreq);
+            }
+            else {
+                spread(lfe);
+            }
+        }
+    }
+
+    //Keeps the gains of the voices in the same order as the list, gains of the voices that
+    //are not in the previous list start without a ramp
+    void Mixer::matchgains(const std::vector<Voice> &list) {
+        bool same = voicegains.size() == list.size();
+
+        for(size_t i=0; same && i<list.size(); i++)
+            same = voicegains[i].controller == list[i].controller;
+
+        if(same)
+            return;
+
+        std::vector<VoiceGains> prev;
+        std::swap(prev, voicegains);
+
+        voicegains.resize(list.size());
+
+        size_t j = 0;
+        for(size_t i=0; i<list.size(); i++) {
+            voicegains[i].controller = list[i].controller;
+
+            //new lists keep the order of the controllers
+            for(size_t k=0; k<prev.size(); k++, j++) {
+                if(j >= prev.size())
+                    j = 0;
+
+                if(prev[j].controller == list[i].controller) {
+                    voicegains[i].gains = std::move(prev[j].gains);
+
+                    break;
+                }
+            }
+        }
+    }
+
+    void Mixer::apply(VoiceGains &state, const float *matrix, int srcchannels, int size) {
+        int count = channels * srcchannels;
+
+        if((int)state.gains.size() != count)
+            state.gains.assign(matrix, matrix + count);
+
+        for(int dest=0; dest<channels; dest++) {
+            for(int ch=0; ch<srcchannels; ch++) {
+                float from = state.gains[dest * srcchannels + ch];
+                float to   = matrix[dest * srcchannels + ch];
+
+                if(from == 0 && to == 0)
+                    continue;
+
+                mixramp(&bus[dest * buffersize], &scratch[ch * buffersize], from, (to - from) / size, size);
+            }
+        }
+
+        state.gains.assign(matrix, matrix + count);
+    }
+
+    //Copies frames of a stream, missing frames are silent. Stream buffers are validated
+    //through the buffer version instead of locking, as loading a buffer could take long.
+    void Mixer::fetch(const Multimedia::AudioStream *src, unsigned long first, int count, float *target) {
+        int srcchannels = (int)src->GetChannelCount();
+        unsigned long last = 0;
+
+        src->bufferreaders++;
+
+        while(true) {
+            unsigned version = src->bufferversion.load();
+
+            if(version & 1) {
+                std::this_thread::yield();
+
+                continue;
+            }
+
+            int done = 0;
+            while(done < count) {
+                unsigned long sample = first + done;
+                int available = 0;
+
+                for(auto &cur : src->buffers) {
+                    if(sample >= cur.beg && sample < cur.end && sample - cur.beg < cur.buffer.GetSize()) {
+                        available = (int)std::min<unsigned long>(count - done, std::min(cur.end, cur.beg + cur.buffer.GetSize()) - sample);
+
+                        std::memcpy(target + done * srcchannels, cur.buffer.RawData() + (sample - cur.beg) * srcchannels,
+                                    sizeof(float) * available * srcchannels);
+
+                        break;
+                    }
+                }
+
+                if(available) {
+                    done += available;
+                    last  = sample + available - 1;
+                }
+                else {
+                    std::fill(target + done * srcchannels, target + (done + 1) * srcchannels, 0.f);
+                    done++;
+                }
+            }
+
+            if(src->bufferversion.load() == version)
+                break;
+        }
+
+        src->bufferreaders--;
+
+        if(last)
+            src->lastsample = last;
+    }
+
+    const float *Mixer::getframes(const Multimedia::Wave *src, unsigned long first, int) {
+        return src->GetData().RawData() + first * src->GetChannelCount();
+    }
+
+    const float *Mixer::getframes(const Multimedia::AudioStream *src, unsigned long first, int count) {
+        if(frames.size() < size_t(count * src->GetChannelCount()))
+            frames.resize(count * src->GetChannelCount());
+
+        fetch(src, first, count, &frames[0]);
+
+        return &frames[0];
+    }
+
+    float Mixer::get(const Multimedia::Wave *src, unsigned long sample, int ch) {
+        return src->Get(sample, ch);
+    }
+
+    float Mixer::get(const Multimedia::AudioStream *src, unsigned long sample, int ch) {
+        float frame[8];
+
+        if(src->GetChannelCount() > 8) {
+            std::vector<float> frame(src->GetChannelCount());
+            fetch(src, sample, 1, &frame[0]);
+
+            return frame[ch];
+        }
+
+        fetch(src, sample, 1, frame);
+
+        return frame[ch];
+    }
+
+} } }
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../Audio.h"
+
+#include <vector>
+
+namespace Gorgon {
+
+namespace Multimedia {
+    class Wave;
+    class AudioStream;
+}
+
+namespace Audio {
+
+    class BasicController;
+    class Source;
+
+namespace internal {
+
+    /// A controller as seen by the mixer. Source type is resolved when the controllers are
+    /// published, therefore, mixer does not need to check types for every buffer. Mixers use
+    /// the source stored here instead of the data of the controller, which might be changed
+    /// or released while the list is in use.
+    struct Voice {
+        BasicController *controller;
+
+        const Source *source;
+
+        /// Only one of wave and stream is set
+        const Multimedia::Wave        *wave;
+        const Multimedia::AudioStream *stream;
+
+        bool positional;
+    };
+
+    /// Publishes the current list of controllers to the mixers. Should be called with
+    /// ControllerMtx locked, after the list or the data of a controller is changed. If wait is
+    /// set, this function returns after mixers stop using the previous list, so that the
+    /// removed controllers and data can be destroyed. Mixers never lock ControllerMtx.
+    void PublishControllers(bool wait = true);
+
+    /**
+     * Mixes the published controllers into a buffer for the given device. Sources are
+     * resampled with linear interpolation one block at a time and mixed to planar channel
+     * buffers with vectorized loops, which are interleaved at the end. There can be up to 4
+     * mixers at the same time.
+     *
+     * Every voice is mixed through a gain matrix from its source channels to the device
+     * channels. Matrices are calculated once per block from the channel layouts, volumes and
+     * for positional controllers, the location of the source and the listener. Gains are
+     * ramped linearly from the previous block to avoid zipper noise.
+     */
+    class Mixer {
+    public:
+        /// Creates a new mixer for the given device. If buffersize is 0, it is calculated from
+        /// BufferDuration.
+        Mixer(const Device &device, int buffersize = 0);
+
+        Mixer(const Mixer &) = delete;
+
+        ~Mixer();
+
+        /// Mixes the given number of samples, which should not be larger than the buffer size.
+        /// Returned buffer is interleaved and stays valid until the next call.
+        const float *Mix(int size);
+
+        /// Returns the maximum number of samples that can be mixed at once
+        int GetBufferSize() const {
+            return buffersize;
+        }
+
+        /// Returns the number of channels in the mixed data
+        int GetChannelCount() const {
+            return channels;
+        }
+
+    private:
+        template<class S_>
+        int render(const Voice &voice, const S_ *src, int size);
+
+        /// Gains from the source channels to the device channels of a voice in the last block
+        struct VoiceGains {
+            BasicController *controller;
+            std::vector<float> gains;
+        };
+
+        void matchgains(const std::vector<Voice> &list);
+
+        void route(const Voice &voice, float *matrix);
+
+        void spatialize(const Voice &voice, float *matrix);
+
+        void apply(VoiceGains &state, const float *matrix, int sourcechannels, int size);
+
+        void fetch(const Multimedia::AudioStream *src, unsigned long first, int count, float *target);
+
+        const float *getframes(const Multimedia::Wave *src, unsigned long first, int count);
+
+        const float *getframes(const Multimedia::AudioStream *src, unsigned long first, int count);
+
+        float get(const Multimedia::Wave *src, unsigned long sample, int ch);
+
+        float get(const Multimedia::AudioStream *src, unsigned long sample, int ch);
+
+        Device device;
+
+        int freq;
+        int channels;
+        int buffersize;
+        int slot;
+
+        /// Indices of the speakers in the device
+        int frontleft, frontright, backleft, backright, lowfreq;
+
+        /// Speaker distance compensation, calculated for every block
+        float boost[4];
+
+        /// Gains of the voices in the order of the published list
+        std::vector<VoiceGains> voicegains;
+
+        /// Target gains of the current voice, device channels x source channels
+        std::vector<float> matrix;
+
+        /// Planar output, one buffer per device channel
+        std::vector<float> bus;
+
+        /// Planar resampled source, one buffer per source channel
+        std::vector<float> scratch;
+
+        /// Copy of the frames of a stream source
+        std::vector<float> frames;
+
+        /// Interleaved output
+        std::vector<float> data;
+    };
+
+    /// Duration of an audio buffer in seconds
+    extern float BufferDuration;
+
+    /// Size of an audio buffer in samples, calculated from BufferDuration if 0
+    extern int BufferSize;
+
+}
+
+} }
@@ -0,0 +1,52 @@
+#include "../Audio.h"
+
+#include "Mixer.h"
+
+#include <chrono>
+#include <thread>
+
+namespace Gorgon { namespace Audio {
+	///@cond Internal
+	
+	namespace internal {
+		std::chrono::steady_clock::time_point nullstart;
+		unsigned long long nullposted = 0;
+	}
+	
+	void AudioLoop();
+	
+	static bool nullready = false;
+	
+	void Initialize() {
+		Log << "Starting null audio...";
+		
+		Device::Refresh();
+		
+		Current = Device::Default();
+		
+		if(internal::BufferSize == 0)
+			internal::BufferSize = int(Current.GetSampleRate() * internal::BufferDuration);
+		
+		internal::volume.resize(Current.GetChannelCount());
+		for(auto &v : internal::volume) v = 1;
+		
+		internal::nullstart  = std::chrono::steady_clock::now();
+		internal::nullposted = 0;
+		
+		internal::audiothread = std::thread(&AudioLoop);
+		
+		Log.Log("Null audio is ready, audio will not be played.", Utils::Logger::Success);
+		nullready = true;
+	}
+	
+	void Device::Refresh() {
+		devices = {Device("null", "Null device", 48000, Format::Float, false, StandardChannels(2))};
+		def = devices[0];
+	}
+	
+	bool IsAvailable() {
+		return nullready;
+	}
+
+	///@endcond
+} }
@@ -0,0 +1,32 @@
+/// This file should be included from Audio.cpp
+
+#include <chrono>
+
+namespace Gorgon { namespace Audio {
+	namespace internal {
+		extern std::chrono::steady_clock::time_point nullstart;
+		extern unsigned long long nullposted;
+	}
+	
+	/// Null device consumes samples at the rate of the device
+	size_t GetWritableSize(int) {
+		auto elapsed = std::chrono::steady_clock::now() - internal::nullstart;
+		auto played  = (unsigned long long)(std::chrono::duration<double>(elapsed).count() * Current.GetSampleRate());
+		
+		//keep a buffer ahead of the playback
+		played += internal::BufferSize;
+		
+		if(played <= internal::nullposted)
+			return 0;
+		
+		return (size_t)std::min<unsigned long long>(played - internal::nullposted, internal::BufferSize);
+	}
+	
+	void PostData(const float *, int size, int) {
+		internal::nullposted += size;
+	}
+	
+	void SkipFrame() {
+	}
+
+} }
@@ -0,0 +1,75 @@
+#include "Offline.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace Gorgon { namespace Audio {
+
+    OfflineRenderer::OfflineRenderer(const Device &device, int buffersize) :
+        device(device), mixer(device, buffersize)
+    {
+        start = std::chrono::steady_clock::now();
+
+        //channel volumes are indexed by the device channel
+        if((int)internal::volume.size() < device.GetChannelCount())
+            internal::volume.resize(device.GetChannelCount(), 1.f);
+    }
+
+    template<class F_>
+    void OfflineRenderer::render(unsigned long samples, F_ fn) {
+        unsigned long done = 0;
+
+        while(done < samples) {
+            int size = (int)std::min<unsigned long>(samples - done, mixer.GetBufferSize());
+
+            if(realtime) {
+                //wait until the previous buffer is played
+                auto target = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>((double)rendered / device.GetSampleRate())
+                );
+
+                std::this_thread::sleep_until(target);
+            }
+
+            fn(mixer.Mix(size), done, size);
+
+            done     += size;
+            rendered += size;
+        }
+    }
+
+    void OfflineRenderer::Render(Containers::Wave &target, unsigned long samples) {
+        int channels = device.GetChannelCount();
+
+        std::vector<Channel> chs;
+        for(int i=0; i<channels; i++)
+            chs.push_back(device.GetChannel(i));
+
+        target.Resize(samples, chs);
+        target.SetSampleRate(device.GetSampleRate());
+
+        float *data = target.RawData();
+
+        render(samples, [&](const float *mixed, unsigned long offset, int size) {
+            std::memcpy(data + offset * channels, mixed, sizeof(float) * size * channels);
+        });
+    }
+
+    Containers::Wave OfflineRenderer::Render(float seconds) {
+        Containers::Wave wave;
+
+        Render(wave, (unsigned long)(seconds * device.GetSampleRate()));
+
+        return wave;
+    }
+
+    void OfflineRenderer::Advance(unsigned long samples) {
+        render(samples, [](const float *, unsigned long, int) { });
+    }
+
+    bool OfflineRenderer::RenderToFile(const std::string &filename, float seconds, int bits) {
+        return Render(seconds).ExportWav(filename, bits);
+    }
+
+} }
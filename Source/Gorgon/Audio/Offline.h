@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../Audio.h"
+#include "../Containers/Wave.h"
+#include "Mixer.h"
+
+#include <chrono>
+#include <string>
+
+namespace Gorgon { namespace Audio {
+
+    /**
+     * Mixes the playing controllers without an audio device. Mixed data can be stored in a
+     * wave, written to a WAV file or discarded. Rendering is done as fast as possible, unless
+     * it is set to real time, in which case rendering waits so that it does not go ahead of
+     * the real time playback. Real time rendering is necessary if streamed sources are used,
+     * as streams are loaded by another thread. This renderer can be used together with the
+     * audio device, but the sources are advanced by both.
+     */
+    class OfflineRenderer {
+    public:
+        /// Creates a renderer for a device with the given properties. If buffersize is 0, it is
+        /// calculated from BufferDuration.
+        explicit OfflineRenderer(int rate = 48000, const std::vector<Channel> &channels = StandardChannels(2), bool headphones = false, int buffersize = 0) :
+            OfflineRenderer(Device("offline", "Offline renderer", rate, Format::Float, headphones, channels), buffersize)
+        { }
+
+        /// Creates a renderer that mixes for the given device. If buffersize is 0, it is
+        /// calculated from BufferDuration.
+        explicit OfflineRenderer(const Device &device, int buffersize = 0);
+
+        /// Renders the given number of samples into the target. Target will be resized to
+        /// contain the samples with the channels and the sample rate of the device.
+        void Render(Containers::Wave &target, unsigned long samples);
+
+        /// Renders the given duration in seconds and returns the mixed data.
+        Containers::Wave Render(float seconds);
+
+        /// Renders the given number of samples and discards them, advancing the playback.
+        void Advance(unsigned long samples);
+
+        /// Renders the given duration in seconds and writes it as a PCM WAV file.
+        bool RenderToFile(const std::string &filename, float seconds, int bits = 16);
+
+        /// Whether rendering should wait for the real time playback
+        void SetRealtime(bool value) {
+            realtime = value;
+            start    = std::chrono::steady_clock::now();
+            rendered = 0;
+        }
+
+        /// Returns whether rendering waits for the real time playback
+        bool IsRealtime() const {
+            return realtime;
+        }
+
+        /// Returns the number of samples rendered since the renderer is created or the
+        /// real time mode is changed
+        unsigned long long GetRenderedSamples() const {
+            return rendered;
+        }
+
+        /// Returns the device that the renderer mixes for
+        const Device &GetDevice() const {
+            return device;
+        }
+
+    private:
+        template<class F_>
+        void render(unsigned long samples, F_ fn);
+
+        Device device;
+        internal::Mixer mixer;
+
+        bool realtime = false;
+        std::chrono::steady_clock::time_point start;
+        unsigned long long rendered = 0;
+    };
+
+} }
@@ -6,6 +6,12 @@ SET(Local
 	Controllers.h
 	Controllers.cpp
 	
+	Mixer.h
+	Mixer.cpp
+	
+	Offline.h
+	Offline.cpp
+	
 	Environment.h
     Environment.cpp
 )
@@ -24,3 +30,9 @@ IF(AUDIOLIB STREQUAL "WASAPI")
 	LIST(APPEND Local WASAPI.cpp)
 	LIST(APPEND Local WASAPI.inc.h)
 ENDIF()
+
+
+IF(AUDIOLIB STREQUAL "NULL")
+	LIST(APPEND Local Null.cpp)
+	LIST(APPEND Local Null.inc.h)
+ENDIF()
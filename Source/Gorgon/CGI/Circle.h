@@ -5,8 +5,12 @@
 #include "../Graphics/Color.h"
 #include "../Containers/Image.h"
 #include "../CGI.h"
+#include "../Geometry/PointList.h"
+#include "Rasterizer.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #ifndef GORGON_DEFAULT_SUBDIVISIONS
 #   ifdef NDEBUG
@@ -18,13 +22,73 @@
 
 
 namespace Gorgon { namespace CGI {
+
+///@cond internal
+namespace internal {
+
+    /// Returns a polygon that is within 1/64 pixels of the given circle
+    template<class P_>
+    Geometry::PointList<Geometry::Pointf> circlepolygon(P_ location, Float radius) {
+        int n = 8;
+        if(radius > 1.f/64)
+            n = std::max(n, (int)std::ceil(PI / std::acos(1 - 1.f/64 / radius)));
+
+        Geometry::PointList<Geometry::Pointf> points;
+        for(int i=0; i<n; i++) {
+            Float a = 2 * PI * i / n;
+
+            points.Push({Float(location.X) + radius * std::cos(a), Float(location.Y) + radius * std::sin(a)});
+        }
+
+        return points;
+    }
+
+    /// Circles pass the location of the pixel centers relative to the center of the circle to
+    /// the fill
+    template<class F_, class P_>
+    struct circlefill {
+        F_ &fill;
+        P_ location;
+
+        template<class C_>
+        C_ operator()(Geometry::Pointf, Geometry::Point absolute, C_ underlying, float alpha) {
+            return fill({absolute.X + 0.5f - Float(location.X), absolute.Y + 0.5f - Float(location.Y)}, absolute, underlying, alpha);
+        }
+    };
+
+    /// Fills the given circle paths using analytic coverage, paths are combined with odd
+    /// winding, so an inner path makes a hole.
+    template<class F_, class P_>
+    void analyticcircle(Containers::Image &target, const std::vector<Geometry::PointList<Geometry::Pointf>> &paths, F_ &fill, P_ location) {
+        circlefill<F_, P_> relative{fill, location};
+
+        analyticfill<1>(target, paths, relative);
+    }
+
+    /// Solid fills do not use the location, they are kept as is to use span blending
+    template<class C_, class P_>
+    void analyticcircle(Containers::Image &target, const std::vector<Geometry::PointList<Geometry::Pointf>> &paths, SolidFill<C_> &fill, P_) {
+        analyticfill<1>(target, paths, fill);
+    }
+}
+///@endcond
     
     /**
      * Draws a filled circle with the specified radius to the given target. This
      * function is very fast but is not very accurate. Any S_ value > 1 will enable AA.
+     * If S_ is AnalyticCoverage, the circle is filled as a polygon that is within 1/64
+     * pixels of it, using the exact area covered in each pixel.
      */
     template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, class P_= Geometry::Pointf, class F_ = SolidFill<>>
     void Circle(Containers::Image &target, P_ location, Float radius, F_ fill = SolidFill<>(Graphics::Color::Black)) {
+        if(S_ == AnalyticCoverage) {
+            std::vector<Geometry::PointList<Geometry::Pointf>> paths;
+            paths.push_back(internal::circlepolygon(location, radius));
+
+            internal::analyticcircle(target, paths, fill, location);
+
+            return;
+        }
         
         int minx = std::max((int)floor(float(location.X) - radius), 0);
         int maxx = std::min((int)ceil(float(location.X) + radius), target.GetWidth());
@@ -87,10 +151,21 @@ namespace Gorgon { namespace CGI {
     /**
      * Draws a circle outline with the specified radius to the given target. This
      * function is very fast but is not very accurate. Radius is the inner radius
-     * of the circle. Any S_ value > 1 will enable AA.
+     * of the circle. Any S_ value > 1 will enable AA. If S_ is AnalyticCoverage, the
+     * ring is filled as two polygons that are within 1/64 pixels of its edges, using the
+     * exact area covered in each pixel.
      */
     template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, class P_= Geometry::Pointf, class F_ = SolidFill<>>
     void Circle(Containers::Image &target, P_ location, Float radius, Float border, F_ fill = SolidFill<>(Graphics::Color::Black)) {
+        if(S_ == AnalyticCoverage) {
+            std::vector<Geometry::PointList<Geometry::Pointf>> paths;
+            paths.push_back(internal::circlepolygon(location, radius + border));
+            paths.push_back(internal::circlepolygon(location, radius));
+
+            internal::analyticcircle(target, paths, fill, location);
+
+            return;
+        }
         
         auto inner = radius;
         radius += border;
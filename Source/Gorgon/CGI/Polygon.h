@@ -8,6 +8,7 @@
 #include "../Geometry/PointList.h"
 #include "../Geometry/Line.h"
 #include "../Containers/Collection.h"
+#include "Rasterizer.h"
 #include <stdint.h>
 
 #include <cmath>
@@ -220,13 +221,21 @@ namespace internal {
     /**
      * This function fills the given point list as a polygon. List is treated as closed
      * where last pixel connects to the first. S_ is the number of subdivision for subpixel
-     * accuracy. S_ should be a power of two for this algorithm to work properly. W_ is winding, 0 
+     * accuracy. S_ should be a power of two for this algorithm to work properly. If S_ is
+     * AnalyticCoverage, the exact area covered in each pixel is used instead, which is faster
+     * than subdivisions and blends solid fills a span at a time. W_ is winding, 0 
      * is non-zero, 1 is odd, 2 is non-zero on same path, odd on different path
      */
     template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, int W_ = 1, class P_= Geometry::Pointf, class F_ = SolidFill<>>
     void Polyfill(Containers::Image &target, const Containers::Collection<const Geometry::PointList<P_>> &points, F_ fill = SolidFill<>{Graphics::Color::Black}) {
         if(points.GetSize() < 1) return;
         
+        if(S_ == AnalyticCoverage) {
+            internal::analyticfill<W_>(target, points, fill);
+            
+            return;
+        }
+        
         Float ymin = (Float)int(target.GetHeight()*S_ - 1);
         Float ymax = 0;
         int xmin = int(target.GetWidth()*S_ - 1);
@@ -0,0 +1,512 @@
+#pragma once
+
+#include "../Types.h"
+#include "../Graphics/Color.h"
+#include "../Containers/Image.h"
+#include "../CGI.h"
+#include "../Geometry/PointList.h"
+#include "../Utils/Compiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#ifdef GORGON_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace Gorgon { namespace CGI {
+
+    /// Can be used as S_ in Polyfill and the functions that use it. Instead of sampling
+    /// subdivisions, the exact area of each pixel that is covered by the shape is calculated.
+    /// Its cost does not depend on the anti-aliasing quality.
+    constexpr int AnalyticCoverage = -1;
+
+///@cond internal
+namespace internal {
+
+    /// A run of pixels on a row that should be filled
+    struct CoverageSpan {
+        /// First pixel of the span
+        int X;
+
+        /// Number of pixels in the span
+        int Length;
+
+        /// Coverage of every pixel in the span, nullptr if the pixels are fully covered
+        const float *Coverage;
+    };
+
+    /// Adds a line piece that lies in a single row to the cells of the row. Cells store the
+    /// difference of coverage between consecutive pixels, the row is turned into coverage by
+    /// a running sum. xa and xb are relative to the first cell, d is the height of the piece
+    /// multiplied by its direction. cells should have width + 2 elements. lo and hi are
+    /// extended to the range of the modified cells.
+    inline void accumulatecells(Float *cells, int width, Float xa, Float xb, Float d, int &lo, int &hi) {
+        //covered area does not depend on the direction
+        if(xa > xb)
+            std::swap(xa, xb);
+
+        //piece is completely on the left, covers everything on the row
+        if(xb <= 0) {
+            cells[0] += d;
+            lo = 0;
+            hi = std::max(hi, 0);
+
+            return;
+        }
+
+        //completely on the right, no visible pixels are covered, but the row should be swept
+        //until the end as the cover it removes is not added to any cell
+        if(xa >= width) {
+            hi = width;
+
+            return;
+        }
+
+        //clip, the part on the left covers the row completely
+        if(xa < 0 || xb > width) {
+            Float len = xb - xa;
+
+            if(xa < 0) {
+                cells[0] += d * -xa / len;
+                lo = 0;
+
+                d *= (std::min<Float>(xb, (Float)width)) / len;
+                xa = 0;
+            }
+            else {
+                d *= (width - xa) / len;
+            }
+
+            if(xb > width)
+                hi = width;
+
+            xb = std::min<Float>(xb, (Float)width);
+        }
+
+        Float x0floor = std::floor(xa);
+        int   x0i     = (int)x0floor;
+        Float x1ceil  = std::ceil(xb);
+        int   x1i     = (int)x1ceil;
+
+        if(x1i <= x0i + 1) { //within a single pixel
+            Float xmf = (xa + xb) / 2 - x0floor;
+
+            cells[x0i]     += d - d * xmf;
+            cells[x0i + 1] += d * xmf;
+
+            x1i = x0i + 1;
+        }
+        else {
+            Float s   = 1 / (xb - xa);
+            Float x0f = xa - x0floor;
+            Float a0  = s * (1 - x0f) * (1 - x0f) / 2; //triangle in the first pixel
+            Float x1f = xb - x1ceil + 1;
+            Float am  = s * x1f * x1f / 2;             //triangle in the last pixel
+
+            cells[x0i] += d * a0;
+
+            if(x1i == x0i + 2) {
+                cells[x0i + 1] += d * (1 - a0 - am);
+            }
+            else {
+                Float a1 = s * (Float(1.5) - x0f);
+                cells[x0i + 1] += d * (a1 - a0);
+
+                Float ds = d * s;
+                for(int x=x0i+2; x<x1i-1; x++)
+                    cells[x] += ds;
+
+                Float a2 = a1 + (x1i - x0i - 3) * s;
+                cells[x1i - 1] += d * (1 - a2 - am);
+            }
+
+            cells[x1i] += d * am;
+        }
+
+        lo = std::min(lo, x0i);
+        hi = std::max(hi, x1i);
+    }
+
+    /// Converts the accumulated winding to coverage. W_ is the winding rule, same as Polyfill.
+    /// Rule 2 is applied for each path separately, thus uses non-zero here.
+    template<int W_>
+    float coveragefromwinding(Float acc) {
+        acc = std::abs(acc);
+
+        if(W_ == 1 && acc > 1) {
+            acc -= 2 * std::floor(acc / 2);
+
+            if(acc > 1)
+                acc = 2 - acc;
+        }
+
+        return acc > 1 ? 1.f : float(acc);
+    }
+
+    /**
+     * Calculates the exact area of every pixel covered by the given paths and calls fn with
+     * the row and the list of spans for every row that has covered pixels. Edges are
+     * accumulated as signed area and cover to a row of cells, as font rasterizers do, which
+     * is then turned into coverage in a single pass. Pixels that are almost completely covered
+     * are joined into spans without per pixel coverage. Rows are processed independently,
+     * therefore, clipping does not require any state. The region is between left, top
+     * (inclusive) and right, bottom (exclusive). W_ is winding, 0 is non zero, 1 is odd, 2 is
+     * non-zero on same path, odd on different path.
+     */
+    template<int W_, class PL_, class F_>
+    void findcoveragespans(const PL_ &pointlist, int left, int top, int right, int bottom, F_ fn) {
+        struct edge {
+            //y1 < y2
+            Float x1, y1;
+            Float x2, y2;
+            Float dxdy;
+            Float dir;
+            int index;
+        };
+
+        int width = right - left;
+
+        if(width <= 0 || bottom <= top)
+            return;
+
+        //buffers are reused between the calls, tiled rendering calls this many times for small areas
+        static thread_local std::vector<edge> edges;
+        static thread_local std::vector<Float> cells;
+        static thread_local std::vector<float> coverage;
+        static thread_local std::vector<CoverageSpan> spans;
+        static thread_local std::vector<const edge*> active;
+
+        edges.clear();
+        spans.clear();
+        active.clear();
+
+        int listind = 0;
+        for(const auto &points : pointlist) {
+            int N = (int)points.GetSize();
+            if(N <= 2) {
+                listind++;
+                continue;
+            }
+
+            for(int i=0; i<N; i++) {
+                auto line = points.GetLine(i);
+
+                Float x1 = (Float)line.Start.X, y1 = (Float)line.Start.Y;
+                Float x2 = (Float)line.End.X,   y2 = (Float)line.End.Y;
+                Float dir = 1;
+
+                if(y1 == y2)
+                    continue;
+
+                if(y1 > y2) {
+                    std::swap(x1, x2);
+                    std::swap(y1, y2);
+                    dir = -1;
+                }
+
+                if(y2 <= top || y1 >= bottom)
+                    continue;
+
+                edges.push_back({x1 - left, y1, x2 - left, y2, (x2 - x1) / (y2 - y1), dir, listind});
+            }
+
+            listind++;
+        }
+
+        if(edges.empty())
+            return;
+
+        std::sort(edges.begin(), edges.end(), [](const edge &l, const edge &r) {
+            return l.y1 < r.y1;
+        });
+
+        //cells and coverage are cleared after every row
+        if((int)cells.size() < width + 2)
+            cells.resize(width + 2, Float(0));
+
+        if((int)coverage.size() < width)
+            coverage.resize(width, 0.f);
+
+        const float full = 1 - 1.f/512, none = 1.f/512;
+
+        auto edgeit = edges.begin();
+
+        for(int y = std::max(top, (int)std::floor(edges.front().y1)); y<bottom; y++) {
+            while(edgeit != edges.end() && edgeit->y1 < y + 1) {
+                active.push_back(&*edgeit);
+
+                ++edgeit;
+            }
+
+            if(active.empty()) {
+                if(edgeit == edges.end())
+                    break;
+
+                //skip empty rows
+                y = (int)std::floor(edgeit->y1) - 1;
+
+                continue;
+            }
+
+            if(W_ == 2) {
+                std::sort(active.begin(), active.end(), [](const edge *l, const edge *r) {
+                    return l->index < r->index;
+                });
+            }
+
+            //range of the row that has coverage
+            int rowlo = width, rowhi = -1;
+
+            auto it = active.begin();
+            while(it != active.end()) {
+                int lo = width, hi = -1;
+
+                //for rule 2, each path is accumulated and swept separately
+                do {
+                    const edge &e = **it;
+
+                    Float ya = std::max<Float>((Float)y, e.y1);
+                    Float yb = std::min<Float>((Float)y + 1, e.y2);
+
+                    accumulatecells(
+                        &cells[0], width,
+                        e.x1 + (ya - e.y1) * e.dxdy, e.x1 + (yb - e.y1) * e.dxdy,
+                        (yb - ya) * e.dir, lo, hi
+                    );
+
+                    ++it;
+                } while(it != active.end() && (W_ != 2 || (*it)->index == (*(it - 1))->index));
+
+                if(hi < lo)
+                    continue;
+
+                int end = std::min(hi, width - 1);
+                Float acc = 0;
+
+                for(int x=lo; x<=end; x++) {
+                    acc += cells[x];
+
+                    float c = coveragefromwinding<W_ == 2 ? 0 : W_>(acc);
+
+                    if(W_ == 2)
+                        coverage[x] = coverage[x] + c - 2 * coverage[x] * c;
+                    else
+                        coverage[x] = c;
+                }
+
+                std::fill(cells.begin() + lo, cells.begin() + hi + 1, Float(0));
+
+                rowlo = std::min(rowlo, lo);
+                rowhi = std::max(rowhi, end);
+            }
+
+            //remove completed edges
+            active.erase(
+                std::remove_if(active.begin(), active.end(), [y](const edge *e) {
+                    return e->y2 <= y + 1;
+                }), active.end()
+            );
+
+            //find spans
+            for(int x=rowlo; x<=rowhi;) {
+                int start = x;
+
+                if(coverage[x] < none) {
+                    x++;
+                }
+                else if(coverage[x] > full) {
+                    while(x <= rowhi && coverage[x] > full)
+                        x++;
+
+                    spans.push_back({start + left, x - start, nullptr});
+                }
+                else {
+                    while(x <= rowhi && coverage[x] >= none && coverage[x] <= full)
+                        x++;
+
+                    spans.push_back({start + left, x - start, &coverage[start]});
+                }
+            }
+
+            if(!spans.empty())
+                fn(y, spans);
+
+            spans.clear();
+
+            if(rowlo <= rowhi)
+                std::fill(coverage.begin() + rowlo, coverage.begin() + rowhi + 1, 0.f);
+        }
+    }
+
+    /// Blends a solid color to a span of pixels. RGBA and BGRA images are blended on the raw
+    /// data using SIMD instructions when available, results are the same as RGBA::Blend.
+    /// Other modes use pixel accessors. Coverage can be nullptr for fully covered pixels.
+    inline void blendspan(Containers::Image &target, int x, int y, int length, const float *coverage, Graphics::RGBA color) {
+        if(y < 0 || y >= target.GetHeight())
+            return;
+
+        if(x < 0) {
+            if(coverage)
+                coverage -= x;
+
+            length += x;
+            x = 0;
+        }
+
+        if(x + length > target.GetWidth())
+            length = target.GetWidth() - x;
+
+        if(length <= 0)
+            return;
+
+        auto mode = target.GetMode();
+
+        if(mode != Graphics::ColorMode::RGBA && mode != Graphics::ColorMode::BGRA) {
+            for(int i=0; i<length; i++) {
+                auto col = target.GetRGBAAt(x + i, y);
+                col.Blend(color, coverage ? coverage[i] : 1.f);
+                target.SetRGBAAt(x + i, y, col);
+            }
+
+            return;
+        }
+
+        //color in the order of the image
+        Byte src[4] = {color.R, color.G, color.B, color.A};
+        if(mode == Graphics::ColorMode::BGRA)
+            std::swap(src[0], src[2]);
+
+        Byte *data = target.RawData() + 4 * (y * target.GetWidth() + x);
+
+        if(!coverage && color.A == 255) {
+            for(int i=0; i<length; i++)
+                std::memcpy(data + 4*i, src, 4);
+
+            return;
+        }
+
+        int i = 0;
+
+#ifdef GORGON_SSE2
+        //four pixels at a time, channels are separated into lanes and the calculation is
+        //performed in the same order as RGBA::Blend
+        const __m128 one  = _mm_set1_ps(1.f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 m255 = _mm_set1_ps(255.f);
+        const __m128 sa   = _mm_set1_ps((float)src[3]);
+        const __m128i mask = _mm_set1_epi32(0xff);
+
+        __m128 sc[3] = {_mm_set1_ps((float)src[0]), _mm_set1_ps((float)src[1]), _mm_set1_ps((float)src[2])};
+
+        for(; i+4<=length; i+=4) {
+            __m128i px = _mm_loadu_si128((const __m128i*)(data + 4*i));
+
+            __m128 cov = coverage ? _mm_loadu_ps(coverage + i) : one;
+
+            __m128 a   = _mm_div_ps(_mm_mul_ps(sa, cov), m255);
+            __m128 am1 = _mm_sub_ps(one, a);
+            __m128 da  = _mm_div_ps(_mm_cvtepi32_ps(_mm_srli_epi32(px, 24)), m255);
+            __m128 aa  = _mm_add_ps(a, _mm_mul_ps(da, am1));
+
+            am1 = _mm_mul_ps(am1, da);
+
+            //pixels that stay transparent keep their color
+            __m128 valid = _mm_cmpgt_ps(aa, zero);
+
+            __m128i result = _mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(aa, m255)), 24);
+
+            for(int c=0; c<3; c++) {
+                __m128i chi = _mm_and_si128(_mm_srli_epi32(px, 8*c), mask);
+                __m128  ch  = _mm_cvtepi32_ps(chi);
+
+                __m128 blended = _mm_div_ps(_mm_add_ps(_mm_mul_ps(ch, am1), _mm_mul_ps(sc[c], a)), aa);
+
+                blended = _mm_or_ps(_mm_and_ps(valid, blended), _mm_andnot_ps(valid, ch));
+
+                result = _mm_or_si128(result, _mm_slli_epi32(_mm_cvttps_epi32(blended), 8*c));
+            }
+
+            _mm_storeu_si128((__m128i*)(data + 4*i), result);
+        }
+#endif
+
+        for(; i<length; i++) {
+            Byte *p = data + 4*i;
+
+            Graphics::RGBA col(p[0], p[1], p[2], p[3]);
+            col.Blend({src[0], src[1], src[2], src[3]}, coverage ? coverage[i] : 1.f);
+
+            p[0] = col.R;
+            p[1] = col.G;
+            p[2] = col.B;
+            p[3] = col.A;
+        }
+    }
+
+    /// Applies the given fill to the spans of a row. origin is subtracted from the location
+    /// of the pixels to find the relative coordinates. shift is the location of the target
+    /// in the drawing.
+    template<class F_>
+    void fillspans(Containers::Image &target, int y, const std::vector<CoverageSpan> &spans, F_ &fill, Geometry::Point origin, Geometry::Point shift) {
+        for(const auto &s : spans) {
+            for(int i=0; i<s.Length; i++) {
+                int x = s.X + i;
+
+                auto col = fill({Float(x - origin.X), Float(y - origin.Y)}, {x, y}, target.GetRGBAAt(x - shift.X, y - shift.Y), s.Coverage ? s.Coverage[i] : 1.f);
+
+                target.SetRGBAAt(x - shift.X, y - shift.Y, col);
+            }
+        }
+    }
+
+    /// Solid fills blend whole spans at once
+    inline void fillspans(Containers::Image &target, int y, const std::vector<CoverageSpan> &spans, SolidFill<Graphics::RGBA> &fill, Geometry::Point, Geometry::Point shift) {
+        for(const auto &s : spans)
+            blendspan(target, s.X - shift.X, y - shift.Y, s.Length, s.Coverage, fill.GetColor());
+    }
+
+    /// Fills the given paths using analytic coverage. W_ is the winding rule, same as Polyfill.
+    /// target can be a part of a larger drawing that starts at shift, in that case, the paths
+    /// are clipped to the target and fill receives the coordinates in the drawing.
+    template<int W_, class PL_, class F_>
+    void analyticfill(Containers::Image &target, const PL_ &pointlist, F_ &fill, Geometry::Point shift = {0, 0}) {
+        Float xmin = 0, ymin = 0, xmax = 0, ymax = 0;
+        bool found = false;
+
+        for(const auto &p : pointlist) {
+            for(const auto &pnt : p) {
+                if(!found) {
+                    xmin = xmax = (Float)pnt.X;
+                    ymin = ymax = (Float)pnt.Y;
+                    found = true;
+                }
+                else {
+                    xmin = std::min(xmin, (Float)pnt.X);
+                    xmax = std::max(xmax, (Float)pnt.X);
+                    ymin = std::min(ymin, (Float)pnt.Y);
+                    ymax = std::max(ymax, (Float)pnt.Y);
+                }
+            }
+        }
+
+        if(!found)
+            return;
+
+        Geometry::Point origin = {(int)std::floor(xmin), (int)std::floor(ymin)};
+
+        int left   = std::max(origin.X, shift.X);
+        int top    = std::max(origin.Y, shift.Y);
+        int right  = (int)std::min<Float>(std::ceil(xmax), Float(shift.X + target.GetWidth()));
+        int bottom = (int)std::min<Float>(std::ceil(ymax), Float(shift.Y + target.GetHeight()));
+
+        findcoveragespans<W_>(pointlist, left, top, right, bottom, [&](int y, const std::vector<CoverageSpan> &spans) {
+            fillspans(target, y, spans, fill, origin, shift);
+        });
+    }
+}
+///@endcond
+
+} }
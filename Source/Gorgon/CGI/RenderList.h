@@ -0,0 +1,309 @@
+#pragma once
+
+#include "Polygon.h"
+#include "Line.h"
+#include "Circle.h"
+#include "../Geometry/Bounds.h"
+#include "../Threading.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+namespace Gorgon { namespace CGI {
+
+///@cond internal
+namespace internal {
+
+    /// Tiles are drawn at the top left of a buffer, this fill restores the absolute location
+    /// of the pixels.
+    template<class F_>
+    struct tilefill {
+        F_ fill;
+        Geometry::Point offset;
+
+        template<class C_>
+        C_ operator()(Geometry::Pointf relative, Geometry::Point absolute, C_ underlying, float alpha) {
+            return fill(relative, absolute + offset, underlying, alpha);
+        }
+    };
+
+    template<class F_>
+    tilefill<F_> filltile(F_ fill, Geometry::Point offset) {
+        return {fill, offset};
+    }
+
+    /// Solid fills do not use the location, they are kept as is to use span blending
+    template<class C_>
+    SolidFill<C_> filltile(SolidFill<C_> fill, Geometry::Point) {
+        return fill;
+    }
+
+    /// Returns the pixels that could be touched while filling the given point lists
+    template<class P_>
+    Geometry::Bounds polygonbounds(const std::vector<Geometry::PointList<P_>> &points) {
+        Float xmin = 0, ymin = 0, xmax = 0, ymax = 0;
+        bool found = false;
+
+        for(const auto &p : points) {
+            for(const auto &pnt : p) {
+                if(!found) {
+                    xmin = xmax = (Float)pnt.X;
+                    ymin = ymax = (Float)pnt.Y;
+                    found = true;
+                }
+                else {
+                    xmin = std::min(xmin, (Float)pnt.X);
+                    xmax = std::max(xmax, (Float)pnt.X);
+                    ymin = std::min(ymin, (Float)pnt.Y);
+                    ymax = std::max(ymax, (Float)pnt.Y);
+                }
+            }
+        }
+
+        if(!found)
+            return {0, 0, 0, 0};
+
+        return {(int)std::floor(xmin) - 1, (int)std::floor(ymin) - 1, (int)std::ceil(xmax) + 2, (int)std::ceil(ymax) + 2};
+    }
+}
+///@endcond
+
+    /**
+     * Records CGI drawing operations to render them later using multiple threads. Operations
+     * are binned into square tiles using their bounds. While rendering, every tile is copied
+     * to a small buffer that stays in cache, the operations that touch the tile are drawn to
+     * it in the order they are recorded and the buffer is copied back. Tiles are distributed
+     * to the threads dynamically.
+     *
+     * Geometry is copied while recording, thus the list can be rendered many times and to
+     * different targets. Fills are copied for every tile and receive the same absolute
+     * coordinates as direct drawing. Subdivision based polygon filling clips the shapes to
+     * the tile, therefore, relative coordinates of a clipped polygon may differ from direct
+     * drawing. AnalyticCoverage does not have this problem.
+     */
+    class RenderList {
+    public:
+        /// Creates an empty list, tiles will be tilesize x tilesize pixels.
+        explicit RenderList(int tilesize = 128) : tilesize(tilesize) {
+        }
+
+        /// Records filling the given point list as a polygon. See CGI::Polyfill.
+        template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, int W_ = 1, class P_ = Geometry::Pointf, class F_ = SolidFill<>>
+        void Polyfill(const Geometry::PointList<P_> &points, F_ fill = SolidFill<>{Graphics::Color::Black}) {
+            if(points.GetSize() < 3)
+                return;
+
+            std::vector<Geometry::PointList<P_>> list;
+            list.push_back(points.Duplicate());
+
+            Polyfill<S_, W_, P_, F_>(std::move(list), fill);
+        }
+
+        /// Records filling the given point lists as a polygon. See CGI::Polyfill.
+        template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, int W_ = 1, class P_ = Geometry::Pointf, class F_ = SolidFill<>>
+        void Polyfill(std::vector<Geometry::PointList<P_>> points, F_ fill = SolidFill<>{Graphics::Color::Black}) {
+            auto bounds = internal::polygonbounds(points);
+            auto shared = std::make_shared<std::vector<Geometry::PointList<P_>>>(std::move(points));
+
+            add(bounds, [shared, fill](Containers::Image &tile, Geometry::Point offset) {
+                //analytic coverage can clip without moving the geometry
+                if(S_ == AnalyticCoverage) {
+                    auto f = fill;
+                    internal::analyticfill<W_>(tile, *shared, f, offset);
+
+                    return;
+                }
+
+                std::vector<Geometry::PointList<P_>> moved;
+                moved.reserve(shared->size());
+
+                for(const auto &p : *shared)
+                    moved.push_back(p - P_(offset));
+
+                CGI::Polyfill<S_, W_, P_>(tile, moved, internal::filltile(fill, offset));
+            });
+        }
+
+        /// Records drawing a point list as a list of lines. See CGI::DrawLines.
+        template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, class P_ = Geometry::Pointf, class F_ = SolidFill<>>
+        void DrawLines(const Geometry::PointList<P_> &points, StrokeSettings settings = 1.0, F_ stroke = SolidFill<>{Graphics::Color::Black}) {
+            Polyfill<S_, 0, P_, F_>(LinesToPolygons<S_, P_>(points, settings), stroke);
+        }
+
+        /// Records drawing point lists as lists of lines. See CGI::DrawLines.
+        template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, class P_ = Geometry::Pointf, class F_ = SolidFill<>>
+        void DrawLines(const std::vector<Geometry::PointList<P_>> &points, StrokeSettings settings = 1.0, F_ stroke = SolidFill<>{Graphics::Color::Black}) {
+            std::vector<Geometry::PointList<P_>> polygons;
+
+            for(const auto &p : points) {
+                for(auto &np : LinesToPolygons<S_, P_>(p, settings))
+                    polygons.push_back(std::move(np));
+            }
+
+            Polyfill<S_, 0, P_, F_>(std::move(polygons), stroke);
+        }
+
+        /// Records drawing a filled circle. See CGI::Circle.
+        template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, class P_ = Geometry::Pointf, class F_ = SolidFill<>>
+        void Circle(P_ location, Float radius, F_ fill = SolidFill<>(Graphics::Color::Black)) {
+            add(circlebounds(location, radius), [location, radius, fill](Containers::Image &tile, Geometry::Point offset) {
+                CGI::Circle<S_>(tile, location - P_(offset), radius, internal::filltile(fill, offset));
+            });
+        }
+
+        /// Records drawing a circle outline. See CGI::Circle.
+        template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, class P_ = Geometry::Pointf, class F_ = SolidFill<>>
+        void Circle(P_ location, Float radius, Float border, F_ fill = SolidFill<>(Graphics::Color::Black)) {
+            add(circlebounds(location, radius + border), [location, radius, border, fill](Containers::Image &tile, Geometry::Point offset) {
+                CGI::Circle<S_>(tile, location - P_(offset), radius, border, internal::filltile(fill, offset));
+            });
+        }
+
+        /// Records filling a rectangle. See CGI::Rectangle.
+        template<int S_ = GORGON_DEFAULT_SUBDIVISIONS, class P_ = Geometry::Pointf, class F_ = SolidFill<>>
+        void Rectangle(const Geometry::basic_Rectangle<typename P_::BaseType> &rect, F_ fill = SolidFill<>{Graphics::Color::Black}) {
+            Geometry::PointList<P_> points = {
+                rect.TopLeft(),
+                rect.BottomLeft(),
+                rect.BottomRight(),
+                rect.TopRight()
+            };
+
+            Polyfill<S_, 1, P_, F_>(points, fill);
+        }
+
+        /// Renders the recorded operations to the given target. If threads is 0, the number
+        /// of hardware threads is used.
+        void Render(Containers::Image &target, unsigned threads = 0) const {
+            int W = target.GetWidth(), H = target.GetHeight();
+
+            if(operations.empty() || W <= 0 || H <= 0)
+                return;
+
+            int cols = (W + tilesize - 1) / tilesize;
+            int rows = (H + tilesize - 1) / tilesize;
+
+            //bin
+            std::vector<std::vector<int>> tiles(cols * rows);
+
+            for(int i=0; i<(int)operations.size(); i++) {
+                const auto &b = operations[i].bounds;
+
+                if(b.Right <= 0 || b.Bottom <= 0 || b.Left >= W || b.Top >= H || b.Left >= b.Right || b.Top >= b.Bottom)
+                    continue;
+
+                int x0 = std::max(b.Left, 0) / tilesize, x1 = (std::min(b.Right, W) - 1) / tilesize;
+                int y0 = std::max(b.Top,  0) / tilesize, y1 = (std::min(b.Bottom, H) - 1) / tilesize;
+
+                for(int y=y0; y<=y1; y++)
+                    for(int x=x0; x<=x1; x++)
+                        tiles[y * cols + x].push_back(i);
+            }
+
+            std::vector<int> work;
+            for(int t=0; t<(int)tiles.size(); t++) {
+                if(!tiles[t].empty())
+                    work.push_back(t);
+            }
+
+            if(work.empty())
+                return;
+
+            if(threads == 0)
+                threads = std::max(1u, std::thread::hardware_concurrency());
+
+            threads = std::min(threads, (unsigned)work.size());
+
+            auto mode = target.GetMode();
+            int  bpp  = (int)Graphics::GetChannelsPerPixel(mode);
+
+            std::atomic<int> next{0};
+
+            auto render = [&](int, int) {
+                Containers::Image tile;
+
+                for(int w = next++; w < (int)work.size(); w = next++) {
+                    int t = work[w];
+
+                    Geometry::Point offset = {(t % cols) * tilesize, (t / cols) * tilesize};
+                    Geometry::Size  size   = {std::min(tilesize, W - offset.X), std::min(tilesize, H - offset.Y)};
+
+                    if(tile.GetSize() != size || tile.GetMode() != mode)
+                        tile = Containers::Image(size, mode);
+
+                    Byte *data = target.RawData() + (offset.Y * W + offset.X) * bpp;
+
+                    for(int y=0; y<size.Height; y++)
+                        std::memcpy(tile.RawData() + y * size.Width * bpp, data + y * W * bpp, size.Width * bpp);
+
+                    for(auto i : tiles[t])
+                        operations[i].draw(tile, offset);
+
+                    for(int y=0; y<size.Height; y++)
+                        std::memcpy(data + y * W * bpp, tile.RawData() + y * size.Width * bpp, size.Width * bpp);
+                }
+            };
+
+            if(threads > 1)
+                Threading::RunInParallel(render, threads);
+            else
+                render(0, 1);
+        }
+
+        /// Renders the recorded operations to the given target. If threads is 0, the number
+        /// of hardware threads is used.
+        void Render(Graphics::Bitmap &target, unsigned threads = 0) const {
+            if(target.HasData())
+                Render(target.GetData(), threads);
+        }
+
+        /// Removes all recorded operations
+        void Clear() {
+            operations.clear();
+        }
+
+        /// Returns the number of recorded operations
+        int GetSize() const {
+            return (int)operations.size();
+        }
+
+        /// Returns if there are no recorded operations
+        bool IsEmpty() const {
+            return operations.empty();
+        }
+
+        /// Returns the size of the tiles
+        int GetTileSize() const {
+            return tilesize;
+        }
+
+    private:
+        struct operation {
+            /// Pixels that can be modified by the operation
+            Geometry::Bounds bounds;
+
+            /// Draws the operation to a tile, offset is the location of the tile
+            std::function<void(Containers::Image &, Geometry::Point)> draw;
+        };
+
+        template<class P_>
+        static Geometry::Bounds circlebounds(P_ location, Float radius) {
+            return {
+                (int)std::floor(Float(location.X) - radius) - 2, (int)std::floor(Float(location.Y) - radius) - 2,
+                (int)std::ceil (Float(location.X) + radius) + 2, (int)std::ceil (Float(location.Y) + radius) + 2
+            };
+        }
+
+        void add(Geometry::Bounds bounds, std::function<void(Containers::Image &, Geometry::Point)> draw) {
+            operations.push_back({bounds, std::move(draw)});
+        }
+
+        int tilesize;
+
+        std::vector<operation> operations;
+    };
+
+} }
@@ -3,4 +3,6 @@ set(Local
     Circle.h
     Line.h
     Polygon.h
+    Rasterizer.h
+    RenderList.h
 )
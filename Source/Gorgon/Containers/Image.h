@@ -1,12 +1,15 @@
 #pragma once
 
 #include <vector>
+#include <type_traits>
 
 #include "../Types.h"
 #include "../Geometry/Point.h"
 #include "../Geometry/Size.h"
 #include "../Geometry/Bounds.h"
 #include "../Graphics/Color.h"
+#include "../Graphics/PixelConversion.h"
+#include "../ImageProcessing/Resampling.h"
 #include "../IO/Stream.h"
 
 namespace Gorgon {
@@ -19,6 +22,10 @@ namespace Gorgon {
             Bilinear = Linear,
             Cubic,
             Bicubic = Cubic,
+            /// Averages the pixels that are covered by the target pixel, only used while scaling
+            Area,
+            /// Lanczos filter with 3 lobes, sharper than cubic, only used while scaling
+            Lanczos,
         };
 
         template<class T_, class V_ = void>
@@ -246,95 +253,33 @@ namespace Gorgon {
 
             /// Converts this image data to RGBA buffer
             void ConvertToRGBA() {
-                if(!data) return;
-
-                switch(mode) {
-                case Graphics::ColorMode::BGRA:
-                    for(int i=0; i<size.Area(); i++) {
-                        std::swap(data[i*4+2], data[i*4+0]);
-                    }
-                    break;
-
-                case Graphics::ColorMode::Grayscale_Alpha: {
-                    auto pdata = data;
-                    data = (Byte*)malloc(size.Area()*4*sizeof(T_));
-
-                    for(int i=0; i<size.Area(); i++) {
-                        data[i*4+0] = pdata[i*2+0];
-                        data[i*4+1] = pdata[i*2+0];
-                        data[i*4+2] = pdata[i*2+0];
-                        data[i*4+3] = pdata[i*2+1];
-                    }
-                    delete pdata;
-                }
-                break;
-
-                case Graphics::ColorMode::Grayscale: {
-                    auto pdata = data;
-                    data = (Byte*)malloc(size.Area()*4*sizeof(T_));
-
-                    for(int i=0; i<size.Area(); i++) {
-                        data[i*4+0] = pdata[i+0];
-                        data[i*4+1] = pdata[i+0];
-                        data[i*4+2] = pdata[i+0];
-                        data[i*4+3] = 255;
-                    }
-                    delete pdata;
-                }
-                break;
+                static_assert(std::is_same<T_, Byte>::value, "Pixel conversion only supports Byte images");
 
-                case Graphics::ColorMode::Alpha: {
-                    auto pdata = data;
-                    data = (Byte*)malloc(size.Area()*4*sizeof(T_));
+                if(!data) return;
 
-                    for(int i=0; i<size.Area(); i++) {
-                        data[i*4+0] = 255;
-                        data[i*4+1] = 255;
-                        data[i*4+2] = 255;
-                        data[i*4+3] = pdata[i+0];
-                    }
-                    delete pdata;
-                }
-                break;
+                if(mode == Graphics::ColorMode::RGBA)
+                    return;
 
-                case Graphics::ColorMode::RGB: {
-                    auto pdata = data;
-                    data = (Byte*)malloc(size.Area()*4*sizeof(T_));
+                auto converter = Graphics::GetPixelConverter(mode, Graphics::ColorMode::RGBA);
+                if(!converter)
+                    throw std::runtime_error("Invalid color mode");
 
-                    for(int i=0; i<size.Area(); i++) {
-                        data[i*4+0] = pdata[i*3+0];
-                        data[i*4+1] = pdata[i*3+1];
-                        data[i*4+2] = pdata[i*3+2];
-                        data[i*4+3] = 255;
-                    }
-                    delete pdata;
+                //BGRA is converted in place
+                if(cpp == 4) {
+                    converter(RawData(), RawData(), size.Area());
                 }
-                break;
-
-                case Graphics::ColorMode::BGR: {
+                else {
                     auto pdata = data;
                     data = (Byte*)malloc(size.Area()*4*sizeof(T_));
 
-                    for(int i=0; i<size.Area(); i++) {
-                        data[i*4+0] = pdata[i*3+2];
-                        data[i*4+1] = pdata[i*3+1];
-                        data[i*4+2] = pdata[i*3+0];
-                        data[i*4+3] = 255;
-                    }
-                    delete pdata;
-                }
-                break;
-                
-                case Graphics::ColorMode::RGBA:
-                    //do nothing
-                    break;
-                    
-                default:
-                    throw std::runtime_error("Invalid color mode");
+                    converter((Byte*)pdata, RawData(), size.Area());
 
+                    free(pdata);
                 }
 
                 mode = Graphics::ColorMode::RGBA;
+                cpp = 4;
+                alphaloc = 3;
             }
             
             // cppcheck-suppress constParameter
@@ -419,199 +364,30 @@ namespace Gorgon {
 
             /// Copies this image to a RGBA buffer, buffer should be resize before calling this function
             void CopyToRGBABuffer(Byte *buffer) const {
-                if(!data) return;
+                static_assert(std::is_same<T_, Byte>::value, "Pixel conversion only supports Byte images");
 
-                int i;
-
-                switch(mode) {
-                    case Graphics::ColorMode::RGBA:
-                        memcpy(buffer, data, size.Area()*4);
-                        break;
-
-                    case Graphics::ColorMode::BGRA:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i*4+2];
-                            buffer[i*4+1] = data[i*4+1];
-                            buffer[i*4+2] = data[i*4+0];
-                            buffer[i*4+3] = data[i*4+3];
-                        }
-                        break;
-
-                    case Graphics::ColorMode::Grayscale_Alpha:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i*2+0];
-                            buffer[i*4+1] = data[i*2+0];
-                            buffer[i*4+2] = data[i*2+0];
-                            buffer[i*4+3] = data[i*2+1];
-                        }
-                        break;
-
-                    case Graphics::ColorMode::Grayscale:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i+0];
-                            buffer[i*4+1] = data[i+0];
-                            buffer[i*4+2] = data[i+0];
-                            buffer[i*4+3] = 255;
-                        }
-                        break;
-
-                    case Graphics::ColorMode::Alpha:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = 255;
-                            buffer[i*4+1] = 255;
-                            buffer[i*4+2] = 255;
-                            buffer[i*4+3] = data[i+0];
-                        }
-                        break;
-
-                    case Graphics::ColorMode::RGB: 
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i*3+0];
-                            buffer[i*4+1] = data[i*3+1];
-                            buffer[i*4+2] = data[i*3+2];
-                            buffer[i*4+3] = 255;
-                        }
-                        break;
+                if(!data) return;
 
-                    case Graphics::ColorMode::BGR:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i*3+2];
-                            buffer[i*4+1] = data[i*3+1];
-                            buffer[i*4+2] = data[i*3+0];
-                            buffer[i*4+3] = 255;
-                        }
-                        break;
-                    
-                    default:
-                        throw std::runtime_error("Invalid mode");
-                }
+                Graphics::ConvertPixels(RawData(), mode, buffer, Graphics::ColorMode::RGBA, size.Area());
             }
 
             /// Copies this image to a RGBA buffer, buffer should be resize before calling this function.
             /// This function is here mostly to create icon for Win32
             void CopyToBGRABuffer(Byte *buffer) const {
-                if(!data) return;
-
-                int i;
-
-                switch(mode) {
-                    case Graphics::ColorMode::BGRA:
-                        memcpy(buffer, data, size.Area()*4);
-                        break;
-
-                    case Graphics::ColorMode::RGBA:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i*4+2];
-                            buffer[i*4+1] = data[i*4+1];
-                            buffer[i*4+2] = data[i*4+0];
-                            buffer[i*4+3] = data[i*4+3];
-                        }
-                        break;
-
-                    case Graphics::ColorMode::Grayscale_Alpha:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i*2+0];
-                            buffer[i*4+1] = data[i*2+0];
-                            buffer[i*4+2] = data[i*2+0];
-                            buffer[i*4+3] = data[i*2+1];
-                        }
-                        break;
-
-                    case Graphics::ColorMode::Grayscale:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i+0];
-                            buffer[i*4+1] = data[i+0];
-                            buffer[i*4+2] = data[i+0];
-                            buffer[i*4+3] = 255;
-                        }
-                        break;
-
-                    case Graphics::ColorMode::Alpha:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = 255;
-                            buffer[i*4+1] = 255;
-                            buffer[i*4+2] = 255;
-                            buffer[i*4+3] = data[i+0];
-                        }
-                        break;
-
-                    case Graphics::ColorMode::BGR: 
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i*3+0];
-                            buffer[i*4+1] = data[i*3+1];
-                            buffer[i*4+2] = data[i*3+2];
-                            buffer[i*4+3] = 255;
-                        }
-                        break;
+                static_assert(std::is_same<T_, Byte>::value, "Pixel conversion only supports Byte images");
 
-                    case Graphics::ColorMode::RGB:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i*4+0] = data[i*3+2];
-                            buffer[i*4+1] = data[i*3+1];
-                            buffer[i*4+2] = data[i*3+0];
-                            buffer[i*4+3] = 255;
-                        }
-                        break;
-                    
-                    default:
-                        throw std::runtime_error("Invalid mode");
+                if(!data) return;
 
-                }
+                Graphics::ConvertPixels(RawData(), mode, buffer, Graphics::ColorMode::BGRA, size.Area());
             }
             /// Copies this image to a RGBA buffer, buffer should be resize before calling this function.
             /// This function is here mostly to create icon for X11
             void CopyToBGRABufferLong(unsigned long *buffer) const {
-                if(!data) return;
-
-                int i;
-
-                switch(mode) {
-                    case Graphics::ColorMode::BGRA:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i] = (data[i*4+0]<<0) | (data[i*4+1]<<8) | (data[i*4+2]<<16) | (data[i*4+3]<<24);
-                        }
-                        break;
-
-                    case Graphics::ColorMode::RGBA:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i] = (data[i*4+2]<<0) | (data[i*4+1]<<8) | (data[i*4+0]<<16) | (data[i*4+3]<<24);
-                        }
-                        break;
-
-                    case Graphics::ColorMode::Grayscale_Alpha:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i] = (data[i*2+0]<<0) | (data[i*2+0]<<8) | (data[i*2+0]<<16) | (data[i*2+1]<<24);
-                        }
-                        break;
+                static_assert(std::is_same<T_, Byte>::value, "Pixel conversion only supports Byte images");
 
-                    case Graphics::ColorMode::Grayscale:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i] = (data[i*1+0]<<0) | (data[i*1+0]<<8) | (data[i*1+0]<<16) | (255<<24);
-                        }
-                        break;
-
-                    case Graphics::ColorMode::Alpha: 
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i] = (255<<0) | (255<<8) | (255<<16) | (data[i*1+0]<<24);
-                        }
-                        break;
-
-                    case Graphics::ColorMode::BGR: 
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i] = (data[i*3+0]<<0) | (data[i*3+1]<<8) | (data[i*3+2]<<16) | (255<<24);
-                        }
-                        break;
-
-                    case Graphics::ColorMode::RGB:
-                        for(i=0; i<size.Area(); i++) {
-                            buffer[i] = (data[i*3+2]<<0) | (data[i*3+1]<<8) | (data[i*3+0]<<16) | (255<<24);
-                        }
-                        break;
-                    
-                    default:
-                        throw std::runtime_error("Invalid mode");
+                if(!data) return;
 
-                }
+                Graphics::ConvertPixels(RawData(), mode, buffer, size.Area());
             }
 
             /// Shrinks the size of the image using integer area interpolation.
@@ -649,141 +425,38 @@ namespace Gorgon {
                 return target;
             }
 
-            /// Scales this image to the given size. In the image is shrunk more than 2x its original size
-            /// Area interpolation is used along with the specified interpolation method.
+            /// Scales this image to the given size. While shrinking, the filter is widened to cover
+            /// all the source pixels that fall into a target pixel, thus Linear, Cubic, Area and 
+            /// Lanczos methods do not cause aliasing. Large images are processed in multiple threads.
+            /// Scaling, rotating and skewing are only available for Byte images.
             basic_Image Scale(const Geometry::Size &newsize, InterpolationMethod method = InterpolationMethod::Cubic) const {
-                basic_Image target(newsize, GetMode());
-
-                float fx = (float)size.Width / newsize.Width;
-                float fy = (float)size.Height / newsize.Height;
-
-                if(fx > 2 || fy > 2) {
-                    if(fx < 2)
-                        fx = 1;
-                    if(fy < 2)
-                        fy = 1;
-
-                    auto img = ShrinkMultiple({int(fx), int(fy)});
-
-                    if(img.GetSize() == newsize)
-                        return img;
-                    else
-                        return img.Scale(newsize, method);
-                }
-
-                if(method == InterpolationMethod::NearestNeighbor) {
-                    float yy = fy/2;
-                    for(int y=0; y<newsize.Height; y++) {
-                        float xx = fx/2;
-                        for(int x=0; x<newsize.Width; x++) {
-                            for(unsigned c=0; c<cpp; c++) {
-                                target(x, y, c) = operator()((int)xx, (int)yy, c);
-                            }
-
-                            xx += fx;
-                        }
-
-                        yy += fy;
-                    }
-                }
-                else if(method == InterpolationMethod::Linear) {
-                    float yy = 0.5f;
-                    for(int y=0; y<newsize.Height; y++) {
-                        float ly  = yy - (int)yy;
-                        float ly1 = 1 - ly;
-                        int   y1 = (int)yy;
-                        int   y2 = y1 + 1;
-
-                        y1 = y1 < 0 ? 0 : y1;
-                        y2 = y2 >= size.Height ? size.Height - 1 : y2;
-
-                        float xx = 0.5f;
-                        for(int x=0; x<newsize.Width; x++) {
-                            float lx  = xx - (int)xx;
-                            float lx1 = 1 - lx;
-                            int   x1 = (int)xx;
-                            int   x2 = x1 + 1;
-
-                            x1 = x1 < 0 ? 0 : x1;
-                            x2 = x2 >= size.Width ? size.Width - 1 : x2;
-
-                            for(unsigned c=0; c<cpp; c++) {
-                                target(x, y, c) = FixImageValue<T_>::Fix(
-                                    lx1 * ly1 * operator()(x1, y1, c) +
-                                    lx  * ly1 * operator()(x2, y1, c) +
-                                    lx  * ly  * operator()(x2, y2, c) +
-                                    lx1 * ly  * operator()(x1, y2, c)
-                                );
-                            }
-
-                            xx += fx;
-                        }
-
-                        yy += fy;
-                    }
-                }
-                else if(method == InterpolationMethod::Cubic) {
-                    float yy = 0.f;
-                    int ys[4];
-                    float wy[4], yf[4];
-                    int xs[4];
-                    float wx[4], xf[4];
-                    const float a = -0.5;
-                    for(int y=0; y<newsize.Height; y++) {
-                        yf[1]  = yy - (int)yy;
-                        yf[2] = 1 - yf[1];
-                        yf[3] = 2 - yf[1];
-                        yf[0] = 1 + yf[1];
-
-                        for(int i=0; i<4; i++) {
-                            if(i == 1 || i == 2) {
-                                wy[i] = (a+2) * yf[i]*yf[i]*yf[i] - (a+3) * yf[i]*yf[i] + 1;
-                            }
-                            else {
-                                wy[i] = a * yf[i]*yf[i]*yf[i] - 5*a * yf[i]*yf[i] + 8*a * yf[i] - 4*a;
-                            }
-                            ys[i]  = Clamp((int)yy-1 + i, 0, size.Height-1);
-                        }
+                basic_Image target;
+                Scale(target, newsize, method);
 
-                        float xx = 0.f;
-                        for(int x=0; x<newsize.Width; x++) {
-                            xf[1]  = xx - (int)xx;
-                            xf[2] = 1 - xf[1];
-                            xf[3] = 2 - xf[1];
-                            xf[0] = 1 + xf[1];
+                return target;
+            }
 
-                            for(int i=0; i<4; i++) {
-                                if(i == 1 || i == 2) {
-                                    wx[i] = (a+2) * xf[i]*xf[i]*xf[i] - (a+3) * xf[i]*xf[i] + 1;
-                                }
-                                else {
-                                    wx[i] = a * xf[i]*xf[i]*xf[i] - 5*a * xf[i]*xf[i] + 8*a * xf[i] - 4*a;
-                                }
-                                xs[i]  = Clamp((int)xx-1 + i, 0, size.Width-1);
-                            }
+            /// Scales this image into the given target. Target is resized and switched to the color mode
+            /// of this image, if its size is already correct, its buffer is reused. Target cannot be this
+            /// image.
+            void Scale(basic_Image &target, const Geometry::Size &newsize, InterpolationMethod method = InterpolationMethod::Cubic) const {
+                auto filter = resamplingfilter(method);
 
-                            for(unsigned c=0; c<cpp; c++) {
-                                float v = 0;
-                                for(int j=0; j<4; j++) {
-                                    for(int i=0; i<4; i++) {
-                                        v += wx[i] * wy[j] * operator()(xs[i], ys[j], c);
-                                    }
-                                }
+                Scale(target, {size.Width, newsize.Width, filter}, {size.Height, newsize.Height, filter});
+            }
 
-                                target(x, y, c) = FixImageValue<T_>::Fix(v);
-                            }
+            /// Scales this image into the given target using the given coefficient tables. Tables can be
+            /// reused to scale many images of the same size. Target is resized and switched to the color
+            /// mode of this image. Target cannot be this image.
+            void Scale(basic_Image &target, const ImageProcessing::ResamplingTable &horizontal, const ImageProcessing::ResamplingTable &vertical) const {
+                static_assert(std::is_same<T_, Byte>::value, "Resampling only supports Byte images");
 
-                            xx += fx;
-                        }
+                if(horizontal.GetSourceSize() != size.Width || vertical.GetSourceSize() != size.Height)
+                    throw std::runtime_error("Resampling tables do not match the size of the image");
 
-                        yy += fy;
-                    }
-                }
-                else {
-                    throw std::runtime_error("Unknown interpolation method");
-                }
+                prepare(target, {horizontal.GetDestinationSize(), vertical.GetDestinationSize()});
 
-                return target;
+                ImageProcessing::Resample(RawData(), target.RawData(), cpp, horizontal, vertical);
             }
             
             /// Rotates this image with the given angle.
@@ -791,8 +464,27 @@ namespace Gorgon {
                 return Rotate(angle, {size.Width/2.f, size.Height/2.f}, method);
             }
 
-            /// Rotates this image with the given angle.
+            /// Rotates this image with the given angle. Area and Lanczos methods are performed as Cubic.
             basic_Image Rotate(Float angle, const Geometry::Pointf origin, InterpolationMethod method = InterpolationMethod::Cubic) const {
+                basic_Image target;
+                Rotate(target, angle, origin, method);
+
+                return target;
+            }
+
+            /// Rotates this image with the given angle into the given target. Target is resized and 
+            /// switched to the color mode of this image. Target cannot be this image.
+            void Rotate(basic_Image &target, Float angle, InterpolationMethod method = InterpolationMethod::Cubic) const {
+                Rotate(target, angle, {size.Width/2.f, size.Height/2.f}, method);
+            }
+
+            /// Rotates this image with the given angle into the given target. Target is resized and 
+            /// switched to the color mode of this image. Target cannot be this image.
+            void Rotate(basic_Image &target, Float angle, const Geometry::Pointf origin, InterpolationMethod method = InterpolationMethod::Cubic) const {
+                static_assert(std::is_same<T_, Byte>::value, "Resampling only supports Byte images");
+
+                auto filter = resamplingfilter(method);
+
                 Geometry::Boundsf bnds = {0,0, Geometry::Sizef(size)};
                 Geometry::Rotate(bnds, angle, origin);
                 Geometry::Bounds b{
@@ -802,127 +494,40 @@ namespace Gorgon {
 
                 auto newsize = b.GetSize();
 
-                basic_Image target(newsize, GetMode());
+                prepare(target, newsize);
 
                 Float cosa = std::cos(-angle); //inverse transform
                 Float sina = std::sin(-angle);
 
-                if(method == InterpolationMethod::NearestNeighbor) {
-                    for(int y=0; y<newsize.Height; y++) {
-                        float yn = y - origin.Y + b.Top;
-
-                        for(int x=0; x<newsize.Width; x++) {
-                            for(unsigned c=0; c<cpp; c++) {
-                                float xn = x - origin.X + b.Left;
-
-                                target(x, y, c) = Get((int)std::round(xn * cosa - yn * sina + origin.X), (int)std::round(xn * sina + yn * cosa + origin.Y), c);
-                            }
-                        }
-                    }
-                }
-                else if(method == InterpolationMethod::Linear) {
-                    for(int y=0; y<newsize.Height; y++) {
-                        float yn = y - origin.Y + b.Top;
-
-                        for(int x=0; x<newsize.Width; x++) {
-                            float xn = x - origin.X + b.Left;
-
-                            float xx = xn * cosa - yn * sina + origin.X;
-                            float yy = xn * sina + yn * cosa + origin.Y;
-
-                            int   y1 = (int)std::floor(yy);
-                            float ly  = yy - y1;
-                            float ly1 = 1 - ly;
-                            int   y2 = y1 + 1;
-
-                            int   x1 = (int)std::floor(xx);
-                            float lx  = xx - x1;
-                            float lx1 = 1 - lx;
-                            int   x2 = x1 + 1;
-
-                            for(unsigned c=0; c<cpp; c++) {
-                                target(x, y, c) = FixImageValue<T_>::Fix(
-                                    lx1 * ly1 * Get(x1, y1, c) +
-                                    lx  * ly1 * Get(x2, y1, c) +
-                                    lx  * ly  * Get(x2, y2, c) +
-                                    lx1 * ly  * Get(x1, y2, c)
-                                );
-                            }
-                        }
-                    }
-                }
-                else if(method == InterpolationMethod::Cubic) {
-                    int ys[4];
-                    float wy[4], yf[4];
-                    int xs[4];
-                    float wx[4], xf[4];
-                    const float a = -0.5;
-                    for(int y=0; y<newsize.Height; y++) {
-                        float yn = y - origin.Y + b.Top;
-
-                        for(int x=0; x<newsize.Width; x++) {
-                            float xn = x - origin.X + b.Left;
-
-                            float xx = xn * cosa - yn * sina + origin.X;
-                            float yy = xn * sina + yn * cosa + origin.Y;
-
-                            xf[1]  = xx - std::floor(xx);
-                            xf[2] = 1 - xf[1];
-                            xf[3] = 2 - xf[1];
-                            xf[0] = 1 + xf[1];
-
-                            for(int i=0; i<4; i++) {
-                                if(i == 1 || i == 2) {
-                                    wx[i] = (a+2) * xf[i]*xf[i]*xf[i] - (a+3) * xf[i]*xf[i] + 1;
-                                }
-                                else {
-                                    wx[i] = a * xf[i]*xf[i]*xf[i] - 5*a * xf[i]*xf[i] + 8*a * xf[i] - 4*a;
-                                }
-                                xs[i]  = (int)floor(xx)-1 + i;
-                            }
-
-                            yf[1]  = yy - std::floor(yy);
-                            yf[2] = 1 - yf[1];
-                            yf[3] = 2 - yf[1];
-                            yf[0] = 1 + yf[1];
-
-                            for(int i=0; i<4; i++) {
-                                if(i == 1 || i == 2) {
-                                    wy[i] = (a+2) * yf[i]*yf[i]*yf[i] - (a+3) * yf[i]*yf[i] + 1;
-                                }
-                                else {
-                                    wy[i] = a * yf[i]*yf[i]*yf[i] - 5*a * yf[i]*yf[i] + 8*a * yf[i] - 4*a;
-                                }
-                                ys[i]  = (int)floor(yy)-1 + i;
-                            }
-
-                            for(unsigned c=0; c<cpp; c++) {
-                                float v = 0;
-                                for(int j=0; j<4; j++) {
-                                    for(int i=0; i<4; i++) {
-                                        v += wx[i] * wy[j] * Get(xs[i], ys[j], c);
-                                    }
-                                }
-
-                                target(x, y, c) = FixImageValue<T_>::Fix(v);
-                            }
-                        }
-                    }
-                }
-                else {
-                    throw std::runtime_error("Unknown interpolation method");
-                }
+                //source position of the top left target pixel, then the steps along x and y
+                Geometry::Pointf start = {
+                    (b.Left - origin.X) * cosa - (b.Top - origin.Y) * sina + origin.X,
+                    (b.Left - origin.X) * sina + (b.Top - origin.Y) * cosa + origin.Y
+                };
 
-                return target;
+                ImageProcessing::Transform(RawData(), size, target.RawData(), newsize, cpp, start, {cosa, sina}, {-sina, cosa}, filter);
             }
 
-            /// Rotates this image with the given angle.
+            /// Skews this image along X axis.
             basic_Image SkewX(Float perpixel, InterpolationMethod method = InterpolationMethod::Cubic) const {
                 return SkewX(perpixel, {0.f, 0.f}, method);
             }
 
-            /// Rotates this image with the given angle.
+            /// Skews this image along X axis. Area and Lanczos methods are performed as Cubic.
             basic_Image SkewX(Float perpixel, const Geometry::Pointf origin, InterpolationMethod method = InterpolationMethod::Cubic) const {
+                basic_Image target;
+                SkewX(target, perpixel, origin, method);
+
+                return target;
+            }
+
+            /// Skews this image into the given target. Target is resized and switched to the color mode of
+            /// this image. Target cannot be this image.
+            void SkewX(basic_Image &target, Float perpixel, const Geometry::Pointf origin = {0.f, 0.f}, InterpolationMethod method = InterpolationMethod::Cubic) const {
+                static_assert(std::is_same<T_, Byte>::value, "Resampling only supports Byte images");
+
+                auto filter = resamplingfilter(method);
+
                 Geometry::Boundsf bnds = {0,0, Geometry::Sizef(size)};
                 Geometry::SkewX(bnds, perpixel, origin);
                 Geometry::Bounds b{
@@ -932,96 +537,32 @@ namespace Gorgon {
 
                 auto newsize = b.GetSize();
 
-                basic_Image target(newsize, GetMode());
-
-                if(method == InterpolationMethod::NearestNeighbor) {
-                    for(int y=0; y<newsize.Height; y++) {
-                        float yn = y - origin.Y + b.Top;
-
-                        for(int x=0; x<newsize.Width; x++) {
-                            for(unsigned c=0; c<cpp; c++) {
-                                float xn = float(x + b.Left);
-
-                                target(x, y, c) = Get((int)std::round(xn - yn * perpixel), y, c);
-                            }
-                        }
-                    }
-                }
-                else if(method == InterpolationMethod::Linear) {
-                    for(int y=0; y<newsize.Height; y++) {
-                        float yn = y - origin.Y + b.Top;
-
-                        for(int x=0; x<newsize.Width; x++) {
-                            float xn = float(x + b.Left);
-
-                            float xx = xn - yn * perpixel;
-
-                            int   x1 = (int)std::floor(xx);
-                            float lx  = xx - x1;
-                            float lx1 = 1 - lx;
-                            int   x2 = x1 + 1;
-
-                            for(unsigned c=0; c<cpp; c++) {
-                                target(x, y, c) = FixImageValue<T_>::Fix(
-                                    lx1 * Get(x1, y, c) +
-                                    lx  * Get(x2, y, c)
-                                );
-                            }
-                        }
-                    }
-                }
-                else if(method == InterpolationMethod::Cubic) {
-                    int xs[4];
-                    float wx[4], xf[4];
-                    const float a = -0.5;
-                    for(int y=0; y<newsize.Height; y++) {
-                        float yn = y - origin.Y + b.Top;
-
-                        for(int x=0; x<newsize.Width; x++) {
-                            float xn = float(x + b.Left);
-
-                            float xx = xn - yn * perpixel;
-
-                            xf[1]  = xx - std::floor(xx);
-                            xf[2] = 1 - xf[1];
-                            xf[3] = 2 - xf[1];
-                            xf[0] = 1 + xf[1];
-
-                            for(int i=0; i<4; i++) {
-                                if(i == 1 || i == 2) {
-                                    wx[i] = (a+2) * xf[i]*xf[i]*xf[i] - (a+3) * xf[i]*xf[i] + 1;
-                                }
-                                else {
-                                    wx[i] = a * xf[i]*xf[i]*xf[i] - 5*a * xf[i]*xf[i] + 8*a * xf[i] - 4*a;
-                                }
-                                xs[i]  = (int)floor(xx)-1 + i;
-                            }
+                prepare(target, newsize);
 
-                            for(unsigned c=0; c<cpp; c++) {
-                                float v = 0;
-                                
-                                for(int i=0; i<4; i++) {
-                                    v += wx[i] * Get(xs[i], y, c);
-                                }
-                                target(x, y, c) = FixImageValue<T_>::Fix(v);
-                            }
-                        }
-                    }
-                }
-                else {
-                    throw std::runtime_error("Unknown interpolation method");
-                }
-
-                return target;
+                //row y is shifted by b.Left - (y - origin.Y + b.Top) * perpixel
+                ImageProcessing::ShearRows(RawData(), size, target.RawData(), newsize, cpp, 0, b.Left - (b.Top - origin.Y) * perpixel, -perpixel, filter);
             }
 
-            /// Rotates this image with the given angle.
+            /// Skews this image along Y axis.
             basic_Image SkewY(Float perpixel, InterpolationMethod method = InterpolationMethod::Cubic) const {
                 return SkewY(perpixel, {0.f, 0.f}, method);
             }
 
-            /// Rotates this image with the given angle.
+            /// Skews this image along Y axis. Area and Lanczos methods are performed as Cubic.
             basic_Image SkewY(Float perpixel, const Geometry::Pointf origin, InterpolationMethod method = InterpolationMethod::Cubic) const {
+                basic_Image target;
+                SkewY(target, perpixel, origin, method);
+
+                return target;
+            }
+
+            /// Skews this image into the given target. Target is resized and switched to the color mode of
+            /// this image. Target cannot be this image.
+            void SkewY(basic_Image &target, Float perpixel, const Geometry::Pointf origin = {0.f, 0.f}, InterpolationMethod method = InterpolationMethod::Cubic) const {
+                static_assert(std::is_same<T_, Byte>::value, "Resampling only supports Byte images");
+
+                auto filter = resamplingfilter(method);
+
                 Geometry::Boundsf bnds = {0,0, Geometry::Sizef(size)};
                 Geometry::SkewY(bnds, perpixel, origin);
                 Geometry::Bounds b{
@@ -1031,87 +572,10 @@ namespace Gorgon {
 
                 auto newsize = b.GetSize();
 
-                basic_Image target(newsize, GetMode());
-
-                if(method == InterpolationMethod::NearestNeighbor) {
-                    for(int x=0; x<newsize.Width; x++) {
-                        float xn = x - origin.X + b.Left;
-
-                        for(int y=0; y<newsize.Height; y++) {
-                            for(unsigned c=0; c<cpp; c++) {
-                                float yn = float(y + b.Top);
+                prepare(target, newsize);
 
-                                target(x, y, c) = Get(x, (int)std::round(yn - xn * perpixel), c);
-                            }
-                        }
-                    }
-                }
-                else if(method == InterpolationMethod::Linear) {
-                    for(int x=0; x<newsize.Width; x++) {
-                        float xn = x - origin.X + b.Left;
-
-                        for(int y=0; y<newsize.Height; y++) {
-                            float yn = float(y + b.Top);
-
-                            float yy = yn - xn * perpixel;
-
-                            int   y1 = (int)std::floor(yy);
-                            float ly  = yy - y1;
-                            float ly1 = 1 - ly;
-                            int   y2 = y1 + 1;
-
-                            for(unsigned c=0; c<cpp; c++) {
-                                target(x, y, c) = FixImageValue<T_>::Fix(
-                                    ly1 * Get(x, y1, c) +
-                                    ly  * Get(x, y2, c)
-                                );
-                            }
-                        }
-                    }
-                }
-                else if(method == InterpolationMethod::Cubic) {
-                    int ys[4];
-                    float wy[4], yf[4];
-                    const float a = -0.5;
-                    for(int x=0; x<newsize.Width; x++) {
-                        float xn = x - origin.X + b.Left;
-
-                        for(int y=0; y<newsize.Height; y++) {
-                            float yn = float(y + b.Top);
-
-                            float yy = yn - xn * perpixel;
-
-                            yf[1]  = yy - std::floor(yy);
-                            yf[2] = 1 - yf[1];
-                            yf[3] = 2 - yf[1];
-                            yf[0] = 1 + yf[1];
-
-                            for(int i=0; i<4; i++) {
-                                if(i == 1 || i == 2) {
-                                    wy[i] = (a+2) * yf[i]*yf[i]*yf[i] - (a+3) * yf[i]*yf[i] + 1;
-                                }
-                                else {
-                                    wy[i] = a * yf[i]*yf[i]*yf[i] - 5*a * yf[i]*yf[i] + 8*a * yf[i] - 4*a;
-                                }
-                                ys[i]  = (int)floor(yy)-1 + i;
-                            }
-
-                            for(unsigned c=0; c<cpp; c++) {
-                                float v = 0;
-                                
-                                for(int i=0; i<4; i++) {
-                                    v += wy[i] * Get(x, ys[i], c);
-                                }
-                                target(x, y, c) = FixImageValue<T_>::Fix(v);
-                            }
-                        }
-                    }
-                }
-                else {
-                    throw std::runtime_error("Unknown interpolation method");
-                }
-
-                return target;
+                //column x is shifted by b.Top - (x - origin.X + b.Left) * perpixel
+                ImageProcessing::ShearColumns(RawData(), size, target.RawData(), newsize, cpp, 0, b.Top - (b.Left - origin.X) * perpixel, -perpixel, filter);
             }
             
             /// Mirrors this bitmap along X axis as a new one.
@@ -1909,6 +1373,32 @@ namespace Gorgon {
             }
 
         protected:
+            /// Resizes the target of an operation and switches it to the mode of this image
+            void prepare(basic_Image &target, const Geometry::Size &newsize) const {
+                target.Resize(newsize, mode);
+
+                if(target.GetMode() != mode)
+                    target.ChangeMode(mode);
+            }
+
+            /// Returns the resampling filter for the given method
+            static ImageProcessing::ResamplingFilter resamplingfilter(InterpolationMethod method) {
+                switch(method) {
+                case InterpolationMethod::NearestNeighbor:
+                    return ImageProcessing::ResamplingFilter::Nearest;
+                case InterpolationMethod::Linear:
+                    return ImageProcessing::ResamplingFilter::Linear;
+                case InterpolationMethod::Cubic:
+                    return ImageProcessing::ResamplingFilter::Cubic;
+                case InterpolationMethod::Area:
+                    return ImageProcessing::ResamplingFilter::Box;
+                case InterpolationMethod::Lanczos:
+                    return ImageProcessing::ResamplingFilter::Lanczos;
+                default:
+                    throw std::runtime_error("Unknown interpolation method");
+                }
+            }
+
             /// Data that stores pixels of the image
             T_ *data = nullptr;
 
@@ -99,14 +99,23 @@ namespace Gorgon { namespace Encoding {
 		try {
             cinfo.image_width  = input.GetSize().Width;
             cinfo.image_height = input.GetSize().Height;
+            
+            //other modes are converted row by row, alpha channel is dropped
+            auto jpgmode = input.GetMode();
             switch(input.GetMode()) {
             case Graphics::ColorMode::RGB:
+            case Graphics::ColorMode::BGR:
+            case Graphics::ColorMode::RGBA:
+            case Graphics::ColorMode::BGRA:
                 cinfo.in_color_space = JCS_RGB;
                 cinfo.input_components = 3;
+                jpgmode = Graphics::ColorMode::RGB;
                 break;
             case Graphics::ColorMode::Grayscale:
+            case Graphics::ColorMode::Grayscale_Alpha:
                 cinfo.in_color_space = JCS_GRAYSCALE;
                 cinfo.input_components = 1;
+                jpgmode = Graphics::ColorMode::Grayscale;
                 break;
             default:
                 throw std::runtime_error("JPG compression does not support this color mode.");
@@ -119,9 +128,23 @@ namespace Gorgon { namespace Encoding {
 			auto data = input.RawData();
             auto stride = input.GetSize().Width * input.GetChannelsPerPixel();
             
-            while (cinfo.next_scanline < cinfo.image_height) {
-                jpeg_write_scanlines(&cinfo, &data, 1);
-                data += stride;
+            if(jpgmode != input.GetMode()) {
+                auto converter = Graphics::GetPixelConverter(input.GetMode(), jpgmode);
+                
+                std::vector<Byte> row(input.GetSize().Width * cinfo.input_components);
+                Byte *rowdata = row.data();
+                
+                while (cinfo.next_scanline < cinfo.image_height) {
+                    converter(data, rowdata, input.GetSize().Width);
+                    jpeg_write_scanlines(&cinfo, &rowdata, 1);
+                    data += stride;
+                }
+            }
+            else {
+                while (cinfo.next_scanline < cinfo.image_height) {
+                    jpeg_write_scanlines(&cinfo, &data, 1);
+                    data += stride;
+                }
             }
 		}
 		catch(...) {
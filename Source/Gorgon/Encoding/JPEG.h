@@ -158,6 +158,7 @@ namespace Gorgon { namespace Encoding {
 		}
 
 		/// Encode given image to JPG compressed data. Quality is in percents 100 means best.
+		/// Alpha channel of the image is not encoded, alpha only images are not supported.
 		/// throws runtime error
 		void Encode(Containers::Image &input, std::ostream &output, int quality = 90) {
             jpg::StreamWriter writer(output);
@@ -166,6 +167,7 @@ namespace Gorgon { namespace Encoding {
 		}
 
 		/// Encode given image to JPG compressed data. Quality is in percents 100 means best.
+		/// Alpha channel of the image is not encoded, alpha only images are not supported.
 		/// throws runtime error
 		void Encode(Containers::Image &input, const std::string &output, int quality = 90) {
 			std::ofstream file(output, std::ios::binary);
@@ -175,6 +177,7 @@ namespace Gorgon { namespace Encoding {
 		}
 
 		/// Encode given image to JPG compressed data. Quality is in percents 100 means best.
+		/// Alpha channel of the image is not encoded, alpha only images are not supported.
 		/// throws runtime error
 		void Encode(Containers::Image &input, std::vector<Byte> &output, int quality = 90) {
 			jpg::VectorWriter writer(output);
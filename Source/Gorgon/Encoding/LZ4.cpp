@@ -0,0 +1,205 @@
+#include "LZ4.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+
+
+namespace Gorgon { namespace Encoding {
+
+	namespace {
+		const int hashbits = 16;
+
+		//minimum match length of the format
+		const std::size_t minmatch = 4;
+
+		//last 5 bytes are always literals and last match should start 12 bytes before the end
+		const std::size_t lastliterals = 5;
+		const std::size_t matchstartlimit = 12;
+
+		uint32_t read32(const Byte *data) {
+			uint32_t v;
+			std::memcpy(&v, data, 4);
+
+			return v;
+		}
+
+		uint32_t hash(uint32_t sequence) {
+			return (sequence * 2654435761u) >> (32 - hashbits);
+		}
+
+		void writelength(std::vector<Byte> &output, std::size_t length) {
+			while(length >= 255) {
+				output.push_back(255);
+				length -= 255;
+			}
+
+			output.push_back(Byte(length));
+		}
+
+		void writesequence(std::vector<Byte> &output, const Byte *literals, std::size_t count, std::size_t offset, std::size_t length) {
+			Byte token = Byte((count < 15 ? count : 15) << 4);
+
+			if(length)
+				token |= Byte(length - minmatch < 15 ? length - minmatch : 15);
+
+			output.push_back(token);
+
+			if(count >= 15)
+				writelength(output, count - 15);
+
+			output.insert(output.end(), literals, literals + count);
+
+			if(!length)
+				return;
+
+			output.push_back(Byte(offset & 0xff));
+			output.push_back(Byte(offset >> 8));
+
+			if(length - minmatch >= 15)
+				writelength(output, length - minmatch - 15);
+		}
+
+		std::size_t readlength(const Byte *input, std::size_t inputsize, std::size_t &ip) {
+			std::size_t length = 0;
+			Byte b;
+
+			do {
+				if(ip >= inputsize)
+					throw std::runtime_error("LZ4 data is corrupt");
+
+				b = input[ip++];
+				length += b;
+			} while(b == 255);
+
+			return length;
+		}
+	}
+
+	void LZ4::Encode(const Byte *input, std::size_t size, std::vector<Byte> &output) {
+		output.reserve(output.size() + MaximumEncodedSize(size));
+
+		std::size_t anchor = 0;
+
+		if(size > matchstartlimit) {
+			std::vector<uint32_t> table(1 << hashbits, 0);
+
+			std::size_t pos = 1;
+			std::size_t matchlimit = size - lastliterals;
+
+			while(pos + matchstartlimit <= size) {
+				auto sequence = read32(input + pos);
+				auto &entry = table[hash(sequence)];
+				std::size_t ref = entry;
+
+				entry = uint32_t(pos);
+
+				if(pos - ref > 0xffff || read32(input + ref) != sequence) {
+					//skip faster over data that does not compress
+					pos += 1 + ((pos - anchor) >> 6);
+					continue;
+				}
+
+				while(pos > anchor && ref > 0 && input[pos - 1] == input[ref - 1]) {
+					pos--;
+					ref--;
+				}
+
+				std::size_t length = minmatch;
+				while(pos + length < matchlimit && input[pos + length] == input[ref + length])
+					length++;
+
+				writesequence(output, input + anchor, pos - anchor, pos - ref, length);
+
+				pos += length;
+				anchor = pos;
+
+				if(pos + matchstartlimit <= size)
+					table[hash(read32(input + pos - 2))] = uint32_t(pos - 2);
+			}
+		}
+
+		writesequence(output, input + anchor, size - anchor, 0, 0);
+	}
+
+	void LZ4::Decode(const Byte *input, std::size_t inputsize, Byte *output, std::size_t size) {
+		std::size_t ip = 0, op = 0;
+
+		while(true) {
+			if(ip >= inputsize)
+				throw std::runtime_error("LZ4 data is corrupt");
+
+			Byte token = input[ip++];
+
+			std::size_t count = token >> 4;
+			if(count == 15)
+				count += readlength(input, inputsize, ip);
+
+			if(count > inputsize - ip || count > size - op)
+				throw std::runtime_error("LZ4 data is corrupt");
+
+			//short literal runs are copied in one fixed size step when there is room
+			if(count <= 16 && inputsize - ip >= 16 && size - op >= 16)
+				std::memcpy(output + op, input + ip, 16);
+			else if(count)
+				std::memcpy(output + op, input + ip, count);
+
+			ip += count;
+			op += count;
+
+			//last sequence has only literals
+			if(ip == inputsize)
+				break;
+
+			if(inputsize - ip < 2)
+				throw std::runtime_error("LZ4 data is corrupt");
+
+			std::size_t offset = input[ip] | (input[ip + 1] << 8);
+			ip += 2;
+
+			std::size_t length = token & 15;
+			if(length == 15)
+				length += readlength(input, inputsize, ip);
+
+			length += minmatch;
+
+			if(offset == 0 || offset > op || length > size - op)
+				throw std::runtime_error("LZ4 data is corrupt");
+
+			const Byte *ref = output + op - offset;
+
+			if(offset >= 8 && size - op >= length + 8) {
+				//copies in steps of 8 bytes, may write past the match, which will be overwritten
+				for(std::size_t i = 0; i < length; i += 8)
+					std::memcpy(output + op + i, ref + i, 8);
+			}
+			else if(offset >= length) {
+				std::memcpy(output + op, ref, length);
+			}
+			else {
+				//overlapping copy repeats the last offset bytes
+				for(std::size_t i = 0; i < length; i++)
+					output[op + i] = ref[i];
+			}
+
+			op += length;
+		}
+
+		if(op != size)
+			throw std::runtime_error("LZ4 data does not match the expected size");
+	}
+
+	void LZ4::Decode(std::istream &input, std::size_t inputsize, Byte *output, std::size_t size) {
+		std::vector<Byte> data(inputsize);
+
+		input.read((char*)data.data(), inputsize);
+
+		if((std::size_t)input.gcount() != inputsize)
+			throw std::runtime_error("LZ4 data is truncated");
+
+		Decode(data.data(), inputsize, output, size);
+	}
+
+	LZ4 Lz4;
+
+} }
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <istream>
+#include <cstddef>
+
+#include "../Types.h"
+
+
+namespace Gorgon { namespace Encoding {
+
+	/**
+	 * Fast compression using the LZ4 block format. Compression ratio is lower than LZMA, however,
+	 * decoding is many times faster, which makes it suitable for data that is loaded often. The
+	 * encoded data does not contain the size of the original data, it should be stored alongside.
+	 */
+	class LZ4 {
+	public:
+
+		/// Encodes the given data, encoded data is appended to the output.
+		void Encode(const Byte *input, std::size_t size, std::vector<Byte> &output);
+
+		/// Encodes the given data, encoded data is appended to the output.
+		void Encode(const std::vector<Byte> &input, std::vector<Byte> &output) {
+			Encode(input.data(), input.size(), output);
+		}
+
+		/// Decodes the given data to the output, which should have room for exactly size bytes.
+		/// @throws std::runtime_error if the data is corrupt or does not decode to size bytes
+		void Decode(const Byte *input, std::size_t inputsize, Byte *output, std::size_t size);
+
+		/// Decodes inputsize bytes read from the given stream to the output, which should have room
+		/// for exactly size bytes.
+		/// @throws std::runtime_error if the data is corrupt or does not decode to size bytes
+		void Decode(std::istream &input, std::size_t inputsize, Byte *output, std::size_t size);
+
+		/// Returns the maximum size of the encoded data for the given number of bytes
+		static std::size_t MaximumEncodedSize(std::size_t size) {
+			return size + size / 255 + 16;
+		}
+	};
+
+	/// A default constructed LZ4 object
+	extern LZ4 Lz4;
+
+} }
@@ -205,6 +205,9 @@ namespace Gorgon { namespace Encoding {
 
             
 			int pngcolormode;
+			
+			//modes that are not supported by PNG are converted row by row
+			auto pngmode = buffer.GetMode();
 
             if(replace_colormode) {
                 switch(buffer.GetMode()) {
@@ -241,11 +244,20 @@ namespace Gorgon { namespace Encoding {
                 case Graphics::ColorMode::RGB:
                     pngcolormode=PNG_COLOR_TYPE_RGB;
                     break;
+                case Graphics::ColorMode::BGRA:
+                    pngcolormode=PNG_COLOR_TYPE_RGBA;
+                    pngmode=Graphics::ColorMode::RGBA;
+                    break;
+                case Graphics::ColorMode::BGR:
+                    pngcolormode=PNG_COLOR_TYPE_RGB;
+                    pngmode=Graphics::ColorMode::RGB;
+                    break;
                 case Graphics::ColorMode::Grayscale_Alpha:
                     pngcolormode=PNG_COLOR_TYPE_GRAY_ALPHA;
                     break;
                 case Graphics::ColorMode::Alpha:
                     pngcolormode=PNG_COLOR_TYPE_GRAY_ALPHA;
+                    pngmode=Graphics::ColorMode::Grayscale_Alpha;
                     break;
                 case Graphics::ColorMode::Grayscale:
                     pngcolormode=PNG_COLOR_TYPE_GRAY;
@@ -262,20 +274,16 @@ namespace Gorgon { namespace Encoding {
 
 			png_write_info(png_ptr, info_ptr);
 
-			if(buffer.GetMode() == Graphics::ColorMode::Alpha && !replace_colormode) {
-				//expand to gray_alpha
-				std::unique_ptr<Byte[]> p(new Byte[buffer.GetTotalSize()*2]);
-
-				auto total = buffer.GetTotalSize();
-				auto raw = buffer.RawData();
-				for(unsigned long i=0; i<total; i++) {
-					p[i*2] = 0xff;
-					p[i*2 + 1] = raw[i];
-				}
-
-				int stride=buffer.GetSize().Width*2;
+			if(pngmode != buffer.GetMode()) {
+				auto converter = Graphics::GetPixelConverter(buffer.GetMode(), pngmode);
+				
+				int w = buffer.GetSize().Width;
+				int stride = w*buffer.GetChannelsPerPixel();
+				std::unique_ptr<Byte[]> row(new Byte[w*Graphics::GetChannelsPerPixel(pngmode)]);
+				
 				for(int i=0; i<buffer.GetSize().Height; i++) {
-					png_write_row(png_ptr, &p[i*stride]);
+					converter(buffer.RawData()+i*stride, row.get(), w);
+					png_write_row(png_ptr, row.get());
 				}
 			}
 			else {
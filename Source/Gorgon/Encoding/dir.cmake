@@ -1,6 +1,8 @@
 SET(Local
     LZMA.h
     LZMA.cpp
+    LZ4.h
+    LZ4.cpp
     PNG.h
     PNG.cpp
     URI.h
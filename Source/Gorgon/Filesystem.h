@@ -5,6 +5,7 @@
 #include <string>
 #include <stdexcept>
 #include <vector>
+#include <utility>
 
 namespace Gorgon {
 
@@ -326,6 +327,79 @@ namespace Gorgon {
 		/// @throw  PathNotFoundError if the file cannot be read or does not exits
 		std::string Load(const std::string &filename);
 		
+		/// Maps a file to memory for reading. The contents of the file are not read while mapping,
+		/// operating system loads the pages of the file as they are accessed. Therefore, it is
+		/// possible to work on parts of very large files without reading all of them. The file is
+		/// unmapped when this object is destroyed. This object is movable but not copyable.
+		class MappedFile {
+		public:
+			/// Creates an empty object
+			MappedFile() = default;
+			
+			/// Maps the given file. Throws PathNotFoundError if the file cannot be opened or mapped.
+			explicit MappedFile(const std::string &filename) {
+				Open(filename);
+			}
+			
+			/// Copy constructor is disabled
+			MappedFile(const MappedFile &) = delete;
+			
+			/// Move constructor
+			MappedFile(MappedFile &&other) {
+				Swap(other);
+			}
+			
+			/// Copy assignment is disabled
+			MappedFile &operator =(const MappedFile &) = delete;
+			
+			/// Move assignment
+			MappedFile &operator =(MappedFile &&other) {
+				Close();
+				Swap(other);
+				
+				return *this;
+			}
+			
+			/// Unmaps the file
+			~MappedFile() {
+				Close();
+			}
+			
+			/// Swaps two mapped files
+			void Swap(MappedFile &other) {
+				std::swap(data, other.data);
+				std::swap(size, other.size);
+				std::swap(isopen, other.isopen);
+			}
+			
+			/// Maps the given file, unmapping the current one. Throws PathNotFoundError if the file 
+			/// cannot be opened or mapped.
+			void Open(const std::string &filename);
+			
+			/// Unmaps the file. Pointers obtained from this object become invalid.
+			void Close();
+			
+			/// Returns whether a file is mapped. Empty files are open but have no data.
+			bool IsOpen() const {
+				return isopen;
+			}
+			
+			/// Returns the contents of the file. The returned memory is read only.
+			const char *GetData() const {
+				return data;
+			}
+			
+			/// Returns the size of the file
+			unsigned long long GetSize() const {
+				return size;
+			}
+			
+		private:
+			const char *data = nullptr;
+			unsigned long long size = 0;
+			bool isopen = false;
+		};
+		
 		/// Returns the directory where the program is started from. This will always return the same value 
 		/// through out the execution.
 		std::string StartupDirectory();
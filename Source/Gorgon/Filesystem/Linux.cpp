@@ -13,6 +13,7 @@
 #include <mntent.h>
 #include <fcntl.h>
 #include <sys/sendfile.h>
+#include <sys/mman.h>
 
 namespace Gorgon { namespace Filesystem {
 	
@@ -459,5 +460,47 @@ test_match:
 		return true;
 	}
 	
+	void MappedFile::Open(const std::string &filename) {
+		Close();
+		
+		int fd = open(filename.c_str(), O_RDONLY);
+		if(fd == -1)
+			throw PathNotFoundError("Cannot find the file: "+filename);
+		
+		struct stat status;
+		if(fstat(fd, &status) != 0) {
+			close(fd);
+			throw PathNotFoundError("Cannot read the file: "+filename);
+		}
+		
+		size = (unsigned long long)status.st_size;
+		
+		//mmap cannot map empty files
+		if(size > 0) {
+			void *ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			
+			if(ptr == MAP_FAILED) {
+				close(fd);
+				size = 0;
+				throw PathNotFoundError("Cannot map the file: "+filename);
+			}
+			
+			data = (const char*)ptr;
+		}
+		
+		//mapping stays valid after the descriptor is closed
+		close(fd);
+		isopen = true;
+	}
+	
+	void MappedFile::Close() {
+		if(data)
+			munmap((void*)data, size);
+		
+		data = nullptr;
+		size = 0;
+		isopen = false;
+	}
+	
 } }
 
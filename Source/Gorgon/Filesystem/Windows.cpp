@@ -403,4 +403,53 @@ namespace Gorgon { namespace Filesystem {
 		return true;
 	}
 	
+	void MappedFile::Open(const std::string &filename) {
+		Close();
+		
+		std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+		auto wfilename = converter.from_bytes(filename);
+		
+		HANDLE file = CreateFileW(wfilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if(file == INVALID_HANDLE_VALUE)
+			throw PathNotFoundError("Cannot find the file: "+filename);
+		
+		LARGE_INTEGER filesize;
+		if(!GetFileSizeEx(file, &filesize)) {
+			CloseHandle(file);
+			throw PathNotFoundError("Cannot read the file: "+filename);
+		}
+		
+		size = (unsigned long long)filesize.QuadPart;
+		
+		//empty files cannot be mapped
+		if(size > 0) {
+			HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			void *ptr = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+			
+			//view keeps the mapping alive
+			if(mapping)
+				CloseHandle(mapping);
+			
+			if(!ptr) {
+				CloseHandle(file);
+				size = 0;
+				throw PathNotFoundError("Cannot map the file: "+filename);
+			}
+			
+			data = (const char*)ptr;
+		}
+		
+		CloseHandle(file);
+		isopen = true;
+	}
+	
+	void MappedFile::Close() {
+		if(data)
+			UnmapViewOfFile(data);
+		
+		data = nullptr;
+		size = 0;
+		isopen = false;
+	}
+	
 } }
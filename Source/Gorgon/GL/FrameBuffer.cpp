@@ -8,7 +8,19 @@ namespace Gorgon { namespace GL {
 		if(!glBindFramebuffer) return;
 		buffers.Add(this);
 
-		auto sz = Window::GetMinimumRequiredSize();
+		fixed = false;
+		generate(Window::GetMinimumRequiredSize(), gendepth);
+	}
+
+	void FrameBuffer::Generate(const Geometry::Size &sz, bool gendepth) {
+		if(!glBindFramebuffer) return;
+
+		fixed = true;
+		generate(sz, gendepth);
+	}
+
+	void FrameBuffer::generate(const Geometry::Size &sz, bool gendepth) {
+		size = sz;
 
 		glGenFramebuffers(1, &buffer);
 		glBindFramebuffer(GL_FRAMEBUFFER, buffer);
@@ -35,6 +47,7 @@ namespace Gorgon { namespace GL {
 		auto sz = Window::GetMinimumRequiredSize();
 
 		for(FrameBuffer &buffer : buffers) {
+			buffer.size = sz;
 			ResizeTexture(buffer.GetTexture(), sz, Graphics::ColorMode::RGBA);
 			if(buffer.depth) {
 				glBindRenderbuffer(GL_RENDERBUFFER, buffer.depth);
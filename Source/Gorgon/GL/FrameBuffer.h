@@ -27,11 +27,21 @@ namespace Gorgon { namespace GL {
 			Generate(depth);
 		}
 
+		/// Generates a frame buffer with a fixed size. See Generate(const Geometry::Size &, bool).
+		FrameBuffer(const Geometry::Size &size, bool depth) : FrameBuffer() {
+			Generate(size, depth);
+		}
+
 		/// Generates a frame buffer. If software frame buffer does not work, this will
 		/// create only a texture. Use UpdateTexture to update the texture. This function
 		/// will cause the system to switch to render to screen.
 		void Generate(bool depth);
 
+		/// Generates a frame buffer with the given size. Unlike screen sized buffers, this
+		/// buffer is not resized when the window size changes. Suitable for caching parts of
+		/// the scene. This function will cause the system to switch to render to screen.
+		void Generate(const Geometry::Size &size, bool depth);
+
 		/// Destroys the frame buffer
 		void Destroy();
 
@@ -53,6 +63,16 @@ namespace Gorgon { namespace GL {
 			return texture;
 		}
 
+		/// Returns the size of this buffer
+		Geometry::Size GetSize() const {
+			return size;
+		}
+
+		/// Returns if the size of this buffer is fixed
+		bool IsFixedSize() const {
+			return fixed;
+		}
+
 		/// Begin using this frame buffer.
 		void Use();
 
@@ -69,6 +89,11 @@ namespace Gorgon { namespace GL {
 		static bool HardwareSupport;
 
 	private:
+		void generate(const Geometry::Size &size, bool depth);
+
+		Geometry::Size size = {0, 0};
+		bool fixed = false;
+
 #ifdef OPENGL
 		Texture  texture = 0;
 		uint32_t buffer  = 0;
@@ -64,6 +64,7 @@
 #define GL_TEXTURE30					0x84DE
 #define GL_TEXTURE31					0x84DF
 #define GL_ARRAY_BUFFER					0x8892
+#define GL_ELEMENT_ARRAY_BUFFER			0x8893
 #define GL_STREAM_DRAW					0x88E0
 #define GL_STREAM_READ					0x88E1
 #define GL_STREAM_COPY					0x88E2
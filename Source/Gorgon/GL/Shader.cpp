@@ -251,6 +251,10 @@ namespace Gorgon { namespace GL {
 			glAttachShader(program, geometryshader);
 		}
 
+		for(auto &p : attributes) {
+			glBindAttribLocation(program, p.second, p.first.data());
+		}
+
 		glLinkProgram(program);
 
 		GLint status;
@@ -40,6 +40,11 @@ namespace Gorgon {
 			void UpdateUniform(int name, const Graphics::RGBAf &value);
 			void BindUBO(const std::string& name, UBOBindingPoint::Type bindingPoint);
 
+			/// Sets the location of a vertex attribute. Should be called before the shader is initialized.
+			void SetAttributeLocation(const std::string &name, int location) {
+				attributes[name] = location;
+			}
+
 			void InitializeWithSource(std::string vertexsrc, std::string fragmentsrc,
 									  std::string geometrysrc = "", std::map<std::string, std::string> defines={});
 
@@ -63,6 +68,8 @@ namespace Gorgon {
 			unsigned int					vertexshader;
 			unsigned int					geometryshader;
 			unsigned int					fragmentshader;
+
+			std::map<std::string, int>		attributes;
 		};
 
 	}
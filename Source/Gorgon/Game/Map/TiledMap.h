@@ -9,11 +9,14 @@
 #include <Gorgon/Graphics/Texture.h>
 #include <Gorgon/String.h>
 #include <Gorgon/Struct.h>
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 /**
@@ -50,9 +53,10 @@ namespace Gorgon::Game::Map::Tiled {
         int id, gid; 
         float x, y; 
         int width, height; 
+        std::string name, type; 
         
         /* This is for fill system to work. Supplies reflection. */
-        DefineStructMembers(Object, id, gid, x, y, width, height); 
+        DefineStructMembers(Object, id, gid, x, y, width, height, name, type); 
     }; 
     
     struct ObjectGroup {
@@ -63,6 +67,7 @@ namespace Gorgon::Game::Map::Tiled {
                 return; 
             }
             Parse::Filler::Fill(obj_list, objects); 
+            revision++; 
             auto upper = (*in).parent().parent();
             for(auto i {upper.begin()}; i != upper.end(); i++) {
                 if((*i).attribute("id").value() != std::to_string(id)) {
@@ -99,18 +104,36 @@ namespace Gorgon::Game::Map::Tiled {
             return obj_list[index]; 
         }
 
-        std::vector<Object> GetObjects() {
+        const std::vector<Object>& GetObjects() const {
             return obj_list; 
         }
 
+        /**
+         * @brief Replaces the objects of this group. Indexes built over this group are
+         * rebuilt on their next update.
+         */
+        void SetObjects(std::vector<Object> objects) {
+            obj_list = std::move(objects); 
+            revision++; 
+        }
+
+        /**
+         * @brief Returns a number that changes every time the objects of this group are
+         * changed. ObjectFinding::Tiled::ObjectIndex uses this to detect outdated indexes.
+         */
+        unsigned long GetRevision() const {
+            return revision; 
+        }
+
         void ForEach(std::function<void(Object)> fp) {
-            for(auto obj : obj_list) {
+            for(const auto& obj : obj_list) {
                 fp(obj); 
             }
         }
 
         private: 
         std::vector<Object> obj_list;  
+        unsigned long revision = 0; 
     }; 
 
     /**
@@ -165,10 +188,11 @@ namespace Gorgon::Game::Map::Tiled {
 
         /**
          * @brief Getting the layer mapping.
-         * I couldn't find any better way to handle it yet. 
+         * CSV data is decoded once while the map is loaded. Renderers should
+         * use the decoded tiles instead of parsing the data every frame. 
         */
         void Set(const pugi::xml_node_iterator& in) {
-            mapcsv = (*in).first_child().value(); 
+            decode((*in).first_child().value()); 
         }
 
         /**
@@ -192,25 +216,57 @@ namespace Gorgon::Game::Map::Tiled {
         DefineStructMembers(Layer, id, width, height, name); 
 
 
+        /**
+         * @brief Returns the decoded tile gids of the layer.
+         * Tiles are stored row by row, use the index (x + (y * width)) to access
+         * a tile. Flip flags in the upper bits of the gids are kept as is. 
+         * 
+         * @return const std::vector<uint32_t>& 
+         */
+        const std::vector<uint32_t>& GetTiles() const {
+            return tiles; 
+        }
+
+        /**
+         * @brief Returns the gid of the tile at the given location.
+         * 
+         * @return uint32_t 
+         */
+        uint32_t GetTile(int x, int y) const {
+            return tiles[x + y * width]; 
+        }
+
+        /**
+         * @brief Changes the gid of the tile at the given location. 
+         * Every change increments the revision of the layer. 
+         */
+        void SetTile(int x, int y, uint32_t gid) {
+            tiles[x + y * width] = gid; 
+            revision++; 
+        }
+
+        /**
+         * @brief Returns the revision of the layer data.
+         * Renderers that cache the layer compare revisions to detect changes. 
+         * 
+         * @return unsigned 
+         */
+        unsigned GetRevision() const {
+            return revision; 
+        }
+
         /**
          * @brief Return the 2d array of map data converted from csv.
          * 
          * @return std::vector<std::vector<std::string>> 
          */
         std::vector<std::vector<std::string>> map_data_2d_string() const {
-            std::stringstream ss; 
-            ss << mapcsv; 
             std::vector<std::vector<std::string>> ret;
-            for(std::string line; getline(ss, line);) {
-                if(line.empty()) 
-                    continue;
-                std::stringstream cs;
-                cs << line;
-                std::vector<std::string> row;   
-                for(std::string gid; getline(cs, gid, ',');) {
-                    row.push_back(gid); 
+            for(const auto& row : map_data_2d()) {
+                ret.emplace_back(); 
+                for(auto gid : row) {
+                    ret.back().push_back(std::to_string(gid)); 
                 }
-                ret.push_back(row); 
             }
             return ret; 
         }
@@ -221,68 +277,76 @@ namespace Gorgon::Game::Map::Tiled {
          * @return std::vector<std::vector<int>> 
          */
         std::vector<std::vector<int>> map_data_2d() const {
-            std::stringstream ss; 
-            ss << mapcsv; 
             std::vector<std::vector<int>> ret;
-            for(std::string line; getline(ss, line);) {
-                if(line.empty()) 
-                    continue;
-                std::stringstream cs;
-                cs << line;
-                std::vector<int> row;   
-                for(std::string gid; getline(cs, gid, ',');) {
-                    row.push_back(std::stoi(gid)); 
-                }
-                ret.push_back(row); 
+            if(width <= 0) 
+                return ret; 
+            for(size_t i{}; i < tiles.size(); i += width) {
+                auto end = std::min(tiles.size(), i + width); 
+                ret.emplace_back(tiles.begin() + i, tiles.begin() + end); 
             }
             return ret; 
         }
 
         /**
          * @brief Return the 1d array of map data converted from csv
-         * Try using this vector with the indexes (x + (y * width))
+         * Try using this vector with the indexes (x + (y * width)). 
+         * This function copies the data, use GetTiles() instead.
          * @return std::vector<int> 
          */
         std::vector<int> map_data() const {
-            std::stringstream ss; 
-            ss << mapcsv; 
-            std::vector<int> ret; 
-            for(std::string line; getline(ss, line);) {
-                if(line.empty())
-                    continue; 
-                std::stringstream cs; 
-                cs << line; 
-                for(std::string gid; getline(cs, gid, ',');) {
-                    ret.push_back(std::stoi(gid)); 
-                }
-            }
-            return ret; 
+            return {tiles.begin(), tiles.end()}; 
         }
 
         std::vector<GridTile> data_to_grid() {
             std::vector<GridTile> ret; 
-            const auto& data = map_data();
             ret.reserve(width * height); 
             for(int y{}; y < height; y++) {
                 for(int x{}; x < width; x++) {
                     auto index = x + y * width;
-                    bool passable = data[index] == 0;  
+                    bool passable = tiles[index] == 0;  
                     ret.emplace_back(Geometry::Point{x, y}, passable); 
                 }
             }
             return ret; 
         }
         
-        Geometry::Size Size() {
+        Geometry::Size Size() const {
             return {width, height};
         }
 
-        bool is_passability_layer() {
+        bool is_passability_layer() const {
             return String::ToLower(name).find("passability") != -1;
         }
 
         private:
-        std::string mapcsv; 
+        /**
+         * @brief Decodes comma separated gids. Line breaks and spaces are skipped.
+         */
+        void decode(const char *csv) {
+            tiles.clear(); 
+            if(width > 0 and height > 0) 
+                tiles.reserve(width * height); 
+
+            uint32_t gid = 0; 
+            bool digit = false; 
+            for(auto c = csv; *c; c++) {
+                if(*c >= '0' and *c <= '9') {
+                    gid = gid * 10 + (*c - '0'); 
+                    digit = true; 
+                }
+                else if(*c == ',') {
+                    tiles.push_back(gid); 
+                    gid = 0; 
+                    digit = false; 
+                }
+            }
+            if(digit) 
+                tiles.push_back(gid); 
+            revision++; 
+        }
+
+        std::vector<uint32_t> tiles; 
+        unsigned revision = 0; 
 
     }; 
 
@@ -524,6 +588,20 @@ namespace Gorgon::Game::Map::Tiled {
             return ObjectGroups[index]; 
         }
         
+        /**
+         * @brief Finds the object group with the given id without copying the groups.
+         * 
+         * @return Returns nullptr if not found.
+         */
+        ObjectGroup *FindObjectGroup(int id) {
+            for(auto& group : ObjectGroups) {
+                if(group.id == id) {
+                    return &group; 
+                }
+            }
+            return nullptr; 
+        }
+
         std::unordered_map<int, ObjectGroup> GetObjectGroupMap() const {
             if (ObjectGroups.empty()) {
                 return {}; 
@@ -545,7 +623,7 @@ namespace Gorgon::Game::Map::Tiled {
 
         std::unordered_map<int, int> ObjectLayerOrder() const {
             std::unordered_map<int, int> ret; 
-            for(auto group : ObjectGroups) {
+            for(const auto& group : ObjectGroups) {
                 ret[group.previous_layer_index] = group.id; 
             }
             return ret; 
@@ -1,17 +1,19 @@
 #pragma once
 
 #include "ObjectFinding.h"
+#include "ObjectIndex.h"
 #include <Gorgon/Game/Map/TiledMap.h>
 #include <Gorgon/Geometry/Point.h>
 #include <Gorgon/Geometry/Size.h>
+#include <string>
 #include <utility>
 
 namespace Gorgon::Game::ObjectFinding::Tiled {
     class FindObject : public base_objectfinder<Map::Tiled::Object>{
         public: 
-        ObjectList<Map::Tiled::Object> SearchArea(std::vector<Map::Tiled::Object> obj_list, Geometry::Point top_left, Geometry::Point bottom_right) override {
+        ObjectList<Map::Tiled::Object> SearchArea(const std::vector<Map::Tiled::Object>& obj_list, Geometry::Point top_left, Geometry::Point bottom_right) override {
             ObjectList<Map::Tiled::Object> ret; 
-            for(auto object : obj_list) {
+            for(const auto& object : obj_list) {
                 if(object.x > top_left.X and object.x < bottom_right.X and object.y > top_left.Y and object.y < bottom_right.Y) {
                     ret.push_back(object); 
                 }
@@ -19,9 +21,9 @@ namespace Gorgon::Game::ObjectFinding::Tiled {
             return ret; 
         }
 
-        ObjectList<Map::Tiled::Object> SearchTileGid(std::vector<Map::Tiled::Object> obj_list, int gid) {
+        ObjectList<Map::Tiled::Object> SearchTileGid(const std::vector<Map::Tiled::Object>& obj_list, int gid) {
             ObjectList<Map::Tiled::Object> ret; 
-            for(auto object : obj_list) {
+            for(const auto& object : obj_list) {
                 if(object.gid == gid) {
                     ret.push_back(object); 
                 }
@@ -29,9 +31,9 @@ namespace Gorgon::Game::ObjectFinding::Tiled {
             return ret; 
         }
 
-        ObjectList<Map::Tiled::Object> SearchTileId(std::vector<Map::Tiled::Object> obj_list, int id) {
+        ObjectList<Map::Tiled::Object> SearchTileId(const std::vector<Map::Tiled::Object>& obj_list, int id) {
             ObjectList<Map::Tiled::Object> ret; 
-            for(auto object : obj_list) {
+            for(const auto& object : obj_list) {
                 if(object.id == id) {
                     ret.push_back(object); 
                 }
@@ -39,11 +41,11 @@ namespace Gorgon::Game::ObjectFinding::Tiled {
             return ret; 
         }
 
-        ObjectList<Map::Tiled::Object> SearchBySize(std::vector<Map::Tiled::Object> obj_list, Geometry::Size size, bool(*compare)(Geometry::Size a, Geometry::Size b) = [](Geometry::Size a, Geometry::Size b) { 
+        ObjectList<Map::Tiled::Object> SearchBySize(const std::vector<Map::Tiled::Object>& obj_list, Geometry::Size size, bool(*compare)(Geometry::Size a, Geometry::Size b) = [](Geometry::Size a, Geometry::Size b) { 
             return a == b; 
             }) {
             ObjectList<Map::Tiled::Object> ret; 
-            for(auto object : obj_list) {
+            for(const auto& object : obj_list) {
                 if(compare({object.width, object.height}, size)) {
                     ret.push_back(object); 
                 }
@@ -51,7 +53,7 @@ namespace Gorgon::Game::ObjectFinding::Tiled {
             return ret; 
         }
 
-        ObjectList<Map::Tiled::Object> SearchBetweenSize(std::vector<Map::Tiled::Object> obj_list, Geometry::Size low, Geometry::Size high) {
+        ObjectList<Map::Tiled::Object> SearchBetweenSize(const std::vector<Map::Tiled::Object>& obj_list, Geometry::Size low, Geometry::Size high) {
             ObjectList<Map::Tiled::Object> ret; 
             auto lower = [&](Geometry::Size low, Geometry::Size high) {
                 return low.Area() < high.Area(); 
@@ -59,7 +61,7 @@ namespace Gorgon::Game::ObjectFinding::Tiled {
             if(not lower(low, high)) {
                 std::swap(low, high); 
             }
-            for(auto object : obj_list) {
+            for(const auto& object : obj_list) {
                 Geometry::Size obj_size = {object.width, object.height}; 
                 if(lower(low, obj_size) and lower(obj_size, high)) {
                     ret.push_back(object); 
@@ -67,5 +69,86 @@ namespace Gorgon::Game::ObjectFinding::Tiled {
             }
             return ret; 
         }
+
+        ObjectList<Map::Tiled::Object> SearchName(const std::vector<Map::Tiled::Object>& obj_list, const std::string& name) {
+            ObjectList<Map::Tiled::Object> ret; 
+            for(const auto& object : obj_list) {
+                if(object.name == name) {
+                    ret.push_back(object); 
+                }
+            }
+            return ret; 
+        }
+
+        ObjectList<Map::Tiled::Object> SearchType(const std::vector<Map::Tiled::Object>& obj_list, const std::string& type) {
+            ObjectList<Map::Tiled::Object> ret; 
+            for(const auto& object : obj_list) {
+                if(object.type == type) {
+                    ret.push_back(object); 
+                }
+            }
+            return ret; 
+        }
+
+        /*
+         * The following overloads answer the same queries from an index instead of scanning
+         * the list. The index is updated first if its object group has changed. Results of
+         * area searches are in the order of the grid cells instead of the list order, and
+         * results of SearchBetweenSize are sorted by area.
+         */
+
+        ObjectList<Map::Tiled::Object> SearchArea(ObjectIndex& index, Geometry::Point top_left, Geometry::Point bottom_right) {
+            index.Update(); 
+            ObjectList<Map::Tiled::Object> ret; 
+            index.ForEachInArea(top_left, bottom_right, [&](size_t i) {
+                ret.push_back(index[i]); 
+            });
+            return ret; 
+        }
+
+        ObjectList<Map::Tiled::Object> SearchTileGid(ObjectIndex& index, int gid) {
+            index.Update(); 
+            return collect(index, index.SearchTileGid(gid)); 
+        }
+
+        ObjectList<Map::Tiled::Object> SearchTileId(ObjectIndex& index, int id) {
+            index.Update(); 
+            ObjectList<Map::Tiled::Object> ret; 
+            auto i = index.FindId(id); 
+            if(i != -1) {
+                ret.push_back(index[i]); 
+            }
+            return ret; 
+        }
+
+        ObjectList<Map::Tiled::Object> SearchName(ObjectIndex& index, const std::string& name) {
+            index.Update(); 
+            return collect(index, index.SearchName(name)); 
+        }
+
+        ObjectList<Map::Tiled::Object> SearchType(ObjectIndex& index, const std::string& type) {
+            index.Update(); 
+            return collect(index, index.SearchType(type)); 
+        }
+
+        ObjectList<Map::Tiled::Object> SearchBySize(ObjectIndex& index, Geometry::Size size) {
+            index.Update(); 
+            return collect(index, index.SearchBySize(size)); 
+        }
+
+        ObjectList<Map::Tiled::Object> SearchBetweenSize(ObjectIndex& index, Geometry::Size low, Geometry::Size high) {
+            index.Update(); 
+            return collect(index, index.SearchBetweenSize(low, high)); 
+        }
+
+        private: 
+        static ObjectList<Map::Tiled::Object> collect(const ObjectIndex& index, std::span<const size_t> indices) {
+            ObjectList<Map::Tiled::Object> ret; 
+            ret.reserve(indices.size()); 
+            for(auto i : indices) {
+                ret.push_back(index[i]); 
+            }
+            return ret; 
+        }
     }; 
 }
\ No newline at end of file
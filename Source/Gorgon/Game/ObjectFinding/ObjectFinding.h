@@ -13,6 +13,6 @@ namespace Gorgon::Game::ObjectFinding {
     class base_objectfinder {
         public: 
         base_objectfinder() = default; 
-        virtual ObjectList<T_> SearchArea(std::vector<T_>, Geometry::Point, Geometry::Point) = 0; 
+        virtual ObjectList<T_> SearchArea(const std::vector<T_>&, Geometry::Point, Geometry::Point) = 0; 
     };
 }
\ No newline at end of file
@@ -0,0 +1,385 @@
+#pragma once
+
+#include "ObjectFinding.h"
+#include <Gorgon/Game/Map/TiledMap.h>
+#include <Gorgon/Geometry/Bounds.h>
+#include <Gorgon/Geometry/Point.h>
+#include <Gorgon/Geometry/Size.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Gorgon::Game::ObjectFinding::Tiled {
+
+    /**
+     * @brief Index over the objects of an object group. It should be built once after the
+     * map is loaded and queried as many times as necessary.
+     *
+     * Objects are placed in a uniform grid of cells according to their bounds, so area
+     * queries only visit the cells that overlap the area. Ids, gids, names, types and sizes
+     * are hashed. Queries return indices into the object list or spans of indices that are
+     * owned by the index, no objects are copied. The object list is not copied either, it
+     * should outlive the index. If the list is changed, Rebuild should be called. An index
+     * built over an object group tracks the revision of the group, Update rebuilds it only
+     * if the group is changed. FindObject functions that take an index call Update.
+     */
+    class ObjectIndex {
+        public:
+        explicit ObjectIndex(const std::vector<Map::Tiled::Object>& objects_, int cell_size_ = 64) :
+            objects(&objects_), cell_size(std::max(cell_size_, 1))
+        {
+            Rebuild();
+        }
+
+        explicit ObjectIndex(const Map::Tiled::ObjectGroup& group_, int cell_size_ = 64) :
+            objects(&group_.GetObjects()), group(&group_), cell_size(std::max(cell_size_, 1))
+        {
+            Rebuild();
+        }
+
+        /**
+         * @brief Rebuilds the index from the object list.
+         */
+        void Rebuild() {
+            const auto& list = *objects;
+
+            if(group) {
+                revision = group->GetRevision();
+            }
+
+            ids.clear();
+            gids.clear();
+            names.clear();
+            types.clear();
+            sizes.clear();
+
+            for(size_t i = 0; i < list.size(); i++) {
+                ids.emplace(list[i].id, i);
+                gids[list[i].gid].push_back(i);
+                names[list[i].name].push_back(i);
+                types[list[i].type].push_back(i);
+                sizes[size_key(list[i].width, list[i].height)].push_back(i);
+            }
+
+            by_area.resize(list.size());
+            for(size_t i = 0; i < list.size(); i++) {
+                by_area[i] = i;
+            }
+            std::stable_sort(by_area.begin(), by_area.end(), [&](size_t l, size_t r) {
+                return area(list[l]) < area(list[r]);
+            });
+
+            build_grid();
+        }
+
+        /**
+         * @brief Returns whether the object group of this index is changed after the index
+         * is built. Indexes built over a plain object list are never considered outdated.
+         */
+        bool IsOutdated() const {
+            return group and group->GetRevision() != revision;
+        }
+
+        /**
+         * @brief Rebuilds the index if it is outdated.
+         */
+        void Update() {
+            if(IsOutdated()) {
+                Rebuild();
+            }
+        }
+
+        /**
+         * @brief Returns the object at the given index.
+         */
+        const Map::Tiled::Object& operator[](size_t index) const {
+            return (*objects)[index];
+        }
+
+        const Map::Tiled::Object& GetObject(size_t index) const {
+            return (*objects)[index];
+        }
+
+        size_t GetSize() const {
+            return objects->size();
+        }
+
+        /**
+         * @brief Returns the bounds of the given object. Tile objects are positioned from
+         * their bottom left corner, other objects from their top left.
+         */
+        static Geometry::Bounds GetBounds(const Map::Tiled::Object& object) {
+            int x = int(std::floor(object.x)), y = int(std::floor(object.y));
+            if(object.gid) {
+                return {x, y - object.height, x + object.width, y};
+            }
+            return {x, y, x + object.width, y + object.height};
+        }
+
+        /**
+         * @brief Calls the given function with the index of every object whose position is
+         * strictly inside the given area. This is the same condition as
+         * FindObject::SearchArea.
+         */
+        template<class F_>
+        void ForEachInArea(Geometry::Point top_left, Geometry::Point bottom_right, F_ function) const {
+            const auto& list = *objects;
+
+            visit(top_left.X, top_left.Y, bottom_right.X, bottom_right.Y, [&](size_t index, int cx, int cy) {
+                const auto& object = list[index];
+
+                //objects spanning multiple cells are reported only from the cell that
+                //contains their position
+                if(cell_x(int(std::floor(object.x))) != cx or cell_y(int(std::floor(object.y))) != cy) {
+                    return;
+                }
+
+                if(object.x > top_left.X and object.x < bottom_right.X and object.y > top_left.Y and object.y < bottom_right.Y) {
+                    function(index);
+                }
+            });
+        }
+
+        /**
+         * @brief Fills the indices of the objects whose position is strictly inside the given
+         * area. Output is cleared first, so it can be reused between calls.
+         */
+        void SearchArea(Geometry::Point top_left, Geometry::Point bottom_right, std::vector<size_t>& out) const {
+            out.clear();
+            ForEachInArea(top_left, bottom_right, [&](size_t index) { out.push_back(index); });
+        }
+
+        std::vector<size_t> SearchArea(Geometry::Point top_left, Geometry::Point bottom_right) const {
+            std::vector<size_t> ret;
+            SearchArea(top_left, bottom_right, ret);
+
+            return ret;
+        }
+
+        /**
+         * @brief Calls the given function with the index of every object whose bounds
+         * overlap with the given area.
+         */
+        template<class F_>
+        void ForEachOverlapping(const Geometry::Bounds& area, F_ function) const {
+            const auto& list = *objects;
+            const int qx = cell_x(area.Left), qy = cell_y(area.Top);
+
+            visit(area.Left, area.Top, area.Right, area.Bottom, [&](size_t index, int cx, int cy) {
+                auto b = GetBounds(list[index]);
+
+                //report from the first cell of the overlap so that every object is
+                //reported once
+                if(std::max(cell_x(b.Left), qx) != cx or std::max(cell_y(b.Top), qy) != cy) {
+                    return;
+                }
+
+                if(b.Left <= area.Right and b.Right >= area.Left and b.Top <= area.Bottom and b.Bottom >= area.Top) {
+                    function(index);
+                }
+            });
+        }
+
+        /**
+         * @brief Fills the indices of the objects that contain the given point, useful for
+         * hit testing. Output is cleared first.
+         */
+        void SearchAt(Geometry::Point point, std::vector<size_t>& out) const {
+            out.clear();
+            ForEachOverlapping({point.X, point.Y, point.X, point.Y}, [&](size_t index) { out.push_back(index); });
+        }
+
+        /**
+         * @brief Returns the index of the object with the given id or -1 if there is no such
+         * object.
+         */
+        long FindId(int id) const {
+            auto it = ids.find(id);
+            return it == ids.end() ? -1 : long(it->second);
+        }
+
+        /**
+         * @brief Returns the indices of the objects with the given gid.
+         */
+        std::span<const size_t> SearchTileGid(int gid) const {
+            auto it = gids.find(gid);
+            if(it == gids.end()) {
+                return {};
+            }
+            return it->second;
+        }
+
+        /**
+         * @brief Returns the indices of the objects with the given name.
+         */
+        std::span<const size_t> SearchName(const std::string& name) const {
+            return find(names, name);
+        }
+
+        /**
+         * @brief Returns the indices of the objects with the given type.
+         */
+        std::span<const size_t> SearchType(const std::string& type) const {
+            return find(types, type);
+        }
+
+        /**
+         * @brief Returns the indices of the objects that have exactly the given size.
+         */
+        std::span<const size_t> SearchBySize(Geometry::Size size) const {
+            auto it = sizes.find(size_key(size.Width, size.Height));
+            if(it == sizes.end()) {
+                return {};
+            }
+            return it->second;
+        }
+
+        /**
+         * @brief Returns the indices of the objects whose area is strictly between the areas
+         * of the given sizes, sorted by area. This is the same condition as
+         * FindObject::SearchBetweenSize.
+         */
+        std::span<const size_t> SearchBetweenSize(Geometry::Size low, Geometry::Size high) const {
+            long lowarea = long(low.Width) * low.Height, higharea = long(high.Width) * high.Height;
+            if(lowarea > higharea) {
+                std::swap(lowarea, higharea);
+            }
+
+            const auto& list = *objects;
+            auto begin = std::upper_bound(by_area.begin(), by_area.end(), lowarea, [&](long value, size_t index) {
+                return value < area(list[index]);
+            });
+            auto end = std::lower_bound(begin, by_area.end(), higharea, [&](size_t index, long value) {
+                return area(list[index]) < value;
+            });
+
+            return {by_area.data() + (begin - by_area.begin()), size_t(end - begin)};
+        }
+
+        private:
+        template<class K_>
+        static std::span<const size_t> find(const std::unordered_map<K_, std::vector<size_t>>& map, const K_& key) {
+            auto it = map.find(key);
+            if(it == map.end()) {
+                return {};
+            }
+            return it->second;
+        }
+
+        static long area(const Map::Tiled::Object& object) {
+            return long(object.width) * object.height;
+        }
+
+        static uint64_t size_key(int width, int height) {
+            return (uint64_t(uint32_t(width)) << 32) | uint32_t(height);
+        }
+
+        static int floor_div(int value, int divisor) {
+            return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+        }
+
+        int cell_x(int x) const {
+            return std::clamp(floor_div(x, cell_size) - origin.X, 0, columns - 1);
+        }
+
+        int cell_y(int y) const {
+            return std::clamp(floor_div(y, cell_size) - origin.Y, 0, rows - 1);
+        }
+
+        /// Objects are stored cell by cell in a single array, offsets mark where each cell
+        /// starts.
+        void build_grid() {
+            const auto& list = *objects;
+
+            if(list.empty()) {
+                columns = rows = 0;
+                offsets.assign(1, 0);
+                cells.clear();
+
+                return;
+            }
+
+            Geometry::Bounds extent = GetBounds(list[0]);
+            for(const auto& object : list) {
+                auto b = GetBounds(object);
+                extent.Left = std::min(extent.Left, b.Left);
+                extent.Top = std::min(extent.Top, b.Top);
+                extent.Right = std::max(extent.Right, b.Right);
+                extent.Bottom = std::max(extent.Bottom, b.Bottom);
+            }
+
+            origin = {floor_div(extent.Left, cell_size), floor_div(extent.Top, cell_size)};
+            columns = floor_div(extent.Right, cell_size) - origin.X + 1;
+            rows = floor_div(extent.Bottom, cell_size) - origin.Y + 1;
+
+            offsets.assign(size_t(columns) * rows + 1, 0);
+
+            auto for_cells = [&](const Map::Tiled::Object& object, auto fn) {
+                auto b = GetBounds(object);
+                for(int y = cell_y(b.Top); y <= cell_y(b.Bottom); y++) {
+                    for(int x = cell_x(b.Left); x <= cell_x(b.Right); x++) {
+                        fn(x + y * columns);
+                    }
+                }
+            };
+
+            for(const auto& object : list) {
+                for_cells(object, [&](int cell) { offsets[cell + 1]++; });
+            }
+
+            for(size_t i = 1; i < offsets.size(); i++) {
+                offsets[i] += offsets[i - 1];
+            }
+
+            cells.resize(offsets.back());
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for(size_t i = 0; i < list.size(); i++) {
+                for_cells(list[i], [&](int cell) { cells[fill[cell]++] = uint32_t(i); });
+            }
+        }
+
+        /// Calls function with every object in the cells that overlap the given area, along
+        /// with the cell coordinates.
+        template<class F_>
+        void visit(int left, int top, int right, int bottom, F_ function) const {
+            if(columns == 0) {
+                return;
+            }
+
+            //areas completely outside of the grid are not clamped into it
+            if(floor_div(right, cell_size) < origin.X or floor_div(bottom, cell_size) < origin.Y or
+               floor_div(left, cell_size) >= origin.X + columns or floor_div(top, cell_size) >= origin.Y + rows) {
+                return;
+            }
+
+            for(int y = cell_y(top); y <= cell_y(bottom); y++) {
+                for(int x = cell_x(left); x <= cell_x(right); x++) {
+                    const int cell = x + y * columns;
+                    for(auto i = offsets[cell]; i < offsets[cell + 1]; i++) {
+                        function(size_t(cells[i]), x, y);
+                    }
+                }
+            }
+        }
+
+        const std::vector<Map::Tiled::Object>* objects;
+        const Map::Tiled::ObjectGroup* group = nullptr;
+        unsigned long revision = 0;
+        int cell_size;
+
+        Geometry::Point origin = {0, 0};
+        int columns = 0, rows = 0;
+        std::vector<uint32_t> offsets, cells;
+
+        std::unordered_map<int, size_t> ids;
+        std::unordered_map<int, std::vector<size_t>> gids;
+        std::unordered_map<std::string, std::vector<size_t>> names, types;
+        std::unordered_map<uint64_t, std::vector<size_t>> sizes;
+        std::vector<size_t> by_area;
+    };
+
+}
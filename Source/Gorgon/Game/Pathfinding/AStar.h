@@ -10,11 +10,17 @@
 #include <Gorgon/Graphics/Layer.h>
 #include <Gorgon/Utils/Assert.h>
 #include <Gorgon/Game/Pathfinding/Pathfinders.h>
+#include <Gorgon/Game/Pathfinding/Grid.h>
+#include <Gorgon/Game/Pathfinding/Workers.h>
 #ifndef WIN32
     #include <unistd.h>
 #else 
 using uint = unsigned int; 
 #endif
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 
@@ -29,12 +35,12 @@ namespace Gorgon::Game::Pathfinding::AStar {
         public:
         static uint manhattan(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_) {
             auto delta = std::move(GetHeuristic(source_, target_));
-            return static_cast<uint>(10 * (delta.Y + delta.Y));
+            return static_cast<uint>(10 * (delta.X + delta.Y));
         }
 
         static uint euclidean(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_) {
             auto delta = std::move(GetHeuristic(source_, target_));
-            return static_cast<uint>(10 * sqrt(pow(delta.X, 2) + pow(delta.X, 2)));
+            return static_cast<uint>(10 * sqrt(pow(delta.X, 2) + pow(delta.Y, 2)));
         }
         static uint octagonal(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_) {
             auto delta = std::move(GetHeuristic(source_, target_));
@@ -42,140 +48,162 @@ namespace Gorgon::Game::Pathfinding::AStar {
         }
     };
 
+    /**
+     * @brief A* path finder over a dense grid.
+     * Blocked cells are stored in a bitset, open set is a binary heap and the nodes
+     * are taken from a per cell pool that is reused across queries. Orthogonal moves
+     * cost 10 and diagonal moves cost 14. 
+     */
     class PathFinder : public base_pathfinder
     {
-        bool DetectCollision(Gorgon::Geometry::Point coordinates_) {
-            if (coordinates_.X < 0 || coordinates_.X >= worldSize.Width ||
-                coordinates_.Y < 0 || coordinates_.Y >= worldSize.Height ||
-                std::find(walls.begin(), walls.end(), coordinates_) != walls.end()) {
-                return true;
-            }
-            return false;
-        }
-
-        TileNode* FindNodeOnList(NodeSet& nodes_, Gorgon::Geometry::Point coordinates_) {
-            for (auto node : nodes_) {
-                if (node->coordinates == coordinates_) {
-                    return node;
-                }
-            }
-            return nullptr;
-        }
-
-        void ReleaseNodes(NodeSet& nodes_) {
-                for (auto it = nodes_.begin(); it != nodes_.end();) {
-                    delete *it;
-                    it = nodes_.erase(it);
-                }
-        }
-
     public:
         PathFinder() {
             SetDiagonalMovement(false);
             SetHeuristic(&AStar::Heuristic::manhattan);
-            direction = {
-                { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 },
-                { -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }
-            };
         }
 
-        void SetSize(Gorgon::Geometry::Size layer_size_) {
-            worldSize = layer_size_;
+        void SetSize(Gorgon::Geometry::Size layer_size_) override {
+            grid.SetSize(layer_size_);
         }
 
         Geometry::Size GetSize() const {
-            return worldSize;
+            return grid.GetSize();
         }
 
-        void SetDiagonalMovement(bool enable_) {
+        void SetDiagonalMovement(bool enable_) override {
             directions = (enable_ ? 8 : 4);
         }
         
         void SetHeuristic(HeuristicFunction heuristic_) {
-            heuristic = std::bind(heuristic_, std::placeholders::_1, std::placeholders::_2);
+            heuristic = std::move(heuristic_);
         }
 
-        CoordinateList FindPath(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_) {
-            TileNode *current = nullptr;
-            NodeSet openSet, closedSet;
-            openSet.reserve(100);
-            closedSet.reserve(100);
-            openSet.push_back(new TileNode(source_));
+        /**
+         * @brief Finds the path from source to target. 
+         * The returned list starts from the target and ends with the source. If the 
+         * target cannot be reached, an empty list is returned.
+         */
+        CoordinateList FindPath(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_) override {
+            return FindPath(source_, target_, buffers); 
+        }
 
-            while (!openSet.empty()) {
-                auto current_it = openSet.begin();
-                current = *current_it;
+        /**
+         * @brief Finds the path using the given buffers. This function does not modify 
+         * the path finder, therefore, it can be called from multiple threads as long as 
+         * each thread uses its own buffers and the blocks are not modified.
+         */
+        CoordinateList FindPath(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_, SearchBuffers& buffers_) const {
+            CoordinateList path;
 
-                for (auto it = openSet.begin(); it != openSet.end(); it++) {
-                    auto node = *it;
-                    if (node->get_score() <= current->get_score()) {
-                        current = node;
-                        current_it = it;
-                    }
+            if(not grid.IsInside(source_) or grid.IsBlocked(target_)) {
+                return path; 
+            }
+
+            const int width = grid.GetSize().Width; 
+            buffers_.Prepare(size_t(width) * grid.GetSize().Height); 
+
+            auto& nodes = buffers_.nodes; 
+            auto& closed = buffers_.closed; 
+            auto& open = buffers_.open; 
+            const auto generation = buffers_.generation; 
+
+            const int source = source_.X + source_.Y * width; 
+            const int target = target_.X + target_.Y * width; 
+
+            uint32_t h = heuristic(source_, target_); 
+            nodes[source] = {0, -1, generation}; 
+            buffers_.Push(h, h, source); 
+
+            while(not open.empty()) {
+                const auto current = buffers_.Pop(); 
+
+                //nodes are pushed again when a shorter path is found instead of updating
+                //the heap, older entries are skipped here
+                if(closed[current] == generation) {
+                    continue; 
                 }
+                closed[current] = generation; 
 
-                if (current->coordinates == target_) {
-                    break;
+                if(current == target) {
+                    for(int i = target; i != -1; i = nodes[i].parent) {
+                        path.Push(Geometry::Point(i % width, i / width)); 
+                    }
+                    return path; 
                 }
 
-                closedSet.push_back(current);
-                openSet.erase(current_it);
+                const int cx = current % width, cy = current / width; 
+                const uint32_t g = nodes[current].g; 
 
-                for (uint i = 0; i < directions; ++i) {
-                    Gorgon::Geometry::Point newCoordinates(current->coordinates + direction[i]);
-                    if (DetectCollision(newCoordinates) ||
-                        FindNodeOnList(closedSet, newCoordinates)) {
-                        continue;
+                for (int i = 0; i < directions; ++i) {
+                    const int nx = cx + direction_x[i], ny = cy + direction_y[i]; 
+                    if(grid.IsBlocked(nx, ny)) {
+                        continue; 
                     }
 
-                    uint totalCost = current->G + ((i < 4) ? 10 : 14);
-
-                    TileNode *successor = FindNodeOnList(openSet, newCoordinates);
-                    if (successor == nullptr) {
-                        successor = new TileNode(newCoordinates, current);
-                        successor->G = totalCost;
-                        successor->H = heuristic(successor->coordinates, target_);
-                        openSet.push_back(successor);
+                    const int next = nx + ny * width; 
+                    if(closed[next] == generation) {
+                        continue; 
                     }
-                    else if (totalCost < successor->G) {
-                        successor->parent = current;
-                        successor->G = totalCost;
+
+                    const uint32_t cost = g + ((i < 4) ? 10 : 14);
+                    auto& node = nodes[next]; 
+                    if(node.generation != generation or cost < node.g) {
+                        node = {cost, current, generation}; 
+                        h = heuristic({nx, ny}, target_); 
+                        buffers_.Push(cost + h, h, next); 
                     }
                 }
             }
 
-            CoordinateList path;
-            while (current != nullptr) {
-                path.Push(current->coordinates);
-                current = current->parent;
-            }
+            return path;
+        }
 
-            ReleaseNodes(openSet);
-            ReleaseNodes(closedSet);
+        using base_pathfinder::FindPaths; 
 
-            return path;
+        /**
+         * @brief Finds the paths for the given queries in parallel on the shared worker pool.
+         * Workers use their own search buffers over the same grid. 
+         */
+        void FindPaths(const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_) override {
+            FindPaths(queries_, results_, WorkerPool::Default()); 
         }
 
-        void AddBlock(Gorgon::Geometry::Point coordinates_) {
-            walls.Push(coordinates_);
+        void FindPaths(const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_, WorkerPool& pool_) {
+            RunQueries(pool_, worker_buffers, queries_, results_, [this](Geometry::Point source, Geometry::Point target, SearchBuffers& buffers) {
+                return FindPath(source, target, buffers); 
+            }); 
         }
 
-        void RemoveBlock(Gorgon::Geometry::Point coordinates_) {
-            auto it = std::find(walls.begin(), walls.end(), coordinates_);
-            if (it != walls.end()) {
-                
-                walls.Erase(it);
-            }
+        void AddBlock(Gorgon::Geometry::Point coordinates_) override {
+            grid.Block(coordinates_);
         }
-        void ClearBlocks() {
-            walls.Clear();
+
+        void RemoveBlock(Gorgon::Geometry::Point coordinates_) override {
+            grid.Unblock(coordinates_);
+        }
+
+        void ClearBlocks() override {
+            grid.Clear();
+        }
+
+        bool IsBlocked(Gorgon::Geometry::Point coordinates_) const {
+            return grid.IsBlocked(coordinates_); 
+        }
+
+        const BlockGrid& GetGrid() const {
+            return grid; 
         }
 
     private:
+        //first four are orthogonal
+        static constexpr int direction_x[8] = { 0, 1,  0, -1, -1, 1, -1,  1 }; 
+        static constexpr int direction_y[8] = { 1, 0, -1,  0, -1, 1,  1, -1 }; 
+
         HeuristicFunction heuristic;
-        CoordinateList direction, walls;
-        Gorgon::Geometry::Size worldSize;
-        uint directions;
+        BlockGrid grid; 
+        SearchBuffers buffers;
+        std::vector<SearchBuffers> worker_buffers; 
+        int directions;
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include <Gorgon/Geometry/Point.h>
+#include <Gorgon/Geometry/Size.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace Gorgon::Game::Pathfinding {
+
+    /**
+     * @brief Dense passability grid that uses a single bit for every cell.
+     * Cells outside of the size of the grid are considered blocked. Storage grows
+     * when a block is added outside of the current size, therefore blocks can be
+     * added before the size is set.
+     */
+    class BlockGrid {
+        public:
+        void SetSize(Geometry::Size size_) {
+            size = size_;
+            reserve(size);
+        }
+
+        Geometry::Size GetSize() const {
+            return size;
+        }
+
+        bool IsInside(int x, int y) const {
+            return x >= 0 and y >= 0 and x < size.Width and y < size.Height;
+        }
+
+        bool IsInside(Geometry::Point p) const {
+            return IsInside(p.X, p.Y);
+        }
+
+        /**
+         * @brief Returns true if the cell is blocked or outside of the grid.
+         */
+        bool IsBlocked(int x, int y) const {
+            return not IsInside(x, y) or test(x, y);
+        }
+
+        bool IsBlocked(Geometry::Point p) const {
+            return IsBlocked(p.X, p.Y);
+        }
+
+        void Block(Geometry::Point p) {
+            if(p.X < 0 or p.Y < 0)
+                return;
+            reserve({p.X + 1, p.Y + 1});
+            auto i = bit(p.X, p.Y);
+            bits[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+
+        void Unblock(Geometry::Point p) {
+            if(p.X < 0 or p.Y < 0 or p.X >= storage.Width or p.Y >= storage.Height)
+                return;
+            auto i = bit(p.X, p.Y);
+            bits[i >> 6] &= ~(uint64_t(1) << (i & 63));
+        }
+
+        void Clear() {
+            std::fill(bits.begin(), bits.end(), 0);
+        }
+
+        /**
+         * @brief Calls the given function with the location of every blocked cell,
+         * including the blocks that are outside of the current size.
+         */
+        template<class F_>
+        void ForEachBlock(F_ function) const {
+            for(size_t w = 0; w < bits.size(); w++) {
+                if(bits[w] == 0)
+                    continue;
+
+                for(size_t b = 0; b < 64; b++) {
+                    if((bits[w] >> b) & 1) {
+                        auto i = w * 64 + b;
+                        function(Geometry::Point(int(i % storage.Width), int(i / storage.Width)));
+                    }
+                }
+            }
+        }
+
+        private:
+        size_t bit(int x, int y) const {
+            return size_t(x) + size_t(y) * storage.Width;
+        }
+
+        bool test(int x, int y) const {
+            if(x >= storage.Width or y >= storage.Height)
+                return false;
+            auto i = bit(x, y);
+            return (bits[i >> 6] >> (i & 63)) & 1;
+        }
+
+        void reserve(Geometry::Size required) {
+            if(required.Width <= storage.Width and required.Height <= storage.Height)
+                return;
+
+            Geometry::Size next = {std::max(required.Width, storage.Width), std::max(required.Height, storage.Height)};
+            std::vector<uint64_t> nextbits((size_t(next.Width) * next.Height + 63) / 64, 0);
+
+            for(int y{}; y < storage.Height; y++) {
+                for(int x{}; x < storage.Width; x++) {
+                    if(test(x, y)) {
+                        auto i = size_t(x) + size_t(y) * next.Width;
+                        nextbits[i >> 6] |= uint64_t(1) << (i & 63);
+                    }
+                }
+            }
+
+            storage = next;
+            bits.swap(nextbits);
+        }
+
+        Geometry::Size size = {0, 0}, storage = {0, 0};
+        std::vector<uint64_t> bits;
+    };
+
+    /**
+     * @brief Storage that is reused between path queries.
+     * Nodes are kept in a pool that has an entry for every cell. Instead of clearing
+     * the pool, every query uses a new generation number; a node or a closed entry is
+     * valid only if its generation matches.
+     */
+    struct SearchBuffers {
+        struct Node {
+            uint32_t g;
+            int32_t parent;
+            uint32_t generation;
+        };
+
+        struct OpenEntry {
+            uint32_t f, h;
+            int32_t index;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> closed;
+        std::vector<OpenEntry> open;
+        uint32_t generation = 0;
+
+        /**
+         * @brief Prepares the buffers for a new query over the given number of cells.
+         */
+        void Prepare(size_t cells) {
+            if(nodes.size() != cells) {
+                nodes.assign(cells, Node{0, -1, 0});
+                closed.assign(cells, 0);
+                generation = 0;
+            }
+
+            if(++generation == 0) {
+                std::fill(nodes.begin(), nodes.end(), Node{0, -1, 0});
+                std::fill(closed.begin(), closed.end(), 0);
+                generation = 1;
+            }
+
+            open.clear();
+        }
+
+        /**
+         * @brief Adds an entry to the open set.
+         */
+        void Push(uint32_t f, uint32_t h, int32_t index) {
+            open.push_back({f, h, index});
+            std::push_heap(open.begin(), open.end(), &SearchBuffers::after);
+        }
+
+        /**
+         * @brief Removes and returns the index of the entry with the lowest cost, ties
+         * are broken in favor of the entry that is closer to the target.
+         */
+        int32_t Pop() {
+            std::pop_heap(open.begin(), open.end(), &SearchBuffers::after);
+            auto index = open.back().index;
+            open.pop_back();
+
+            return index;
+        }
+
+        private:
+        static bool after(const OpenEntry& l, const OpenEntry& r) {
+            return l.f > r.f or (l.f == r.f and l.h > r.h);
+        }
+    };
+
+}
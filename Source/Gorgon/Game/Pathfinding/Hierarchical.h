@@ -0,0 +1,595 @@
+#pragma once
+#include <Gorgon/Geometry/Point.h>
+#include <Gorgon/Geometry/Size.h>
+#include <Gorgon/Game/Pathfinding/Pathfinders.h>
+#include <Gorgon/Game/Pathfinding/Grid.h>
+#include <Gorgon/Game/Pathfinding/Workers.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace Gorgon::Game::Pathfinding::Hierarchical {
+
+    /**
+     * @brief Storage that is reused between queries, every thread running queries needs
+     * its own.
+     */
+    struct Buffers {
+        /// Used for the search over the abstract graph
+        SearchBuffers search;
+
+        /// Used for the searches within a cluster
+        std::vector<uint32_t> distance;
+        std::vector<int> parent;
+        std::vector<std::pair<uint32_t, int>> open;
+
+        /// Distances from the source and to the target within their clusters
+        std::vector<uint32_t> from_source, to_target;
+    };
+
+    /**
+     * @brief Hierarchical path finder (HPA*).
+     * The grid is divided into square clusters. Entrances are placed on the open parts of
+     * the borders between neighboring clusters and the distances between the entrances of
+     * a cluster are cached. A query first searches this small abstract graph and then
+     * refines each step of the abstract path within a single cluster. Found paths are near
+     * optimal, in exchange queries on large maps are much faster.
+     *
+     * Adding or removing a block only marks the clusters around the changed cell. Their
+     * entrances and distances are recomputed before the next query, therefore, many blocks
+     * can be changed at once without rebuilding the graph for each.
+     */
+    class PathFinder : public base_pathfinder
+    {
+    public:
+        explicit PathFinder(int cluster_size_ = 16) : cluster_size(cluster_size_) {
+            SetDiagonalMovement(false);
+        }
+
+        void SetSize(Gorgon::Geometry::Size layer_size_) override {
+            grid.SetSize(layer_size_);
+            reset();
+        }
+
+        Geometry::Size GetSize() const {
+            return grid.GetSize();
+        }
+
+        void SetDiagonalMovement(bool enable_) override {
+            diagonal = enable_;
+            reset();
+        }
+
+        /**
+         * @brief Changes the size of the clusters. Smaller clusters make the refinement
+         * faster while larger clusters make the abstract graph smaller.
+         */
+        void SetClusterSize(int size_) {
+            cluster_size = std::max(size_, 2);
+            reset();
+        }
+
+        int GetClusterSize() const {
+            return cluster_size;
+        }
+
+        /**
+         * @brief Finds the path from source to target.
+         * The returned list starts from the target and ends with the source. If the
+         * target cannot be reached, an empty list is returned.
+         */
+        CoordinateList FindPath(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_) override {
+            if(not grid.IsInside(source_) or grid.IsBlocked(target_)) {
+                return {};
+            }
+
+            //a blocked source can be left but not entered, which is the same as searching
+            //with the source unblocked
+            if(grid.IsBlocked(source_)) {
+                RemoveBlock(source_);
+                auto path = FindPath(source_, target_);
+                AddBlock(source_);
+
+                return path;
+            }
+
+            Update();
+
+            return FindPath(source_, target_, scratch);
+        }
+
+        /**
+         * @brief Finds the path using the given buffers. This function does not modify
+         * the path finder, therefore, it can be called from multiple threads as long as
+         * each thread uses its own buffers and the blocks are not modified. The graph
+         * should be up to date, see Update(). Unlike the other overload, paths starting
+         * from a blocked cell cannot be found by this function.
+         */
+        CoordinateList FindPath(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_, Buffers& buffers_) const {
+            CoordinateList path;
+
+            if(not grid.IsInside(source_) or grid.IsBlocked(source_) or grid.IsBlocked(target_)) {
+                return path;
+            }
+
+            const int width = grid.GetSize().Width;
+            const int source = source_.X + source_.Y * width;
+            const int target = target_.X + target_.Y * width;
+
+            const int source_cluster = cluster_of(source);
+            const int target_cluster = cluster_of(target);
+
+            //paths within a cluster do not need the abstract graph, unless they have to
+            //leave the cluster
+            if(source_cluster == target_cluster and explore(clusters[source_cluster], source, target, buffers_)) {
+                append(path, clusters[source_cluster], source, target, buffers_);
+                path.Push(source_);
+
+                return path;
+            }
+
+            //distances from the source and to the target within their clusters
+            auto& from_source = buffers_.from_source;
+            auto& to_target = buffers_.to_target;
+            distances(clusters[source_cluster], source, from_source, buffers_);
+            distances(clusters[target_cluster], target, to_target, buffers_);
+
+            auto& search = buffers_.search;
+            search.Prepare(size_t(width) * grid.GetSize().Height);
+
+            auto& nodes = search.nodes;
+            auto& closed = search.closed;
+            const auto generation = search.generation;
+
+            auto relax = [&](int current, int next, uint32_t cost) {
+                if(closed[next] == generation) {
+                    return;
+                }
+
+                auto& node = nodes[next];
+                if(node.generation != generation or cost < node.g) {
+                    node = {cost, current, generation};
+                    uint32_t h = distance(next % width, next / width, target_.X, target_.Y);
+                    search.Push(cost + h, h, next);
+                }
+            };
+
+            uint32_t h = distance(source_.X, source_.Y, target_.X, target_.Y);
+            nodes[source] = {0, -1, generation};
+            search.Push(h, h, source);
+
+            bool found = false;
+            while(not search.open.empty()) {
+                const auto current = search.Pop();
+
+                if(closed[current] == generation) {
+                    continue;
+                }
+                closed[current] = generation;
+
+                if(current == target) {
+                    found = true;
+                    break;
+                }
+
+                const uint32_t g = nodes[current].g;
+                const auto& c = clusters[cluster_of(current)];
+
+                if(current == source) {
+                    for(size_t i = 0; i < c.nodes.size(); i++) {
+                        if(from_source[i] != unreachable) {
+                            relax(current, c.nodes[i], g + from_source[i]);
+                        }
+                    }
+                }
+
+                int local = c.find(current);
+                if(local != -1) {
+                    const size_t count = c.nodes.size();
+                    for(size_t i = 0; i < count; i++) {
+                        auto d = c.distances[local * count + i];
+                        if(d != unreachable and int(i) != local) {
+                            relax(current, c.nodes[i], g + d);
+                        }
+                    }
+
+                    for(const auto& l : c.links) {
+                        if(l.from == current) {
+                            relax(current, l.to, g + l.cost);
+                        }
+                    }
+
+                    if(cluster_of(current) == target_cluster and to_target[local] != unreachable) {
+                        relax(current, target, g + to_target[local]);
+                    }
+                }
+            }
+
+            if(not found) {
+                return path;
+            }
+
+            //each abstract step is either a link between neighboring cells or lies within
+            //a single cluster
+            for(int i = target; nodes[i].parent != -1; i = nodes[i].parent) {
+                const int from = nodes[i].parent;
+                const auto& c = clusters[cluster_of(from)];
+
+                if(cluster_of(i) == cluster_of(from)) {
+                    explore(c, from, i, buffers_);
+                    append(path, c, from, i, buffers_);
+                }
+                else {
+                    path.Push(Geometry::Point(i % width, i / width));
+                }
+            }
+            path.Push(source_);
+
+            return path;
+        }
+
+        using base_pathfinder::FindPaths;
+
+        /**
+         * @brief Finds the paths for the given queries in parallel on the shared worker pool.
+         * The graph is updated first, then workers use their own buffers over the same graph.
+         */
+        void FindPaths(const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_) override {
+            FindPaths(queries_, results_, WorkerPool::Default());
+        }
+
+        void FindPaths(const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_, WorkerPool& pool_) {
+            Update();
+
+            RunQueries(pool_, worker_buffers, queries_, results_, [this](Geometry::Point source, Geometry::Point target, Buffers& buffers) {
+                return FindPath(source, target, buffers);
+            });
+
+            //queries from blocked cells modify the graph temporarily
+            for(size_t i = 0; i < queries_.size(); i++) {
+                if(grid.IsInside(queries_[i].first) and grid.IsBlocked(queries_[i].first)) {
+                    results_[i] = FindPath(queries_[i].first, queries_[i].second);
+                }
+            }
+        }
+
+        /**
+         * @brief Rebuilds the clusters that are changed since the last update. This is done
+         * automatically before queries.
+         */
+        void Update() {
+            for(auto id : dirty) {
+                rebuild(clusters[id]);
+            }
+            dirty.clear();
+        }
+
+        void AddBlock(Gorgon::Geometry::Point coordinates_) override {
+            grid.Block(coordinates_);
+            invalidate(coordinates_);
+        }
+
+        void RemoveBlock(Gorgon::Geometry::Point coordinates_) override {
+            grid.Unblock(coordinates_);
+            invalidate(coordinates_);
+        }
+
+        void ClearBlocks() override {
+            grid.Clear();
+            reset();
+        }
+
+        bool IsBlocked(Gorgon::Geometry::Point coordinates_) const {
+            return grid.IsBlocked(coordinates_);
+        }
+
+        const BlockGrid& GetGrid() const {
+            return grid;
+        }
+
+    private:
+        static constexpr uint32_t unreachable = std::numeric_limits<uint32_t>::max();
+
+        struct link {
+            int from, to;
+            uint32_t cost;
+        };
+
+        struct cluster {
+            int left, top, right, bottom;
+
+            /// Entrance cells of this cluster
+            std::vector<int> nodes;
+
+            /// Distances between every pair of entrances
+            std::vector<uint32_t> distances;
+
+            /// Connections from entrances to the entrances of the neighboring clusters
+            std::vector<link> links;
+
+            bool dirty = true;
+
+            int find(int cell) const {
+                auto it = std::find(nodes.begin(), nodes.end(), cell);
+                return it == nodes.end() ? -1 : int(it - nodes.begin());
+            }
+        };
+
+        int cluster_of(int cell) const {
+            const int width = grid.GetSize().Width;
+            return (cell % width) / cluster_size + (cell / width) / cluster_size * columns;
+        }
+
+        bool open(int x, int y) const {
+            return not grid.IsBlocked(x, y);
+        }
+
+        /// Octile distance when diagonal movement is enabled, manhattan distance otherwise.
+        uint32_t distance(int x1, int y1, int x2, int y2) const {
+            const uint32_t dx = std::abs(x1 - x2), dy = std::abs(y1 - y2);
+            if(diagonal) {
+                return 10 * std::max(dx, dy) + 4 * std::min(dx, dy);
+            }
+            return 10 * (dx + dy);
+        }
+
+        void reset() {
+            auto size = grid.GetSize();
+            columns = (size.Width + cluster_size - 1) / cluster_size;
+            rows = (size.Height + cluster_size - 1) / cluster_size;
+
+            clusters.assign(size_t(columns) * rows, cluster());
+            dirty.clear();
+
+            for(int y = 0; y < rows; y++) {
+                for(int x = 0; x < columns; x++) {
+                    auto& c = clusters[x + y * columns];
+                    c.left = x * cluster_size;
+                    c.top = y * cluster_size;
+                    c.right = std::min(c.left + cluster_size, size.Width);
+                    c.bottom = std::min(c.top + cluster_size, size.Height);
+                    dirty.push_back(x + y * columns);
+                }
+            }
+        }
+
+        /// Entrances that involve the given cell can only change in the clusters that
+        /// contain the cell or one of its neighbors.
+        void invalidate(Geometry::Point p) {
+            for(int y = p.Y - 1; y <= p.Y + 1; y++) {
+                for(int x = p.X - 1; x <= p.X + 1; x++) {
+                    if(not grid.IsInside(x, y)) {
+                        continue;
+                    }
+
+                    auto id = x / cluster_size + y / cluster_size * columns;
+                    if(not clusters[id].dirty) {
+                        clusters[id].dirty = true;
+                        dirty.push_back(id);
+                    }
+                }
+            }
+        }
+
+        /// Calls emit for every entrance on the border between cells a(i) and b(i) where
+        /// i is in [0, count). Both clusters sharing a border call this function with the
+        /// same parameters, therefore, both sides agree on the entrances.
+        void border(int ax, int ay, int bx, int by, int stepx, int stepy, int count, const std::function<void(int, int, uint32_t)>& emit) const {
+            const int width = grid.GetSize().Width;
+            auto a = [&](int i) { return (ax + i * stepx) + (ay + i * stepy) * width; };
+            auto b = [&](int i) { return (bx + i * stepx) + (by + i * stepy) * width; };
+            auto crossing = [&](int i) {
+                return open(ax + i * stepx, ay + i * stepy) and open(bx + i * stepx, by + i * stepy);
+            };
+
+            for(int i = 0; i < count; ) {
+                if(not crossing(i)) {
+                    i++;
+                    continue;
+                }
+
+                int start = i;
+                while(i < count and crossing(i)) {
+                    i++;
+                }
+
+                //short openings get a single entrance at the middle, longer ones get an
+                //entrance at each end
+                if(i - start < 6) {
+                    int mid = (start + i - 1) / 2;
+                    emit(a(mid), b(mid), 10);
+                }
+                else {
+                    emit(a(start), b(start), 10);
+                    emit(a(i - 1), b(i - 1), 10);
+                }
+            }
+
+            if(not diagonal) {
+                return;
+            }
+
+            //diagonal crossings are necessary only if neither of the straight crossings
+            //next to them is open
+            for(int i = 0; i + 1 < count; i++) {
+                if(crossing(i) or crossing(i + 1)) {
+                    continue;
+                }
+
+                if(open(ax + i * stepx, ay + i * stepy) and open(bx + (i + 1) * stepx, by + (i + 1) * stepy)) {
+                    emit(a(i), b(i + 1), 14);
+                }
+
+                if(open(ax + (i + 1) * stepx, ay + (i + 1) * stepy) and open(bx + i * stepx, by + i * stepy)) {
+                    emit(a(i + 1), b(i), 14);
+                }
+            }
+        }
+
+        /// Calls emit if the corner cells of two diagonally neighboring clusters should be
+        /// linked. The link is necessary only when both cells between them are blocked.
+        void corner(int ax, int ay, int bx, int by, const std::function<void(int, int, uint32_t)>& emit) const {
+            if(diagonal and open(ax, ay) and open(bx, by) and not open(ax, by) and not open(bx, ay)) {
+                const int width = grid.GetSize().Width;
+                emit(ax + ay * width, bx + by * width, 14);
+            }
+        }
+
+        void rebuild(cluster& c) {
+            c.nodes.clear();
+            c.links.clear();
+            c.dirty = false;
+
+            auto outgoing = [&](int from, int to, uint32_t cost) {
+                c.links.push_back({from, to, cost});
+            };
+            auto incoming = [&](int from, int to, uint32_t cost) {
+                c.links.push_back({to, from, cost});
+            };
+
+            const int w = c.right - c.left, h = c.bottom - c.top;
+            const auto size = grid.GetSize();
+
+            if(c.right < size.Width) {
+                border(c.right - 1, c.top, c.right, c.top, 0, 1, h, outgoing);
+            }
+            if(c.left > 0) {
+                border(c.left - 1, c.top, c.left, c.top, 0, 1, h, incoming);
+            }
+            if(c.bottom < size.Height) {
+                border(c.left, c.bottom - 1, c.left, c.bottom, 1, 0, w, outgoing);
+            }
+            if(c.top > 0) {
+                border(c.left, c.top - 1, c.left, c.top, 1, 0, w, incoming);
+            }
+
+            if(c.right < size.Width and c.bottom < size.Height) {
+                corner(c.right - 1, c.bottom - 1, c.right, c.bottom, outgoing);
+            }
+            if(c.left > 0 and c.top > 0) {
+                corner(c.left - 1, c.top - 1, c.left, c.top, incoming);
+            }
+            if(c.right < size.Width and c.top > 0) {
+                corner(c.right - 1, c.top, c.right, c.top - 1, outgoing);
+            }
+            if(c.left > 0 and c.bottom < size.Height) {
+                corner(c.left - 1, c.bottom, c.left, c.bottom - 1, incoming);
+            }
+
+            for(const auto& l : c.links) {
+                if(c.find(l.from) == -1) {
+                    c.nodes.push_back(l.from);
+                }
+            }
+
+            const size_t count = c.nodes.size();
+            c.distances.assign(count * count, unreachable);
+
+            std::vector<uint32_t> row;
+            for(size_t i = 0; i < count; i++) {
+                distances(c, c.nodes[i], row, scratch);
+                std::copy(row.begin(), row.end(), c.distances.begin() + i * count);
+            }
+        }
+
+        /// Fills the distances from the given cell to every entrance of the cluster.
+        void distances(const cluster& c, int from, std::vector<uint32_t>& out, Buffers& buffers) const {
+            explore(c, from, -1, buffers);
+
+            const int width = grid.GetSize().Width;
+            const int w = c.right - c.left;
+
+            out.resize(c.nodes.size());
+            for(size_t i = 0; i < c.nodes.size(); i++) {
+                out[i] = buffers.distance[(c.nodes[i] % width - c.left) + (c.nodes[i] / width - c.top) * w];
+            }
+        }
+
+        /// Searches the cluster starting from the given cell. If target is not -1 search
+        /// stops as soon as the target is reached. Returns whether the target is reached.
+        bool explore(const cluster& c, int from, int target, Buffers& buffers) const {
+            const int width = grid.GetSize().Width;
+            const int w = c.right - c.left, h = c.bottom - c.top;
+
+            auto& local_distance = buffers.distance;
+            auto& local_parent = buffers.parent;
+            auto& local_open = buffers.open;
+
+            local_distance.assign(size_t(w) * h, unreachable);
+            local_parent.assign(size_t(w) * h, -1);
+            local_open.clear();
+
+            auto compare = [](const std::pair<uint32_t, int>& l, const std::pair<uint32_t, int>& r) {
+                return l.first > r.first;
+            };
+
+            const int start = (from % width - c.left) + (from / width - c.top) * w;
+            const int goal = target == -1 ? -1 : (target % width - c.left) + (target / width - c.top) * w;
+
+            local_distance[start] = 0;
+            local_open.push_back({0, start});
+
+            static const int dx[8] = { 0, 1,  0, -1, -1, 1, -1,  1 };
+            static const int dy[8] = { 1, 0, -1,  0, -1, 1,  1, -1 };
+
+            while(not local_open.empty()) {
+                std::pop_heap(local_open.begin(), local_open.end(), compare);
+                auto [d, current] = local_open.back();
+                local_open.pop_back();
+
+                if(d != local_distance[current]) {
+                    continue;
+                }
+
+                if(current == goal) {
+                    return true;
+                }
+
+                const int x = current % w, y = current / w;
+                for(int i = 0; i < (diagonal ? 8 : 4); i++) {
+                    const int nx = x + dx[i], ny = y + dy[i];
+                    if(nx < 0 or ny < 0 or nx >= w or ny >= h or not open(c.left + nx, c.top + ny)) {
+                        continue;
+                    }
+
+                    const int next = nx + ny * w;
+                    const uint32_t cost = d + (i < 4 ? 10 : 14);
+                    if(cost < local_distance[next]) {
+                        local_distance[next] = cost;
+                        local_parent[next] = current;
+                        local_open.push_back({cost, next});
+                        std::push_heap(local_open.begin(), local_open.end(), compare);
+                    }
+                }
+            }
+
+            return goal == -1;
+        }
+
+        /// Appends the path from target back to the given source, excluding the source,
+        /// using the results of the last explore call.
+        void append(CoordinateList& path, const cluster& c, int from, int target, const Buffers& buffers) const {
+            const int width = grid.GetSize().Width;
+            const int w = c.right - c.left;
+
+            const int start = (from % width - c.left) + (from / width - c.top) * w;
+            for(int i = (target % width - c.left) + (target / width - c.top) * w; i != start; i = buffers.parent[i]) {
+                path.Push(Geometry::Point(c.left + i % w, c.top + i / w));
+            }
+        }
+
+        BlockGrid grid;
+        Buffers scratch;
+        std::vector<Buffers> worker_buffers;
+        int cluster_size;
+        int columns = 0, rows = 0;
+        bool diagonal = false;
+
+        std::vector<cluster> clusters;
+        std::vector<int> dirty;
+    };
+
+}
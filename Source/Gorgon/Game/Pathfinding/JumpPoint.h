@@ -0,0 +1,305 @@
+#pragma once
+#include <Gorgon/Geometry/Point.h>
+#include <Gorgon/Geometry/Size.h>
+#include <Gorgon/Game/Pathfinding/Pathfinders.h>
+#include <Gorgon/Game/Pathfinding/Grid.h>
+#include <Gorgon/Game/Pathfinding/Workers.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace Gorgon::Game::Pathfinding::JumpPoint {
+
+    /**
+     * @brief Jump point search over a uniform cost grid.
+     * Instead of adding every neighbor to the open set, straight and diagonal runs are
+     * scanned until a cell with a forced neighbor is found and only these jump points
+     * are added. Movement rules and costs are the same as AStar::PathFinder, therefore,
+     * paths of the same length are found, but considerably fewer nodes are expanded on
+     * open areas.
+     */
+    class PathFinder : public base_pathfinder
+    {
+    public:
+        PathFinder() {
+            SetDiagonalMovement(false);
+        }
+
+        void SetSize(Gorgon::Geometry::Size layer_size_) override {
+            grid.SetSize(layer_size_);
+        }
+
+        Geometry::Size GetSize() const {
+            return grid.GetSize();
+        }
+
+        void SetDiagonalMovement(bool enable_) override {
+            diagonal = enable_;
+        }
+
+        /**
+         * @brief Finds the path from source to target.
+         * The returned list starts from the target and ends with the source. If the
+         * target cannot be reached, an empty list is returned.
+         */
+        CoordinateList FindPath(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_) override {
+            return FindPath(source_, target_, buffers);
+        }
+
+        /**
+         * @brief Finds the path using the given buffers. This function does not modify
+         * the path finder, therefore, it can be called from multiple threads as long as
+         * each thread uses its own buffers and the blocks are not modified.
+         */
+        CoordinateList FindPath(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_, SearchBuffers& buffers_) const {
+            CoordinateList path;
+
+            if(not grid.IsInside(source_) or grid.IsBlocked(target_)) {
+                return path;
+            }
+
+            const int width = grid.GetSize().Width;
+            buffers_.Prepare(size_t(width) * grid.GetSize().Height);
+
+            auto& nodes = buffers_.nodes;
+            auto& closed = buffers_.closed;
+            const auto generation = buffers_.generation;
+
+            const int source = source_.X + source_.Y * width;
+            const int target = target_.X + target_.Y * width;
+
+            uint32_t h = distance(source_.X, source_.Y, target_.X, target_.Y);
+            nodes[source] = {0, -1, generation};
+            buffers_.Push(h, h, source);
+
+            while(not buffers_.open.empty()) {
+                const auto current = buffers_.Pop();
+
+                if(closed[current] == generation) {
+                    continue;
+                }
+                closed[current] = generation;
+
+                if(current == target) {
+                    //jump points are connected by straight or diagonal lines
+                    for(int i = target; nodes[i].parent != -1; i = nodes[i].parent) {
+                        int x = i % width, y = i / width;
+                        const int px = nodes[i].parent % width, py = nodes[i].parent / width;
+                        const int dx = sign(px - x), dy = sign(py - y);
+
+                        while(x != px or y != py) {
+                            path.Push(Geometry::Point(x, y));
+                            x += dx;
+                            y += dy;
+                        }
+                    }
+                    path.Push(source_);
+
+                    return path;
+                }
+
+                const int cx = current % width, cy = current / width;
+                const uint32_t g = nodes[current].g;
+
+                int dx = 0, dy = 0;
+                if(nodes[current].parent != -1) {
+                    dx = sign(cx - nodes[current].parent % width);
+                    dy = sign(cy - nodes[current].parent / width);
+                }
+
+                int successors[8];
+                int count = neighbors(cx, cy, dx, dy, successors);
+
+                for(int i = 0; i < count; i++) {
+                    const int sx = successors[i] % 3 - 1, sy = successors[i] / 3 - 1;
+                    const int next = jump(cx + sx, cy + sy, sx, sy, target_);
+
+                    if(next == -1 or closed[next] == generation) {
+                        continue;
+                    }
+
+                    const int nx = next % width, ny = next / width;
+                    const uint32_t cost = g + distance(cx, cy, nx, ny);
+                    auto& node = nodes[next];
+                    if(node.generation != generation or cost < node.g) {
+                        node = {cost, current, generation};
+                        h = distance(nx, ny, target_.X, target_.Y);
+                        buffers_.Push(cost + h, h, next);
+                    }
+                }
+            }
+
+            return path;
+        }
+
+        using base_pathfinder::FindPaths;
+
+        /**
+         * @brief Finds the paths for the given queries in parallel on the shared worker pool.
+         * Workers use their own search buffers over the same grid.
+         */
+        void FindPaths(const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_) override {
+            FindPaths(queries_, results_, WorkerPool::Default());
+        }
+
+        void FindPaths(const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_, WorkerPool& pool_) {
+            RunQueries(pool_, worker_buffers, queries_, results_, [this](Geometry::Point source, Geometry::Point target, SearchBuffers& buffers) {
+                return FindPath(source, target, buffers);
+            });
+        }
+
+        void AddBlock(Gorgon::Geometry::Point coordinates_) override {
+            grid.Block(coordinates_);
+        }
+
+        void RemoveBlock(Gorgon::Geometry::Point coordinates_) override {
+            grid.Unblock(coordinates_);
+        }
+
+        void ClearBlocks() override {
+            grid.Clear();
+        }
+
+        bool IsBlocked(Gorgon::Geometry::Point coordinates_) const {
+            return grid.IsBlocked(coordinates_);
+        }
+
+        const BlockGrid& GetGrid() const {
+            return grid;
+        }
+
+    private:
+        static int sign(int value) {
+            return (value > 0) - (value < 0);
+        }
+
+        bool open(int x, int y) const {
+            return not grid.IsBlocked(x, y);
+        }
+
+        /// Octile distance when diagonal movement is enabled, manhattan distance otherwise.
+        uint32_t distance(int x1, int y1, int x2, int y2) const {
+            const uint32_t dx = std::abs(x1 - x2), dy = std::abs(y1 - y2);
+            if(diagonal) {
+                return 10 * std::max(dx, dy) + 4 * std::min(dx, dy);
+            }
+            return 10 * (dx + dy);
+        }
+
+        /// Writes directions that should be followed from the given cell, reached by
+        /// moving in dx, dy. Directions are encoded as (dx + 1) + (dy + 1) * 3.
+        int neighbors(int x, int y, int dx, int dy, int *out) const {
+            int count = 0;
+            auto add = [&](int nx, int ny) {
+                if(open(x + nx, y + ny)) {
+                    out[count++] = (nx + 1) + (ny + 1) * 3;
+                }
+            };
+
+            if(dx == 0 and dy == 0) {
+                add(0, 1); add(1, 0); add(0, -1); add(-1, 0);
+                if(diagonal) {
+                    add(-1, -1); add(1, 1); add(-1, 1); add(1, -1);
+                }
+            }
+            else if(not diagonal) {
+                if(dx != 0) {
+                    add(0, -1); add(0, 1); add(dx, 0);
+                }
+                else {
+                    add(-1, 0); add(1, 0); add(0, dy);
+                }
+            }
+            else if(dx != 0 and dy != 0) {
+                add(0, dy); add(dx, 0); add(dx, dy);
+                if(not open(x - dx, y)) {
+                    add(-dx, dy);
+                }
+                if(not open(x, y - dy)) {
+                    add(dx, -dy);
+                }
+            }
+            else if(dx != 0) {
+                add(dx, 0);
+                if(not open(x, y + 1)) {
+                    add(dx, 1);
+                }
+                if(not open(x, y - 1)) {
+                    add(dx, -1);
+                }
+            }
+            else {
+                add(0, dy);
+                if(not open(x + 1, y)) {
+                    add(1, dy);
+                }
+                if(not open(x - 1, y)) {
+                    add(-1, dy);
+                }
+            }
+
+            return count;
+        }
+
+        /// Scans from the given cell in the given direction and returns the index of the
+        /// first jump point or -1 if the scan hits a block.
+        int jump(int x, int y, int dx, int dy, Geometry::Point target) const {
+            const int width = grid.GetSize().Width;
+
+            while(open(x, y)) {
+                if(x == target.X and y == target.Y) {
+                    return x + y * width;
+                }
+
+                if(dx != 0 and dy != 0) {
+                    if((open(x - dx, y + dy) and not open(x - dx, y)) or (open(x + dx, y - dy) and not open(x, y - dy))) {
+                        return x + y * width;
+                    }
+
+                    if(jump(x + dx, y, dx, 0, target) != -1 or jump(x, y + dy, 0, dy, target) != -1) {
+                        return x + y * width;
+                    }
+                }
+                else if(diagonal) {
+                    if(dx != 0) {
+                        if((open(x + dx, y + 1) and not open(x, y + 1)) or (open(x + dx, y - 1) and not open(x, y - 1))) {
+                            return x + y * width;
+                        }
+                    }
+                    else {
+                        if((open(x + 1, y + dy) and not open(x + 1, y)) or (open(x - 1, y + dy) and not open(x - 1, y))) {
+                            return x + y * width;
+                        }
+                    }
+                }
+                else if(dx != 0) {
+                    if((open(x, y - 1) and not open(x - dx, y - 1)) or (open(x, y + 1) and not open(x - dx, y + 1))) {
+                        return x + y * width;
+                    }
+                }
+                else {
+                    if((open(x - 1, y) and not open(x - 1, y - dy)) or (open(x + 1, y) and not open(x + 1, y - dy))) {
+                        return x + y * width;
+                    }
+
+                    //vertical runs stop where a horizontal run would find a jump point
+                    if(jump(x + 1, y, 1, 0, target) != -1 or jump(x - 1, y, -1, 0, target) != -1) {
+                        return x + y * width;
+                    }
+                }
+
+                x += dx;
+                y += dy;
+            }
+
+            return -1;
+        }
+
+        BlockGrid grid;
+        SearchBuffers buffers;
+        std::vector<SearchBuffers> worker_buffers;
+        bool diagonal = false;
+    };
+
+}
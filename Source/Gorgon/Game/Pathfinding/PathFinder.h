@@ -0,0 +1,109 @@
+#pragma once
+#include <Gorgon/Geometry/Point.h>
+#include <Gorgon/Geometry/Size.h>
+#include <Gorgon/Game/Pathfinding/Pathfinders.h>
+#include <Gorgon/Game/Pathfinding/Grid.h>
+#include <Gorgon/Game/Pathfinding/AStar.h>
+#include <Gorgon/Game/Pathfinding/JumpPoint.h>
+#include <Gorgon/Game/Pathfinding/Hierarchical.h>
+#include <memory>
+
+namespace Gorgon::Game::Pathfinding {
+
+    /**
+     * @brief Path finder that forwards the queries to one of the available algorithms.
+     * The algorithm can be changed at any time, size, diagonal movement and blocks are
+     * transferred to the new algorithm.
+     */
+    class PathFinder : public base_pathfinder
+    {
+    public:
+        explicit PathFinder(Algorithm algorithm_ = Algorithm::AStar) {
+            SetAlgorithm(algorithm_);
+        }
+
+        void SetAlgorithm(Algorithm algorithm_) {
+            if(implementation and algorithm == algorithm_) {
+                return;
+            }
+
+            algorithm = algorithm_;
+
+            switch(algorithm) {
+            case Algorithm::JumpPoint:
+                implementation = std::make_unique<JumpPoint::PathFinder>();
+                break;
+            case Algorithm::Hierarchical:
+                implementation = std::make_unique<Hierarchical::PathFinder>();
+                break;
+            default:
+                implementation = std::make_unique<AStar::PathFinder>();
+                break;
+            }
+
+            implementation->SetSize(size);
+            implementation->SetDiagonalMovement(diagonal);
+            blocks.ForEachBlock([this](Geometry::Point p) {
+                implementation->AddBlock(p);
+            });
+        }
+
+        Algorithm GetAlgorithm() const {
+            return algorithm;
+        }
+
+        void SetSize(Gorgon::Geometry::Size layer_size_) override {
+            size = layer_size_;
+            implementation->SetSize(size);
+        }
+
+        Geometry::Size GetSize() const {
+            return size;
+        }
+
+        void SetDiagonalMovement(bool enable_) override {
+            diagonal = enable_;
+            implementation->SetDiagonalMovement(diagonal);
+        }
+
+        CoordinateList FindPath(Gorgon::Geometry::Point source_, Gorgon::Geometry::Point target_) override {
+            return implementation->FindPath(source_, target_);
+        }
+
+        using base_pathfinder::FindPaths;
+
+        void FindPaths(const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_) override {
+            implementation->FindPaths(queries_, results_);
+        }
+
+        void AddBlock(Gorgon::Geometry::Point coordinates_) override {
+            blocks.Block(coordinates_);
+            implementation->AddBlock(coordinates_);
+        }
+
+        void RemoveBlock(Gorgon::Geometry::Point coordinates_) override {
+            blocks.Unblock(coordinates_);
+            implementation->RemoveBlock(coordinates_);
+        }
+
+        void ClearBlocks() override {
+            blocks.Clear();
+            implementation->ClearBlocks();
+        }
+
+        /**
+         * @brief Returns the path finder that is currently in use.
+         */
+        base_pathfinder& GetImplementation() {
+            return *implementation;
+        }
+
+    private:
+        std::unique_ptr<base_pathfinder> implementation;
+        Algorithm algorithm = Algorithm::AStar;
+        Geometry::Size size = {0, 0};
+        bool diagonal = false;
+        BlockGrid blocks;
+    };
+
+}
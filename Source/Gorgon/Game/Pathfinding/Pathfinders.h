@@ -2,6 +2,8 @@
 #include <Gorgon/Geometry/Size.h>
 #include <Gorgon/Geometry/PointList.h>
 #include <Gorgon/Geometry/Point.h>
+#include <utility>
+#include <vector>
 #ifdef WIN32
 using uint = unsigned int;
 #endif
@@ -20,15 +22,52 @@ namespace Gorgon::Game::Pathfinding {
     using NodeSet = std::vector<TileNode*>;
     using CoordinateList = Geometry::PointList<>;
 
+    /// Source and target of a path query
+    using PathQuery = std::pair<Geometry::Point, Geometry::Point>;
+
+
+    /**
+     * @brief Path finding algorithms that can be selected at runtime. 
+     */
+    enum class Algorithm {
+        /// A* over every cell, finds the shortest path
+        AStar,
+        /// Jump point search, finds the shortest path, faster on open areas
+        JumpPoint,
+        /// Hierarchical A* over clusters, finds near optimal paths, fastest on large maps
+        Hierarchical
+    };
 
     class base_pathfinder {
         public: 
         base_pathfinder() = default; 
+        virtual ~base_pathfinder() = default; 
         virtual void SetSize(Gorgon::Geometry::Size) = 0; 
         virtual CoordinateList FindPath(Gorgon::Geometry::Point, Gorgon::Geometry::Point) = 0; 
         virtual void SetDiagonalMovement(bool) = 0; 
         virtual void AddBlock(Gorgon::Geometry::Point) = 0;
         virtual void RemoveBlock(Gorgon::Geometry::Point) = 0; 
         virtual void ClearBlocks() = 0; 
+
+        /**
+         * @brief Finds the paths for all given queries, results are placed in the same 
+         * order as the queries. Path finders that support it solve the queries in parallel 
+         * using WorkerPool::Default(), blocks should not be changed until this function
+         * returns. These path finders keep buffers for every worker, therefore, this
+         * function should not be called concurrently on the same path finder.
+         */
+        virtual void FindPaths(const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_) {
+            results_.resize(queries_.size()); 
+            for(size_t i = 0; i < queries_.size(); i++) {
+                results_[i] = FindPath(queries_[i].first, queries_[i].second); 
+            }
+        }
+
+        std::vector<CoordinateList> FindPaths(const std::vector<PathQuery>& queries_) {
+            std::vector<CoordinateList> results; 
+            FindPaths(queries_, results); 
+
+            return results; 
+        }
     };
  }
\ No newline at end of file
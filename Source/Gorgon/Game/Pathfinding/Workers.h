@@ -0,0 +1,96 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <Gorgon/Game/Pathfinding/Pathfinders.h>
+#include <Gorgon/Threading.h>
+
+namespace Gorgon::Game::Pathfinding {
+
+    /**
+     * @brief Runs batch path queries on the shared Threading::Scheduler.
+     * A batch is split into as many executions as the thread count of the pool, each with
+     * its own worker id. No threads are created, therefore, a batch can be started every
+     * frame. The calling thread also takes part in the work. While waiting, the calling
+     * thread might run unrelated tasks of the scheduler, which may start batches of their
+     * own, therefore, batches are not serialized. Worker ids are only unique within a batch,
+     * batches that share per worker data should not run at the same time.
+     */
+    class WorkerPool {
+        public:
+        /**
+         * @brief Creates a pool that runs the given number of executions including the
+         * calling thread. If threads is 0, the number of hardware threads is used.
+         */
+        explicit WorkerPool(unsigned threads_ = 0) {
+            if(threads_ == 0) {
+                threads_ = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            threads = threads_;
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /**
+         * @brief Returns the number of threads including the calling thread. Worker ids
+         * passed to the functions are less than this number.
+         */
+        unsigned GetThreadCount() const {
+            return threads;
+        }
+
+        /**
+         * @brief Calls the given function for every index in [0, count) and returns when
+         * all calls are finished. First parameter is the index, second is the id of the
+         * worker that runs the call. Calls of this batch with the same worker id never run
+         * concurrently.
+         */
+        void Run(size_t count_, const std::function<void(size_t, unsigned)>& function_) {
+            if(count_ == 0) {
+                return;
+            }
+
+            std::atomic<size_t> next{0};
+
+            Threading::RunInParallel([&](int id, int) {
+                for(size_t i = next++; i < count_; i = next++) {
+                    function_(i, unsigned(id));
+                }
+            }, unsigned(std::min<size_t>(threads, count_)));
+        }
+
+        /**
+         * @brief Returns the pool that is shared by the path finders.
+         */
+        static WorkerPool& Default() {
+            static WorkerPool pool;
+
+            return pool;
+        }
+
+        private:
+        unsigned threads;
+    };
+
+    /**
+     * @brief Solves the given queries on the pool. Every worker uses its own element of the
+     * buffers, which is resized to the number of threads of the pool. Find is called with
+     * the source, the target and the buffers of the worker.
+     */
+    template<class Buffers_, class Find_>
+    void RunQueries(WorkerPool& pool_, std::vector<Buffers_>& buffers_, const std::vector<PathQuery>& queries_, std::vector<CoordinateList>& results_, Find_ find_) {
+        buffers_.resize(pool_.GetThreadCount());
+        results_.resize(queries_.size());
+
+        pool_.Run(queries_.size(), [&](size_t index, unsigned worker) {
+            results_[index] = find_(queries_[index].first, queries_[index].second, buffers_[worker]);
+        });
+    }
+
+}
@@ -10,6 +10,7 @@ It's ODR violation but still the Renderer function will be here.
 #pragma once
 #include <Gorgon/CGI.h>
 #include <Gorgon/CGI/Line.h>
+#include <Gorgon/CGI/RenderList.h>
 #include <Gorgon/Containers/Collection.h>
 #include <Gorgon/Game/Exceptions/Exception.h>
 #include <Gorgon/Geometry/Bounds.h>
@@ -28,8 +29,13 @@ It's ODR violation but still the Renderer function will be here.
 #include <Gorgon/Utils/Assert.h>
 #include <Gorgon/Utils/Logging.h>
 #include <Gorgon/Widgets/Registry.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #ifndef RENDERER_H
@@ -223,6 +229,7 @@ namespace Gorgon::Game::Rendering {
             static_cast<Derived*>(this)->drawable_ready = false; 
             resources.clear();
             drawables.clear();
+            invalidate_chunks(); 
         }
 
         void PrepareZoomed(int factor) {
@@ -255,6 +262,7 @@ namespace Gorgon::Game::Rendering {
             static_cast<Derived*>(this)->drawable_ready = false;
             resources.clear();
             drawables.clear();
+            invalidate_chunks(); 
             if(prepare) {
                 this->Prepare(); 
             } 
@@ -268,12 +276,127 @@ namespace Gorgon::Game::Rendering {
             target_layer = &layer;
         }
 
+        /**
+         * @brief Sets the visible area in the coordinates of the target layer.
+         * Only the tiles and objects that fall into this area are drawn. If camera 
+         * is not set, the size of the target layer is used.
+         */
+        void SetCamera(const Geometry::Bounds& camera) {
+            this->camera = camera; 
+            has_camera = true; 
+        }
+
+        /**
+         * @brief Resets the camera to cover the target layer. 
+         */
+        void ResetCamera() {
+            has_camera = false; 
+        }
+
+        /**
+         * @brief Returns the visible area in the coordinates of the target layer.
+         */
+        Geometry::Bounds GetCamera() const {
+            if(has_camera) 
+                return camera; 
+            return {{0, 0}, target_layer->GetTargetSize()}; 
+        }
+
+        /**
+         * @brief Marks the layer with the given id as static.
+         * Static layers are pre-rendered into fixed size chunks of frame buffers. A chunk
+         * is only redrawn when the tiles it contains are changed. If the layer is changed 
+         * directly, its revision is used to redraw all of its chunks. Use SetTile to 
+         * change tiles of static layers. As chunks are blended twice, partially transparent
+         * pixels will be slightly darker. If frame buffers are not supported, static layers
+         * are drawn directly.
+         */
+        void SetStaticLayer(int id, bool value = true) {
+            if(value)
+                static_layers[id]; 
+            else 
+                static_layers.erase(id); 
+        }
+
+        /**
+         * @brief Returns whether the layer with the given id is static.
+         */
+        bool IsStaticLayer(int id) const {
+            return static_layers.count(id) != 0; 
+        }
+
+        /**
+         * @brief Changes the size of the chunks static layers are rendered into. 
+         */
+        void SetChunkSize(const Geometry::Size& size) {
+            chunk_size = size; 
+            invalidate_chunks(); 
+        }
+
+        /**
+         * @brief Returns the size of the chunks static layers are rendered into.
+         */
+        Geometry::Size GetChunkSize() const {
+            return chunk_size; 
+        }
+
+        /**
+         * @brief Changes the tile at the given location of the layer with the given id.
+         * If the layer is static, only the chunks that contain the tile are redrawn. 
+         */
+        void SetTile(int layer_id, int x, int y, uint32_t gid) {
+            for(auto& layer : map.GetLayers()) {
+                if(layer.id != layer_id) 
+                    continue; 
+
+                layer.SetTile(x, y, gid); 
+
+                auto it = static_layers.find(layer_id); 
+                if(it == static_layers.end() or it->second.chunks.empty()) 
+                    return; 
+
+                auto& cache = it->second; 
+                auto tile = static_cast<Derived*>(this)->tile_bounds(x, y); 
+                tile.Left   -= cache.area.Left; 
+                tile.Right  -= cache.area.Left; 
+                tile.Top    -= cache.area.Top; 
+                tile.Bottom -= cache.area.Top; 
+
+                int cx0 = std::max(0, floor_div(tile.Left, chunk_size.Width)); 
+                int cx1 = std::min(cache.columns - 1, floor_div(tile.Right - 1, chunk_size.Width)); 
+                int cy0 = std::max(0, floor_div(tile.Top, chunk_size.Height)); 
+                int cy1 = std::min(cache.rows - 1, floor_div(tile.Bottom - 1, chunk_size.Height)); 
+
+                for(int cy = cy0; cy <= cy1; cy++) {
+                    for(int cx = cx0; cx <= cx1; cx++) {
+                        cache.chunks[cx + cy * cache.columns].dirty = true; 
+                    }
+                }
+
+                cache.revision = layer.GetRevision(); 
+                return; 
+            }
+        }
+
         base_tile_renderer(Graphics::Layer& target_layer, const std::initializer_list<map_type>& map_list) : map_list(map_list) , target_layer(&target_layer) {}
         base_tile_renderer(Graphics::Layer& target_layer, const std::vector<map_type>& map_list) : map_list(map_list) , target_layer(&target_layer) {}
         base_tile_renderer(const std::initializer_list<map_type>& map_list) : map_list(map_list), target_layer(nullptr) {}
         base_tile_renderer() : map_list(), target_layer(nullptr) {}
 
         protected: 
+        struct chunk {
+            std::unique_ptr<GL::FrameBuffer> buffer; 
+            std::unique_ptr<Graphics::TextureImage> image; 
+            bool dirty = true; 
+        }; 
+
+        struct chunk_cache {
+            Geometry::Bounds area; 
+            int columns = 0, rows = 0; 
+            unsigned revision = 0; 
+            std::vector<chunk> chunks; 
+        }; 
+
         std::vector<std::shared_ptr<Graphics::Bitmap>> resources;
         std::vector<std::shared_ptr<Graphics::TextureImage>> drawables;
 
@@ -286,6 +409,99 @@ namespace Gorgon::Game::Rendering {
 
         Graphics::Layer * target_layer; 
 
+        Geometry::Bounds camera; 
+        bool has_camera = false; 
+
+        Geometry::Size chunk_size = {512, 512}; 
+        std::unordered_map<int, chunk_cache> static_layers; 
+
+        static int floor_div(int a, int b) {
+            return a / b - (a % b != 0 and (a < 0) != (b < 0)); 
+        }
+
+        /**
+         * @brief Returns the largest tile size in the tilesets and the map.
+         */
+        Geometry::Size tile_extent() {
+            Geometry::Size ret = {map.tilewidth, map.tileheight}; 
+            for(const auto& tileset : map.GetTileSets()) {
+                ret.Width  = std::max(ret.Width, tileset.tilewidth); 
+                ret.Height = std::max(ret.Height, tileset.tileheight); 
+            }
+            return ret; 
+        }
+
+        void invalidate_chunks() {
+            for(auto& cache : static_layers) {
+                cache.second = chunk_cache{}; 
+            }
+        }
+
+        /**
+         * @brief Draws the given layer using the cached chunks. Returns false if the layer
+         * is not static or frame buffers are not supported, the layer should be drawn 
+         * directly in this case. 
+         */
+        template<class layer_type>
+        bool render_static(const layer_type& layer, const Geometry::Bounds& view, int off_x, int off_y) {
+            if(not GL::FrameBuffer::HardwareSupport) 
+                return false; 
+
+            auto it = static_layers.find(layer.id); 
+            if(it == static_layers.end()) 
+                return false; 
+
+            auto self = static_cast<Derived*>(this); 
+            auto& cache = it->second; 
+            const auto CW = chunk_size.Width, CH = chunk_size.Height; 
+
+            if(cache.chunks.empty() or cache.revision != layer.GetRevision()) {
+                cache.area     = self->map_area(); 
+                cache.columns  = (cache.area.Width()  + CW - 1) / CW; 
+                cache.rows     = (cache.area.Height() + CH - 1) / CH; 
+                cache.revision = layer.GetRevision(); 
+                cache.chunks.clear(); 
+                cache.chunks.resize(cache.columns * cache.rows); 
+            }
+
+            //visible area in map coordinates relative to the chunk grid
+            auto left = view.Left - off_x - cache.area.Left, top = view.Top - off_y - cache.area.Top; 
+
+            int cx0 = std::max(0, floor_div(left, CW)); 
+            int cx1 = std::min(cache.columns - 1, floor_div(left + view.Width() - 1, CW)); 
+            int cy0 = std::max(0, floor_div(top, CH)); 
+            int cy1 = std::min(cache.rows - 1, floor_div(top + view.Height() - 1, CH)); 
+
+            auto prev_mode = target_layer->GetDrawMode(); 
+            target_layer->SetDrawMode(Graphics::TextureTarget::FrameBuffer); 
+
+            for(int cy = cy0; cy <= cy1; cy++) {
+                for(int cx = cx0; cx <= cx1; cx++) {
+                    auto& c = cache.chunks[cx + cy * cache.columns]; 
+                    int x = cache.area.Left + cx * CW, y = cache.area.Top + cy * CH; 
+
+                    if(c.dirty) {
+                        if(not c.buffer) {
+                            c.buffer = std::make_unique<GL::FrameBuffer>(chunk_size, false); 
+                            c.image  = std::make_unique<Graphics::TextureImage>(c.buffer->GetTexture(), Graphics::ColorMode::RGBA, chunk_size); 
+                        }
+
+                        Graphics::Layer chunk_layer; 
+                        self->draw_tiles(layer, chunk_layer, {0, 0, CW, CH}, -x, -y); 
+                        chunk_layer.RenderTo(*c.buffer); 
+
+                        c.dirty = false; 
+                    }
+
+                    c.image->Draw(*target_layer, x + off_x, y + off_y); 
+                }
+            }
+
+            target_layer->SetDrawMode(prev_mode); 
+
+            return true; 
+        }
+
         void RepeatCyclic(int outer, int inner, std::function<void(int, int)> Fp) {
             for(int i{}; i < outer; i++) {
                 for(int j{}; j < inner; j++) {
@@ -322,7 +538,7 @@ namespace Gorgon::Game::Rendering {
         using Base::RepeatCyclic; 
         
         void pass_layer_impl() {
-            auto pass_layer = Base::map.GetPassabilityLayer(); 
+            auto& pass_layer = Base::map.GetPassabilityLayer(); 
             for (auto block : pass_layer.data_to_grid()) {
                 if (block.is_passable()) { continue; }
 
@@ -415,44 +631,89 @@ namespace Gorgon::Game::Rendering {
             if(!drawable_ready) 
                 throw Exception::not_ready("The renderer is not ready to render yet. Did you try calling \"Prepare()\"?"); 
 
-            auto size = target_layer->GetTargetSize();
-            auto layers = map.GetLayers(); 
-            const auto W = size.Width, H = size.Height; 
-            const auto TW = map.tilewidth, TH = map.tileheight;
-            const auto MW = map.width, MH = map.height;
+            const auto& layers = map.GetLayers(); 
+            const auto view = Base::GetCamera(); 
 
             for(const auto& layer : layers) {
-                auto map_data = layer.map_data(); 
-                auto name = Gorgon::String::ToLower(layer.name);
-                if (name.find("passability") != -1) {
+                if (layer.is_passability_layer()) {
                     continue;
                 }
-                Base::RepeatCyclic(MW, MH, [&](int x, int y) {
-                    auto gid = map_data[x + y * MW]; 
-                    if(gid == 0) 
-                        return; 
-                    if(this->Base::drawables[gid - 1]->GetImageSize().Height == TH * 2) {
-                        this->Base::drawables[gid - 1]->Draw(*Base::target_layer, x * TW + off_x, (y * TH) - TH + off_y); 
-                        return; 
-                    }
-                    this->Base::drawables[gid - 1]->Draw(*Base::target_layer, x * TW + off_x, y * TH + off_y); 
-                });
+                if(!Base::render_static(layer, view, off_x, off_y)) {
+                    draw_tiles(layer, *target_layer, view, off_x, off_y); 
+                }
                 const auto& obj_it = Base::objects.find(layer.id);
                 if(obj_it != Base::objects.end()) {
-                    render_object(obj_it->second, off_x, off_y); 
+                    render_object(obj_it->second, view, off_x, off_y); 
                 }
             }
         }
 
-        void render_object(int id, int off_x, int off_y) {
-            auto group = Base::map.GetObjectGroupMap(); 
-            group[id].ForEach([&](auto obj) {
-                this->Base::drawables[obj.gid - 1]->Draw(*Base::target_layer, obj.x + off_x, obj.y - obj.height + off_y);
-            }); 
+        /**
+         * @brief Draws the tiles of the layer that are visible in the given view.
+         * Tiles that are twice the height of the map tiles are drawn one row above.
+         */
+        template<class layer_type>
+        void draw_tiles(const layer_type& layer, Graphics::Layer& target, const Geometry::Bounds& view, int off_x, int off_y) {
+            const auto TW = map.tilewidth, TH = map.tileheight;
+            const auto MW = map.width, MH = map.height;
+            const auto ext = Base::tile_extent(); 
+            const auto& tiles = layer.GetTiles(); 
+            const auto& drawables = Base::drawables; 
+
+            const int x0 = std::max(0, Base::floor_div(view.Left - off_x - ext.Width, TW) + 1); 
+            const int x1 = std::min(MW - 1, Base::floor_div(view.Right - off_x - 1, TW)); 
+            const int y0 = std::max(0, Base::floor_div(view.Top - off_y - ext.Height, TH) + 1); 
+            const int y1 = std::min(MH - 1, Base::floor_div(view.Bottom - off_y + TH - 1, TH)); 
+
+            for(int y = y0; y <= y1; y++) {
+                for(int x = x0; x <= x1; x++) {
+                    auto gid = tiles[x + y * MW]; 
+                    if(gid == 0) 
+                        continue; 
+                    const auto& img = *drawables[gid - 1]; 
+                    if(img.GetImageSize().Height == TH * 2) {
+                        img.Draw(target, x * TW + off_x, (y * TH) - TH + off_y); 
+                        continue; 
+                    }
+                    img.Draw(target, x * TW + off_x, y * TH + off_y); 
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the area covered by the tiles in map coordinates.
+         */
+        Geometry::Bounds map_area() {
+            const auto TW = map.tilewidth, TH = map.tileheight;
+            const auto ext = Base::tile_extent(); 
+            const auto over_w = std::max(0, ext.Width - TW), over_h = std::max(0, ext.Height - TH); 
+            return {0, -over_h, map.width * TW + over_w, map.height * TH + over_h}; 
+        }
 
-            for (auto [key, val] : group) {
+        /**
+         * @brief Returns the area the tile at the given location could cover in map coordinates.
+         */
+        Geometry::Bounds tile_bounds(int x, int y) {
+            const auto TW = map.tilewidth, TH = map.tileheight;
+            const auto ext = Base::tile_extent(); 
+            const auto over_h = std::max(0, ext.Height - TH); 
+            return {x * TW, y * TH - over_h, x * TW + ext.Width, y * TH + ext.Height}; 
+        }
+
+        void render_object(int id, const Geometry::Bounds& view, int off_x, int off_y) {
+            auto group = Base::map.FindObjectGroup(id); 
+            if(group) {
+                for(const auto& obj : group->GetObjects()) {
+                    int x = int(obj.x) + off_x, y = int(obj.y) - obj.height + off_y; 
+                    if(x >= view.Right or y >= view.Bottom or x + obj.width <= view.Left or y + obj.height <= view.Top) 
+                        continue; 
+                    Base::drawables[obj.gid - 1]->Draw(*Base::target_layer, obj.x + off_x, obj.y - obj.height + off_y);
+                }
+            }
+
+            for (const auto& val : Base::map.GetObjectGroups()) {
                 if (val.previous_object_group_index == id) {
-                    render_object(val.id, off_x, off_y);
+                    render_object(val.id, view, off_x, off_y);
                     break; 
                 } 
             }
@@ -463,6 +724,8 @@ namespace Gorgon::Game::Rendering {
                 Base::allbounds = std::make_shared<Graphics::Bitmap>();
                 (*Base::allbounds).Resize(map.width * map.tilewidth, map.height * map.tileheight);
             
+                //bounds of all tiles are recorded and drawn together using multiple threads
+                CGI::RenderList bounds;
             
                 Base::RepeatCyclic(Base::map.width, Base::map.height, [&](int x, int y) {
                     Geometry::PointList<> list; 
@@ -477,9 +740,11 @@ namespace Gorgon::Game::Rendering {
                     list.Push(bottom_right);
                     list.Push(top_right);
 
-                    CGI::DrawLines(*Base::allbounds, list, stroke, color);
+                    bounds.DrawLines(list, stroke, color);
                 }); 
 
+                bounds.Render(*Base::allbounds);
+
                 first_time_all  = false; 
             }
             (*Base::allbounds).Prepare();
@@ -547,7 +812,7 @@ namespace Gorgon::Game::Rendering {
         using Base::map;
         
         void pass_layer_impl() {
-            auto pass_layer = Base::map.GetPassabilityLayer(); 
+            auto& pass_layer = Base::map.GetPassabilityLayer(); 
             for (auto block : pass_layer.data_to_grid()) {
                 if (block.is_passable()) { continue; }
 
@@ -644,47 +909,104 @@ namespace Gorgon::Game::Rendering {
             if(!drawable_ready) 
                 throw Exception::not_ready("The renderer is not ready. Did you try calling \"Ready()\"?"); 
 
-            auto size = target_layer->GetTargetSize();
-            auto layers = map.GetLayers(); 
-            const auto W = size.Width, H = size.Height; 
-            const auto TW = map.tilewidth, TH = map.tileheight;
-            const auto MW = map.width, MH = map.height; 
+            const auto& layers = map.GetLayers(); 
+            const auto view = Base::GetCamera(); 
 
             for(const auto& layer: layers) {
-                auto name = Gorgon::String::ToLower(layer.name);
-            
-                if (name.find("passability") != -1) {
+                if (layer.is_passability_layer()) {
                     continue;
                 }
-                auto map_data = layer.map_data();
-                Base::RepeatCyclic(MW, MH,[=](int x, int y) {
-                    auto active_layer = layer; 
-                    auto gid = map_data[x + (y * MW)]; 
+                if(!Base::render_static(layer, view, off_x, off_y)) {
+                    draw_tiles(layer, *target_layer, view, off_x, off_y); 
+                }
+                const auto& obj_it = Base::objects.find(layer.id);
+                if(obj_it != Base::objects.end()) {
+                    render_object(obj_it->second, view, off_x, off_y); 
+                }
+            }
+            
+        }
+
+        /**
+         * @brief Draws the tiles of the layer that are visible in the given view.
+         * Visible range is calculated for each row using the diagonal coordinates 
+         * (x - y) and (x + y) of the tiles. 
+         */
+        template<class layer_type>
+        void draw_tiles(const layer_type& layer, Graphics::Layer& target, const Geometry::Bounds& view, int off_x, int off_y) {
+            const auto TW = map.tilewidth, TH = map.tileheight;
+            const auto MW = map.width, MH = map.height; 
+            const auto HW = std::max(1, TW / 2), HH = std::max(1, TH / 2); 
+            const auto ext = Base::tile_extent(); 
+            const auto& tiles = layer.GetTiles();
+            const auto& drawables = Base::drawables; 
+            const auto base_x = TW * MW / 2 + off_x; 
+
+            //range of (x - y) and (x + y) that are visible
+            const int a0 = Base::floor_div(view.Left - base_x - ext.Width, HW) + 1; 
+            const int a1 = Base::floor_div(view.Right - base_x - 1, HW); 
+            const int b0 = Base::floor_div(view.Top - off_y - ext.Height, HH) + 1; 
+            const int b1 = Base::floor_div(view.Bottom - off_y - 1, HH); 
+
+            const int y0 = std::max(0, Base::floor_div(b0 - a1, 2)); 
+            const int y1 = std::min(MH - 1, Base::floor_div(b1 - a0, 2)); 
+
+            for(int y = y0; y <= y1; y++) {
+                const int x0 = std::max({0, a0 + y, b0 - y}); 
+                const int x1 = std::min({MW - 1, a1 + y, b1 - y}); 
+                for(int x = x0; x <= x1; x++) {
+                    auto gid = tiles[x + (y * MW)]; 
                     if(gid == 0)
-                        return; 
+                        continue; 
                     Geometry::Point point {
                         (x - y) * (TW / 2) + (TW * MW / 2) + off_x, 
                         (y + x) * (TH / 2) + off_y
                     };  
-                    Base::drawables[gid - 1]->Draw(*target_layer, point);
-                });
-                const auto& obj_it = Base::objects.find(layer.id);
-                if(obj_it != Base::objects.end()) {
-                    render_object(obj_it->second, off_x, off_y); 
+                    drawables[gid - 1]->Draw(target, point);
                 }
             }
-            
         }
 
-        void render_object(int id, int off_x, int off_y) {
-            auto group = Base::map.GetObjectGroupMap(); 
-            group[id].ForEach([&](auto obj) {
-                this->Base::drawables[obj.gid - 1]->Draw(*Base::target_layer, obj.x + off_x, obj.y - obj.height + off_y);
-            }); 
+        /**
+         * @brief Returns the area covered by the tiles in map coordinates.
+         */
+        Geometry::Bounds map_area() {
+            const auto TW = map.tilewidth, TH = map.tileheight;
+            const auto MW = map.width, MH = map.height; 
+            const auto ext = Base::tile_extent(); 
+            return {
+                (1 - MH) * (TW / 2) + (TW * MW / 2), 0, 
+                (MW - 1) * (TW / 2) + (TW * MW / 2) + ext.Width, (MW + MH - 2) * (TH / 2) + ext.Height
+            }; 
+        }
+
+        /**
+         * @brief Returns the area the tile at the given location could cover in map coordinates.
+         */
+        Geometry::Bounds tile_bounds(int x, int y) {
+            const auto TW = map.tilewidth, TH = map.tileheight;
+            const auto ext = Base::tile_extent(); 
+            Geometry::Point point {
+                (x - y) * (TW / 2) + (TW * map.width / 2), 
+                (y + x) * (TH / 2)
+            }; 
+            return {point, ext}; 
+        }
+
+        void render_object(int id, const Geometry::Bounds& view, int off_x, int off_y) {
+            auto group = Base::map.FindObjectGroup(id); 
+            if(group) {
+                for(const auto& obj : group->GetObjects()) {
+                    int x = int(obj.x) + off_x, y = int(obj.y) - obj.height + off_y; 
+                    if(x >= view.Right or y >= view.Bottom or x + obj.width <= view.Left or y + obj.height <= view.Top) 
+                        continue; 
+                    Base::drawables[obj.gid - 1]->Draw(*Base::target_layer, obj.x + off_x, obj.y - obj.height + off_y);
+                }
+            }
 
-            for (auto [key, val] : group) {
+            for (const auto& val : Base::map.GetObjectGroups()) {
                 if (val.previous_object_group_index == id) {
-                    render_object(val.id, off_x, off_y);
+                    render_object(val.id, view, off_x, off_y);
                     break; 
                 } 
             }
@@ -695,6 +1017,9 @@ namespace Gorgon::Game::Rendering {
                 Base::allbounds = std::make_shared<Graphics::Bitmap>();
                 (*Base::allbounds).Resize(map.width * map.tilewidth, map.height * map.tileheight);
             
+                //bounds of all tiles are recorded and drawn together using multiple threads
+                CGI::RenderList bounds;
+            
                 Base::RepeatCyclic(Base::map.width, Base::map.height, [&](int x, int y) {
                     Geometry::PointList<> list; 
                     
@@ -727,9 +1052,11 @@ namespace Gorgon::Game::Rendering {
                     list.Push(top_left);
 
 
-                    CGI::DrawLines(*Base::allbounds, list, stroke, color);
+                    bounds.DrawLines(list, stroke, color);
                 }); 
 
+                bounds.Render(*Base::allbounds);
+
                 first_time_all  = false; 
             }
             (*Base::allbounds).Prepare();
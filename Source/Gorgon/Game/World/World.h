@@ -16,7 +16,7 @@
 #include <Gorgon/Input/Mouse.h>
 #include <Gorgon/Scene.h>
 #include <Gorgon/UI.h>
-#include <Gorgon/Game/Pathfinding/AStar.h>
+#include <Gorgon/Game/Pathfinding/PathFinder.h>
 #include <Gorgon/Utils/Assert.h>
 #include <Gorgon/Window.h>
 #include <vector>
@@ -266,13 +266,14 @@ namespace Gorgon::Game::Template {
         static const bool value = sizeof(test<C>(0)) == sizeof(YesType);
     };
     
-    template<typename renderer, typename generator = Pathfinding::AStar::PathFinder>
+    template<typename renderer, typename generator = Pathfinding::PathFinder>
     class Scene : public Gorgon::Scene {
 
         private: 
         renderer map_renderer; 
         bool is_ready, bg_render; 
         generator path_finder; 
+        Pathfinding::Algorithm algorithm = Pathfinding::Algorithm::AStar; 
 
         protected:
         void doframe(unsigned int delta) override {
@@ -314,7 +315,11 @@ namespace Gorgon::Game::Template {
 
         void InitPathfinder() {
             if constexpr (has_passability_layer<typename renderer::MapType, Map::Tiled::Layer&()>::value) {
-                path_finder.SetSize({map_renderer.GetActiveMap().tilewidth, map_renderer.GetActiveMap().tileheight});
+                if constexpr (requires(generator& g) { g.SetAlgorithm(algorithm); }) {
+                    path_finder.SetAlgorithm(algorithm); 
+                }
+
+                path_finder.SetSize({map_renderer.GetActiveMap().width, map_renderer.GetActiveMap().height});
                 for(auto grid : map_renderer.GetActiveMap().GetPassabilityLayer().data_to_grid()) {
                     if(not grid.is_passable()) {
                         path_finder.AddBlock(grid.location); 
@@ -386,6 +391,19 @@ namespace Gorgon::Game::Template {
             InitPathfinder();  
         }
 
+        /**
+         * @brief Changes the path finding algorithm. Only effective if the path finder
+         * of the scene supports choosing the algorithm, which is the default. 
+         */
+        void SetPathfindingAlgorithm(Pathfinding::Algorithm algorithm_) {
+            algorithm = algorithm_; 
+            ReinitPathfinder(); 
+        }
+
+        Pathfinding::Algorithm GetPathfindingAlgorithm() const {
+            return algorithm; 
+        }
+
 
         Geometry::Size GetTargetSize() {
             return graphics.GetTargetSize();
@@ -426,13 +444,13 @@ namespace Gorgon::Game::Template {
         }
         
 
-        Event<Game::Template::Scene<renderer>, unsigned int> OnUpdate;
-        Event<Game::Template::Scene<renderer>, Graphics::Layer&> OnRender;
-        Event<Game::Template::Scene<renderer>, Geometry::Point> OnMouseMove; 
-        Event<Game::Template::Scene<renderer>, Geometry::Point> OnMouseDown; 
-        Event<Game::Template::Scene<renderer>, Geometry::Point> OnMouseUp; 
-        Event<Game::Template::Scene<renderer>, Geometry::Point> OnMouseClick; 
-        Event<Game::Template::Scene<renderer>, Input::Key, float> OnKeyEvent; 
+        Event<Game::Template::Scene<renderer, generator>, unsigned int> OnUpdate;
+        Event<Game::Template::Scene<renderer, generator>, Graphics::Layer&> OnRender;
+        Event<Game::Template::Scene<renderer, generator>, Geometry::Point> OnMouseMove; 
+        Event<Game::Template::Scene<renderer, generator>, Geometry::Point> OnMouseDown; 
+        Event<Game::Template::Scene<renderer, generator>, Geometry::Point> OnMouseUp; 
+        Event<Game::Template::Scene<renderer, generator>, Geometry::Point> OnMouseClick; 
+        Event<Game::Template::Scene<renderer, generator>, Input::Key, float> OnKeyEvent; 
         
     };  
 
@@ -509,7 +527,7 @@ namespace Gorgon::Game::Template {
             function(GetScene<renderer_type>(SceneID)); 
         }
 
-        template<typename Renderer_, typename PathFinder_ = Pathfinding::AStar::PathFinder, typename... Args_>
+        template<typename Renderer_, typename PathFinder_ = Pathfinding::PathFinder, typename... Args_>
         void NewScene(SceneID id, Renderer_&& class_, Args_&&... args) {
             manager.template NewScene<Scene<Renderer_, PathFinder_>>(id, class_.GetMap(), std::forward<Args_>(args)...);
         }
@@ -16,7 +16,7 @@
 
 int main() {
     Gorgon::Game::Map::Tiled::Map map{"fishbg.tmx"}; 
-    auto objects = map.GetObjectGroup(0).GetObjects();
+    Gorgon::Game::ObjectFinding::Tiled::ObjectIndex objects{map.GetObjectGroup(0)};
     Gorgon::Game::ObjectFinding::Tiled::FindObject finder; 
     auto results = finder.SearchArea(objects, {300, 150}, {400, 250}); 
 
@@ -25,6 +25,34 @@ namespace Gorgon {
         /// created. There is a mechanism to ensure initialization is performed once.
         void Initialize();
 
+        /// Contains rendering counters that are collected while layers are rendered. Counters are
+        /// accumulated until ResetRenderStatistics is called.
+        struct RenderStatistics {
+            /// Number of surfaces that are rendered
+            unsigned long Surfaces  = 0;
+
+            /// Number of batches formed. When batching is disabled, every surface forms its own
+            /// batch.
+            unsigned long Batches   = 0;
+
+            /// Number of draw calls issued to the GL
+            unsigned long DrawCalls = 0;
+        };
+
+        /// Returns the rendering statistics collected since the last reset.
+        RenderStatistics GetRenderStatistics();
+
+        /// Resets the rendering statistics.
+        void ResetRenderStatistics();
+
+        /// Enables or disables batched rendering. When enabled, consecutive surfaces in a layer
+        /// that use the same texture, shader and drawing mode are drawn with a single draw call.
+        /// Batching is enabled by default.
+        void SetBatching(bool value);
+
+        /// Returns whether batched rendering is enabled.
+        bool IsBatchingEnabled();
+
         /// Details which directions a texture should tile. If its not tiled for that direction, it will
         /// be stretched. If the target size is smaller, tiling causes partial draw instead of shrinking.
         /// @todo Should be fitted to String::Enum
@@ -541,9 +569,25 @@ namespace Gorgon {
 
             extern GL::Texture LastTexture;
 
+            extern RenderStatistics Statistics;
+
             void ActivateQuadVertices();
             void DrawQuadVertices();
 
+            /// A single vertex of a batched quad
+            struct BatchVertex {
+                float Position[3];
+                float TexCoord[2];
+                float Color[4];
+            };
+
+            /// Maximum number of quads that can be drawn in a single draw call
+            static const int MaxBatchQuads = 4096;
+
+            /// Draws the given quads, each quad should have 4 vertices in the same order as
+            /// QuadVertices. Bound shader and textures are used for drawing.
+            void DrawBatchVertices(const BatchVertex *vertices, int quads);
+
         }
     }
 }
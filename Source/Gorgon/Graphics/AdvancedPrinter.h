@@ -24,6 +24,9 @@ namespace Gorgon { namespace Graphics {
      * aspect of text rendering. It allows images and tables to be placed. Use AdvancedTextBuilder
      * to easily build advanced markup. Unlike other text printers AdvancedRenderer is a heavy object
      * and should not be copied around. Normal font must be set in order to print anything.
+     * Unlike BasicPrinter and StyledPrinter, texts are not kept in a layout cache, the output
+     * depends on the size of the target, the images and all fonts of the printer, which do not
+     * report changes. Markup is parsed every time the text is printed.
      */
     class AdvancedPrinter : public TextPrinter {
     public:
@@ -0,0 +1,384 @@
+#include "Atlas.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+namespace Gorgon { namespace Graphics {
+
+	AtlasPacker::AtlasPacker(const Geometry::Size &size) : size(size) {
+		Reset();
+	}
+
+	void AtlasPacker::Reset() {
+		freelist.clear();
+		freelist.push_back({0, 0, size});
+
+		used   = 0;
+		extent = {0, 0};
+	}
+
+	bool AtlasPacker::Place(const Geometry::Size &sz, Geometry::Bounds &location) {
+		int bestshort = INT_MAX, bestlong = INT_MAX;
+		const Geometry::Bounds *best = nullptr;
+
+		//best short side fit: choose the free rectangle that leaves the least amount of space
+		//along the shorter side, ties are broken with the longer side
+		for(auto &f : freelist) {
+			if(f.Width() < sz.Width || f.Height() < sz.Height) continue;
+
+			int dw = f.Width()  - sz.Width;
+			int dh = f.Height() - sz.Height;
+
+			int s = std::min(dw, dh), l = std::max(dw, dh);
+
+			if(s < bestshort || (s == bestshort && l < bestlong)) {
+				bestshort = s;
+				bestlong  = l;
+				best      = &f;
+			}
+		}
+
+		if(!best) return false;
+
+		location = {best->Left, best->Top, sz};
+
+		split(location);
+
+		used += sz.Area();
+
+		if(location.Right > extent.Width)
+			extent.Width = location.Right;
+
+		if(location.Bottom > extent.Height)
+			extent.Height = location.Bottom;
+
+		return true;
+	}
+
+	void AtlasPacker::Free(const Geometry::Bounds &location) {
+		used -= location.Width() * location.Height();
+
+		if(used <= 0) {
+			Reset();
+
+			return;
+		}
+
+		//free rectangles that share a complete edge with the freed area are combined with it.
+		//Without this, free list grows with every removal and placement slows down
+		auto r = location;
+		bool merged;
+
+		do {
+			merged = false;
+
+			for(unsigned i=0; i<freelist.size(); i++) {
+				auto &f = freelist[i];
+
+				if(f.Left == r.Left && f.Right == r.Right && f.Top <= r.Bottom && r.Top <= f.Bottom) {
+					r.Top    = std::min(r.Top, f.Top);
+					r.Bottom = std::max(r.Bottom, f.Bottom);
+				}
+				else if(f.Top == r.Top && f.Bottom == r.Bottom && f.Left <= r.Right && r.Left <= f.Right) {
+					r.Left  = std::min(r.Left, f.Left);
+					r.Right = std::max(r.Right, f.Right);
+				}
+				else {
+					continue;
+				}
+
+				freelist[i] = freelist.back();
+				freelist.pop_back();
+				merged = true;
+				break;
+			}
+		} while(merged);
+
+		std::vector<Geometry::Bounds> added = {r};
+		prune(added);
+	}
+
+	void AtlasPacker::split(const Geometry::Bounds &u) {
+		std::vector<Geometry::Bounds> added;
+
+		for(unsigned i=0; i<freelist.size(); ) {
+			auto f = freelist[i];
+
+			if(f.Left >= u.Right || f.Right <= u.Left || f.Top >= u.Bottom || f.Bottom <= u.Top) {
+				i++;
+				continue;
+			}
+
+			//remaining parts of the free rectangle. These parts overlap each other so that
+			//every free rectangle is as large as possible
+			if(u.Left > f.Left)
+				added.push_back({f.Left, f.Top, u.Left, f.Bottom});
+
+			if(u.Right < f.Right)
+				added.push_back({u.Right, f.Top, f.Right, f.Bottom});
+
+			if(u.Top > f.Top)
+				added.push_back({f.Left, f.Top, f.Right, u.Top});
+
+			if(u.Bottom < f.Bottom)
+				added.push_back({f.Left, u.Bottom, f.Right, f.Bottom});
+
+			freelist[i] = freelist.back();
+			freelist.pop_back();
+		}
+
+		prune(added);
+	}
+
+	void AtlasPacker::prune(std::vector<Geometry::Bounds> &added) {
+		//only the new rectangles are checked, existing ones are already pruned against
+		//each other
+		for(unsigned i=0; i<added.size(); ) {
+			bool contained = false;
+
+			for(unsigned j=0; j<added.size(); j++) {
+				if(i != j && Geometry::Contains(added[j], added[i]) && (added[j] != added[i] || j < i)) {
+					contained = true;
+					break;
+				}
+			}
+
+			if(!contained) {
+				for(unsigned j=0; j<freelist.size(); ) {
+					if(Geometry::Contains(freelist[j], added[i])) {
+						contained = true;
+						break;
+					}
+
+					if(Geometry::Contains(added[i], freelist[j])) {
+						freelist[j] = freelist.back();
+						freelist.pop_back();
+					}
+					else {
+						j++;
+					}
+				}
+			}
+
+			if(contained) {
+				added[i] = added.back();
+				added.pop_back();
+			}
+			else {
+				i++;
+			}
+		}
+
+		freelist.insert(freelist.end(), added.begin(), added.end());
+	}
+
+
+	AtlasManager::page::page(const Geometry::Size &size, ColorMode mode) :
+		mode(mode), shadow(size, mode), packer(size)
+	{
+		shadow.Clear();
+		texture = GL::GenerateTexture(shadow);
+	}
+
+	AtlasManager::page::~page() {
+		GL::DestroyTexture(texture);
+	}
+
+	const TextureImage &AtlasManager::Add(const Containers::Image &image) {
+		std::unique_ptr<TextureImage> img(new TextureImage);
+		auto &ret = *img;
+
+		place(image, ret, std::move(img));
+
+		return ret;
+	}
+
+	void AtlasManager::Add(const Containers::Image &image, Texture &target) {
+		Remove(target);
+
+		place(image, target, nullptr);
+	}
+
+	void AtlasManager::place(const Containers::Image &image, Texture &target, std::unique_ptr<TextureImage> owned) {
+		if(!CanPlace(image.GetSize()))
+			throw std::runtime_error("Image is larger than the atlas page");
+
+		Geometry::Size size = {image.GetWidth() + margin*2, image.GetHeight() + margin*2};
+
+		int p;
+		Geometry::Bounds location;
+
+		if(!findplace(size, image.GetMode(), p, location, true)) {
+			Defragment();
+
+			if(!findplace(size, image.GetMode(), p, location, true))
+				throw std::runtime_error("Atlas is full");
+		}
+
+		upload(p, image, location);
+
+		auto &e    = entries[&target];
+		e.page     = p;
+		e.location = location;
+		e.target   = &target;
+		e.owned    = std::move(owned);
+
+		pages[p]->count++;
+
+		bind(e);
+	}
+
+	bool AtlasManager::findplace(const Geometry::Size &size, ColorMode mode, int &p, Geometry::Bounds &location, bool limit) {
+		int modepages = 0;
+
+		for(int i=0; i<(int)pages.size(); i++) {
+			if(pages[i]->mode != mode) continue;
+
+			modepages++;
+
+			if(pages[i]->packer.Place(size, location)) {
+				p = i;
+
+				return true;
+			}
+		}
+
+		if(limit && maxpages && modepages >= maxpages)
+			return false;
+
+		pages.emplace_back(new page(pagesize, mode));
+		p = (int)pages.size() - 1;
+
+		return pages.back()->packer.Place(size, location);
+	}
+
+	void AtlasManager::upload(int p, const Containers::Image &image, const Geometry::Bounds &location) {
+		auto &pg  = *pages[p];
+		int cpp   = (int)pg.shadow.GetChannelsPerPixel();
+		int width = pg.shadow.GetWidth();
+
+		//clear margins as they might contain pixels from a removed image
+		for(int y=location.Top; y<location.Bottom; y++) {
+			memset(pg.shadow.RawData() + (y * width + location.Left) * cpp, 0, location.Width() * cpp);
+		}
+
+		image.CopyTo(pg.shadow, {location.Left + margin, location.Top + margin});
+
+		GL::CopyToTexture(pg.texture, pg.shadow, location, location.TopLeft());
+	}
+
+	void AtlasManager::bind(entry &e) {
+		auto &pg = *pages[e.page];
+
+		e.target->Set(pg.texture, pg.mode, pagesize, {
+			e.location.Left  + margin, e.location.Top    + margin,
+			e.location.Right - margin, e.location.Bottom - margin
+		});
+	}
+
+	bool AtlasManager::Remove(const Texture &texture) {
+		auto it = entries.find(&texture);
+
+		if(it == entries.end())
+			return false;
+
+		auto &pg = *pages[it->second.page];
+
+		pg.packer.Free(it->second.location);
+		pg.count--;
+
+		entries.erase(it);
+
+		return true;
+	}
+
+	void AtlasManager::Rebind(const Texture &from, Texture &to) {
+		auto it = entries.find(&from);
+
+		if(it == entries.end())
+			throw std::runtime_error("Texture is not in the atlas");
+
+		auto e = std::move(it->second);
+		entries.erase(it);
+
+		e.target = &to;
+		entries[&to] = std::move(e);
+	}
+
+	bool AtlasManager::CopyImage(const Texture &texture, Containers::Image &target) const {
+		auto it = entries.find(&texture);
+
+		if(it == entries.end())
+			return false;
+
+		auto &pg = *pages[it->second.page];
+		auto &l  = it->second.location;
+
+		target.Resize({l.Width() - margin*2, l.Height() - margin*2}, pg.mode);
+		pg.shadow.CopyTo(target, {l.Left + margin, l.Top + margin, l.Right - margin, l.Bottom - margin});
+
+		return true;
+	}
+
+	void AtlasManager::Defragment() {
+		std::vector<std::unique_ptr<page>> old;
+		std::swap(old, pages);
+
+		std::vector<entry *> list;
+		list.reserve(entries.size());
+
+		for(auto &p : entries)
+			list.push_back(&p.second);
+
+		//larger images first, this results in tighter packing
+		std::sort(list.begin(), list.end(), [](const entry *l, const entry *r) {
+			auto la = l->location.Width() * l->location.Height();
+			auto ra = r->location.Width() * r->location.Height();
+
+			if(la == ra)
+				return l->location.Height() > r->location.Height();
+			else
+				return la > ra;
+		});
+
+		for(auto e : list) {
+			auto &src = *old[e->page];
+
+			int p;
+			Geometry::Bounds location;
+
+			findplace(e->location.GetSize(), src.mode, p, location, false);
+
+			src.shadow.CopyTo(pages[p]->shadow, e->location, location.TopLeft());
+			pages[p]->count++;
+
+			e->page     = p;
+			e->location = location;
+		}
+
+		for(auto &p : pages)
+			GL::UpdateTexture(p->texture, p->shadow);
+
+		for(auto e : list)
+			bind(*e);
+	}
+
+	void AtlasManager::Clear() {
+		entries.clear();
+		pages.clear();
+	}
+
+	float AtlasManager::GetOccupancy() const {
+		if(pages.empty()) return 0.f;
+
+		long used = 0;
+
+		for(auto &p : pages)
+			used += p->packer.GetUsedArea();
+
+		return float(used) / (pagesize.Area() * pages.size());
+	}
+
+} }
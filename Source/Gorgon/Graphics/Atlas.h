@@ -0,0 +1,201 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <memory>
+
+#include "../Geometry/Size.h"
+#include "../Geometry/Bounds.h"
+#include "../Containers/Image.h"
+#include "Animations.h"
+#include "Texture.h"
+
+namespace Gorgon { namespace Graphics {
+
+	/**
+	 * Packs rectangles into a fixed size area using MaxRects algorithm with best short side
+	 * fit heuristic. This class only performs book keeping and does not require a GL context,
+	 * therefore, it can be used for offline packing. Freed areas are returned to the free list
+	 * and can be reused. Freeing may cause fragmentation, in this case the packer should be
+	 * reset and all rectangles should be placed again.
+	 */
+	class AtlasPacker {
+	public:
+		/// Creates a new packer that will place rectangles into the given area
+		explicit AtlasPacker(const Geometry::Size &size);
+
+		/// Places a rectangle of the given size. Returns false if there is no room for the given
+		/// size. Location is set only if the rectangle is placed.
+		bool Place(const Geometry::Size &size, Geometry::Bounds &location);
+
+		/// Returns the given area back to the free list. The area should be obtained from Place
+		/// function and should not be freed more than once.
+		void Free(const Geometry::Bounds &location);
+
+		/// Removes all placed rectangles
+		void Reset();
+
+		/// Returns the size of the area rectangles are packed in
+		Geometry::Size GetSize() const {
+			return size;
+		}
+
+		/// Returns the total area of the placed rectangles
+		long GetUsedArea() const {
+			return used;
+		}
+
+		/// Returns the size of the smallest area that contains all rectangles placed since the
+		/// last reset.
+		Geometry::Size GetExtent() const {
+			return extent;
+		}
+
+		/// Returns the ratio of the used area to the total area
+		float GetOccupancy() const {
+			return size.Area() ? float(used) / size.Area() : 0.f;
+		}
+
+	private:
+		void split(const Geometry::Bounds &used);
+		void prune(std::vector<Geometry::Bounds> &added);
+
+		Geometry::Size size;
+		Geometry::Size extent = {0, 0};
+		std::vector<Geometry::Bounds> freelist;
+		long used = 0;
+	};
+
+	/**
+	 * Manages shared texture pages that small images are packed into. Using an atlas for small
+	 * images such as icons, widget skins and glyphs reduces texture switches and allows
+	 * consecutive draws to be batched. Each page contains images of a single color mode. A copy
+	 * of every page is kept in the memory so that pages can be defragmented without reading
+	 * back from the GL.
+	 *
+	 * Images can either be added to the atlas directly, in which case the returned TextureImage
+	 * is owned by the manager, or can be bound to an existing Texture. In both cases, the texture
+	 * is updated in place when the image is relocated during defragmentation. Bound textures
+	 * should be removed from the atlas before they are destroyed. Bitmap::Prepare(AtlasManager &)
+	 * handles this automatically.
+	 */
+	class AtlasManager {
+	public:
+		/// Creates a new atlas manager. Margin is left around every image to prevent bleeding
+		/// while images are drawn scaled. If maxpages is not 0, no more than the given number of
+		/// pages will be created for each color mode, when the pages are full, atlas is
+		/// defragmented before giving up.
+		explicit AtlasManager(const Geometry::Size &pagesize = {1024, 1024}, int margin = 1, int maxpages = 0) :
+			pagesize(pagesize), margin(margin), maxpages(maxpages)
+		{ }
+
+		AtlasManager(const AtlasManager &) = delete;
+
+		AtlasManager &operator =(const AtlasManager &) = delete;
+
+		/// Destroys all pages. Textures obtained from this manager should not be used afterwards.
+		~AtlasManager() {
+			Clear();
+		}
+
+		/// Adds the given image to the atlas and returns a texture image that points to the
+		/// region of the image. Returned image is owned by the manager and stays valid until it is
+		/// removed. Throws if the image is larger than a page or if the atlas is full.
+		const TextureImage &Add(const Containers::Image &image);
+
+		/// Adds the given image to the atlas and sets the given texture to point to the region
+		/// of the image. The target texture will be updated if the image is relocated. If the
+		/// target is already in the atlas, its image will be replaced. Throws if the image is
+		/// larger than a page or if the atlas is full.
+		void Add(const Containers::Image &image, Texture &target);
+
+		/// Evicts the given texture from the atlas, freeing its area for other images. Returns
+		/// false if the texture is not in this atlas.
+		bool Remove(const Texture &texture);
+
+		/// Changes the texture that is bound to an image in the atlas. This is necessary when a
+		/// bound texture is moved. The target texture should not be in the atlas.
+		void Rebind(const Texture &from, Texture &to);
+
+		/// Copies the image of the given texture back from the atlas. This works even if the
+		/// source image is discarded. Returns false if the texture is not in this atlas.
+		bool CopyImage(const Texture &texture, Containers::Image &target) const;
+
+		/// Returns if the given texture is in this atlas
+		bool Contains(const Texture &texture) const {
+			return entries.count(&texture) != 0;
+		}
+
+		/// Returns whether an image of the given size can be placed in this atlas.
+		bool CanPlace(const Geometry::Size &size) const {
+			return size.Width + margin*2 <= pagesize.Width && size.Height + margin*2 <= pagesize.Height;
+		}
+
+		/// Repacks all images in the atlas to reclaim the area fragmented by removals. Images
+		/// are packed from the largest to the smallest. Textures are updated in place. Pages that
+		/// are no longer necessary are destroyed.
+		void Defragment();
+
+		/// Removes all images and destroys all pages.
+		void Clear();
+
+		/// Returns the number of pages
+		int GetPageCount() const {
+			return (int)pages.size();
+		}
+
+		/// Returns the number of images in the atlas
+		int GetImageCount() const {
+			return (int)entries.size();
+		}
+
+		/// Returns the GL texture of the given page
+		GL::Texture GetPageTexture(int page) const {
+			return pages[page]->texture;
+		}
+
+		/// Returns the size of the pages
+		Geometry::Size GetPageSize() const {
+			return pagesize;
+		}
+
+		/// Returns the ratio of the used area to the total area of all pages
+		float GetOccupancy() const;
+
+	private:
+		struct page {
+			page(const Geometry::Size &size, ColorMode mode);
+
+			~page();
+
+			ColorMode mode;
+			GL::Texture texture = 0;
+			Containers::Image shadow;
+			AtlasPacker packer;
+			int count = 0;
+		};
+
+		struct entry {
+			int page;
+			Geometry::Bounds location;
+			Texture *target;
+			std::unique_ptr<TextureImage> owned;
+		};
+
+		void place(const Containers::Image &image, Texture &target, std::unique_ptr<TextureImage> owned);
+
+		bool findplace(const Geometry::Size &size, ColorMode mode, int &page, Geometry::Bounds &location, bool limit);
+
+		void upload(int page, const Containers::Image &image, const Geometry::Bounds &location);
+
+		void bind(entry &e);
+
+		Geometry::Size pagesize;
+		int margin;
+		int maxpages;
+
+		std::vector<std::unique_ptr<page>> pages;
+		std::map<const Texture *, entry> entries;
+	};
+
+} }
@@ -1,4 +1,5 @@
 #include "Bitmap.h"
+#include "Atlas.h"
 
 #include <fstream>
 #include <algorithm>
@@ -13,10 +14,56 @@ namespace Gorgon { namespace Graphics {
 	
 	void Bitmap::Prepare() {
 		if(data) {
+			releaseatlas();
 			Graphics::Texture::Set(*data);
 		}
 	}
 
+	void Bitmap::Prepare(AtlasManager &atlas) {
+		if(data) {
+			releaseatlas();
+			Graphics::Texture::Destroy();
+
+			atlas.Add(*data, *this);
+			this->atlas = &atlas;
+		}
+	}
+
+	bool Bitmap::CopyFromAtlas(Containers::Image &target) const {
+		if(!atlas)
+			return false;
+
+		return atlas->CopyImage(*this, target);
+	}
+
+	void Bitmap::releaseatlas() {
+		if(atlas) {
+			atlas->Remove(*this);
+			atlas = nullptr;
+
+			Graphics::Texture::Release();
+		}
+	}
+
+	void Bitmap::swapatlas(Bitmap &other) {
+		//atlas entries are bound to the texture objects, after swapping textures, bindings
+		//should be exchanged as well
+		if(atlas && atlas == other.atlas) {
+			Texture temp;
+
+			atlas->Rebind(other, temp);
+			atlas->Rebind(*this, other);
+			atlas->Rebind(temp, *this);
+		}
+		else {
+			if(other.atlas)
+				other.atlas->Rebind(*this, other);
+
+			if(atlas)
+				atlas->Rebind(other, *this);
+		}
+	}
+
 	void Bitmap::Discard() {
 		delete data;
 		data=nullptr;
@@ -321,6 +368,7 @@ namespace Gorgon { namespace Graphics {
 				return;
 			}
 			else if(mode == ColorMode::Alpha) {
+				releaseatlas();
 				this->data->ChangeMode(ColorMode::Grayscale);
 
 				return;
@@ -797,11 +845,11 @@ namespace Gorgon { namespace Graphics {
         if(factor <= 0)
             throw std::runtime_error("Zoom factor is invalid.");
         
-		Graphics::Bitmap target(GetWidth() * factor, GetHeight() * factor, GetMode());
+		Graphics::Bitmap target;
         
-        target.ForAllPixels([&](int x, int y, int c) {
-            target(x, y, c) = (*data)(x / factor, y / factor, c);
-        });
+        //nearest neighbor copies whole pixels and repeated rows
+        target.Resize({GetWidth() * factor, GetHeight() * factor}, GetMode());
+        data->Scale(target.GetData(), target.GetSize(), Containers::InterpolationMethod::NearestNeighbor);
         
         return target;
     }
@@ -13,6 +13,7 @@
 
 namespace Gorgon { namespace Graphics {
 
+	class AtlasManager;
 
     /**
 	 * This object contains an bitmap image. It allows draw, load, import, export functionality. An image may work
@@ -91,6 +92,9 @@ namespace Gorgon { namespace Graphics {
 			swap(data, other.data);
 
 			Graphics::Texture::Swap(other);
+
+			swap(atlas, other.atlas);
+			swapatlas(other);
 		}
 		
         //types are derived not to type the same code for every class
@@ -106,6 +110,7 @@ namespace Gorgon { namespace Graphics {
 		/// Move assignment
 		Bitmap &operator =(Bitmap &&other) {
 			Discard();
+			releaseatlas();
 			Graphics::Texture::Destroy();
 
 			Swap(other);
@@ -127,6 +132,7 @@ namespace Gorgon { namespace Graphics {
 
 		/// Destroys the contained data, including the texture
 		void Destroy() {
+			releaseatlas();
 			Texture::Destroy();
 			delete data;
 			data=nullptr;
@@ -134,6 +140,7 @@ namespace Gorgon { namespace Graphics {
 
 		/// Destroys image data
 		virtual ~Bitmap() {
+			releaseatlas();
 			delete data;
 		}
 		
@@ -185,6 +192,8 @@ namespace Gorgon { namespace Graphics {
 		/// Notice that changing data does not prepare the data to be drawn, a separate call to Prepare 
 		/// function is necessary
 		void Assign(const Containers::Image &image) {
+			releaseatlas();
+
 			if(!data) {
 				data=new Containers::Image;
 			}
@@ -202,6 +211,8 @@ namespace Gorgon { namespace Graphics {
 		/// Notice that changing data does not prepare the data to be drawn, a separate call to Prepare 
 		/// function is necessary.
 		void Assign(Byte *newdata, const Geometry::Size &size, Graphics::ColorMode mode) {
+			releaseatlas();
+
 			if(!data) {
 				data=new Containers::Image;
 			}
@@ -221,12 +232,16 @@ namespace Gorgon { namespace Graphics {
 				throw std::runtime_error("Data is not set");
 			}
 
+			releaseatlas();
+
 			data->Assign(newdata);
 		}
 
 		/// Assumes the contents of the given image as image data. Notice that assuming data does not prepare the data to be drawn, 
 		/// a separate call to Prepare function is necessary.
 		void Assume(Containers::Image &image) {
+			releaseatlas();
+
 			delete data;
 			data = &image;
 		}
@@ -234,6 +249,8 @@ namespace Gorgon { namespace Graphics {
 		/// Assumes the contents of the given image as image data by moving it into the bitmap buffer. Notice that assuming data 
 		/// does not prepare the data to be drawn, a separate call to Prepare function is necessary.
 		void Assume(Containers::Image &&image) {
+			releaseatlas();
+
 			if(!data) {
 				data=new Containers::Image;
 			}
@@ -250,6 +267,8 @@ namespace Gorgon { namespace Graphics {
 		/// the image is empty, therefore it could be specified as any value. Notice that assuming data
 		/// does not prepare the data to be drawn, a separate call to Prepare function is necessary.
 		void Assume(Byte *newdata, const Geometry::Size &size, Graphics::ColorMode mode) {
+			releaseatlas();
+
 			if(!data) {
 				data=new Containers::Image;
 			}
@@ -266,12 +285,16 @@ namespace Gorgon { namespace Graphics {
 				throw std::runtime_error("Data is not set");
 			}
 
+			releaseatlas();
+
 			data->Assume(newdata);
 		}
 
 		/// Resizes the image to the given size and color mode. This function discards the contents
 		/// of the image and does not perform any initialization.
 		void Resize(const Geometry::Size &size, Graphics::ColorMode mode=Graphics::ColorMode::RGBA) {
+			releaseatlas();
+
 			if(!data) {
 				data=new Containers::Image;
 			}
@@ -427,6 +450,20 @@ namespace Gorgon { namespace Graphics {
 		/// This function prepares image for drawing
 		virtual void Prepare();
 
+		/// Prepares this image for drawing by packing it into the given atlas instead of creating a
+		/// separate texture. The image is removed from the atlas when it is destroyed, prepared
+		/// again or its data is replaced. The atlas should outlive this image.
+		void Prepare(AtlasManager &atlas);
+
+		/// Returns the atlas this image is prepared in, nullptr if it is not in an atlas.
+		AtlasManager *GetAtlas() const {
+			return atlas;
+		}
+
+		/// Copies the image back from the atlas this image is prepared in. This works even if
+		/// the data is discarded. Returns false if the image is not in an atlas.
+		bool CopyFromAtlas(Containers::Image &target) const;
+
 		/// This function discards image data
 		virtual void Discard();
 
@@ -710,14 +747,14 @@ namespace Gorgon { namespace Graphics {
             return ret;
         }
 
-        /// Scales this bitmap as a new one using the supplied interpolation method. If the size is reduced more
-        /// than twice, integer part of the size reduction is done using area interpolation.
+        /// Scales this bitmap as a new one using the supplied interpolation method. While shrinking, the filter
+        /// covers all the source pixels, use Area method for the best quality thumbnails.
 		Bitmap Scale(int width, int height, Containers::InterpolationMethod method = Containers::InterpolationMethod::Cubic) const {        
 			return Scale({width, height}, method);
 		}
 
-        /// Scales this bitmap as a new one using the supplied interpolation method. If the size is reduced more
-        /// than twice, integer part of the size reduction is done using area interpolation.
+        /// Scales this bitmap as a new one using the supplied interpolation method. While shrinking, the filter
+        /// covers all the source pixels, use Area method for the best quality thumbnails.
 		Bitmap Scale(const Geometry::Size &newsize, Containers::InterpolationMethod method = Containers::InterpolationMethod::Cubic) const {        
 			ASSERT(data, "Bitmap data is not set");
 
@@ -727,6 +764,16 @@ namespace Gorgon { namespace Graphics {
 			return ret;
 		}
 
+        /// Scales this bitmap into the given target using the supplied interpolation method. The data of the
+        /// target is reused if it already has the correct size. Target should be prepared again before drawing.
+		void Scale(Bitmap &target, const Geometry::Size &newsize, Containers::InterpolationMethod method = Containers::InterpolationMethod::Cubic) const {
+			ASSERT(data, "Bitmap data is not set");
+			ASSERT(&target != this, "Target cannot be the same bitmap");
+
+			target.Resize(newsize, GetMode());
+			data->Scale(target.GetData(), newsize, method);
+		}
+
         /// Rotates this bitmap as a new one using the supplied interpolation method.
 		Bitmap Rotate(Float ang, const Geometry::Pointf &origin, Containers::InterpolationMethod method = Containers::InterpolationMethod::Cubic) const {       
 			ASSERT(data, "Bitmap data is not set");
@@ -849,6 +896,18 @@ namespace Gorgon { namespace Graphics {
 
 		/// Container for the image data, could be null indicating its discarded
 		Containers::Image *data = nullptr;
+
+		/// The atlas that contains the texture of this image
+		AtlasManager *atlas = nullptr;
+
+	private:
+		/// Removes this image from its atlas
+		void releaseatlas();
+
+		/// Fixes atlas bindings after textures are swapped
+		void swapatlas(Bitmap &other);
+
+	protected:
 		
 		using Texture::size;
 	};
@@ -35,6 +35,8 @@ namespace Gorgon { namespace Graphics {
         underlinepos = other.underlinepos;
 
         linegap = other.linegap;
+        
+        other.revision++;
     }
 
     void BitmapFont::AddGlyph(Glyph glyph, const RectangularDrawable& bitmap, Geometry::Pointf offset, float advance) {
@@ -59,6 +61,8 @@ namespace Gorgon { namespace Graphics {
 			isascii = false;
         
         glyphmap[glyph] = GlyphDescriptor(bitmap, offset, advance);
+        
+        revision++;
     }
 
 
@@ -125,6 +129,8 @@ namespace Gorgon { namespace Graphics {
 		underlinepos = (int)std::round(baseline + linethickness + 1);
         
         linegap = std::round(height * 1.2f);
+        
+        revision++;
 	}
 	
 
@@ -1000,6 +1006,8 @@ namespace Gorgon { namespace Graphics {
             }
             
             glyphmap.erase(g);
+            
+            revision++;
         }
     }
 
@@ -1118,6 +1126,9 @@ namespace Gorgon { namespace Graphics {
         underlinepos = other.underlinepos;
 
         linegap = other.linegap;
+        
+        revision++;
+        other.revision++;
 
         return *this;
     }
@@ -179,10 +179,12 @@ namespace Gorgon { namespace Graphics {
 		
 		void SetKerning(Glyph left, Glyph right, Geometry::Pointf kern) {
             kerning[{left, right}] = kern;
+            revision++;
         }
 		
 		void SetKerning(Glyph left, Glyph right, float x) {
             kerning[{left, right}] = {x, 0.f};
+            revision++;
         }
 
         /// Converts individual glyphs to a single atlas. Only the glyphs that are registered as bitmaps can be packed.
@@ -234,12 +236,14 @@ namespace Gorgon { namespace Graphics {
 		virtual float GetLineThickness() const override { return (float)linethickness; }
 
 		virtual int GetUnderlineOffset() const override { return underlinepos; }
+        
+        virtual unsigned long GetRevision() const override { return revision; }
 
 		/// Changes the line height of the font. Adding glyphs may override this value.
-		void SetHeight(int value) { height = value; }
+		void SetHeight(int value) { height = value; revision++; }
 
 		/// Changes the maximum width for a character. Adding glyphs may override this value.
-		void SetMaxWidth(int value) { maxwidth = value; }
+		void SetMaxWidth(int value) { maxwidth = value; revision++; }
 
 		/// Searches through the currently registered glyphs to determine dimensions. This 
 		/// function will calculate following values: height, max width, underline offset.
@@ -247,7 +251,7 @@ namespace Gorgon { namespace Graphics {
 		void DetermineDimensions();
         
         /// Changes the spacing between glyphs
-        void SetGlyphSpacing(int value) { spacing = value; }
+        void SetGlyphSpacing(int value) { spacing = value; revision++; }
 		
 		/// Returns the spacing between glyphs
 		int GetGlyphSpacing() const { return spacing; }
@@ -259,10 +263,10 @@ namespace Gorgon { namespace Graphics {
 		void SetUnderlineOffset(int value) { underlinepos = value; }
 		
 		/// Changes the baseline. Might cause problems if the font already has glyphs in it.
-		void SetBaseline(float value) { baseline = value; }
+		void SetBaseline(float value) { baseline = value; revision++; }
 		
 		/// Changes the distance between two lines. Non-integer values are not recommended.
-		void SetLineGap(float value) { linegap = value; }
+		void SetLineGap(float value) { linegap = value; revision++; }
         
         /// Imports bitmap font images from a folder with the specified file naming template.
         /// Automatic detection will only work if there is a single bitmap font set in the
@@ -431,6 +435,8 @@ namespace Gorgon { namespace Graphics {
 		int underlinepos = 0;
         
         float linegap = 0;
+        
+        unsigned long revision = 0;
     };
     
 } }
@@ -540,6 +540,48 @@ namespace Gorgon { namespace Graphics {
         }
 
     } //internal
+    
+    bool TextLayout::IsValid(const TextPrinter &printer, const std::string &text, int width, TextAlignment align, bool bounded) const {
+        if(this->printer != &printer || revision != printer.GetLayoutRevision() || !matches(text, width, align, bounded))
+            return false;
+        
+        if(!printer.IsReady())
+            return renderer == nullptr;
+        
+        auto &current = printer.GetGlyphRenderer();
+        
+        return renderer == &current && rendererrevision == current.GetRevision();
+    }
+    
+    void TextPrinter::layouttext(TextLayout &layout, const std::string &text, int width, TextAlignment align, bool bounded) const {
+        layout.Clear();
+        
+        layout.printer  = this;
+        layout.revision = GetLayoutRevision();
+        
+        if(IsReady()) {
+            layout.renderer         = &GetGlyphRenderer();
+            layout.rendererrevision = layout.renderer->GetRevision();
+        }
+        
+        layout.text     = text;
+        layout.width    = width;
+        layout.align    = align;
+        layout.bounded  = bounded;
+        
+        dolayout(layout, text, width, align, bounded);
+    }
+    
+    void TextPrinter::dolayout(TextLayout &layout, const std::string &text, int width, TextAlignment, bool bounded) const {
+        layout.SetSize(bounded ? GetSize(text, width) : GetSize(text));
+    }
+    
+    void TextPrinter::printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Point location) const {
+        if(layout.IsBounded())
+            print(target, layout.GetText(), {location, layout.GetWidth(), 0}, layout.GetAlignment());
+        else
+            print(target, layout.GetText(), location);
+    }
 
     
     Geometry::Size BasicPrinter::GetSize(const std::string& text) const {
@@ -810,97 +852,123 @@ namespace Gorgon { namespace Graphics {
     }
     
     void BasicPrinter::print(TextureTarget& target, const std::string& text, Geometry::Point location, RGBAf color) const {
-        if(renderer->NeedsPrepare())
-            renderer->Prepare(text);
-        
-        auto cur = location;
+        auto &layout = cache.Get(*this, text, 0, TextAlignment::Left, false, [&](TextLayout &l) { 
+            Layout(l, text); 
+        });
         
-        internal::simpleprint(
-            *renderer, text.begin(), text.end(),
-            [&](Glyph prev, Glyph next) { return int(renderer->KerningDistance(prev, next).X); },
-            [&](Glyph g) { return (int)renderer->GetCursorAdvance(g);  },
-            [&](Glyph g, int poff, float off) { cur.X += poff; if(g != '\t') renderer->Render(g, target, cur, color); cur.X += (int)off; },
-            std::bind(&internal::dodefaulttab<int>, location.X, std::ref(cur.X), renderer->GetEMSize() * 4),
-            [&](Glyph) { cur.Y += (int)renderer->GetLineGap(); cur.X = location.X; }
-        );
+        printlayout(target, layout, location, color);
     }
 
     void BasicPrinter::print(TextureTarget &target, const std::string &text, Geometry::Rectangle location, TextAlignment align, RGBAf color) const {
+        auto &layout = cache.Get(*this, text, location.Width, align, true, [&](TextLayout &l) { 
+            Layout(l, text, location.Width, align); 
+        });
+        
+        printlayout(target, layout, location.TopLeft(), color);
+    }
+    
+    void BasicPrinter::dolayout(TextLayout &layout, const std::string &text, int width, TextAlignment align, bool bounded) const {
         if(renderer->NeedsPrepare())
             renderer->Prepare(text);
         
-        auto y   = location.Y;
-        auto tot = location.Width;
+        if(!bounded) {
+            auto cur = Geometry::Point(0, 0);
+            
+            int maxx = 0;
+            
+            internal::simpleprint(
+                *renderer, text.begin(), text.end(),
+                [&](Glyph prev, Glyph next) { return int(renderer->KerningDistance(prev, next).X); },
+                [&](Glyph g) { return (int)renderer->GetCursorAdvance(g);  },
+                [&](Glyph g, int poff, float off) { cur.X += poff; if(g != '\t') layout.AddGlyph(g, cur); cur.X += (int)off; },
+                std::bind(&internal::dodefaulttab<int>, 0, std::ref(cur.X), renderer->GetEMSize() * 4),
+                [&](Glyph) { cur.Y += (int)renderer->GetLineGap(); if(maxx < cur.X) maxx = cur.X; cur.X = 0; }
+            );
+            
+            layout.SetSize({maxx, cur.Y});
+            
+            return;
+        }
+        
+        auto y   = 0;
+        int maxx = 0;
 
         internal::boundedprint(
-            *renderer, text.begin(), text.end(), tot,
+            *renderer, text.begin(), text.end(), width,
 
             [&](Glyph, internal::markvecit begin, internal::markvecit end, int w) {
-                auto off = location.X;
+                auto off = 0;
 
                 if(align == TextAlignment::Center) {
-                    off += (int)std::round((tot - w) / 2.f);
+                    off += (int)std::round((width - w) / 2.f);
                 }
                 else if(align == TextAlignment::Right) {
-                    off += tot - w;
+                    off += width - w;
                 }
 
                 for(auto it = begin; it != end; ++it) {
                     if(it->g != '\t')
-                        renderer->Render(it->g, target, {(float)it->location + off, (float)y}, color);
+                        layout.AddGlyph(it->g, {(float)it->location + off, (float)y});
                 }
 
                 y += (int)renderer->GetLineGap();
+                
+                if(maxx < w)
+                    maxx = w;
             },
 
             [&](Glyph prev, Glyph next) { return int(renderer->KerningDistance(prev, next).X); },
             [&](Glyph g) { return (int)renderer->GetCursorAdvance(g);  },
             std::bind(&internal::dodefaulttab<int>, 0, std::placeholders::_1, renderer->GetEMSize() * 4)
         );
+        
+        layout.SetSize({maxx, y});
+    }
+    
+    void BasicPrinter::printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Point location, RGBAf color) const {
+        Geometry::Pointf offset = location;
+        
+        for(auto &g : layout.GetGlyphs())
+            renderer->Render(g.glyph, target, g.location + offset, color);
     }
 
     void StyledPrinter::print(TextureTarget &target, const std::string &text, Geometry::Point location) const {
+        auto &layout = cache.Get(*this, text, 0, TextAlignment::Left, false, [&](TextLayout &l) { 
+            Layout(l, text); 
+        });
+        
+        printlayout(target, layout, location);
+    }
+    
+    void StyledPrinter::printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Point location) const {
         if(shadow.type == TextShadow::Flat) {
-            print(target, text, Geometry::Pointf(location) + shadow.offset, shadow.color, shadow.color, shadow.color);
+            printlayout(target, layout, Geometry::Pointf(location) + shadow.offset, shadow.color, shadow.color, shadow.color);
         }
 
-        print(target, text, location, color, strikecolor, underlinecolor);
+        printlayout(target, layout, location, color, strikecolor, underlinecolor);
     }
 
-    void StyledPrinter::print(TextureTarget &target, const std::string &text, Geometry::Pointf location, 
-                               RGBAf color, RGBAf strikecolor, RGBAf underlinecolor) const {
-        if(renderer->NeedsPrepare())
-            renderer->Prepare(text);
-        
-        //strike through, underline
-        auto cur = location;
-
+    void StyledPrinter::printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Pointf location, 
+                                    RGBAf color, RGBAf strikecolor, RGBAf underlinecolor) const {
         if(strikecolor.R == -1)
             strikecolor = color;
 
         if(underlinecolor.R == -1)
             underlinecolor = color;
-
-        internal::simpleprint(
-            *renderer, text.begin(), text.end(),
-            [&](Glyph prev, Glyph next) { return int(hspace + renderer->KerningDistance(prev, next).X); },
-            [&](Glyph g) { return (int)renderer->GetCursorAdvance(g);  },
-            [&](Glyph g, int poff, float off) { cur.X += poff; renderer->Render(g, target, cur, color); cur.X += (int)off; },
-            std::bind(&internal::dodefaulttab<float>, location.X, std::ref(cur.X), (float)tabwidth),
-            [&](Glyph) { 
-                if(strike) {
-                    target.Draw(location.X, cur.Y + GetStrikePosition(), cur.X - location.X, (float)renderer->GetLineThickness(), strikecolor);
-                }
-
-                if(underline) {
-                    target.Draw(location.X, cur.Y + renderer->GetUnderlineOffset(), cur.X - location.X, (float)renderer->GetLineThickness(), underlinecolor);
-                }
-
-                cur.Y += (int)std::round(renderer->GetLineGap() * vspace + pspace);
-                cur.X = location.X;
+        
+        for(auto &g : layout.GetGlyphs())
+            renderer->Render(g.glyph, target, g.location + location, color);
+        
+        //strike through, underline
+        for(auto &l : layout.GetLines()) {
+            if(strike) {
+                target.Draw(location.X + l.location.X, location.Y + l.location.Y + GetStrikePosition(), l.width, (float)renderer->GetLineThickness(), strikecolor);
             }
-        );
 
+            if(underline) {
+                target.Draw(location.X + l.location.X, location.Y + l.location.Y + renderer->GetUnderlineOffset(), l.width, (float)renderer->GetLineThickness(), underlinecolor);
+            }
+        }
     }
 
     Geometry::Size StyledPrinter::GetSize(const std::string &text) const {
@@ -1332,35 +1400,55 @@ namespace Gorgon { namespace Graphics {
     }
 
     void StyledPrinter::print(TextureTarget &target, const std::string &text, Geometry::Rectangle location, TextAlignment align_override) const {
-        /*if(renderer->NeedsPrepare())
-            renderer->Prepare(text);
-        */
-        if(shadow.type == TextShadow::Flat) {
-            print(target, text, Geometry::Rectanglef(location) + shadow.offset, align_override, shadow.color, shadow.color, shadow.color);
-        }
-
-        print(target, text, location, align_override, color, strikecolor, underlinecolor);
+        auto &layout = cache.Get(*this, text, location.Width, align_override, true, [&](TextLayout &l) { 
+            Layout(l, text, location.Width, align_override); 
+        });
+        
+        printlayout(target, layout, location.TopLeft());
     }
 
-    void StyledPrinter::print(TextureTarget &target, const std::string &text, Geometry::Rectanglef location, 
-                               TextAlignment align, RGBAf color, RGBAf strikecolor, RGBAf underlinecolor) const {
+    void StyledPrinter::dolayout(TextLayout &layout, const std::string &text, int width, TextAlignment align, bool bounded) const {
         if(renderer->NeedsPrepare())
             renderer->Prepare(text);
         
-        auto y   = location.Y;
-        int tot  = (int)location.Width;
-
-        if(strikecolor.R == -1)
-            strikecolor = color;
-
-        if(underlinecolor.R == -1)
-            underlinecolor = color;
+        if(!bounded) {
+            auto cur = Geometry::Pointf(0, 0);
+            
+            float maxx = 0;
+            
+            internal::simpleprint(
+                *renderer, text.begin(), text.end(),
+                [&](Glyph prev, Glyph next) { return int(hspace + renderer->KerningDistance(prev, next).X); },
+                [&](Glyph g) { return (int)renderer->GetCursorAdvance(g);  },
+                [&](Glyph g, int poff, float off) { cur.X += poff; layout.AddGlyph(g, cur); cur.X += (int)off; },
+                std::bind(&internal::dodefaulttab<float>, 0.f, std::ref(cur.X), (float)tabwidth),
+                [&](Glyph) { 
+                    layout.AddLine({0, cur.Y}, cur.X);
+                    
+                    if(maxx < cur.X) 
+                        maxx = cur.X;
+                    
+                    cur.Y += (int)std::round(renderer->GetLineGap() * vspace + pspace);
+                    cur.X = 0;
+                }
+            );
+            
+            int y = (int)cur.Y;
+            
+            layout.SetSize({maxx > 0 ? (int)maxx : 0, y > 0 ? (y - pspace + (int)std::round(renderer->GetLineGap() * (1 - vspace))) : 0});
+            
+            return;
+        }
+        
+        auto y   = 0;
+        int tot  = width;
+        int maxx = 0;
 
         internal::boundedprint(
             *renderer, text.begin(), text.end(), tot,
 
             [&](Glyph g, internal::markvecit begin, internal::markvecit end, int w) {
-                auto off = location.X;
+                auto off = 0;
 
                 if(justify && g == 0) {
                     //count spaces and letters
@@ -1384,36 +1472,36 @@ namespace Gorgon { namespace Graphics {
                         }
                     }
 
-                    auto target = tot - w;
+                    auto extra = tot - w;
                     int gs = 0; //glyph spacing
                     int spsp = 0; //space spacing
                     int extraspsp = 0; //extra spaced spaces
 
-                    if(letters && target/letters >= 1) { //we can increase glyph spacing
-                        gs = target/letters;
+                    if(letters && extra/letters >= 1) { //we can increase glyph spacing
+                        gs = extra/letters;
                         if(gs > 1 && gs > renderer->GetHeight()/3) //1 is always usable
                             gs = renderer->GetHeight()/3;
 
-                        target -= gs*letters;
+                        extra -= gs*letters;
                     }
 
                     if(sps > 0) {
-                        spsp = target/sps;
+                        spsp = extra/sps;
 
                         //max 2em
                         if(spsp > renderer->GetHeight() * 4) {
                             spsp = renderer->GetHeight() * 4;
-                            target -= spsp*sps;
+                            extra -= spsp*sps;
                         }
                         else {
-                            target -= spsp*sps;
+                            extra -= spsp*sps;
 
-                            extraspsp = target;
-                            target = 0;
+                            extraspsp = extra;
+                            extra = 0;
                         }
                     }
 
-                    if(target == 0) {
+                    if(extra == 0) {
                         //go over all glyphs and set widths
                         int off = 0;
                         for(auto it=begin; it!=end; ++it) {
@@ -1431,10 +1519,16 @@ namespace Gorgon { namespace Graphics {
                             }
                         }
 
-                        w = tot - target;
+                        w = tot - extra;
                     }
                 }
 
+                if(w > maxx)
+                    maxx = w;
+                
+                if(justify && g == 0 && maxx < tot)
+                    maxx = tot;
+                
                 if(align == TextAlignment::Center) {
                     off += (int)std::round((tot - w) / 2.f);
                 }
@@ -1444,16 +1538,11 @@ namespace Gorgon { namespace Graphics {
 
                 for(auto it=begin; it!=end; ++it) {
                     if(it->g != '\t')
-                        renderer->Render(it->g, target, {(float)it->location + off, (float)y}, color);
+                        layout.AddGlyph(it->g, {(float)it->location + off, (float)y});
                 }
 
-                if(strike) {
-                    target.Draw((float)begin->location + off, y + GetStrikePosition(), (float)w, (float)renderer->GetLineThickness(), strikecolor);
-                }
-
-                if(underline) {
-                    target.Draw((float)begin->location + off, y + renderer->GetUnderlineOffset(), (float)w, (float)renderer->GetLineThickness(), underlinecolor);
-                }
+                if(begin != end)
+                    layout.AddLine({(float)begin->location + off, (float)y}, (float)w);
 
                 y += (int)std::round(renderer->GetLineGap() * vspace);
 
@@ -1465,6 +1554,8 @@ namespace Gorgon { namespace Graphics {
             [&](Glyph g) { return (int)renderer->GetCursorAdvance(g);  },
             std::bind(&internal::dodefaulttab<int>, 0, std::placeholders::_1, tabwidth ? tabwidth : 16)
         );
+        
+        layout.SetSize({maxx > 0 ? maxx : 0, y > 0 ?  y - pspace + (int)std::round(renderer->GetLineGap() * (1 - vspace)) : 0});
     }
 
     void BasicPrinter::printnowrap(TextureTarget& target, const std::string& text, Geometry::Rectangle location, TextAlignment align, RGBAf color) const {
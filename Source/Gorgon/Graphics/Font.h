@@ -2,6 +2,11 @@
 
 #include <stdint.h>
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <functional>
 #include <limits.h>
 
 #include "../Types.h"
@@ -292,6 +297,235 @@ namespace Gorgon { namespace Graphics {
         /// Notifies glyph renderer about a text to be rendered. If renderers require modification
         /// to their internal structures, they should mark them 
         virtual void Prepare(const std::string &) const { }
+        
+        /// Should return a number that changes whenever glyphs or metrics change in a way that
+        /// would place already laid out text differently. Text layouts are recreated when this
+        /// number changes.
+        virtual unsigned long GetRevision() const { return 0; }
+    };
+    
+    class TextPrinter;
+    
+    /**
+    * Stores the glyphs of a text that are positioned by a text printer. Once a text is laid out,
+    * it can be printed many times without decoding, kerning, wrapping and placing its glyphs 
+    * again. Locations are relative to the point where the text is printed. A layout can only be
+    * printed by the printer that created it. Widgets can keep a layout and call Update function 
+    * of the printer every frame, text will be laid out again only if the text, the width or the
+    * settings of the printer change.
+    */
+    class TextLayout {
+        friend class TextPrinter;
+        friend class TextLayoutCache;
+    public:
+        /// A glyph and its location
+        struct Placement {
+            Glyph glyph;
+            Geometry::Pointf location;
+        };
+        
+        /// Start and width of a line, strike through and underline are drawn using these.
+        struct Line {
+            Geometry::Pointf location;
+            float width;
+        };
+        
+        /// Returns whether this layout is created by the given printer for the given parameters 
+        /// and the printer has not changed since then.
+        bool IsValid(const TextPrinter &printer, const std::string &text, int width, TextAlignment align, bool bounded) const;
+        
+        /// Removes all glyphs and invalidates the layout.
+        void Clear() {
+            printer  = nullptr;
+            renderer = nullptr;
+            glyphs.clear();
+            lines.clear();
+            size = {0, 0};
+        }
+        
+        /// Adds a glyph to the layout. Used by the printers.
+        void AddGlyph(Glyph g, Geometry::Pointf location) {
+            glyphs.push_back({g, location});
+        }
+        
+        /// Adds a line to the layout. Used by the printers.
+        void AddLine(Geometry::Pointf location, float width) {
+            lines.push_back({location, width});
+        }
+        
+        /// Sets the size of the text. Used by the printers.
+        void SetSize(Geometry::Size value) {
+            size = value;
+        }
+        
+        /// Returns the positioned glyphs
+        const std::vector<Placement> &GetGlyphs() const {
+            return glyphs;
+        }
+        
+        /// Returns the lines of the text
+        const std::vector<Line> &GetLines() const {
+            return lines;
+        }
+        
+        /// Returns the size of the text
+        Geometry::Size GetSize() const {
+            return size;
+        }
+        
+        /// Returns the text that is laid out
+        const std::string &GetText() const {
+            return text;
+        }
+        
+        /// Returns the width of the area the text is laid out in
+        int GetWidth() const {
+            return width;
+        }
+        
+        /// Returns the alignment of the text
+        TextAlignment GetAlignment() const {
+            return align;
+        }
+        
+        /// Returns whether the text is laid out in an area, otherwise it is laid out to be 
+        /// printed at a point.
+        bool IsBounded() const {
+            return bounded;
+        }
+        
+    private:
+        bool matches(const std::string &text, int width, TextAlignment align, bool bounded) const {
+            return this->width == width && this->align == align && this->bounded == bounded && this->text == text;
+        }
+        
+        const TextPrinter *printer = nullptr;
+        unsigned long revision = 0;
+        
+        //printers can switch to another renderer that has the same revision
+        const GlyphRenderer *renderer = nullptr;
+        unsigned long rendererrevision = 0;
+        
+        std::string text;
+        int width = 0;
+        TextAlignment align = TextAlignment::Left;
+        bool bounded = false;
+        
+        std::vector<Placement> glyphs;
+        std::vector<Line> lines;
+        Geometry::Size size = {0, 0};
+    };
+    
+    /**
+    * Keeps the most recently printed text layouts of a printer so that the text that is printed
+    * every frame is not laid out again. When the cache is full, least recently used layout is 
+    * dropped. Copying a cache creates an empty cache with the same capacity. This class is not
+    * thread safe.
+    */
+    class TextLayoutCache {
+    public:
+        explicit TextLayoutCache(std::size_t capacity = 64) : capacity(capacity) { }
+        
+        TextLayoutCache(const TextLayoutCache &other) : capacity(other.capacity) { }
+        
+        TextLayoutCache &operator =(const TextLayoutCache &other) {
+            Clear();
+            capacity = other.capacity;
+            
+            return *this;
+        }
+        
+        /// Returns the layout for the given parameters. If the layout is not in the cache or it is
+        /// no longer valid, create function is called with the layout to fill.
+        template<class F_>
+        const TextLayout &Get(const TextPrinter &printer, const std::string &text, int width, TextAlignment align, bool bounded, F_ create) {
+            if(capacity == 0) {
+                create(scratch);
+                
+                return scratch;
+            }
+            
+            auto hash = std::hash<std::string>()(text) ^ (std::size_t(width) << 2) ^ (std::size_t(align) << 1) ^ std::size_t(bounded);
+            
+            auto range = index.equal_range(hash);
+            for(auto it = range.first; it != range.second; ++it) {
+                auto &layout = it->second->layout;
+                
+                if(layout.matches(text, width, align, bounded)) {
+                    if(!layout.IsValid(printer, text, width, align, bounded))
+                        create(layout);
+                    
+                    //move to front as the most recently used
+                    entries.splice(entries.begin(), entries, it->second);
+                    
+                    return layout;
+                }
+            }
+            
+            if(entries.size() >= capacity)
+                evict();
+            
+            entries.push_front({hash, {}});
+            index.insert({hash, entries.begin()});
+            
+            create(entries.front().layout);
+            
+            return entries.front().layout;
+        }
+        
+        /// Removes all layouts
+        void Clear() {
+            index.clear();
+            entries.clear();
+            scratch.Clear();
+        }
+        
+        /// Changes the number of layouts that can be kept. 0 disables caching.
+        void SetCapacity(std::size_t value) {
+            capacity = value;
+            
+            while(entries.size() > capacity)
+                evict();
+        }
+        
+        /// Returns the number of layouts that can be kept
+        std::size_t GetCapacity() const {
+            return capacity;
+        }
+        
+        /// Returns the number of layouts in the cache
+        std::size_t GetSize() const {
+            return entries.size();
+        }
+        
+    private:
+        struct entry {
+            std::size_t hash;
+            TextLayout layout;
+        };
+        
+        //removes the least recently used layout
+        void evict() {
+            auto last = std::prev(entries.end());
+            auto range = index.equal_range(last->hash);
+            
+            for(auto it = range.first; it != range.second; ++it) {
+                if(it->second == last) {
+                    index.erase(it);
+                    break;
+                }
+            }
+            
+            entries.erase(last);
+        }
+        
+        std::size_t capacity;
+        
+        std::list<entry> entries;
+        std::unordered_multimap<std::size_t, std::list<entry>::iterator> index;
+        
+        //used when caching is disabled
+        TextLayout scratch;
     };
 
     /**
@@ -354,6 +588,49 @@ namespace Gorgon { namespace Graphics {
             print(target, text, {0, 0, target.GetTargetSize()});
         }
         
+        /// Prints the given layout to the target. Layout should be created by this printer.
+        void Print(TextureTarget &target, const TextLayout &layout, Geometry::Point location) const {
+            printlayout(target, layout, location);
+        }
+        
+        /// Lays out the given text to be printed at a point.
+        void Layout(TextLayout &layout, const std::string &text) const {
+            layouttext(layout, text, 0, TextAlignment::Left, false);
+        }
+        
+        /// Lays out the given text to be printed in an area with the given width. Unless the width
+        /// is 0, text will be wrapped.
+        void Layout(TextLayout &layout, const std::string &text, int width, TextAlignment align) const {
+            layouttext(layout, text, width, align, true);
+        }
+        
+        /// Lays out the given text to be printed at a point if the layout is not valid for it. 
+        /// Returns true if the text is laid out again.
+        bool Update(TextLayout &layout, const std::string &text) const {
+            if(layout.IsValid(*this, text, 0, TextAlignment::Left, false))
+                return false;
+            
+            Layout(layout, text);
+            
+            return true;
+        }
+        
+        /// Lays out the given text to be printed in an area if the layout is not valid for it.
+        /// Returns true if the text is laid out again.
+        bool Update(TextLayout &layout, const std::string &text, int width, TextAlignment align) const {
+            if(layout.IsValid(*this, text, width, align, true))
+                return false;
+            
+            Layout(layout, text, width, align);
+            
+            return true;
+        }
+        
+        /// Returns a number that changes whenever the settings of this printer change in a way
+        /// that would place the glyphs differently. Changes to the glyph renderer are tracked
+        /// by the layouts separately.
+        virtual unsigned long GetLayoutRevision() const { return 0; }
+        
         /// Whether the render can render text
         virtual bool IsReady() const = 0;
 
@@ -413,11 +690,25 @@ namespace Gorgon { namespace Graphics {
         /// align the text. Automatic wrapping should not be used.
         virtual void printnowrap(TextureTarget &target, const std::string &text,
                         Geometry::Rectangle location, TextAlignment align_override) const = 0;
+        
+        /// Should place the glyphs of the text into the given layout. Layout is cleared before
+        /// this call. If bounded is not set, text should be placed as it is printed at a point.
+        /// Default implementation only calculates the size, the text is then printed directly
+        /// by printlayout.
+        virtual void dolayout(TextLayout &layout, const std::string &text, int width, TextAlignment align, bool bounded) const;
+        
+        /// Should print the given layout to the given location.
+        virtual void printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Point location) const;
+        
+    private:
+        void layouttext(TextLayout &layout, const std::string &text, int width, TextAlignment align, bool bounded) const;
     };
     
     /**
     * This is the basic font, performing the minimal amount of operations necessary to render
-    * text on the screen. It requires a single GlyphRenderer to work.
+    * text on the screen. It requires a single GlyphRenderer to work. Texts that are printed
+    * directly are laid out through a layout cache that is modified while printing, therefore,
+    * a printer should not print from multiple threads at the same time.
     */
     class BasicPrinter : public TextPrinter {
     public:
@@ -492,6 +783,28 @@ namespace Gorgon { namespace Graphics {
             return color;
         }
         
+        /// Prints the given layout with the given color. Layout should be created by this printer.
+        void Print(TextureTarget &target, const TextLayout &layout, Geometry::Point location, RGBAf color) const {
+            printlayout(target, layout, location, color);
+        }
+        
+        /// Changes the number of layouts that are kept for the texts printed directly. Setting
+        /// this value to 0 disables the cache.
+        void SetLayoutCacheSize(std::size_t value) {
+            cache.SetCapacity(value);
+        }
+        
+        /// Returns the number of layouts that are kept for the texts printed directly.
+        std::size_t GetLayoutCacheSize() const {
+            return cache.GetCapacity();
+        }
+        
+        /// Removes all cached layouts. Layouts are recreated automatically if the glyph renderer
+        /// reports a new revision, this is only necessary if the renderer does not do so.
+        void ClearLayoutCache() const {
+            cache.Clear();
+        }
+        
         virtual bool IsReady() const override {
             return renderer != nullptr;
         }
@@ -566,6 +879,14 @@ namespace Gorgon { namespace Graphics {
                         Geometry::Rectangle location, RGBAf color) const {
             printnowrap(target, text, location, defaultalign, color);
         }
+        
+        virtual void dolayout(TextLayout &layout, const std::string &text, int width, TextAlignment align, bool bounded) const override;
+        
+        virtual void printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Point location) const override {
+            printlayout(target, layout, location, color);
+        }
+        
+        virtual void printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Point location, RGBAf color) const;
 
         /// Default alignment if none is specified
         TextAlignment defaultalign;
@@ -575,6 +896,9 @@ namespace Gorgon { namespace Graphics {
 
     private:
         const GlyphRenderer *renderer;
+        
+        //layouts of the texts that are printed directly
+        mutable TextLayoutCache cache;
     };
 
     /**
@@ -607,7 +931,9 @@ namespace Gorgon { namespace Graphics {
     * This text renderer can style text according to the set parameters. It can draw shadow
     * modify spacings and tabwidth and is capable of rendering underline. This object is not
     * heavy, and could be copied. When setting up spacing, try to avoid non-integer values,
-    * as they would cause text to blur.
+    * as they would cause text to blur. Texts that are printed directly are laid out through a
+    * layout cache that is modified while printing, therefore, a printer should not print from
+    * multiple threads at the same time, copies can be used instead.
     */
     class StyledPrinter : public TextPrinter {
     public:
@@ -626,6 +952,7 @@ namespace Gorgon { namespace Graphics {
         
         void SetGlyphRenderer(GlyphRenderer &renderer) {
             this->renderer = &renderer;
+            revision++;
         }
         
         /// Changes the color of the text
@@ -764,18 +1091,21 @@ namespace Gorgon { namespace Graphics {
         void AlignLeft() {
             defaultalign = TextAlignment::Left;
             justify = false;
+            revision++;
         }
 
         /// Aligns the text to the right, removes justify
         void AlignRight() {
             defaultalign  = TextAlignment::Right;
             justify = false;
+            revision++;
         }
 
         /// Aligns the text to the center, removes justify
         void AlignCenter() {
             defaultalign = TextAlignment::Center;
             justify = false;
+            revision++;
         }
         
         /// Returns the default alignment for the text
@@ -787,24 +1117,28 @@ namespace Gorgon { namespace Graphics {
         /// text as well last line of a paragraph.
         void SetJustify(bool value) {
             justify = value;
+            revision++;
         }
 
         /// Aligns the text to the left, sets justify
         void JustifyLeft() {
             defaultalign = TextAlignment::Left;
             justify = true;
+            revision++;
         }
 
         /// Aligns the text to the right, sets justify
         void JustifyRight() {
             defaultalign  = TextAlignment::Right;
             justify = true;
+            revision++;
         }
 
         /// Aligns the text to the center, sets justify
         void JustifyCenter() {
             defaultalign = TextAlignment::Center;
             justify = true;
+            revision++;
         }
         
         /// Returns whether the text would be justified
@@ -817,6 +1151,7 @@ namespace Gorgon { namespace Graphics {
         /// the second.
         void SetLineSpacingPixels(int value) {
             vspace = (float)value / renderer->GetHeight();
+            revision++;
         }
         
         /// Returns the line spacing in pixels
@@ -830,6 +1165,7 @@ namespace Gorgon { namespace Graphics {
         /// result to the nearest pixel. 
         void SetLineSpacing(float value) {
             vspace = value;
+            revision++;
         }
         
         /// Returns the line spacing as percentage of line gap
@@ -841,6 +1177,7 @@ namespace Gorgon { namespace Graphics {
         /// the regular character spacing.
         void SetLetterSpacing(int value) {
             hspace = value;
+            revision++;
         }
         
         /// Returns the spacing between the letters in pixels
@@ -853,11 +1190,13 @@ namespace Gorgon { namespace Graphics {
         /// left aligned.
         void SetTabWidth(int value) {
             tabwidth = value;
+            revision++;
         }
 
         /// Sets the tab width in digit widths.
         void SetTabWidthInLetters(float value) {
             tabwidth = (int)std::round(value * renderer->GetCursorAdvance('A'));
+            revision++;
         }
         
         /// Returns tab width in pixels.
@@ -869,6 +1208,7 @@ namespace Gorgon { namespace Graphics {
         /// line break. This distance is in pixels.
         void SetParagraphSpacing(int value) {
             pspace = value;
+            revision++;
         }
         
         /// Get the space between paragraphs in pixels.
@@ -895,6 +1235,27 @@ namespace Gorgon { namespace Graphics {
         virtual const GlyphRenderer &GetGlyphRenderer() const override {
             return *renderer;
         }
+        
+        /// Changes the number of layouts that are kept for the texts printed directly. Setting
+        /// this value to 0 disables the cache.
+        void SetLayoutCacheSize(std::size_t value) {
+            cache.SetCapacity(value);
+        }
+        
+        /// Returns the number of layouts that are kept for the texts printed directly.
+        std::size_t GetLayoutCacheSize() const {
+            return cache.GetCapacity();
+        }
+        
+        /// Removes all cached layouts. Layouts are recreated automatically if the glyph renderer
+        /// reports a new revision, this is only necessary if the renderer does not do so.
+        void ClearLayoutCache() const {
+            cache.Clear();
+        }
+        
+        virtual unsigned long GetLayoutRevision() const override {
+            return revision;
+        }
 
         virtual Geometry::Size GetSize(const std::string &text) const override;
 
@@ -927,12 +1288,14 @@ namespace Gorgon { namespace Graphics {
                         Geometry::Rectangle location) const override {
             printnowrap(target, text, location, defaultalign);
         }
+        
+        virtual void dolayout(TextLayout &layout, const std::string &text, int width, TextAlignment align, bool bounded) const override;
+        
+        virtual void printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Point location) const override;
 
     private:
         //internal, float to facilitate shadow offset
-        void print(TextureTarget &target, const std::string &text, Geometry::Pointf location, RGBAf color, RGBAf strikecolor, RGBAf underlinecolor) const;
-
-        void print(TextureTarget &target, const std::string &text, Geometry::Rectanglef location, TextAlignment align, RGBAf color, RGBAf strikecolor, RGBAf underlinecolor) const;
+        void printlayout(TextureTarget &target, const TextLayout &layout, Geometry::Pointf location, RGBAf color, RGBAf strikecolor, RGBAf underlinecolor) const;
 
         GlyphRenderer *renderer = nullptr;
 
@@ -950,6 +1313,12 @@ namespace Gorgon { namespace Graphics {
         int   hspace = 0;
         int   pspace = 0;
         int   tabwidth = 0;
+        
+        //changes when a setting that affects the layout is changed
+        unsigned long revision = 0;
+        
+        //layouts of the texts that are printed directly
+        mutable TextLayoutCache cache;
     };
     
     namespace internal {
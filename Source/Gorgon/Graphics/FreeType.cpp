@@ -1,6 +1,7 @@
 #include "FreeType.h"
 
 #include <set>
+#include <algorithm>
 
 #include "Bitmap.h"
 #include "../Filesystem.h"
@@ -376,6 +377,8 @@ namespace Gorgon { namespace Graphics {
         }
         
 		this->size = (float)size;
+        revision++;
+        
         return true;
     }
     
@@ -391,7 +394,7 @@ namespace Gorgon { namespace Graphics {
             done++; //already loaded glyphs are also counted as done
 
             //we already have this glyph
-            if(glyphmap.count(g)) continue;
+            if(find(g)) continue;
 
             auto index = FT_Get_Char_Index(lib->face, g);
             
@@ -414,8 +417,8 @@ namespace Gorgon { namespace Graphics {
             }
 
             //check if glyph is already loaded. if so use the same
-            if(ft_to_map.count(index) && glyphmap.count(ft_to_map[index])) {
-                glyphmap[g] = glyphmap[ft_to_map[index]];
+            if(ft_to_map.count(index) && find(ft_to_map[index])) {
+                insert(g, *find(ft_to_map[index]));
                 continue;
             }
 
@@ -436,16 +439,21 @@ namespace Gorgon { namespace Graphics {
             destroylist.Add(*bmp);
             destroylist.Add(*withoffset);
 
-            glyphmap[g] = {{bmp, withoffset},
-                           slot->linearHoriAdvance/float(1<<16),
-                           {(int)slot->bitmap_left, (int)-slot->bitmap_top},
-                           (unsigned int)index};
+            insert(g, {{bmp, withoffset},
+                       slot->linearHoriAdvance/float(1<<16),
+                       {(int)slot->bitmap_left, (int)-slot->bitmap_top},
+                       (unsigned int)index});
             ft_to_map[index] = g;
 
             if(g < 127 && isdigit(g) && digw < bmp->GetWidth())
                 digw = bmp->GetWidth();
 
-            if(prepare) {
+            //packed glyphs are placed to the atlas directly instead of being prepared first
+            if(keeppacked) {
+                packimage(bmp);
+                packimage(withoffset);
+            }
+            else if(prepare) {
                 bmp->Prepare();
                 withoffset->Prepare();
             }
@@ -500,47 +508,50 @@ namespace Gorgon { namespace Graphics {
     
     
     bool FreeType::IsReady() const {
-        return height != 0 && (lib->face != nullptr || !glyphmap.empty());
+        return height != 0 && (lib->face != nullptr || !glyphmap.empty() || 
+            std::any_of(latin.begin(), latin.end(), [](const GlyphDescriptor &d) { return d.images.regular != nullptr; })
+        );
     }
 
     Geometry::Size FreeType::GetSize(Glyph chr) const {
-		if(glyphmap.count(chr))
-			return glyphmap.at(chr).images.regular->GetSize();
-		else if(glyphmap.count(0) && !internal::isspace(chr) && !internal::isnewline(chr) && chr != '\t')
-			return glyphmap.at(0).images.regular->GetSize();
+		auto glyph = findordefault(chr);
+		
+		if(glyph)
+			return glyph->images.regular->GetSize();
 		else
 			return{0, 0};
 	}
 	
 	Geometry::Point FreeType::GetOffset(Glyph chr) const {
-		if(glyphmap.count(chr))
-			return glyphmap.at(chr).offset;
-		else if(glyphmap.count(0) && !internal::isspace(chr) && !internal::isnewline(chr) && chr != '\t')
-			return glyphmap.at(0).offset;
+		auto glyph = findordefault(chr);
+		
+		if(glyph)
+			return glyph->offset;
 		else
 			return{0, 0};
     }
 
     float FreeType::GetCursorAdvance(Glyph chr) const  {
-		if(glyphmap.count(chr))
-			return glyphmap.at(chr).advance;
+		auto glyph = find(chr);
+		
+		if(glyph)
+			return glyph->advance;
         else if(chr == '\t')
             return (float)height;
         else if(internal::isspace(chr))
             return float(height / 4);
-		else if(glyphmap.count(0))
-			return glyphmap.at(0).advance;
+		else if((glyph = find(0)) != nullptr)
+			return glyph->advance;
 		else
 			return 0;
 	}
 	
 	bool FreeType::Exists(Glyph g) const {
-        int c = (int)glyphmap.count(g);
-        return c != 0;
+        return find(g) != nullptr;
     }
     
     bool FreeType::Available(Glyph g) const {
-        if(glyphmap.count(g))
+        if(find(g))
 			return true;
         
         if(!lib->face)
@@ -550,39 +561,35 @@ namespace Gorgon { namespace Graphics {
     }
     
     void FreeType::Render(Glyph chr, TextureTarget &target, Geometry::Pointf location, RGBAf color) const {
-        if(glyphmap.count(chr)) {
-            auto glyph = glyphmap.at(chr);
-            glyph.images.regular->Draw(target, location + glyph.offset + Geometry::Pointf(0.f, (float)baseline), color);
-        }
-		else if(glyphmap.count(0) && !internal::isspace(chr) && !internal::isnewline(chr) && chr != '\t') {
-			auto glyph = glyphmap.at(0);
-			glyph.images.regular->Draw(target, location + glyph.offset + Geometry::Pointf(0.f, (float)baseline), color);
-		}
+        auto glyph = findordefault(chr);
+        
+        if(glyph)
+            glyph->images.regular->Draw(target, location + glyph->offset + Geometry::Pointf(0.f, (float)baseline), color);
     }
     
     Drawable *FreeType::GetCharacter(Glyph chr) {
-        if(glyphmap.count(chr)) {
-            auto glyph = glyphmap.at(chr);
-            return glyph.images.regular;
-        }
-		else {
+        auto glyph = find(chr);
+        
+        if(!glyph) {
 			LoadGlyphs(chr);
             
-            if(glyphmap.count(chr)) {
-                auto glyph = glyphmap.at(chr);
-                return glyph.images.regular;
-            }
+            glyph = find(chr);
 		}
 		
-		return nullptr;
+		return glyph ? glyph->images.regular : nullptr;
     }
     
     Geometry::Pointf FreeType::KerningDistance(Glyph chr1, Glyph chr2) const {
-        if(!lib->face || !haskerning || !glyphmap.count(chr1) || !glyphmap.count(chr2))
+        if(!lib->face || !haskerning)
+            return {0.f, 0.f};
+        
+        auto l = find(chr1), r = find(chr2);
+        
+        if(!l || !r)
             return {0.f, 0.f};
         
         FT_Vector p;
-        FT_Get_Kerning(lib->face, glyphmap.at(chr1).ftindex, glyphmap.at(chr2).ftindex, FT_KERNING_DEFAULT, &p);
+        FT_Get_Kerning(lib->face, l->ftindex, r->ftindex, FT_KERNING_DEFAULT, &p);
 
         return {std::round(p.x / 64.f), std::round(p.y / 64.f)};
     }
@@ -621,9 +628,6 @@ namespace Gorgon { namespace Graphics {
         
         for(auto &range : ranges) 
             loadglyphs(range, true);
-        
-        if(keeppacked)
-            pack();
     }
     
     
@@ -631,18 +635,20 @@ namespace Gorgon { namespace Graphics {
         BitmapFont font;
 
 		//determine glyph spacing
-		GlyphDescriptor d;
+		const GlyphDescriptor *d = nullptr;
 		int gs = int(GetHeight() / 10);
 
-		if(glyphmap.count('0') && glyphmap['0'].advance != 0 && glyphmap['0'].images.regular != nullptr)
-			d = glyphmap['0'];
-		else if(glyphmap.count('A') && glyphmap['A'].advance != 0 && glyphmap['A'].images.regular != nullptr)
-			d = glyphmap['A'];
-		else if(glyphmap.count('_') && glyphmap['_'].advance != 0 && glyphmap['_'].images.regular != nullptr)
-			d = glyphmap['_'];
+		for(Glyph c : {Glyph('0'), Glyph('A'), Glyph('_')}) {
+			d = find(c);
+			
+			if(d && d->advance != 0)
+				break;
+			
+			d = nullptr;
+		}
 		
-		if(d.advance != 0 && d.images.regular != nullptr)
-			gs = (int)std::round(d.advance - d.images.regular->GetWidth() + glyphmap['0'].offset.X);
+		if(d)
+			gs = (int)std::round(d->advance - d->images.regular->GetWidth() + (find('0') ? find('0')->offset.X : 0));
 
 		if(gs < 1)
 			gs = 1;
@@ -655,55 +661,46 @@ namespace Gorgon { namespace Graphics {
         
         //copy kerning table
         if(haskerning) {
-            for(auto &l : glyphmap) {
-                for(auto &r : glyphmap) {
-                    auto p = KerningDistance(l.first, r.first);
+            forallglyphs([&](Glyph l, const GlyphDescriptor &) {
+                forallglyphs([&](Glyph r, const GlyphDescriptor &) {
+                    auto p = KerningDistance(l, r);
                     
                     if(p.X != 0 || p.Y != 0) {
-                        font.SetKerning(l.first, r.first, p);
+                        font.SetKerning(l, r, p);
                     }
-                }
-            }
+                });
+            });
         }
         
         std::map<const RectangularDrawable*, Bitmap*> newmapping;
         
-        for(auto &g : glyphmap) {
-            if(!newmapping.count(g.second.images.regular)) {
-                if(dynamic_cast<const Bitmap*>(g.second.images.regular)) {
-                    auto img = dynamic_cast<const Bitmap*>(g.second.images.regular);
-                    
-                    newmapping[img] = new Bitmap(img->Duplicate());
-                    
-                    if(prepare)
-                        newmapping[img]->Prepare();
+        forallglyphs([&](Glyph g, const GlyphDescriptor &desc) {
+            auto img = dynamic_cast<const Bitmap*>(desc.images.regular);
+            
+            if(img && !newmapping.count(img)) {
+                auto bmp = new Bitmap;
+                
+                //if the data is discarded, packed glyphs can still be copied back from the atlas
+                if(img->HasData()) {
+                    bmp->Assign(img->GetData());
                 }
-                else if(dynamic_cast<const TextureImage*>(g.second.images.regular) && atlasdata.GetTotalSize() > 0 && 
-                        dynamic_cast<const TextureImage*>(g.second.images.regular)->GetID() == atlas.GetID()) {
-                    auto img = dynamic_cast<const TextureImage*>(g.second.images.regular);
-                    
-                    //create a new bitmap
-                    auto bmp = new Bitmap(g.second.images.regular->GetSize(), atlasdata.GetMode());
-                    
-                    //copy atlas data back to it
-                    auto c = img->GetCoordinates();
-                    int left   = (int)std::round(c[0].X * atlasdata.GetWidth());
-                    int right  = (int)std::round(c[2].X * atlasdata.GetWidth());
-                    int top    = (int)std::round(c[0].Y * atlasdata.GetHeight());
-                    int bottom = (int)std::round(c[2].Y * atlasdata.GetHeight());
-                    
-                    atlasdata.CopyTo(bmp->GetData(), {left, top, right, bottom});
-                    if(prepare)
-                        bmp->Prepare();
+                else {
+                    Containers::Image data;
                     
-                    newmapping.insert({img, bmp});
+                    if(img->CopyFromAtlas(data))
+                        bmp->Assume(std::move(data));
                 }
+                
+                if(prepare)
+                    bmp->Prepare();
+                
+                newmapping.insert({img, bmp});
             }
             
-            if(newmapping.count(g.second.images.regular)) {
-                font.AssumeGlyph(g.first, *newmapping[g.second.images.regular], g.second.offset + Geometry::Pointf(0, baseline), g.second.advance);
+            if(newmapping.count(desc.images.regular)) {
+                font.AssumeGlyph(g, *newmapping[desc.images.regular], desc.offset + Geometry::Pointf(0, baseline), desc.advance);
             }
-        }
+        });
         
         return font;
     }
@@ -713,18 +710,20 @@ namespace Gorgon { namespace Graphics {
         BitmapFont font;
 
 		//determine glyph spacing
-		GlyphDescriptor d;
+		const GlyphDescriptor *d = nullptr;
 		int gs = int(GetHeight() / 10);
 
-		if(glyphmap.count('0') && glyphmap['0'].advance != 0 && glyphmap['0'].images.regular != nullptr)
-			d = glyphmap['0'];
-		else if(glyphmap.count('A') && glyphmap['A'].advance != 0 && glyphmap['A'].images.regular != nullptr)
-			d = glyphmap['A'];
-		else if(glyphmap.count('_') && glyphmap['_'].advance != 0 && glyphmap['_'].images.regular != nullptr)
-			d = glyphmap['_'];
+		for(Glyph c : {Glyph('0'), Glyph('A'), Glyph('_')}) {
+			d = find(c);
+			
+			if(d && d->advance != 0)
+				break;
+			
+			d = nullptr;
+		}
 
-		if(d.advance != 0 && d.images.regular != nullptr)
-			gs = (int)std::round(d.advance - d.images.regular->GetWidth() + glyphmap['0'].offset.X);
+		if(d)
+			gs = (int)std::round(d->advance - d->images.regular->GetWidth() + (find('0') ? find('0')->offset.X : 0));
 
 		if(gs < 1)
 			gs = 1;
@@ -737,76 +736,28 @@ namespace Gorgon { namespace Graphics {
         
         //copy kerning table
         if(haskerning) {
-            for(auto &l : glyphmap) {
-                for(auto &r : glyphmap) {
-                    auto p = KerningDistance(l.first, r.first);
+            forallglyphs([&](Glyph l, const GlyphDescriptor &) {
+                forallglyphs([&](Glyph r, const GlyphDescriptor &) {
+                    auto p = KerningDistance(l, r);
                     
                     if(p.X != 0 || p.Y != 0) {
-                        font.SetKerning(l.first, r.first, p);
+                        font.SetKerning(l, r, p);
                     }
-                }
-            }
+                });
+            });
         }
-
-        //if there is no atlasdata, there is no way or reason to unpack
-        if(unpack && atlasdata.GetTotalSize() != 0) {
-            std::map<const RectangularDrawable*, Bitmap *> map;
-
-            for(auto &g : glyphmap) {
-                // already bitmap no need to do anything
-                if(dynamic_cast<const Bitmap*>(g.second.images.regular)) {
-                    font.AddGlyph(g.first, *g.second.images.regular, g.second.offset + Geometry::Pointf(0, baseline), g.second.advance);
-                }
-                else {
-                    //just to be sure
-                    auto img = dynamic_cast<const TextureImage*>(g.second.images.regular);
-                    
-                    //if the glyph is not transformed and can be transformed
-                    if(!map.count(g.second.images.regular) && img && img->GetID() == atlas.GetID()) {
-                        //create a new bitmap
-                        auto bmp = new Bitmap(g.second.images.regular->GetSize(), atlasdata.GetMode());
-                        
-                        font.Adopt(*bmp);
-                        
-                        //copy atlas data back to it
-                        auto c = img->GetCoordinates();
-                        int left   = (int)std::round(c[0].X * atlasdata.GetWidth());
-                        int right  = (int)std::round(c[2].X * atlasdata.GetWidth());
-                        int top    = (int)std::round(c[0].Y * atlasdata.GetHeight());
-                        int bottom = (int)std::round(c[2].Y * atlasdata.GetHeight());
-                        
-                        atlasdata.CopyTo(bmp->GetData(), {left, top, right, bottom}, {0, 0});
-                        if(prepare)
-                            bmp->Prepare();
-                        
-                        map.insert({img, bmp});
-                        
-                        delete img;
-                    }
-                    
-                    if(map.count(g.second.images.regular)) {
-                        font.AddGlyph(g.first, *map[g.second.images.regular], g.second.offset + Geometry::Pointf(0, baseline), g.second.advance);
-                    }
-                }
-            }
-        }
-        else {
-            //add glpyhs
-            for(auto &g : glyphmap) {
-                font.AddGlyph(g.first, *g.second.images.regular, g.second.offset + Geometry::Pointf(0, baseline), g.second.advance);
-            }
-            
-            //transfer ownership
-            for(const auto &i : destroylist) {
-                font.Adopt(i);
-            }
+        
+        forallglyphs([&](Glyph g, const GlyphDescriptor &desc) {
+            //atlas is destroyed with this font, glyphs should leave it
+            unpackimage(desc.images.regular, unpack || prepare, unpack);
+            unpackimage(desc.images.withoffset, unpack || prepare, unpack);
             
-            //if we have atlas
-            if(atlas.GetID()) {
-                //adopt and release it
-                font.Adopt(*new TextureImage(atlas.GetID(), atlas.GetMode(), atlas.GetImageSize()));
-                atlas.Release();
-            }
+            font.AddGlyph(g, *desc.images.regular, desc.offset + Geometry::Pointf(0, baseline), desc.advance);
+        });
+        
+        //transfer ownership
+        for(const auto &i : destroylist) {
+            font.Adopt(i);
         }
         
         //clear to ensure they wont be destroyed
@@ -819,237 +770,77 @@ namespace Gorgon { namespace Graphics {
     
 
     void FreeType::Clear(){
+        latin.fill(GlyphDescriptor());
         glyphmap.clear();
         destroylist.DeleteAll();
 
-        atlasdata.Destroy();
-        
-        std::vector<bool> e;
-        std::swap(used, e);
-        rowsused = 0;
+        //images are removed from the atlas as they are destroyed
+        atlas.reset();
             
 		digw = 0;
+        revision++;
     }
     
     
-    void FreeType::setatlassize(unsigned size) const {
-        if(size < 1) return;
+    void FreeType::packimage(RectangularDrawable *image) const {
+        auto bmp = dynamic_cast<Bitmap*>(image);
         
-        int w = CeilToPowerOf2(unsigned(sqrt(float(size))));
-        int h = CeilToPowerOf2((int)ceil(size / w));
+        if(!bmp || !bmp->HasData() || bmp->GetAtlas())
+            return;
         
-        if(atlas.GetID()) {
-            //resize and copy everything
-            
-            std::vector<bool> nu(w*h);
-            int ow = atlasdata.GetWidth(), oh = atlasdata.GetHeight();
-            for(int y=0; y<oh; y++)
-                for(int x=0; x<ow; x++)
-                    nu[y*w+x] = used[y*ow+x];
-                
-            std::swap(used, nu);
-            
-            for(auto &g : glyphmap) {
-                if(g.second.images.regular && dynamic_cast<const TextureImage*>(g.second.images.regular)) {
-                    //cast away constness, we need to update them as their base is modified
-                    auto im = dynamic_cast<TextureImage*>(g.second.images.regular);
-                    auto c = im->GetCoordinates();
-                        
-                    int l = (int)std::round(c[0].X*ow);
-                    int t = (int)std::round(c[0].Y*oh);
-                    int r = (int)std::round(c[2].X*ow);
-                    int b = (int)std::round(c[2].Y*oh);
-                    
-                    im->Set(im->GetID(), im->GetMode(), {w, h}, {l, t, r, b});
-                }
-            }
-            
-            
-            Containers::Image ni({w, h}, ColorMode::Alpha);
-            atlasdata.CopyTo(ni, {0, 0});
-            atlasdata.Swap(ni);
-
-            GL::UpdateTexture(atlas.GetID(), atlasdata);
-            atlas.Set(atlas.GetID(), atlas.GetMode(), {w, h});
-        }
-        else {
-            used.resize(w*h);
-            atlas.CreateEmpty({w, h}, ColorMode::Alpha);
-            atlasdata.Resize ({w, h}, ColorMode::Alpha);
+        if(!atlas) {
+            atlasmargin = tightpack ? 0 : 1;
+            atlas.reset(new AtlasManager({512, 512}, atlasmargin));
         }
+        
+        //empty glyphs like space and very large glyphs do not go to the atlas
+        if(bmp->GetSize().Area() > 0 && atlas->CanPlace(bmp->GetSize()))
+            bmp->Prepare(*atlas);
+        else if(!bmp->HasTexture())
+            bmp->Prepare();
     }
     
     
-    void FreeType::pack(float extrasize) const {
-        int cursize = 0;
-        bool cpeach = true;
-        if(atlas.GetID()) {
-            cursize = rowsused * atlas.GetImageSize().Width;
-        }
-        
-        //collect images
-        Containers::Collection<const Bitmap> images;
-        for(auto &g : glyphmap) {
-            if(dynamic_cast<const Bitmap*>(g.second.images.regular))
-                images.Add(dynamic_cast<const Bitmap*>(g.second.images.regular));
-        }
+    void FreeType::unpackimage(RectangularDrawable *image, bool prepare, bool keepdata) const {
+        auto bmp = dynamic_cast<Bitmap*>(image);
         
-        if(images.GetSize() == 0)
+        if(!bmp || !bmp->GetAtlas())
             return;
         
-        //determine collective size, add 2% extra for inefficiency
-        //of packing
-        for(auto &i : images) {
-            cursize += (int)ceil(i.GetSize().Area() * 1.2 + (tightpack ? 0 : i.GetWidth() + i.GetHeight()));
-        }
-        
-        //Copying each image separately is not working properly, thus it is disabled for now
-        //if(images.GetCount() > 5)
-            cpeach = false;
+        bool hasdata = bmp->HasData();
         
-        if(atlas.GetID()) {
-            if(cursize > atlas.GetImageSize().Area()) {
-                //enlarge for future glyphs
-                cursize = (int)std::ceil(cursize * (1 + extrasize));
-                
-                setatlassize(cursize);
-            }
+        if(!hasdata) {
+            Containers::Image data;
+            bmp->CopyFromAtlas(data);
+            bmp->Assume(std::move(data));
         }
-        else {
-			cursize = (int)std::ceil(cursize * (1 + extrasize));
-
-            setatlassize(cursize);
-        }
-        
-        //sort by height then width
-        images.Sort([](const Bitmap &l, const Bitmap &r) {
-            if(l.GetHeight() == r.GetHeight())
-                return l.GetWidth() < r.GetWidth();
-            else
-                return l.GetHeight() < r.GetHeight();
-        });
         
-        auto aw = atlasdata.GetWidth(), ah = atlasdata.GetHeight();
+        //preparing removes the image from the atlas
+        bmp->Prepare();
         
-        std::map<const RectangularDrawable *, TextureImage *> replacements;
+        if(!prepare)
+            GL::DestroyTexture(bmp->ReleaseTexture().GetID());
         
-        //this is not the best algorithm for the job, but it gets the deed done
-        for(auto &b : images) {
-        retry:
-            Geometry::Point cur = {0, 0};
-            
-            auto w = b.GetWidth(), h = b.GetHeight();
-            
-            if(!tightpack) {
-                w++;
-                h++;
-            }
-            
-            bool found = false;
-            while(!found) {
-                //run out of width, start over from the next row
-                if(cur.X + w > aw) { 
-                    cur.Y++;
-                    cur.X = 0;
-                }
-
-                //run out of space, resize and retry
-                if(cur.Y + h > ah) { 
-                    cursize = (int)std::ceil(cursize * 1.2);
-                    setatlassize(cursize);
-                    
-                    for(auto &img : replacements) {
-                        auto im = img.second;
-                        auto c = im->GetCoordinates();
-                        
-                        int l = (int)std::round(c[0].X*aw);
-                        int t = (int)std::round(c[0].Y*ah);
-                        int r = (int)std::round(c[2].X*aw);
-                        int b = (int)std::round(c[2].Y*ah);
-                        im->Set(im->GetID(), im->GetMode(), atlasdata.GetSize(), {l, t, r, b});
-                    }
-                    aw = atlasdata.GetWidth();
-                    ah = atlasdata.GetHeight();
-                    
-                    
-                    goto retry;
-                }
-                
-                bool full = false;
-                //check horizontal free
-                for(int x=cur.X; x<cur.X+w; x++) {
-                    if(used[x + cur.Y * aw]) {
-                        full = true;
-                        break;
-                    }
-                }
-                
-                if(full) {
-                    cur.X++;
-                    continue;
-                }
-                
-                //check vertical free
-                for(int y=cur.Y; y<cur.Y+h; y++) {
-                    if(used[cur.X + y * aw]) {
-                        full = true;
-                        break;
-                    }
-                }
-                
-                if(full) {
-                    cur.X++;
-                    continue;
-                }
-                
-                for(int y=cur.Y; y<cur.Y+h; y++) {
-                    for(int x=cur.X; x<cur.X+w; x++) {
-                        used[x+y*aw] = true;
-                    }
-                }
-                
-                //found our place
-                b.GetData().CopyTo(atlasdata, cur);
-                if(cpeach) {
-                    GL::CopyToTexture(atlas.GetID(), b.GetData(), cur);
-                }
-                
-                auto tex = new TextureImage(atlas.GetID(), ColorMode::Alpha, atlas.GetImageSize(), {cur, b.GetSize()});
-                
-                if(cur.Y + h > rowsused)
-                    rowsused = cur.Y + h;
-                
-                replacements.insert({&b, tex});
-                
-                destroylist.Add(tex);
-                
-                found = true;
-            }
+        if(!hasdata && !keepdata)
+            bmp->Discard();
+    }
+    
+    
+    void FreeType::pack(float) const {
+        //margin cannot be changed after the atlas is created, glyphs are moved to a new atlas
+        if(atlas && atlasmargin != (tightpack ? 0 : 1)) {
+            forallglyphs([&](Glyph, const GlyphDescriptor &d) {
+                unpackimage(d.images.regular, false, true);
+                unpackimage(d.images.withoffset, false, true);
+            });
             
-            if(!found) //useless
-                return;
-        }
-        
-        if(!cpeach) {
-            GL::UpdateTexture(atlas.GetID(), atlasdata);
+            atlas.reset();
         }
         
-        //to test if the atlas is good
-        //Bitmap ad;
-        //ad.Assign(atlasdata);
-        //ad.ExportPNG("test.png");
-        
-        //replace images
-        for(auto &g : glyphmap) {
-            if(replacements.count(g.second.images.regular))
-                g.second.images.regular = replacements[g.second.images.regular];
-        }
-        
-        //destroy old images
-        for(auto &im : images) {
-            destroylist.Remove(im);
-        }
-        images.Destroy();
+        forallglyphs([&](Glyph, const GlyphDescriptor &d) {
+            packimage(d.images.regular);
+            packimage(d.images.withoffset);
+        });
     }
 
     bool FreeType::LoadGlyphs(const std::vector< Gorgon::Graphics::GlyphRange >& ranges, bool prepare) {
@@ -1058,31 +849,25 @@ namespace Gorgon { namespace Graphics {
                 return false;
         }
         
-        if(keeppacked)
-            pack();
-        
         return true;
     }
 
     bool FreeType::LoadGlyphs(GlyphRange range, bool prepare) { 
-        if(!loadglyphs(range, prepare))
-            return false;
-        
-        if(keeppacked)
-            pack();
-        
-        return true;
+        return loadglyphs(range, prepare);
     }
     
     void FreeType::Discard() {
-        atlasdata.Destroy();
-        
-        for(auto &g : glyphmap) {
-            auto bmp = dynamic_cast<Bitmap*>(g.second.images.regular);
+        forallglyphs([](Glyph, const GlyphDescriptor &d) {
+            auto bmp = dynamic_cast<Bitmap*>(d.images.regular);
             
             if(bmp)
                 bmp->Discard();
-        }
+            
+            bmp = dynamic_cast<Bitmap*>(d.images.withoffset);
+            
+            if(bmp)
+                bmp->Discard();
+        });
         
         lib->destroyface();
         filename = "";
@@ -1107,7 +892,7 @@ namespace Gorgon { namespace Graphics {
             loadglyphs('f', true);
             loadglyphs('j', true);
 
-            if(glyphmap.count(0xc2)) { 
+            if(find(0xc2)) { 
                 c[0] = 0xc2;
             }
             else
@@ -1117,14 +902,14 @@ namespace Gorgon { namespace Graphics {
         c[2] = 'f';
 
         for(int i = 0; i<3; i++) {
-            if(!glyphmap.count(c[i]) || !glyphmap.at(c[i]).images.regular)
+            if(!find(c[i]))
                 return {0, GetHeight()};
         }
 
         int miny = GetHeight(), maxy = 0;
 
         for(int i = 0; i<3; i++) {
-            const auto &g = glyphmap.at(c[i]);
+            const auto &g = *find(c[i]);
 
             //we trust freetype to give us trimmed images
 
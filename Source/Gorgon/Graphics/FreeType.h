@@ -3,9 +3,14 @@
 #include "Font.h"
 #include "Drawables.h"
 #include "BitmapFont.h"
+#include "Atlas.h"
 #include "../Geometry/Point.h"
 #include "../Containers/Collection.h"
 
+#include <array>
+#include <memory>
+#include <unordered_map>
+
 namespace Gorgon { namespace Resource { class Font; } }
 
 
@@ -234,8 +239,10 @@ namespace Gorgon { namespace Graphics {
         /// work if discard is called. Prepare parameter is used if the font is unpacked.
         BitmapFont MoveOutBitmap(bool unpack = false, bool prepare = true);
         
-        /// Packs current glyphs into a single atlas. If keeppacked is selected, any call to LoadGlyph
-        /// function pack the loaded asset immediately.
+        /// Packs current glyphs into shared atlas pages. If keeppacked is selected, any call to
+        /// LoadGlyph function packs the loaded glyphs immediately. New pages are created when the
+        /// existing ones are full. If tight is not set, one pixel gap is left around the glyphs.
+        /// extrasize is no longer used as pages have a fixed size.
         void Pack(bool keeppacked = true, bool tight = true, float extrasize = 0.2) {
             this->keeppacked = keeppacked;
             this->tightpack  = tight;
@@ -320,6 +327,8 @@ namespace Gorgon { namespace Graphics {
 		/// The position of the underline, if it is to be drawn.
 		virtual int GetUnderlineOffset() const override { return underlinepos; }
         
+        virtual unsigned long GetRevision() const override { return revision; }
+        
         /// Should return if the glyph renderer requires preparation regarding the text given.
         virtual bool NeedsPrepare() const override { return true; }
         
@@ -338,18 +347,68 @@ namespace Gorgon { namespace Graphics {
     private:
         void pack(float extrasize = 0.2) const;
         
+        //places the given glyph image into the atlas, images that do not fit are prepared
+        //separately
+        void packimage(RectangularDrawable *image) const;
+        
+        //moves the given glyph image out of the atlas. Image will have its own texture if 
+        //prepare is set and its data if keepdata is set.
+        void unpackimage(RectangularDrawable *image, bool prepare, bool keepdata) const;
+        
         bool loadglyphs(GlyphRange range, bool prepare) const;
         
         bool finalizeload();
 
 		bool savedata(std::ostream &stream);
         
-        void setatlassize(unsigned size) const;
+        //returns the descriptor of the given glyph or nullptr if it is not loaded
+        const GlyphDescriptor *find(Glyph g) const {
+            if(g < latin.size())
+                return latin[g].images.regular ? &latin[g] : nullptr;
+            
+            auto it = glyphmap.find(g);
+            
+            return it == glyphmap.end() ? nullptr : &it->second;
+        }
+        
+        //returns the descriptor to be drawn for the given glyph, glyph 0 is used for the glyphs
+        //that are not loaded unless they are whitespace
+        const GlyphDescriptor *findordefault(Glyph g) const {
+            auto d = find(g);
+            
+            if(d || internal::isspace(g) || internal::isnewline(g) || g == '\t')
+                return d;
+            
+            return find(0);
+        }
+        
+        void insert(Glyph g, const GlyphDescriptor &d) const {
+            if(g < latin.size())
+                latin[g] = d;
+            else
+                glyphmap[g] = d;
+        }
+        
+        //calls the given function with every loaded glyph and its descriptor
+        template<class F_>
+        void forallglyphs(F_ fn) const {
+            for(Glyph g = 0; g < latin.size(); g++) {
+                if(latin[g].images.regular)
+                    fn(g, latin[g]);
+            }
+            
+            for(auto &p : glyphmap)
+                fn(p.first, p.second);
+        }
         
         // automatic loading requires these functions to be mutable
         mutable ftlib *lib;
         
-        mutable std::map<Glyph, GlyphDescriptor> glyphmap ;
+        //ASCII and Latin-1 glyphs are directly indexed, a glyph is loaded if it has a regular
+        //image. Rest of the glyphs are hashed.
+        mutable std::array<GlyphDescriptor, 256> latin;
+        
+        mutable std::unordered_map<Glyph, GlyphDescriptor> glyphmap;
         
         //this exists to speed up loading glyphs that are already read.
         mutable std::map<unsigned int, Glyph>    ft_to_map;
@@ -363,16 +422,12 @@ namespace Gorgon { namespace Graphics {
         const Byte *data = nullptr;
         long datasize = 0;
         
-        //stores the glyph atlas. could be empty if packing is not used
-        mutable Texture atlas;
-        //stores atlas pixel data
-        mutable Containers::Image atlasdata;
+        //stores the glyph atlas pages. could be empty if packing is not used. Glyph images are 
+        //bound to the atlas and should be destroyed before it.
+        mutable std::unique_ptr<AtlasManager> atlas;
         
-        //stores which pixels are used within the atlas
-        mutable std::vector<bool> used;
-        
-        //stores first free pixel location
-        mutable int rowsused = 0;
+        //margin of the current atlas
+        mutable int atlasmargin = 0;
         
         bool keeppacked = true;
         bool tightpack  = true;
@@ -384,6 +439,9 @@ namespace Gorgon { namespace Graphics {
         
         int maxadvance = 0;
         
+        //changes whenever glyph placement might change, see GlyphRenderer::GetRevision
+        unsigned long revision = 0;
+        
         int height = 0;
         
         float baseline = 0;
@@ -3,6 +3,10 @@
 #include "../WindowManager.h"
 #include "../Geometry/Transform3D.h"
 #include "Layer.h"
+#include "Shaders.h"
+
+#include <vector>
+#include <cstddef>
 
 namespace Gorgon { namespace Graphics {
 
@@ -20,6 +24,13 @@ namespace Gorgon { namespace Graphics {
 		GLuint quadvbo;
 		std::map<decltype(WindowManager::CurrentContext()), GLuint> vaos;
 
+		GLuint batchvbo, batchibo;
+		std::map<decltype(WindowManager::CurrentContext()), GLuint> batchvaos;
+
+		RenderStatistics Statistics;
+
+		bool batching = true;
+
 		void ActivateQuadVertices() {
 #ifndef NDEBUG
 			if(vaos.count(WindowManager::CurrentContext())==0) {
@@ -31,9 +42,47 @@ namespace Gorgon { namespace Graphics {
 
 		void DrawQuadVertices() {
 			glDrawArrays(GL_TRIANGLES, 0, 6);
+			Statistics.DrawCalls++;
+		}
+
+		void DrawBatchVertices(const BatchVertex *vertices, int quads) {
+#ifndef NDEBUG
+			if(batchvaos.count(WindowManager::CurrentContext())==0) {
+				throw std::logic_error("Context not initialized???");
+			}
+#endif
+			glBindVertexArray(batchvaos[WindowManager::CurrentContext()]);
+			glBindBuffer(GL_ARRAY_BUFFER, batchvbo);
+
+			for(int i=0; i<quads; i+=MaxBatchQuads) {
+				int count = std::min(quads - i, MaxBatchQuads);
+
+				//orphan the buffer so that the driver need not wait for the previous draw
+				glBufferData(GL_ARRAY_BUFFER, MaxBatchQuads * 4 * sizeof(BatchVertex), nullptr, GL_STREAM_DRAW);
+				glBufferSubData(GL_ARRAY_BUFFER, 0, count * 4 * sizeof(BatchVertex), vertices + i*4);
+
+				glDrawElements(GL_TRIANGLES, count * 6, GL_UNSIGNED_SHORT, (GLvoid*)0);
+				Statistics.DrawCalls++;
+			}
 		}
 	}
 
+	RenderStatistics GetRenderStatistics() {
+		return internal::Statistics;
+	}
+
+	void ResetRenderStatistics() {
+		internal::Statistics = {};
+	}
+
+	void SetBatching(bool value) {
+		internal::batching = value;
+	}
+
+	bool IsBatchingEnabled() {
+		return internal::batching;
+	}
+
 	void Initialize() {
 		using namespace internal;
 
@@ -47,6 +96,22 @@ namespace Gorgon { namespace Graphics {
 			glBindBuffer(GL_ARRAY_BUFFER, quadvbo);
 			glBufferData(GL_ARRAY_BUFFER, 6 * sizeof(int), quadvertexindex, GL_STATIC_DRAW);
 
+			//batch indices never change, each quad is formed from two triangles
+			std::vector<uint16_t> indices(MaxBatchQuads * 6);
+			for(int i=0; i<MaxBatchQuads; i++) {
+				for(int j=0; j<6; j++) {
+					indices[i*6 + j] = uint16_t(i*4 + quadvertexindex[j]);
+				}
+			}
+
+			glGenBuffers(1, &batchibo);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batchibo);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), &indices[0], GL_STATIC_DRAW);
+
+			glGenBuffers(1, &batchvbo);
+			glBindBuffer(GL_ARRAY_BUFFER, batchvbo);
+			glBufferData(GL_ARRAY_BUFFER, MaxBatchQuads * 4 * sizeof(BatchVertex), nullptr, GL_STREAM_DRAW);
+
 			Layer::mask.Generate(true);
 		}
 
@@ -55,8 +120,24 @@ namespace Gorgon { namespace Graphics {
 			glGenVertexArrays(1, &vaos[ctx]);
 			glBindVertexArray(vaos[ctx]);
 
+			glBindBuffer(GL_ARRAY_BUFFER, quadvbo);
 			glEnableVertexAttribArray(0);
 			glVertexAttribIPointer(0, 1, GL_INT, 0, (GLvoid*)0);
+
+			glGenVertexArrays(1, &batchvaos[ctx]);
+			glBindVertexArray(batchvaos[ctx]);
+
+			glBindBuffer(GL_ARRAY_BUFFER, batchvbo);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batchibo);
+
+			glEnableVertexAttribArray(BatchShader::Position);
+			glVertexAttribPointer(BatchShader::Position, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (GLvoid*)offsetof(BatchVertex, Position));
+			glEnableVertexAttribArray(BatchShader::TexCoord);
+			glVertexAttribPointer(BatchShader::TexCoord, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (GLvoid*)offsetof(BatchVertex, TexCoord));
+			glEnableVertexAttribArray(BatchShader::Color);
+			glVertexAttribPointer(BatchShader::Color, 4, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (GLvoid*)offsetof(BatchVertex, Color));
+
+			glBindVertexArray(vaos[ctx]);
 		}
 		
 	}
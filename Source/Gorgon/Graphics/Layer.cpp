@@ -3,6 +3,8 @@
 #include "../GL.h"
 #include "Shaders.h"
 
+#include <vector>
+
 namespace Gorgon { 
 
     extern Graphics::RGBAf LayerColor;
@@ -82,6 +84,68 @@ namespace Graphics {
             glScissor(cliprectangle.X, cliprectangle.Y, cliprectangle.Width, cliprectangle.Height);
         }
 
+        if(IsBatchingEnabled())
+            renderbatched();
+        else
+            rendersurfaces();
+
+        for(auto &l : children) {
+            l.Render();
+        }
+
+        if(clippingenabled) {
+            if(!isclipset)
+                glDisable(GL_SCISSOR_TEST);
+            else {
+                cliprectangle = prevclip;
+                glScissor(cliprectangle.X, cliprectangle.Y, cliprectangle.Width, cliprectangle.Height);
+            }
+        }
+
+        reverttransformandclip();
+        LayerColor = prev_col;
+    }
+
+    void Layer::RenderTo(GL::FrameBuffer &target) {
+        auto size = target.GetSize();
+
+        //frame state is saved as this function is called between frames
+        auto prev_transform = Transform;
+        auto prev_clip      = Clip;
+        auto prev_offset    = Offset;
+        auto prev_screen    = ScreenSize;
+        auto prev_col       = LayerColor;
+
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        target.Use();
+        GL::Resize(size);
+        glClearColor(0, 0, 0, 0);
+        GL::Clear();
+        GL::SetDefaultClear();
+
+        ResetTransform(size);
+        Clip       = {0, 0, size};
+        Offset     = {0, 0};
+        ScreenSize = size;
+        LayerColor = RGBAf(1.f);
+
+        Render();
+
+        target.RenderToScreen();
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+        Transform  = prev_transform;
+        Clip       = prev_clip;
+        Offset     = prev_offset;
+        ScreenSize = prev_screen;
+        LayerColor = prev_col;
+    }
+
+    void Layer::rendersurfaces() {
+        using namespace internal;
+
         ActivateQuadVertices();
         
         int ind = 0;
@@ -188,6 +252,8 @@ namespace Graphics {
             }
 
             DrawQuadVertices();
+            Statistics.Surfaces++;
+            Statistics.Batches++;
             ind++;
         }
         
@@ -195,22 +261,130 @@ namespace Graphics {
             GL::SetDefaultBlending();
             mask.RenderToScreen();
         }
+    }
 
-        for(auto &l : children) {
-            l.Render();
-        }
+    void Layer::renderbatched() {
+        using namespace internal;
 
-        if(clippingenabled) {
-            if(!isclipset)
-                glDisable(GL_SCISSOR_TEST);
+        //Render is only called from the main thread, buffer is reused to avoid reallocation
+        static std::vector<BatchVertex> vertices;
+
+        struct batchkey {
+            BatchShader::Type type;
+            DrawMode mode;
+            GL::Texture texture;
+
+            bool operator ==(const batchkey &other) const {
+                return type == other.type && mode == other.mode && texture == other.texture;
+            }
+        } key = {BatchShader::Fill, Normal, 0};
+
+        auto flush = [&] {
+            if(vertices.empty()) return;
+
+            if(key.mode == UseMask) {
+                BatchShader::UseMasked(key.type)
+                    .SetDiffuse(key.texture)
+                    .SetMask(mask.GetTexture())
+                ;
+            }
             else {
-                cliprectangle = prevclip;
-                glScissor(cliprectangle.X, cliprectangle.Y, cliprectangle.Width, cliprectangle.Height);
+                BatchShader::Use(key.type, key.mode == ToMask ? ShaderMode::ToMask : ShaderMode::Normal)
+                    .SetDiffuse(key.texture)
+                ;
+            }
+
+            DrawBatchVertices(&vertices[0], int(vertices.size() / 4));
+            Statistics.Batches++;
+
+            vertices.clear();
+        };
+        
+        int ind = 0;
+        auto nextop = operations.begin();
+        int nextopind = -1;
+        if(nextop != operations.end())
+            nextopind = (int)nextop->index;
+
+        DrawMode current = Normal;
+
+        for(auto &surface : surfaces) {            
+            while(ind == nextopind) {
+                flush();
+
+                switch(nextop->type) {
+                case Operation::NewMask:
+                    mask.Use();
+                    glClearColor(1.0f, 0, 0, 0);
+                    GL::Clear();
+                    GL::SetDefaultClear();
+                    mask.RenderToScreen();
+                    break;
+                }
+
+                ++nextop;
+                if(nextop != operations.end())
+                    nextopind = (int)nextop->index;
+                else
+                    nextopind = -1;
+
+                ind++;
+            }
+
+            if(surface.GetDrawMode() == ToMask && current != ToMask) {
+                flush();
+                glBlendFuncSeparate(GL_DST_COLOR, GL_ZERO, GL_ONE, GL_ZERO);
+                mask.Use();
             }
+
+            if(surface.GetDrawMode() != ToMask && current == ToMask) {
+                flush();
+                GL::SetDefaultBlending();
+                mask.RenderToScreen();
+            }
+
+            current = surface.GetDrawMode();
+
+            batchkey next = {BatchShader::Fill, current, 0};
+            GL::QuadTextureCoords tex = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+
+            if(surface.IsSet()) {
+                next.type    = surface.GetMode() == ColorMode::Alpha ? BatchShader::Alpha : BatchShader::Simple;
+                next.texture = surface.TextureID();
+
+                tex = surface.GetTextureCoords();
+
+                if(current == FrameBuffer) {
+                    tex.FlipY();
+                }
+            }
+
+            if(!(next == key) || vertices.size() >= MaxBatchQuads * 4) {
+                flush();
+                key = next;
+            }
+
+            auto verts = surface.GetVertices(Transform);
+            auto color = surface.GetColor()*LayerColor;
+
+            for(int i=0; i<4; i++) {
+                vertices.push_back({
+                    {verts[i].X, verts[i].Y, verts[i].Z},
+                    {tex[i].X, tex[i].Y},
+                    {color.R, color.G, color.B, color.A}
+                });
+            }
+
+            Statistics.Surfaces++;
+            ind++;
         }
 
-        reverttransformandclip();
-        LayerColor = prev_col;
+        flush();
+        
+        if(current == ToMask) {
+            GL::SetDefaultBlending();
+            mask.RenderToScreen();
+        }
     }
 
     GL::FrameBuffer Layer::mask;
@@ -273,6 +273,13 @@ namespace Gorgon { namespace Graphics {
         /// Render this layer to the GL. This function is used internally and not necessary to be called
         virtual void Render() override;
 
+        /// Renders this layer and its children immediately to the given frame buffer. The buffer
+        /// is cleared before rendering and the layer is placed according to the size of the buffer.
+        /// Texture of the buffer can then be drawn using FrameBuffer drawing mode. Masking is not
+        /// supported while rendering to a frame buffer. This function should not be called while
+        /// the window is being rendered.
+        void RenderTo(GL::FrameBuffer &target);
+
         ///Get current drawing mode. See Layer page to see available drawing modes
         virtual DrawMode GetDrawMode() const override { return mode; }
 
@@ -323,6 +330,12 @@ namespace Gorgon { namespace Graphics {
         using Gorgon::Layer::GetSize;
 
     private:
+        /// Renders surfaces one by one
+        void rendersurfaces();
+
+        /// Renders surfaces by combining consecutive surfaces that can be drawn together
+        void renderbatched();
+
         std::vector<internal::Surface> surfaces;
         std::vector<Operation> operations;
 
@@ -0,0 +1,516 @@
+#include "PixelConversion.h"
+
+#include "../Utils/Compiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef GORGON_SSE2
+#   include <emmintrin.h>
+#endif
+
+#ifdef GORGON_X86
+#   include <immintrin.h>
+#endif
+
+namespace Gorgon { namespace Graphics {
+
+    namespace {
+        //modes in the order they are placed in the converter table
+        const int ModeCount = 7;
+
+        int modeindex(ColorMode mode) {
+            switch(mode) {
+            case ColorMode::RGB:             return 0;
+            case ColorMode::BGR:             return 1;
+            case ColorMode::RGBA:            return 2;
+            case ColorMode::BGRA:            return 3;
+            case ColorMode::Grayscale:       return 4;
+            case ColorMode::Grayscale_Alpha: return 5;
+            case ColorMode::Alpha:           return 6;
+            default:                         return -1;
+            }
+        }
+
+        constexpr int channelsof(ColorMode mode) {
+            return mode == ColorMode::RGBA || mode == ColorMode::BGRA ? 4 :
+                   mode == ColorMode::RGB  || mode == ColorMode::BGR  ? 3 :
+                   mode == ColorMode::Grayscale_Alpha ? 2 : 1;
+        }
+
+        //alpha only images are considered to be white
+        constexpr bool isgray(ColorMode mode) {
+            return mode == ColorMode::Grayscale || mode == ColorMode::Grayscale_Alpha || mode == ColorMode::Alpha;
+        }
+
+        template<ColorMode M_>
+        RGBA readpixel(const Byte *p) {
+            switch(M_) {
+            case ColorMode::RGB:             return {p[0], p[1], p[2], 255};
+            case ColorMode::BGR:             return {p[2], p[1], p[0], 255};
+            case ColorMode::RGBA:            return {p[0], p[1], p[2], p[3]};
+            case ColorMode::BGRA:            return {p[2], p[1], p[0], p[3]};
+            case ColorMode::Grayscale:       return {p[0], p[0], p[0], 255};
+            case ColorMode::Grayscale_Alpha: return {p[0], p[0], p[0], p[1]};
+            default:                         return {255, 255, 255, p[0]};
+            }
+        }
+
+        template<ColorMode M_>
+        void writepixel(Byte *p, RGBA c, bool gray) {
+            switch(M_) {
+            case ColorMode::RGB:
+                p[0] = c.R; p[1] = c.G; p[2] = c.B;
+                break;
+            case ColorMode::BGR:
+                p[0] = c.B; p[1] = c.G; p[2] = c.R;
+                break;
+            case ColorMode::RGBA:
+                p[0] = c.R; p[1] = c.G; p[2] = c.B; p[3] = c.A;
+                break;
+            case ColorMode::BGRA:
+                p[0] = c.B; p[1] = c.G; p[2] = c.R; p[3] = c.A;
+                break;
+            case ColorMode::Grayscale:
+                p[0] = gray ? c.R : c.Luminance();
+                break;
+            case ColorMode::Grayscale_Alpha:
+                p[0] = gray ? c.R : c.Luminance(); p[1] = c.A;
+                break;
+            default:
+                p[0] = c.A;
+                break;
+            }
+        }
+
+        //converts pixels in [begin, end), the whole pixel is read before it is written,
+        //so in place conversion is possible when the pixel sizes match
+        template<ColorMode F_, ColorMode T_>
+        void convertportable(const Byte *source, Byte *destination, long begin, long end) {
+            for(long i=begin; i<end; i++)
+                writepixel<T_>(destination + i * channelsof(T_), readpixel<F_>(source + i * channelsof(F_)), isgray(F_));
+        }
+
+        template<ColorMode F_, ColorMode T_>
+        void portable(const Byte *source, Byte *destination, long count) {
+            convertportable<F_, T_>(source, destination, 0, count);
+        }
+
+        void copy(const Byte *source, Byte *destination, long count, int channels) {
+            if(source != destination)
+                memcpy(destination, source, count * channels);
+        }
+
+        template<int C_>
+        void identity(const Byte *source, Byte *destination, long count) {
+            copy(source, destination, count, C_);
+        }
+
+        //SIMD kernels convert as many pixels as they can in blocks and return the number of
+        //pixels converted, remaining pixels are converted by the portable version
+        typedef long (*Kernel)(const Byte *source, Byte *destination, long count);
+
+        template<ColorMode F_, ColorMode T_, Kernel K_>
+        void accelerated(const Byte *source, Byte *destination, long count) {
+            convertportable<F_, T_>(source, destination, K_(source, destination, count), count);
+        }
+
+#ifdef GORGON_SSE2
+        //RGBA <-> BGRA
+        long swapsse2(const Byte *source, Byte *destination, long count) {
+            __m128i ag = _mm_set1_epi32(0xff00ff00), rb = _mm_set1_epi32(0x00ff00ff);
+            long i = 0;
+
+            for(; i + 4 <= count; i += 4) {
+                __m128i v = _mm_loadu_si128((const __m128i*)(source + i*4));
+                __m128i c = _mm_and_si128(v, rb);
+
+                c = _mm_or_si128(_mm_slli_epi32(c, 16), _mm_srli_epi32(c, 16));
+
+                _mm_storeu_si128((__m128i*)(destination + i*4), _mm_or_si128(_mm_and_si128(v, ag), c));
+            }
+
+            return i;
+        }
+
+        //Grayscale -> RGBA or BGRA
+        long graysse2(const Byte *source, Byte *destination, long count) {
+            __m128i ff = _mm_set1_epi8(-1);
+            long i = 0;
+
+            for(; i + 16 <= count; i += 16) {
+                __m128i g  = _mm_loadu_si128((const __m128i*)(source + i));
+                __m128i gg = _mm_unpacklo_epi8(g, g), ga = _mm_unpacklo_epi8(g, ff);
+                __m128i *out = (__m128i*)(destination + i*4);
+
+                _mm_storeu_si128(out,     _mm_unpacklo_epi16(gg, ga));
+                _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(gg, ga));
+
+                gg = _mm_unpackhi_epi8(g, g);
+                ga = _mm_unpackhi_epi8(g, ff);
+
+                _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(gg, ga));
+                _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(gg, ga));
+            }
+
+            return i;
+        }
+
+        //Alpha -> RGBA or BGRA
+        long alphasse2(const Byte *source, Byte *destination, long count) {
+            __m128i ff = _mm_set1_epi8(-1);
+            long i = 0;
+
+            for(; i + 16 <= count; i += 16) {
+                __m128i a  = _mm_loadu_si128((const __m128i*)(source + i));
+                __m128i fa = _mm_unpacklo_epi8(ff, a);
+                __m128i *out = (__m128i*)(destination + i*4);
+
+                _mm_storeu_si128(out,     _mm_unpacklo_epi16(ff, fa));
+                _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(ff, fa));
+
+                fa = _mm_unpackhi_epi8(ff, a);
+
+                _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(ff, fa));
+                _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(ff, fa));
+            }
+
+            return i;
+        }
+
+        //Grayscale_Alpha -> RGBA or BGRA
+        long grayalphasse2(const Byte *source, Byte *destination, long count) {
+            __m128i low = _mm_set1_epi16(0xff);
+            long i = 0;
+
+            for(; i + 8 <= count; i += 8) {
+                __m128i v  = _mm_loadu_si128((const __m128i*)(source + i*2));
+                __m128i g  = _mm_and_si128(v, low);
+                __m128i gg = _mm_or_si128(g, _mm_slli_epi16(g, 8));
+                __m128i *out = (__m128i*)(destination + i*4);
+
+                _mm_storeu_si128(out,     _mm_unpacklo_epi16(gg, v));
+                _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(gg, v));
+            }
+
+            return i;
+        }
+
+        //Grayscale -> Grayscale_Alpha and Alpha -> Grayscale_Alpha. Alpha only images are
+        //white, so both cases interleave a constant with the source
+        template<bool A_>
+        long tograyalphasse2(const Byte *source, Byte *destination, long count) {
+            __m128i ff = _mm_set1_epi8(-1);
+            long i = 0;
+
+            for(; i + 16 <= count; i += 16) {
+                __m128i v = _mm_loadu_si128((const __m128i*)(source + i));
+                __m128i *out = (__m128i*)(destination + i*2);
+
+                _mm_storeu_si128(out,     A_ ? _mm_unpacklo_epi8(ff, v) : _mm_unpacklo_epi8(v, ff));
+                _mm_storeu_si128(out + 1, A_ ? _mm_unpackhi_epi8(ff, v) : _mm_unpackhi_epi8(v, ff));
+            }
+
+            return i;
+        }
+
+        //Grayscale_Alpha -> Grayscale or Alpha
+        template<bool A_>
+        long fromgrayalphasse2(const Byte *source, Byte *destination, long count) {
+            __m128i low = _mm_set1_epi16(0xff);
+            long i = 0;
+
+            auto channel = [&](const Byte *p) {
+                __m128i v = _mm_loadu_si128((const __m128i*)p);
+
+                return A_ ? _mm_srli_epi16(v, 8) : _mm_and_si128(v, low);
+            };
+
+            for(; i + 16 <= count; i += 16)
+                _mm_storeu_si128((__m128i*)(destination + i), _mm_packus_epi16(channel(source + i*2), channel(source + i*2 + 16)));
+
+            return i;
+        }
+
+        //RGBA or BGRA -> Alpha
+        long extractalphasse2(const Byte *source, Byte *destination, long count) {
+            long i = 0;
+
+            auto alpha = [&](int j) {
+                return _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(source + i*4 + j*16)), 24);
+            };
+
+            for(; i + 16 <= count; i += 16) {
+                __m128i a = _mm_packs_epi32(alpha(0), alpha(1));
+                __m128i b = _mm_packs_epi32(alpha(2), alpha(3));
+
+                _mm_storeu_si128((__m128i*)(destination + i), _mm_packus_epi16(a, b));
+            }
+
+            return i;
+        }
+#endif
+
+#ifdef GORGON_X86
+        //byte orders for pshufb, -1 clears the byte
+        inline __m128i swapmask() {
+            return _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+        }
+
+        inline __m128i expandmask(bool swap) {
+            return swap ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+                        : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        }
+
+        inline __m128i packmask(bool swap) {
+            return swap ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+                        : _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        }
+
+        TARGET_SSSE3 long swapssse3(const Byte *source, Byte *destination, long count) {
+            __m128i mask = swapmask();
+            long i = 0;
+
+            for(; i + 4 <= count; i += 4)
+                _mm_storeu_si128((__m128i*)(destination + i*4), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + i*4)), mask));
+
+            return i;
+        }
+
+        //RGB <-> BGR, 5 pixels are converted from each 16 bytes. The last byte belongs to the
+        //next pixel and is written back unchanged, thus in place conversion is safe.
+        TARGET_SSSE3 long swap3ssse3(const Byte *source, Byte *destination, long count) {
+            __m128i mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+            long i = 0;
+
+            for(; (i + 5) * 3 + 1 <= count * 3; i += 5)
+                _mm_storeu_si128((__m128i*)(destination + i*3), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + i*3)), mask));
+
+            return i;
+        }
+
+        //RGB or BGR -> RGBA or BGRA, S_ swaps red and blue
+        template<bool S_>
+        TARGET_SSSE3 long expandssse3(const Byte *source, Byte *destination, long count) {
+            __m128i mask = expandmask(S_), alpha = _mm_set1_epi32(0xff000000);
+            long i = 0;
+
+            for(; i + 16 <= count; i += 16) {
+                const Byte *in = source + i*3;
+                __m128i a = _mm_loadu_si128((const __m128i*)in);
+                __m128i b = _mm_loadu_si128((const __m128i*)(in + 16));
+                __m128i c = _mm_loadu_si128((const __m128i*)(in + 32));
+                __m128i *out = (__m128i*)(destination + i*4);
+
+                _mm_storeu_si128(out,     _mm_or_si128(_mm_shuffle_epi8(a, mask), alpha));
+                _mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), mask), alpha));
+                _mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), mask), alpha));
+                _mm_storeu_si128(out + 3, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), mask), alpha));
+            }
+
+            return i;
+        }
+
+        //RGBA or BGRA -> RGB or BGR, S_ swaps red and blue
+        template<bool S_>
+        TARGET_SSSE3 long packssse3(const Byte *source, Byte *destination, long count) {
+            __m128i mask = packmask(S_);
+            long i = 0;
+
+            for(; i + 16 <= count; i += 16) {
+                const __m128i *in = (const __m128i*)(source + i*4);
+                __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(in),     mask);
+                __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(in + 1), mask);
+                __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(in + 2), mask);
+                __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(in + 3), mask);
+                __m128i *out = (__m128i*)(destination + i*3);
+
+                _mm_storeu_si128(out,     _mm_or_si128(a, _mm_slli_si128(b, 12)));
+                _mm_storeu_si128(out + 1, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+                _mm_storeu_si128(out + 2, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+            }
+
+            return i;
+        }
+
+        TARGET_AVX2 long swapavx2(const Byte *source, Byte *destination, long count) {
+            __m256i mask = _mm256_broadcastsi128_si256(swapmask());
+            long i = 0;
+
+            for(; i + 8 <= count; i += 8)
+                _mm256_storeu_si256((__m256i*)(destination + i*4), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(source + i*4)), mask));
+
+            return i;
+        }
+
+        //RGB or BGR -> RGBA or BGRA. 8 pixels are placed into two lanes, 4 pixels each, then
+        //expanded within the lanes. Reads 8 bytes past the 8 pixels, loop stops before the
+        //end of the source.
+        template<bool S_>
+        TARGET_AVX2 long expandavx2(const Byte *source, Byte *destination, long count) {
+            __m256i mask   = _mm256_broadcastsi128_si256(expandmask(S_));
+            __m256i alpha  = _mm256_set1_epi32(0xff000000);
+            __m256i spread = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+            long i = 0;
+
+            for(; i * 3 + 32 <= count * 3; i += 8) {
+                __m256i v = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)(source + i*3)), spread);
+
+                _mm256_storeu_si256((__m256i*)(destination + i*4), _mm256_or_si256(_mm256_shuffle_epi8(v, mask), alpha));
+            }
+
+            return i;
+        }
+#endif
+
+        template<ColorMode F_>
+        void fillrow(PixelConverter *row) {
+            row[0] = &portable<F_, ColorMode::RGB>;
+            row[1] = &portable<F_, ColorMode::BGR>;
+            row[2] = &portable<F_, ColorMode::RGBA>;
+            row[3] = &portable<F_, ColorMode::BGRA>;
+            row[4] = &portable<F_, ColorMode::Grayscale>;
+            row[5] = &portable<F_, ColorMode::Grayscale_Alpha>;
+            row[6] = &portable<F_, ColorMode::Alpha>;
+        }
+
+        typedef std::array<PixelConverter, ModeCount * ModeCount> ConverterTable;
+
+        ConverterTable buildtable() {
+            ConverterTable table;
+
+            auto set = [&table](ColorMode from, ColorMode to, PixelConverter converter) {
+                table[modeindex(from) * ModeCount + modeindex(to)] = converter;
+            };
+
+            fillrow<ColorMode::RGB>(&table[0 * ModeCount]);
+            fillrow<ColorMode::BGR>(&table[1 * ModeCount]);
+            fillrow<ColorMode::RGBA>(&table[2 * ModeCount]);
+            fillrow<ColorMode::BGRA>(&table[3 * ModeCount]);
+            fillrow<ColorMode::Grayscale>(&table[4 * ModeCount]);
+            fillrow<ColorMode::Grayscale_Alpha>(&table[5 * ModeCount]);
+            fillrow<ColorMode::Alpha>(&table[6 * ModeCount]);
+
+            for(ColorMode mode : {ColorMode::RGB, ColorMode::BGR})
+                set(mode, mode, &identity<3>);
+
+            for(ColorMode mode : {ColorMode::RGBA, ColorMode::BGRA})
+                set(mode, mode, &identity<4>);
+
+            set(ColorMode::Grayscale_Alpha, ColorMode::Grayscale_Alpha, &identity<2>);
+
+            for(ColorMode mode : {ColorMode::Grayscale, ColorMode::Alpha})
+                set(mode, mode, &identity<1>);
+
+            using CM = ColorMode;
+
+#ifdef GORGON_SSE2
+            set(CM::RGBA, CM::BGRA, &accelerated<CM::RGBA, CM::BGRA, swapsse2>);
+            set(CM::BGRA, CM::RGBA, &accelerated<CM::BGRA, CM::RGBA, swapsse2>);
+
+            set(CM::Grayscale, CM::RGBA, &accelerated<CM::Grayscale, CM::RGBA, graysse2>);
+            set(CM::Grayscale, CM::BGRA, &accelerated<CM::Grayscale, CM::BGRA, graysse2>);
+
+            set(CM::Grayscale_Alpha, CM::RGBA, &accelerated<CM::Grayscale_Alpha, CM::RGBA, grayalphasse2>);
+            set(CM::Grayscale_Alpha, CM::BGRA, &accelerated<CM::Grayscale_Alpha, CM::BGRA, grayalphasse2>);
+
+            set(CM::Alpha, CM::RGBA, &accelerated<CM::Alpha, CM::RGBA, alphasse2>);
+            set(CM::Alpha, CM::BGRA, &accelerated<CM::Alpha, CM::BGRA, alphasse2>);
+
+            set(CM::Grayscale, CM::Grayscale_Alpha, &accelerated<CM::Grayscale, CM::Grayscale_Alpha, tograyalphasse2<false>>);
+            set(CM::Alpha,     CM::Grayscale_Alpha, &accelerated<CM::Alpha,     CM::Grayscale_Alpha, tograyalphasse2<true>>);
+
+            set(CM::Grayscale_Alpha, CM::Grayscale, &accelerated<CM::Grayscale_Alpha, CM::Grayscale, fromgrayalphasse2<false>>);
+            set(CM::Grayscale_Alpha, CM::Alpha,     &accelerated<CM::Grayscale_Alpha, CM::Alpha,     fromgrayalphasse2<true>>);
+
+            set(CM::RGBA, CM::Alpha, &accelerated<CM::RGBA, CM::Alpha, extractalphasse2>);
+            set(CM::BGRA, CM::Alpha, &accelerated<CM::BGRA, CM::Alpha, extractalphasse2>);
+#endif
+
+#ifdef GORGON_X86
+            if(Utils::SupportsSSSE3()) {
+                set(CM::RGBA, CM::BGRA, &accelerated<CM::RGBA, CM::BGRA, swapssse3>);
+                set(CM::BGRA, CM::RGBA, &accelerated<CM::BGRA, CM::RGBA, swapssse3>);
+
+                set(CM::RGB, CM::BGR, &accelerated<CM::RGB, CM::BGR, swap3ssse3>);
+                set(CM::BGR, CM::RGB, &accelerated<CM::BGR, CM::RGB, swap3ssse3>);
+
+                set(CM::RGB, CM::RGBA, &accelerated<CM::RGB, CM::RGBA, expandssse3<false>>);
+                set(CM::BGR, CM::BGRA, &accelerated<CM::BGR, CM::BGRA, expandssse3<false>>);
+                set(CM::RGB, CM::BGRA, &accelerated<CM::RGB, CM::BGRA, expandssse3<true>>);
+                set(CM::BGR, CM::RGBA, &accelerated<CM::BGR, CM::RGBA, expandssse3<true>>);
+
+                set(CM::RGBA, CM::RGB, &accelerated<CM::RGBA, CM::RGB, packssse3<false>>);
+                set(CM::BGRA, CM::BGR, &accelerated<CM::BGRA, CM::BGR, packssse3<false>>);
+                set(CM::RGBA, CM::BGR, &accelerated<CM::RGBA, CM::BGR, packssse3<true>>);
+                set(CM::BGRA, CM::RGB, &accelerated<CM::BGRA, CM::RGB, packssse3<true>>);
+            }
+
+            if(Utils::SupportsAVX2()) {
+                set(CM::RGBA, CM::BGRA, &accelerated<CM::RGBA, CM::BGRA, swapavx2>);
+                set(CM::BGRA, CM::RGBA, &accelerated<CM::BGRA, CM::RGBA, swapavx2>);
+
+                set(CM::RGB, CM::RGBA, &accelerated<CM::RGB, CM::RGBA, expandavx2<false>>);
+                set(CM::BGR, CM::BGRA, &accelerated<CM::BGR, CM::BGRA, expandavx2<false>>);
+                set(CM::RGB, CM::BGRA, &accelerated<CM::RGB, CM::BGRA, expandavx2<true>>);
+                set(CM::BGR, CM::RGBA, &accelerated<CM::BGR, CM::RGBA, expandavx2<true>>);
+            }
+#endif
+
+            return table;
+        }
+    }
+
+    PixelConverter GetPixelConverter(ColorMode from, ColorMode to) {
+        static const ConverterTable table = buildtable();
+
+        int f = modeindex(from), t = modeindex(to);
+
+        if(f == -1 || t == -1)
+            return nullptr;
+
+        return table[f * ModeCount + t];
+    }
+
+    void ConvertPixels(const Byte *source, ColorMode from, Byte *destination, ColorMode to, long count) {
+        auto converter = GetPixelConverter(from, to);
+
+        if(!converter)
+            throw std::runtime_error("Invalid color mode");
+
+        converter(source, destination, count);
+    }
+
+    void ConvertPixels(const Byte *source, ColorMode from, unsigned long *destination, long count) {
+        auto converter = GetPixelConverter(from, ColorMode::BGRA);
+
+        if(!converter)
+            throw std::runtime_error("Invalid color mode");
+
+        if(sizeof(unsigned long) == 4) {
+            converter(source, (Byte*)destination, count);
+
+            return;
+        }
+
+        //convert in small blocks that stay in cache, then widen
+        const long block = 1024;
+        Byte buffer[block * 4];
+        int cpp = channelsof(from);
+
+        for(long i=0; i<count; i+=block) {
+            long n = std::min(block, count - i);
+
+            converter(source + i * cpp, buffer, n);
+
+            for(long j=0; j<n; j++) {
+                const Byte *p = buffer + j*4;
+
+                destination[i + j] = (unsigned long)p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+            }
+        }
+    }
+
+} }
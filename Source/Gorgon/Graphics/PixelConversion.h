@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../Types.h"
+#include "Color.h"
+
+namespace Gorgon { namespace Graphics {
+
+    /// Converts the given number of pixels from one color mode to another. Source and
+    /// destination should not overlap, unless both modes have the same number of channels
+    /// per pixel, in which case they can be the same buffer.
+    typedef void (*PixelConverter)(const Byte *source, Byte *destination, long count);
+
+    /**
+     * Returns the converter that converts pixels from the first mode to the second one. All
+     * pairs of RGB, BGR, RGBA, BGRA, Grayscale, Grayscale_Alpha and Alpha modes are supported.
+     * Converters are selected according to the instruction sets supported by the processor,
+     * the first call will perform the detection. Missing color channels are set to 255, while
+     * color channels are reduced to grayscale using RGBA::Luminance. Returns nullptr for
+     * invalid modes.
+     */
+    PixelConverter GetPixelConverter(ColorMode from, ColorMode to);
+
+    /// Converts the given number of pixels from one color mode to another. The destination
+    /// should have room for count * GetChannelsPerPixel(to) bytes. Throws if either mode is
+    /// invalid.
+    void ConvertPixels(const Byte *source, ColorMode from, Byte *destination, ColorMode to, long count);
+
+    /// Converts the given number of pixels to 32-bit BGRA values, blue in the lowest byte order.
+    /// This layout is used by X11 icons, which are stored in unsigned long regardless of its
+    /// size.
+    void ConvertPixels(const Byte *source, ColorMode from, unsigned long *destination, long count);
+
+} }
@@ -71,4 +71,123 @@ namespace Gorgon { namespace Graphics {
 		InitializeWithSource(MaskedNoTex_V, MaskedFill_F);
 	}
 
+	static std::string TypeName(BatchShader::Type type) {
+		switch(type) {
+		case BatchShader::Simple:
+			return "Simple";
+		case BatchShader::Alpha:
+			return "Alpha";
+		case BatchShader::Fill:
+			return "Fill";
+		default:
+			return "Unknown";
+		}
+	}
+
+	BatchShader &BatchShader::Use(Type type, ShaderMode mode) {
+		static BatchShader 
+			simple(Simple, ShaderMode::Normal), simpletomask(Simple, ShaderMode::ToMask),
+			alpha(Alpha, ShaderMode::Normal),   alphatomask(Alpha, ShaderMode::ToMask),
+			fill(Fill, ShaderMode::Normal),     filltomask(Fill, ShaderMode::ToMask)
+		;
+
+		BatchShader *shader;
+
+		switch(type) {
+		case Simple:
+			shader = mode == ShaderMode::ToMask ? &simpletomask : &simple;
+			break;
+		case Alpha:
+			shader = mode == ShaderMode::ToMask ? &alphatomask : &alpha;
+			break;
+		case Fill:
+			shader = mode == ShaderMode::ToMask ? &filltomask : &fill;
+			break;
+		default:
+			throw std::runtime_error("Unknown batch shader type");
+		}
+
+		shader->Shader::Use();
+
+		return *shader;
+	}
+
+	BatchShader &BatchShader::UseMasked(Type type) {
+		static BatchShader 
+			simple(Simple, ShaderMode::Normal, true),
+			alpha(Alpha, ShaderMode::Normal, true),
+			fill(Fill, ShaderMode::Normal, true)
+		;
+
+		BatchShader *shader;
+
+		switch(type) {
+		case Simple:
+			shader = &simple;
+			break;
+		case Alpha:
+			shader = &alpha;
+			break;
+		case Fill:
+			shader = &fill;
+			break;
+		default:
+			throw std::runtime_error("Unknown batch shader type");
+		}
+
+		shader->Shader::Use();
+
+		return *shader;
+	}
+
+	BatchShader::BatchShader(Type type, ShaderMode mode, bool masked) : 
+		Shader("Gorgon::Graphics::Batch-"+TypeName(type)+"-"+(masked ? std::string("Masked") : ModeName(mode)))
+	{
+		SetAttributeLocation("vertex_position", Position);
+		SetAttributeLocation("vertex_texcoord", TexCoord);
+		SetAttributeLocation("vertex_color",    Color);
+
+		std::map<std::string, std::string> defines = {{"BATCH", "1"}};
+
+		if(masked) {
+			defines["MASKED"] = "1";
+
+			switch(type) {
+			case Simple:
+				InitializeWithSource(Batch_V, Masked_F, defines);
+				break;
+			case Alpha:
+				InitializeWithSource(Batch_V, MaskedAlpha_F, defines);
+				break;
+			case Fill:
+				InitializeWithSource(Batch_V, MaskedFill_F, defines);
+				break;
+			default:
+				throw std::runtime_error("Unknown batch shader type");
+			}
+		}
+		else if(mode == ShaderMode::ToMask) {
+			InitializeWithSource(Batch_V, type == Fill ? ToMaskFill_F : ToMask_F, defines);
+		}
+		else {
+			switch(type) {
+			case Simple:
+				InitializeWithSource(Batch_V, Simple_F, defines);
+				break;
+			case Alpha:
+				InitializeWithSource(Batch_V, Alpha_F, defines);
+				break;
+			case Fill:
+				InitializeWithSource(Batch_V, Fill_F, defines);
+				break;
+			default:
+				throw std::runtime_error("Unknown batch shader type");
+			}
+		}
+
+		Shader::Use();
+		BindTexture("diffuse", 0);
+		BindTexture("mask", 1);
+	}
+
 } }
@@ -311,5 +311,53 @@ namespace Gorgon { namespace Graphics {
 		MaskedFillShader();
 	};
 
+	/// This shader is used to draw batches of quads. Vertex positions, texture coordinates and
+	/// tint colors are supplied as vertex attributes instead of uniforms, allowing many surfaces
+	/// sharing a texture to be drawn with a single draw call.
+	class BatchShader : private GL::Shader {
+	public:
+		/// Type of the fragment operation
+		enum Type {
+			/// Texture is multiplied by the tint color
+			Simple,
+			/// Alpha channel of the texture is used with the tint color
+			Alpha,
+			/// No texture, area is filled with the tint color
+			Fill
+		};
+
+		/// Vertex attribute locations used by batch shaders
+		enum Attribute {
+			Position,
+			TexCoord,
+			Color
+		};
+
+		/// Activates the batch shader for the given type and mode.
+		static BatchShader &Use(Type type, ShaderMode mode = ShaderMode::Normal);
+
+		/// Activates the masked batch shader for the given type.
+		static BatchShader &UseMasked(Type type);
+
+		/// Sets diffuse texture
+		BatchShader &SetDiffuse(GL::Texture value) {
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, value);
+
+			return *this;
+		}
+
+		/// Sets the mask texture
+		BatchShader &SetMask(GL::Texture value) {
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, value);
+
+			return *this;
+		}
+
+	private:
+		BatchShader(Type type, ShaderMode mode, bool masked = false);
+	};
+
 
 } }
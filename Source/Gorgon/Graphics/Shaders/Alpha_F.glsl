@@ -3,7 +3,11 @@
 in vec2 texcoord;
 
 uniform sampler2D diffuse;
+#ifdef BATCH
+in vec4           tint;
+#else
 uniform vec4      tint;
+#endif
 
 out vec4 output_color;
 
@@ -0,0 +1,23 @@
+#version 130
+
+in vec3 vertex_position;
+in vec2 vertex_texcoord;
+in vec4 vertex_color;
+
+out vec2 texcoord;
+out vec4 tint;
+#ifdef MASKED
+out vec2 maskcoord;
+#endif
+  
+void main()
+{
+	gl_Position = vec4(vertex_position, 1.0f);
+
+    texcoord = vertex_texcoord;
+    tint = vertex_color;
+
+#ifdef MASKED
+	maskcoord = vec2((vertex_position.x + 1) / 2, (vertex_position.y + 1) / 2);
+#endif
+}
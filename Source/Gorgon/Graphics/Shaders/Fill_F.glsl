@@ -1,6 +1,10 @@
 #version 130
 
+#ifdef BATCH
+in vec4           tint;
+#else
 uniform vec4      tint;
+#endif
 
 out vec4 output_color;
 
@@ -5,7 +5,11 @@ in vec2 maskcoord;
 
 uniform sampler2D diffuse;
 uniform sampler2D mask;
+#ifdef BATCH
+in vec4           tint;
+#else
 uniform vec4      tint;
+#endif
 
 out vec4 output_color;
 
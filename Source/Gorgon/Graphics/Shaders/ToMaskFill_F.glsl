@@ -2,7 +2,11 @@
 
 in vec2 texcoord;
 
+#ifdef BATCH
+in vec4           tint;
+#else
 uniform vec4      tint;
+#endif
 
 out vec4 output_color;
 
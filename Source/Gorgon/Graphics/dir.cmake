@@ -5,6 +5,8 @@ SET(Local
 	AdvancedPrinterConstants.h
 	AdvancedPrinter.cpp
 	Animations.h
+	Atlas.h
+	Atlas.cpp
 	Bitmap.h
 	Bitmap.cpp
 	BlankImage.h
@@ -12,6 +14,8 @@ SET(Local
 	Color.cpp
 	ColorSpaces.h
 	ColorSpaces.cpp
+	PixelConversion.h
+	PixelConversion.cpp
 	Drawables.h
 	EmptyImage.h
 	Font.h
@@ -49,6 +53,7 @@ endif()
 EmbedShaders(ShaderSrc.strings.gen Shaders.cpp 
 	"Shaders/Simple_V.glsl"
 	"Shaders/NoTex_V.glsl"	
+	"Shaders/Batch_V.glsl"	
 	"Shaders/Simple_F.glsl"	
 	"Shaders/Alpha_F.glsl"	
 	"Shaders/Fill_F.glsl"	
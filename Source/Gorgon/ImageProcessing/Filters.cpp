@@ -0,0 +1,288 @@
+#include "Filters.h"
+
+#include "../Utils/Compiler.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef GORGON_SSE2
+#   include <emmintrin.h>
+#endif
+
+#ifdef GORGON_X86
+#   include <immintrin.h>
+#endif
+
+namespace Gorgon { namespace ImageProcessing { namespace internal {
+
+    std::vector<int> taptable(int size, int taps, OutOfBoundsPolicy policy) {
+        std::vector<int> table(size_t(size) * taps);
+
+        for(int x=0; x<size; x++) {
+            for(int i=0; i<taps; i++) {
+                int c = x - i + taps/2;
+
+                if(c < 0 || c >= size) {
+                    switch(policy) {
+                    case OutOfBoundsPolicy::NearestNeighbor:
+                        c = Clamp(c, 0, size - 1);
+                        break;
+
+                    case OutOfBoundsPolicy::Cyclic:
+                        c = PositiveMod(c, size);
+                        break;
+
+                    case OutOfBoundsPolicy::Mirror:
+                        c = Clamp(Mirror(c, size - 1), 0, size - 1);
+                        break;
+
+                    default:
+                        c = size;
+                        break;
+                    }
+                }
+
+                table[x * taps + i] = c;
+            }
+        }
+
+        return table;
+    }
+
+    int convolutionthreads(long work, int bands) {
+        //below this amount of multiplications, starting threads costs more than it saves
+        if(work < 1 << 20)
+            return 1;
+
+        int threads = (int)std::thread::hardware_concurrency();
+
+        return Clamp(threads, 1, bands);
+    }
+
+    namespace {
+        //out[q] += sum of in[q + offsets[i]] * kernel[i] for q in [begin, end)
+        void convolveportable(const float *in, float *out, int begin, int end, const int *offsets, const float *kernel, int size) {
+            for(int q=begin; q<end; q++) {
+                float acc = 0;
+
+                for(int i=0; i<size; i++)
+                    acc += in[q + offsets[i]] * kernel[i];
+
+                out[q] += acc;
+            }
+        }
+
+        void accumulateportable(const float *in, float *out, int begin, int end, float weight) {
+            for(int i=begin; i<end; i++)
+                out[i] += in[i] * weight;
+        }
+
+#ifdef GORGON_SSE2
+        int convolvesse2(const float *in, float *out, int begin, int end, const int *offsets, const float *kernel, int size) {
+            int q = begin;
+
+            for(; q + 8 <= end; q += 8) {
+                __m128 acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps();
+
+                for(int i=0; i<size; i++) {
+                    __m128 k = _mm_set1_ps(kernel[i]);
+                    const float *p = in + q + offsets[i];
+
+                    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(p), k));
+                    acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(p + 4), k));
+                }
+
+                _mm_storeu_ps(out + q,     _mm_add_ps(_mm_loadu_ps(out + q), acc1));
+                _mm_storeu_ps(out + q + 4, _mm_add_ps(_mm_loadu_ps(out + q + 4), acc2));
+            }
+
+            return q;
+        }
+
+        int accumulatesse2(const float *in, float *out, int begin, int end, float weight) {
+            __m128 w = _mm_set1_ps(weight);
+            int i = begin;
+
+            for(; i + 4 <= end; i += 4)
+                _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), w)));
+
+            return i;
+        }
+
+        int loadsse2(const Byte *in, float *out, int count) {
+            __m128i zero = _mm_setzero_si128();
+            int i = 0;
+
+            for(; i + 16 <= count; i += 16) {
+                __m128i b = _mm_loadu_si128((const __m128i*)(in + i));
+                __m128i lo = _mm_unpacklo_epi8(b, zero), hi = _mm_unpackhi_epi8(b, zero);
+
+                _mm_storeu_ps(out + i,      _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)));
+                _mm_storeu_ps(out + i + 4,  _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)));
+                _mm_storeu_ps(out + i + 8,  _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)));
+                _mm_storeu_ps(out + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)));
+            }
+
+            return i;
+        }
+
+        int storesse2(const float *in, Byte *out, int count, bool round) {
+            __m128 lo = _mm_setzero_ps(), hi = _mm_set1_ps(255.f);
+            __m128 half = _mm_set1_ps(round ? 0.5f : 0.f);
+            int i = 0;
+
+            //clamping before the conversion avoids overflow, packing with saturation keeps
+            //the values in range afterwards
+            auto convert = [&](const float *p) {
+                return _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), lo), hi), half));
+            };
+
+            for(; i + 16 <= count; i += 16) {
+                __m128i a = _mm_packs_epi32(convert(in + i),     convert(in + i + 4));
+                __m128i b = _mm_packs_epi32(convert(in + i + 8), convert(in + i + 12));
+
+                _mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi16(a, b));
+            }
+
+            return i;
+        }
+#endif
+
+#ifdef GORGON_X86
+        TARGET_AVX2 int convolveavx2(const float *in, float *out, int begin, int end, const int *offsets, const float *kernel, int size) {
+            int q = begin;
+
+            for(; q + 16 <= end; q += 16) {
+                __m256 acc1 = _mm256_setzero_ps(), acc2 = _mm256_setzero_ps();
+
+                for(int i=0; i<size; i++) {
+                    __m256 k = _mm256_set1_ps(kernel[i]);
+                    const float *p = in + q + offsets[i];
+
+                    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(p), k, acc1);
+                    acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(p + 8), k, acc2);
+                }
+
+                _mm256_storeu_ps(out + q,     _mm256_add_ps(_mm256_loadu_ps(out + q), acc1));
+                _mm256_storeu_ps(out + q + 8, _mm256_add_ps(_mm256_loadu_ps(out + q + 8), acc2));
+            }
+
+            return q;
+        }
+
+        TARGET_AVX2 int accumulateavx2(const float *in, float *out, int begin, int end, float weight) {
+            __m256 w = _mm256_set1_ps(weight);
+            int i = begin;
+
+            for(; i + 8 <= end; i += 8)
+                _mm256_storeu_ps(out + i, _mm256_fmadd_ps(_mm256_loadu_ps(in + i), w, _mm256_loadu_ps(out + i)));
+
+            return i;
+        }
+#endif
+
+        const bool useavx2 = Utils::SupportsAVX2();
+    }
+
+    void convolverow(const float *in, float *out, int width, int channels, const int *taps, const float *kernel, int size) {
+        //interior pixels read their taps from consecutive pixels
+        int first = std::min(size - 1 - size/2, width);
+        int last  = std::max(width - 1 - size/2, first - 1);
+
+        auto border = [&](int x) {
+            const int *t = taps + x * size;
+
+            for(int c=0; c<channels; c++) {
+                float acc = 0;
+
+                for(int i=0; i<size; i++)
+                    acc += in[t[i] * channels + c] * kernel[i];
+
+                out[x * channels + c] += acc;
+            }
+        };
+
+        for(int x=0; x<first; x++)
+            border(x);
+
+        for(int x=last+1; x<width; x++)
+            border(x);
+
+        if(last < first)
+            return;
+
+        //interior is a one dimensional convolution over the channel values where taps are
+        //one pixel apart, this allows any number of channels to be vectorized
+        int offsets[256];
+        std::vector<int> largeoffsets;
+        int *off = offsets;
+
+        if(size > 256) {
+            largeoffsets.resize(size);
+            off = largeoffsets.data();
+        }
+
+        for(int i=0; i<size; i++)
+            off[i] = (size/2 - i) * channels;
+
+        int q   = first * channels;
+        int end = (last + 1) * channels;
+
+#ifdef GORGON_X86
+        if(useavx2)
+            q = convolveavx2(in, out, q, end, off, kernel, size);
+#endif
+#ifdef GORGON_SSE2
+        q = convolvesse2(in, out, q, end, off, kernel, size);
+#endif
+
+        convolveportable(in, out, q, end, off, kernel, size);
+    }
+
+    void accumulaterow(const float *in, float *out, int count, float weight) {
+        int i = 0;
+
+#ifdef GORGON_X86
+        if(useavx2)
+            i = accumulateavx2(in, out, i, count, weight);
+#endif
+#ifdef GORGON_SSE2
+        i = accumulatesse2(in, out, i, count, weight);
+#endif
+
+        accumulateportable(in, out, i, count, weight);
+    }
+
+    void scalerow(float *row, const float *factors, int width, int channels) {
+        for(int x=0; x<width; x++) {
+            for(int c=0; c<channels; c++)
+                row[x * channels + c] *= factors[x];
+        }
+    }
+
+    void loadrow(const Byte *in, float *out, int count) {
+        int i = 0;
+
+#ifdef GORGON_SSE2
+        i = loadsse2(in, out, count);
+#endif
+
+        for(; i<count; i++)
+            out[i] = in[i];
+    }
+
+    void storerow(const float *in, Byte *out, int count, bool round) {
+        int i = 0;
+
+#ifdef GORGON_SSE2
+        i = storesse2(in, out, count, round);
+#endif
+
+        for(; i<count; i++) {
+            float v = Clamp(in[i], 0.f, 255.f);
+
+            out[i] = Byte(round ? v + 0.5f : v);
+        }
+    }
+
+} } }
@@ -3,6 +3,13 @@
 #include "Kernel.h"
 
 #include "../Containers/Image.h"
+#include "../Threading.h"
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 
 namespace Gorgon { namespace ImageProcessing {
@@ -32,320 +39,381 @@ namespace Gorgon { namespace ImageProcessing {
         ScaleRoundAndClamp
     };
 
-    /**
-     * Performs convolution operation to the given image with the supplied kernel, there are 
-     * warnings that apply to the use of parameters, read the whole documentation. For bitmaps
-     * you may use Convolution member function. It will call this function with the contained image.
-     * outsidecolor could be converted from RGBA if an 8-bit image is used. outofrange is only used
-     * when this function is applied to integral typed images including Image class. scale is used
-     * only if outofrange is set to Scale or ScaleThenClamp. If noalpha is set, the operation will
-     * not be performed on alpha channel and the original alpha channel is copied to the output.
-     */
-    template <class CT_ = Byte>
-    Containers::basic_Image<CT_> Convolution(
-        const Containers::basic_Image<CT_> &input,
-        Kernel kernel, 
-        OutOfBoundsPolicy outofbounds = OutOfBoundsPolicy::NearestNeighbor,
-        OutOfRangePolicy outofrange = OutOfRangePolicy::Clamp,
-        std::array<CT_, 4> outsidecolor = {}, 
-        bool noalpha = false, bool normalize = false,
-        std::array<Float, 4> scale = {1.f, 1.f, 1.f, 1.f}
-    ) {
-        if(input.GetSize().Area() == 0)
-            return {};
+    /// @cond internal
+    namespace internal {
+        /// Returns the source position of every tap for every position along an axis of the
+        /// given size. Taps that fall outside are mapped according to the policy. If the 
+        /// policy does not supply a position, size is used, which should be an extra pixel
+        /// or row containing the outside value.
+        std::vector<int> taptable(int size, int taps, OutOfBoundsPolicy policy);
         
-        if(normalize)
-            kernel.Normalize();
+        /// Returns the number of threads that should be used for the given amount of work
+        int convolutionthreads(long work, int bands);
         
-        //collect info
-        auto mode = input.GetMode();
+        /// Convolves a row of interleaved channels with a one dimensional kernel and adds the
+        /// result to out. in should contain width + 1 pixels, the last one being the outside
+        /// value. taps is the table returned from taptable.
+        void convolverow(const float *in, float *out, int width, int channels, const int *taps, const float *kernel, int size);
         
-        int C = GetChannelsPerPixel(mode);
-        int A = GetAlphaIndex(mode);
+        /// out += in * weight
+        void accumulaterow(const float *in, float *out, int count, float weight);
         
-        int W = input.GetWidth();
-        int H = input.GetHeight();
+        /// Multiplies every channel of a pixel with the factor of the pixel
+        void scalerow(float *row, const float *factors, int width, int channels);
         
-        int w = kernel.GetWidth();
-        int h = kernel.GetHeight();
+        void loadrow(const Byte *in, float *out, int count);
         
-        Containers::basic_Image<CT_> output({W, H}, mode);
+        /// Clamps the values to 0-255 while storing, rounds if requested
+        void storerow(const float *in, Byte *out, int count, bool round);
         
-        auto forpixelsmultiplier = [&]() {
-            for(int y=0; y<H; y++) {
-                for(int x=0; x<W; x++) {
-                    std::array<Float, 4> values = {};
+        template<class CT_>
+        void loadrow(const CT_ *in, float *out, int count) {
+            for(int i=0; i<count; i++)
+                out[i] = (float)in[i];
+        }
+        
+        /// Stores a row of convolution results to the output applying out of range policy.
+        /// If alpha is not -1, it will be copied from the original.
+        template<class CT_>
+        void storerow(const float *in, CT_ *out, const CT_ *original, int width, int channels, int alpha, 
+                      OutOfRangePolicy outofrange, const std::array<Float, 4> &scale) {
+            auto store = [&](auto fn) {
+                for(int x=0; x<width; x++) {
+                    for(int c=0; c<channels; c++)
+                        out[x * channels + c] = fn(in[x * channels + c], c);
+                }
+            };
+            
+            const float lo = (float)std::numeric_limits<CT_>::min(), hi = (float)std::numeric_limits<CT_>::max();
+            
+            if(!std::is_integral<CT_>::value) {
+                store([](float v, int) { return (CT_)v; });
+            }
+            else if(std::is_same<CT_, Byte>::value && (outofrange == OutOfRangePolicy::Clamp || outofrange == OutOfRangePolicy::RoundAndClamp)) {
+                storerow(in, (Byte*)out, width * channels, outofrange == OutOfRangePolicy::RoundAndClamp);
+            }
+            else {
+                switch(outofrange) {
+                case OutOfRangePolicy::Clamp:
+                    store([&](float v, int) { return (CT_)Clamp(v, lo, hi); });
+                    break;
                     
-                    Float weightsum = 0;
+                case OutOfRangePolicy::RoundAndClamp:
+                    store([&](float v, int) { return (CT_)Clamp(std::round(v), lo, hi); });
+                    break;
                     
-                    for(int i=0; i<w; i++) {
-                        for(int j=0; j<h; j++) {
-                            auto cx = x - i + w/2;
-                            auto cy = y - j + h/2;
-                            
-                            if(cx >= 0 && cx < W && cy >= 0 && cy < H) {
-                                for(int c=0; c<C; c++) {
-                                    values[c] += input(cx, cy, c) * kernel(i, j);
-                                }
-                                
-                                weightsum += kernel(i, j);
-                            }
-                        }
-                    }
+                case OutOfRangePolicy::Abs:
+                    store([](float v, int) { return (CT_)std::fabs(v); });
+                    break;
                     
-                    if(std::is_integral<CT_>::value) {
-                        switch(outofrange) {
-                        case OutOfRangePolicy::Clamp:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)Clamp<Float>(
-                                        values[c] / weightsum, 
-                                        std::numeric_limits<CT_>::min(), std::numeric_limits<CT_>::max()
-                                    );
-                            }
-                            break;
-                            
-                        case OutOfRangePolicy::RoundAndClamp:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)Clamp<Float>(
-                                        std::round(values[c] / weightsum),
-                                        std::numeric_limits<CT_>::min(), std::numeric_limits<CT_>::max()
-                                    );
-                            }
-                            break;
-                            
-                        case OutOfRangePolicy::Abs:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)std::fabs(values[c] / weightsum);
-                            }
-                            break;
-                            
-                        case OutOfRangePolicy::RoundAndAbs:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)std::fabs(std::round(values[c] / weightsum));
-                            }
-                            break;
-                        
-                        case OutOfRangePolicy::Scale:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)(values[c] / weightsum * scale[c]);
-                            }
-                            break;
-                        
-                        case OutOfRangePolicy::ScaleAndClamp:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)Clamp<Float>(
-                                        values[c] / weightsum * scale[c],
-                                        std::numeric_limits<CT_>::min(), std::numeric_limits<CT_>::max()
-                                    );
-                            }
-                            break;
-                        
-                        case OutOfRangePolicy::ScaleAndRound:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)std::round(values[c] / weightsum * scale[c]);
-                            }
-                            break;
-                        
-                        case OutOfRangePolicy::ScaleRoundAndClamp:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)Clamp<Float>(
-                                        std::round(values[c] / weightsum * scale[c]),
-                                        std::numeric_limits<CT_>::min(), std::numeric_limits<CT_>::max()
-                                    );
-                            }
-                            break;
-                        
-                        default:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = Byte(values[c] / weightsum);
-                            }
-                            break;
+                case OutOfRangePolicy::RoundAndAbs:
+                    store([](float v, int) { return (CT_)std::fabs(std::round(v)); });
+                    break;
+                
+                case OutOfRangePolicy::Scale:
+                    store([&](float v, int c) { return (CT_)(v * scale[c]); });
+                    break;
+                
+                case OutOfRangePolicy::ScaleAndClamp:
+                    store([&](float v, int c) { return (CT_)Clamp(float(v * scale[c]), lo, hi); });
+                    break;
+                
+                case OutOfRangePolicy::ScaleAndRound:
+                    store([&](float v, int c) { return (CT_)std::round(v * scale[c]); });
+                    break;
+                
+                case OutOfRangePolicy::ScaleRoundAndClamp:
+                    store([&](float v, int c) { return (CT_)Clamp(float(std::round(v * scale[c])), lo, hi); });
+                    break;
+                
+                default:
+                    store([](float v, int) { return (CT_)v; });
+                    break;
+                }
+            }
+            
+            if(alpha != -1) {
+                for(int x=0; x<width; x++)
+                    out[x * channels + alpha] = original[x * channels + alpha];
+            }
+        }
+        
+        /**
+         * Convolution engine. If separable is set, kernel contains w horizontal values 
+         * followed by h vertical values, otherwise w x h values. Rows are processed in bands,
+         * each band first converts or horizontally filters the source rows it needs and then 
+         * combines them vertically. Bands are distributed to threads.
+         */
+        template<class CT_>
+        void convolve(
+            const Containers::basic_Image<CT_> &input, Containers::basic_Image<CT_> &output,
+            const std::vector<float> &kernel, int w, int h, bool separable,
+            OutOfBoundsPolicy outofbounds, OutOfRangePolicy outofrange, 
+            const std::array<CT_, 4> &outsidecolor, bool noalpha, const std::array<Float, 4> &scale
+        ) {
+            int C = input.GetChannelsPerPixel();
+            int A = noalpha ? input.GetAlphaIndex() : -1;
+            
+            int W = input.GetWidth();
+            int H = input.GetHeight();
+            
+            bool partial = outofbounds == OutOfBoundsPolicy::PartialSum;
+            
+            auto xtaps = taptable(W, w, outofbounds);
+            auto ytaps = taptable(H, h, outofbounds);
+            
+            const float *row = kernel.data();
+            const float *col = kernel.data() + w;
+            
+            //value of the pixels outside, partial sum excludes them
+            std::array<float, 4> outside = {};
+            if(outofbounds == OutOfBoundsPolicy::FixedColor) {
+                for(int c=0; c<C; c++)
+                    outside[c] = (float)outsidecolor[c];
+            }
+            
+            //partial sums are divided by the total weight of the taps that are inside. For
+            //separable kernels these are calculated separately for each axis, for others the
+            //weight of each kernel row is calculated for every x.
+            std::vector<float> xweights, yweights;
+            if(partial) {
+                int rows = separable ? 1 : h;
+                
+                xweights.assign(size_t(W) * rows, 0.f);
+                for(int j=0; j<rows; j++) {
+                    for(int x=0; x<W; x++) {
+                        for(int i=0; i<w; i++) {
+                            if(xtaps[x * w + i] != W)
+                                xweights[j * W + x] += row[j * w + i];
                         }
                     }
-                    else {
-                        for(int c=0; c<C; c++) {
-                            if(!noalpha || c != A)
-                                output(x, y, c) = Byte(values[c] / weightsum);
+                }
+                
+                if(separable) {
+                    yweights.assign(H, 0.f);
+                    for(int y=0; y<H; y++) {
+                        for(int j=0; j<h; j++) {
+                            if(ytaps[y * h + j] != H)
+                                yweights[y] += col[j];
                         }
                     }
+                    
+                    for(auto &v : xweights) v = 1.f / v;
+                    for(auto &v : yweights) v = 1.f / v;
                 }
             }
-        };
-        
-        auto forpixels = [&](auto oob) {
-            for(int y=0; y<H; y++) {
-                for(int x=0; x<W; x++) {
-                    std::array<Float, 4> values = {};
+            
+            const int band   = std::max(64, 4 * h);
+            const int bands  = (H + band - 1) / band;
+            const int stride = separable ? W * C : (W + 1) * C;
+            
+            const CT_ *in  = reinterpret_cast<const CT_*>(input.RawData());
+            CT_       *out = reinterpret_cast<CT_*>(output.RawData());
+            
+            std::atomic<int> next(0);
+            
+            auto work = [&](int, int) {
+                //source rows of the current band, converted to float and for separable 
+                //kernels horizontally filtered. slots maps source row to the buffer row.
+                std::vector<float> buffer(size_t(band + h) * stride);
+                std::vector<float> source((W + 1) * C), result(W * C), weights;
+                std::vector<int> slots(H + 1, -1), used;
+                
+                if(partial && !separable)
+                    weights.resize(W);
+                
+                //prepares the given source row, H is the outside row
+                auto prepare = [&](int r, float *target) {
+                    float *src = separable ? source.data() : target;
+                    
+                    if(r == H) {
+                        for(int x=0; x<=W; x++)
+                            for(int c=0; c<C; c++)
+                                src[x * C + c] = outside[c];
+                    }
+                    else {
+                        loadrow(in + size_t(r) * W * C, src, W * C);
+                        
+                        for(int c=0; c<C; c++)
+                            src[W * C + c] = outside[c];
+                    }
                     
-                    for(int i=0; i<w; i++) {
+                    if(separable) {
+                        std::fill(target, target + stride, 0.f);
+                        convolverow(src, target, W, C, xtaps.data(), row, w);
+                        
+                        if(partial)
+                            scalerow(target, xweights.data(), W, C);
+                    }
+                };
+                
+                for(int b = next++; b < bands; b = next++) {
+                    int y0 = b * band, y1 = std::min(H, y0 + band);
+                    
+                    for(int y=y0; y<y1; y++) {
                         for(int j=0; j<h; j++) {
-                            auto cx = x - i + w/2;
-                            auto cy = y - j + h/2;
+                            int r = ytaps[y * h + j];
                             
-                            if(cx < 0 || cx >= W || cy < 0 || cy >= H) {
-                                oob(cx, cy, values, kernel(i, j));
-                            }
-                            else {
-                                for(int c=0; c<C; c++) {
-                                    values[c] += input(cx, cy, c) * kernel(i, j);
-                                }
+                            if(slots[r] == -1) {
+                                slots[r] = (int)used.size();
+                                used.push_back(r);
+                                
+                                prepare(r, &buffer[size_t(slots[r]) * stride]);
                             }
                         }
                     }
                     
-                    
-                    if(std::is_integral<CT_>::value) {
-                        switch(outofrange) {
-                        case OutOfRangePolicy::Clamp:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)Clamp<Float>(
-                                        values[c], 
-                                        std::numeric_limits<CT_>::min(), std::numeric_limits<CT_>::max()
-                                    );
-                            }
-                            break;
-                            
-                        case OutOfRangePolicy::RoundAndClamp:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)Clamp<Float>(
-                                        std::round(values[c]),
-                                        std::numeric_limits<CT_>::min(), std::numeric_limits<CT_>::max()
-                                    );
-                            }
-                            break;
-                        case OutOfRangePolicy::Abs:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)std::fabs(values[c]);
-                            }
-                            break;
-                            
-                        case OutOfRangePolicy::RoundAndAbs:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)std::fabs(std::round(values[c]));
-                            }
-                            break;
+                    for(int y=y0; y<y1; y++) {
+                        std::fill(result.begin(), result.end(), 0.f);
                         
-                        case OutOfRangePolicy::Scale:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)(values[c] * scale[c]);
-                            }
-                            break;
+                        if(partial && !separable)
+                            std::fill(weights.begin(), weights.end(), 0.f);
                         
-                        case OutOfRangePolicy::ScaleAndClamp:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)Clamp<Float>(
-                                        values[c] * scale[c],
-                                        std::numeric_limits<CT_>::min(), std::numeric_limits<CT_>::max()
-                                    );
+                        for(int j=0; j<h; j++) {
+                            int r = ytaps[y * h + j];
+                            const float *src = &buffer[size_t(slots[r]) * stride];
+                            
+                            if(separable) {
+                                accumulaterow(src, result.data(), W * C, col[j]);
                             }
-                            break;
-                        
-                        case OutOfRangePolicy::ScaleAndRound:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)std::round(values[c] * scale[c]);
+                            else {
+                                convolverow(src, result.data(), W, C, xtaps.data(), row + j * w, w);
+                                
+                                if(partial && r != H)
+                                    accumulaterow(&xweights[j * W], weights.data(), W, 1.f);
                             }
-                            break;
+                        }
                         
-                        case OutOfRangePolicy::ScaleRoundAndClamp:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = (CT_)Clamp<Float>(
-                                        std::round(values[c] * scale[c]),
-                                        std::numeric_limits<CT_>::min(), std::numeric_limits<CT_>::max()
-                                    );
+                        if(partial) {
+                            if(separable) {
+                                for(auto &v : result) v *= yweights[y];
                             }
-                            break;
-                        
-                        default:
-                            for(int c=0; c<C; c++) {
-                                if(!noalpha || c != A)
-                                    output(x, y, c) = Byte(values[c]);
+                            else {
+                                for(auto &v : weights) v = 1.f / v;
+                                
+                                scalerow(result.data(), weights.data(), W, C);
                             }
-                            break;
-                        }
-                    }
-                    else {
-                        for(int c=0; c<C; c++) {
-                            if(!noalpha || c != A)
-                                output(x, y, c) = Byte(values[c]);
                         }
+                        
+                        storerow(result.data(), out + size_t(y) * W * C, in + size_t(y) * W * C, W, C, A, outofrange, scale);
                     }
+                    
+                    for(auto r : used)
+                        slots[r] = -1;
+                    
+                    used.clear();
                 }
-            }
-        };
-        
-        switch(outofbounds) {
-        default:
-        case OutOfBoundsPolicy::FixedColor:
-            forpixels([&](auto , auto , auto &values, float kernel) {
-                for(int c=0; c<C; c++) {
-                    values[c] += outsidecolor[c] * kernel;
-                }
-            });
-            break;
+            };
             
-        case OutOfBoundsPolicy::PartialSum:
-            forpixelsmultiplier();
-            break;
+            int threads = convolutionthreads(long(W) * H * C * (separable ? w + h : w * h), bands);
             
-        case OutOfBoundsPolicy::NearestNeighbor:
-            forpixels([&](auto x, auto y, auto &values, float kernel) {
-                auto cx = Clamp(x, 0, W - 1);
-                auto cy = Clamp(y, 0, H - 1);
-                
-                for(int c=0; c<C; c++) {
-                    values[c] += input(cx, cy, c) * kernel;
-                }
-            });
-            break;
+            if(threads > 1)
+                Threading::RunInParallel(work, threads);
+            else
+                work(0, 1);
+        }
+    }
+    /// @endcond
+    
+    /**
+     * Performs convolution operation to the given image with the supplied kernel, there are 
+     * warnings that apply to the use of parameters, read the whole documentation. For bitmaps
+     * you may use Convolution member function. It will call this function with the contained image.
+     * outsidecolor could be converted from RGBA if an 8-bit image is used. outofrange is only used
+     * when this function is applied to integral typed images including Image class. scale is used
+     * only if outofrange is set to Scale or ScaleThenClamp. If noalpha is set, the operation will
+     * not be performed on alpha channel and the original alpha channel is copied to the output.
+     * 
+     * Kernels that are separable are detected and applied in two one dimensional passes, which
+     * reduces the work per pixel from width x height to width + height multiplications. Rows
+     * are filtered using SIMD instructions when available and large images are processed in
+     * multiple threads. Calculations are performed in single precision.
+     */
+    template <class CT_ = Byte>
+    Containers::basic_Image<CT_> Convolution(
+        const Containers::basic_Image<CT_> &input,
+        Kernel kernel, 
+        OutOfBoundsPolicy outofbounds = OutOfBoundsPolicy::NearestNeighbor,
+        OutOfRangePolicy outofrange = OutOfRangePolicy::Clamp,
+        std::array<CT_, 4> outsidecolor = {}, 
+        bool noalpha = false, bool normalize = false,
+        std::array<Float, 4> scale = {1.f, 1.f, 1.f, 1.f}
+    ) {
+        if(input.GetSize().Area() == 0 || kernel.GetSize().Area() == 0)
+            return {};
+        
+        if(normalize)
+            kernel.Normalize();
+        
+        Containers::basic_Image<CT_> output(input.GetSize(), input.GetMode());
+        
+        std::vector<Float> horizontal, vertical;
+        std::vector<float> values;
+        
+        bool separable = kernel.Separate(horizontal, vertical);
+        
+        if(separable) {
+            values.assign(horizontal.begin(), horizontal.end());
+            values.insert(values.end(), vertical.begin(), vertical.end());
+        }
+        else {
+            values.assign(kernel.GetData().begin(), kernel.GetData().end());
+        }
+        
+        internal::convolve(
+            input, output, values, kernel.GetWidth(), kernel.GetHeight(), separable,
+            outofbounds, outofrange, outsidecolor, noalpha, scale
+        );
+        
+        return output;
+    }
+    
+    /**
+     * Performs convolution using a horizontal and a vertical one dimensional kernel. The result
+     * is the same as using the product of these kernels with the Convolution function. This is 
+     * the fastest way to apply gaussian blur, use Kernel::GaussianFilter for both axis. Only the
+     * values of the kernels are used, they can be either rows or columns. If normalize is set,
+     * both kernels are normalized separately. Remaining parameters are the same as Convolution.
+     */
+    template <class CT_ = Byte>
+    Containers::basic_Image<CT_> SeparableConvolution(
+        const Containers::basic_Image<CT_> &input,
+        const Kernel &horizontal, const Kernel &vertical,
+        OutOfBoundsPolicy outofbounds = OutOfBoundsPolicy::NearestNeighbor,
+        OutOfRangePolicy outofrange = OutOfRangePolicy::Clamp,
+        std::array<CT_, 4> outsidecolor = {}, 
+        bool noalpha = false, bool normalize = false,
+        std::array<Float, 4> scale = {1.f, 1.f, 1.f, 1.f}
+    ) {
+        auto &h = horizontal.GetData();
+        auto &v = vertical.GetData();
+        
+        if(input.GetSize().Area() == 0 || h.empty() || v.empty())
+            return {};
+        
+        std::vector<float> values(h.begin(), h.end());
+        values.insert(values.end(), v.begin(), v.end());
+        
+        if(normalize) {
+            float htotal = 0, vtotal = 0;
             
-        case OutOfBoundsPolicy::Cyclic:
-            forpixels([&](auto x, auto y, auto &values, float kernel) {
-                auto cx = PositiveMod(x, W - 1);
-                auto cy = PositiveMod(y, H - 1);
-                
-                for(int c=0; c<C; c++) {
-                    values[c] += input(cx, cy, c) * kernel;
-                }
-            });
-            break;
+            for(size_t i=0; i<h.size(); i++)
+                htotal += values[i];
             
-        case OutOfBoundsPolicy::Mirror:
-            forpixels([&](auto x, auto y, auto &values, float kernel) {
-                auto cx = Mirror(x, W - 1);
-                auto cy = Mirror(y, H - 1);
-                
-                for(int c=0; c<C; c++) {
-                    values[c] += input(cx, cy, c) * kernel;
-                }
-            });
-            break;
-        }
-
-        if(noalpha && A != -1) {
-            for(int y=0; y<H; y++) {
-                for(int x=0; x<W; x++) {
-                    output(x, y, A) = input(x, y, A);
-                }
-            }
+            for(size_t i=h.size(); i<values.size(); i++)
+                vtotal += values[i];
+            
+            for(size_t i=0; i<values.size(); i++)
+                values[i] /= i < h.size() ? htotal : vtotal;
         }
-
+        
+        Containers::basic_Image<CT_> output(input.GetSize(), input.GetMode());
+        
+        internal::convolve(
+            input, output, values, (int)h.size(), (int)v.size(), true,
+            outofbounds, outofrange, outsidecolor, noalpha, scale
+        );
+        
         return output;
     }
 
@@ -2,6 +2,7 @@
 
 #include "../Utils/Assert.h"
 
+#include <cmath>
 #include <iomanip>
 #include <numeric>
 
@@ -52,6 +53,45 @@ namespace Gorgon { namespace ImageProcessing {
         }
     }
 
+    bool Kernel::Separate(std::vector<Float> &horizontal, std::vector<Float> &vertical, Float tolerance) const {
+        if(size.Area() == 0)
+            return false;
+        
+        //largest element is used as the pivot for numerical stability
+        int pivot = 0;
+        for(int i=1; i<size.Area(); i++) {
+            if(std::fabs(kernel[i]) > std::fabs(kernel[pivot]))
+                pivot = i;
+        }
+        
+        Float p = kernel[pivot];
+        if(p == 0)
+            return false;
+        
+        int px = pivot % size.Width;
+        int py = pivot / size.Width;
+        
+        horizontal.resize(size.Width);
+        vertical.resize(size.Height);
+        
+        for(int x=0; x<size.Width; x++)
+            horizontal[x] = Get(x, py);
+        
+        for(int y=0; y<size.Height; y++)
+            vertical[y] = Get(px, y) / p;
+        
+        //rank 1 check
+        tolerance *= std::fabs(p);
+        for(int y=0; y<size.Height; y++) {
+            for(int x=0; x<size.Width; x++) {
+                if(std::fabs(Get(x, y) - horizontal[x] * vertical[y]) > tolerance)
+                    return false;
+            }
+        }
+        
+        return true;
+    }
+
     Kernel Kernel::SobelFilter(Axis axis) {
         Kernel nkernel;
         
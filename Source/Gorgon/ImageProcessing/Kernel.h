@@ -114,9 +114,30 @@ namespace Gorgon { namespace ImageProcessing {
             return kernel;
         }
         
+        /// Returns the internal data that is stored
+        const std::vector<Float> &GetData() const {
+            return kernel;
+        }
+        
         /// Normalizes the kernel so the sum becomes 1
         void Normalize();
         
+        /// Splits this kernel into a horizontal and a vertical one dimensional kernel whose
+        /// product is this kernel. Returns false if the kernel cannot be separated, in this case
+        /// horizontal and vertical are left in an unspecified state. tolerance is relative to
+        /// the element with the largest magnitude. Kernels with a single row or column are 
+        /// always separable. Convolution uses this function to apply separable kernels in two
+        /// passes.
+        bool Separate(std::vector<Float> &horizontal, std::vector<Float> &vertical, Float tolerance = 1e-5f) const;
+        
+        /// Returns whether this kernel can be written as the product of a horizontal and a
+        /// vertical kernel, @see Separate
+        bool IsSeparable(Float tolerance = 1e-5f) const {
+            std::vector<Float> horizontal, vertical;
+            
+            return Separate(horizontal, vertical, tolerance);
+        }
+        
         /// Create a sobel filter for gradient calculation
         static Kernel SobelFilter(Axis axis);
         
@@ -0,0 +1,663 @@
+#include "Resampling.h"
+#include "Filters.h"
+
+#include "../Utils/Compiler.h"
+#include "../Threading.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#ifdef GORGON_SSE2
+#   include <emmintrin.h>
+#endif
+
+#ifdef GORGON_X86
+#   include <immintrin.h>
+#endif
+
+namespace Gorgon { namespace ImageProcessing {
+
+    namespace {
+        float cubic(float x) {
+            const float a = -0.5f;
+
+            x = std::fabs(x);
+
+            if(x < 1)
+                return (a+2) * x*x*x - (a+3) * x*x + 1;
+            else if(x < 2)
+                return a * x*x*x - 5*a * x*x + 8*a * x - 4*a;
+            else
+                return 0;
+        }
+
+        float lanczos(float x) {
+            x = std::fabs(x);
+
+            if(x < 1e-6f)
+                return 1;
+            else if(x >= 3)
+                return 0;
+
+            return 3 * std::sin(PI * x) * std::sin(PI * x / 3) / (PI * PI * x * x);
+        }
+
+        float support(ResamplingFilter filter) {
+            switch(filter) {
+            case ResamplingFilter::Linear:
+                return 1;
+            case ResamplingFilter::Cubic:
+                return 2;
+            case ResamplingFilter::Lanczos:
+                return 3;
+            default:
+                return 0.5f;
+            }
+        }
+
+        float evaluate(ResamplingFilter filter, float x) {
+            switch(filter) {
+            case ResamplingFilter::Linear:
+                return std::max(0.f, 1 - std::fabs(x));
+            case ResamplingFilter::Cubic:
+                return cubic(x);
+            case ResamplingFilter::Lanczos:
+                return lanczos(x);
+            default:
+                return 0;
+            }
+        }
+
+        //Weights of the cubic filter for fractions in 1/1024 steps, used where the fraction
+        //changes for every pixel.
+        const int CubicSteps = 1024;
+
+        const float *cubictable() {
+            static const std::vector<float> table = [] {
+                std::vector<float> t((CubicSteps + 1) * 4);
+
+                for(int i=0; i<=CubicSteps; i++) {
+                    float f = float(i) / CubicSteps;
+
+                    t[i*4 + 0] = cubic(1 + f);
+                    t[i*4 + 1] = cubic(f);
+                    t[i*4 + 2] = cubic(1 - f);
+                    t[i*4 + 3] = cubic(2 - f);
+                }
+
+                return t;
+            }();
+
+            return table.data();
+        }
+
+        //only the filters that have a fixed number of taps can be used for shifting
+        ResamplingFilter fixedfilter(ResamplingFilter filter) {
+            if(filter == ResamplingFilter::Nearest || filter == ResamplingFilter::Linear)
+                return filter;
+
+            return ResamplingFilter::Cubic;
+        }
+
+        //weights to sample at position p using a fixed filter, returns the first pixel
+        int shiftweights(ResamplingFilter filter, Float p, float *weights, int &taps) {
+            int i = (int)std::floor(p);
+            float f = float(p - i);
+
+            switch(filter) {
+            case ResamplingFilter::Nearest:
+                taps = 1;
+                weights[0] = 1;
+
+                return (int)std::round(p);
+
+            case ResamplingFilter::Linear:
+                taps = 2;
+                weights[0] = 1 - f;
+                weights[1] = f;
+
+                return i;
+
+            default:
+                taps = 4;
+                weights[0] = cubic(1 + f);
+                weights[1] = cubic(f);
+                weights[2] = cubic(1 - f);
+                weights[3] = cubic(2 - f);
+
+                return i - 1;
+            }
+        }
+
+        //Runs fn(first, last) for bands of rows, bands are distributed to threads if the work
+        //is large enough
+        template<class F_>
+        void forbands(int rows, int band, long work, F_ fn) {
+            int bands = (rows + band - 1) / band;
+            std::atomic<int> next(0);
+
+            auto run = [&](int, int) {
+                for(int b = next++; b < bands; b = next++)
+                    fn(b * band, std::min(rows, (b + 1) * band));
+            };
+
+            int threads = internal::convolutionthreads(work, bands);
+
+            if(threads > 1)
+                Threading::RunInParallel(run, threads);
+            else
+                run(0, 1);
+        }
+
+        //calls fn with the channel count as a compile time constant
+        template<class F_>
+        void withchannels(int channels, F_ fn) {
+            switch(channels) {
+            case 1:  fn(std::integral_constant<int, 1>()); break;
+            case 2:  fn(std::integral_constant<int, 2>()); break;
+            case 3:  fn(std::integral_constant<int, 3>()); break;
+            default: fn(std::integral_constant<int, 4>()); break;
+            }
+        }
+
+        //out[q] = sum of in[q + i * channels] * weights[i] for q in [begin, end)
+        void shiftportable(const float *in, float *out, int begin, int end, int channels, const float *weights, int taps) {
+            for(int q=begin; q<end; q++) {
+                float acc = 0;
+
+                for(int i=0; i<taps; i++)
+                    acc += in[q + i * channels] * weights[i];
+
+                out[q] = acc;
+            }
+        }
+
+        template<int C_>
+        void filterrowportable(const float *in, float *out, const ResamplingTable &table, int begin) {
+            int taps = table.GetTaps();
+
+            for(int d=begin; d<table.GetDestinationSize(); d++) {
+                const float *src = in + table.GetStart(d) * C_;
+                const float *w   = table.GetWeights(d);
+                float acc[C_] = {};
+
+                for(int i=0; i<taps; i++) {
+                    for(int c=0; c<C_; c++)
+                        acc[c] += src[i * C_ + c] * w[i];
+                }
+
+                for(int c=0; c<C_; c++)
+                    out[d * C_ + c] = acc[c];
+            }
+        }
+
+#ifdef GORGON_SSE2
+        int shiftsse2(const float *in, float *out, int end, int channels, const float *weights, int taps) {
+            int q = 0;
+
+            for(; q + 4 <= end; q += 4) {
+                __m128 acc = _mm_setzero_ps();
+
+                for(int i=0; i<taps; i++)
+                    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(in + q + i * channels), _mm_set1_ps(weights[i])));
+
+                _mm_storeu_ps(out + q, acc);
+            }
+
+            return q;
+        }
+
+        //every pixel of an RGBA row fits into a register
+        int filterrowsse2(const float *in, float *out, const ResamplingTable &table, int begin) {
+            int taps = table.GetTaps();
+            int d = begin;
+
+            for(; d<table.GetDestinationSize(); d++) {
+                const float *src = in + table.GetStart(d) * 4;
+                const float *w   = table.GetWeights(d);
+                __m128 acc = _mm_setzero_ps();
+
+                for(int i=0; i<taps; i++)
+                    acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(src + i * 4), _mm_set1_ps(w[i])));
+
+                _mm_storeu_ps(out + d * 4, acc);
+            }
+
+            return d;
+        }
+#endif
+
+#ifdef GORGON_X86
+        TARGET_AVX2 int shiftavx2(const float *in, float *out, int end, int channels, const float *weights, int taps) {
+            int q = 0;
+
+            for(; q + 8 <= end; q += 8) {
+                __m256 acc = _mm256_setzero_ps();
+
+                for(int i=0; i<taps; i++)
+                    acc = _mm256_fmadd_ps(_mm256_loadu_ps(in + q + i * channels), _mm256_set1_ps(weights[i]), acc);
+
+                _mm256_storeu_ps(out + q, acc);
+            }
+
+            return q;
+        }
+
+        //two RGBA pixels are filtered at once, one in each lane
+        TARGET_AVX2 int filterrowavx2(const float *in, float *out, const ResamplingTable &table) {
+            int taps = table.GetTaps();
+            int d = 0;
+
+            for(; d + 2 <= table.GetDestinationSize(); d += 2) {
+                const float *s1 = in + table.GetStart(d) * 4, *s2 = in + table.GetStart(d + 1) * 4;
+                const float *w1 = table.GetWeights(d),        *w2 = table.GetWeights(d + 1);
+                __m256 acc = _mm256_setzero_ps();
+
+                for(int i=0; i<taps; i++) {
+                    __m256 p = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s1 + i * 4)), _mm_loadu_ps(s2 + i * 4), 1);
+                    __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(w1[i])), _mm_set1_ps(w2[i]), 1);
+
+                    acc = _mm256_fmadd_ps(p, w, acc);
+                }
+
+                _mm256_storeu_ps(out + d * 4, acc);
+            }
+
+            return d;
+        }
+#endif
+
+        const bool useavx2 = Utils::SupportsAVX2();
+
+        //Filters a row of floats horizontally using the table
+        void filterrow(const float *in, float *out, int channels, const ResamplingTable &table) {
+            if(channels == 4) {
+                int d = 0;
+
+#ifdef GORGON_X86
+                if(useavx2)
+                    d = filterrowavx2(in, out, table);
+#endif
+
+#ifdef GORGON_SSE2
+                d = filterrowsse2(in, out, table, d);
+#endif
+
+                filterrowportable<4>(in, out, table, d);
+
+                return;
+            }
+
+            withchannels(channels, [&](auto C) {
+                filterrowportable<decltype(C)::value>(in, out, table, 0);
+            });
+        }
+
+        //out[q] = sum of in[q + i * channels] * weights[i] for q in [0, count)
+        void shiftrow(const float *in, float *out, int count, int channels, const float *weights, int taps) {
+            int q = 0;
+
+#ifdef GORGON_X86
+            if(useavx2)
+                q = shiftavx2(in, out, count, channels, weights, taps);
+#endif
+#ifdef GORGON_SSE2
+            q += shiftsse2(in + q, out + q, count - q, channels, weights, taps);
+#endif
+
+            shiftportable(in, out, q, count, channels, weights, taps);
+        }
+
+        void resamplenearest(const Byte *source, Byte *destination, int channels, const ResamplingTable &horizontal, const ResamplingTable &vertical) {
+            int W = horizontal.GetSourceSize();
+            int DW = horizontal.GetDestinationSize(), DH = vertical.GetDestinationSize();
+            size_t stride = size_t(DW) * channels;
+
+            forbands(DH, 64, long(DW) * DH, [&](int y0, int y1) {
+                for(int y=y0; y<y1; y++) {
+                    Byte *out = destination + y * stride;
+
+                    //enlarged images repeat the same rows
+                    if(y > y0 && vertical.GetStart(y) == vertical.GetStart(y - 1)) {
+                        memcpy(out, out - stride, stride);
+                        continue;
+                    }
+
+                    const Byte *in = source + size_t(vertical.GetStart(y)) * W * channels;
+
+                    withchannels(channels, [&](auto C) {
+                        const int c = decltype(C)::value;
+
+                        for(int x=0; x<DW; x++)
+                            memcpy(out + x * c, in + horizontal.GetStart(x) * c, c);
+                    });
+                }
+            });
+        }
+    }
+
+    ResamplingTable::ResamplingTable(int source, int destination, ResamplingFilter filter) :
+        source(source), filter(filter)
+    {
+        if(source <= 0 || destination <= 0)
+            return;
+
+        double scale = double(source) / destination;
+
+        starts.resize(destination);
+
+        if(filter == ResamplingFilter::Nearest) {
+            taps = 1;
+            weights.assign(destination, 1.f);
+
+            for(int d=0; d<destination; d++)
+                starts[d] = std::min(int((d + 0.5) * scale), source - 1);
+
+            return;
+        }
+
+        //filters are widened while shrinking so that every source pixel contributes
+        double stretch = std::max(1.0, scale);
+        double radius  = support(filter) * stretch;
+
+        taps = std::min((int)std::ceil(2 * radius) + 1, source);
+
+        weights.assign(size_t(destination) * taps, 0.f);
+
+        std::vector<float> contributions;
+
+        for(int d=0; d<destination; d++) {
+            double center = (d + 0.5) * scale - 0.5;
+            int first = (int)std::ceil(center - radius);
+            int last  = (int)std::floor(center + radius);
+
+            contributions.clear();
+
+            //box filter covers every pixel that overlaps with the destination pixel
+            if(filter == ResamplingFilter::Box) {
+                first = (int)std::floor(d * scale);
+                last  = (int)std::ceil((d + 1) * scale) - 1;
+            }
+
+            for(int j=first; j<=last; j++) {
+                float w;
+
+                if(filter == ResamplingFilter::Box) {
+                    //area of the source pixel that is covered by the destination pixel
+                    double l = std::max<double>(j, d * scale), r = std::min<double>(j + 1, (d + 1) * scale);
+
+                    w = float(std::max(0.0, r - l));
+                }
+                else {
+                    w = evaluate(filter, float((j - center) / stretch));
+                }
+
+                contributions.push_back(w);
+            }
+
+            int lo = Clamp(first, 0, source - 1);
+            int start = std::max(0, std::min(lo, source - taps));
+            float *target = &weights[size_t(d) * taps];
+            float sum = 0;
+
+            for(int j=first; j<=last; j++) {
+                float w = contributions[j - first];
+
+                target[Clamp(j, 0, source - 1) - start] += w;
+                sum += w;
+            }
+
+            if(sum != 0) {
+                for(int i=0; i<taps; i++)
+                    target[i] /= sum;
+            }
+
+            starts[d] = start;
+        }
+    }
+
+    void Resample(const Byte *source, Byte *destination, int channels, const ResamplingTable &horizontal, const ResamplingTable &vertical) {
+        int W  = horizontal.GetSourceSize(),      H  = vertical.GetSourceSize();
+        int DW = horizontal.GetDestinationSize(), DH = vertical.GetDestinationSize();
+
+        if(DW == 0 || DH == 0 || W == 0 || H == 0)
+            return;
+
+        if(horizontal.GetFilter() == ResamplingFilter::Nearest && vertical.GetFilter() == ResamplingFilter::Nearest) {
+            resamplenearest(source, destination, channels, horizontal, vertical);
+
+            return;
+        }
+
+        const int band = 32;
+        const int C = channels;
+        const size_t stride = size_t(DW) * C;
+
+        long work = long(DW) * C * (long(H) * horizontal.GetTaps() + long(DH) * vertical.GetTaps());
+
+        forbands(DH, band, work, [&](int y0, int y1) {
+            int r0 = vertical.GetStart(y0), r1 = 0;
+
+            for(int y=y0; y<y1; y++) {
+                r0 = std::min(r0, vertical.GetStart(y));
+                r1 = std::max(r1, vertical.GetStart(y) + vertical.GetTaps());
+            }
+
+            //source rows of the band, horizontally filtered
+            std::vector<float> row(size_t(W) * C), rows(size_t(r1 - r0) * stride), result(stride);
+
+            for(int r=r0; r<r1; r++) {
+                internal::loadrow(source + size_t(r) * W * C, row.data(), W * C);
+                filterrow(row.data(), &rows[(r - r0) * stride], C, horizontal);
+            }
+
+            for(int y=y0; y<y1; y++) {
+                const float *w = vertical.GetWeights(y);
+
+                std::fill(result.begin(), result.end(), 0.f);
+
+                for(int j=0; j<vertical.GetTaps(); j++) {
+                    if(w[j] != 0)
+                        internal::accumulaterow(&rows[(vertical.GetStart(y) + j - r0) * stride], result.data(), int(stride), w[j]);
+                }
+
+                internal::storerow(result.data(), destination + y * stride, int(stride), true);
+            }
+        });
+    }
+
+    void Resample(const Byte *source, const Geometry::Size &sourcesize, Byte *destination, const Geometry::Size &destinationsize, int channels, ResamplingFilter filter) {
+        Resample(source, destination, channels,
+                 ResamplingTable(sourcesize.Width,  destinationsize.Width,  filter),
+                 ResamplingTable(sourcesize.Height, destinationsize.Height, filter));
+    }
+
+    void ShearRows(const Byte *source, const Geometry::Size &sourcesize, Byte *destination, const Geometry::Size &destinationsize, int channels,
+                   int rowoffset, Float start, Float perrow, ResamplingFilter filter)
+    {
+        const int W = sourcesize.Width, H = sourcesize.Height, DW = destinationsize.Width;
+        const int C = channels;
+        const size_t stride = size_t(DW) * C;
+
+        filter = fixedfilter(filter);
+
+        forbands(destinationsize.Height, 64, long(DW) * destinationsize.Height * C * 4, [&](int y0, int y1) {
+            //source row placed so that destination pixel x is the sum of taps starting from x
+            std::vector<float> row(size_t(DW + 4) * C), result(stride);
+
+            for(int y=y0; y<y1; y++) {
+                Byte *out = destination + y * stride;
+                int sy = y + rowoffset;
+
+                if(sy < 0 || sy >= H) {
+                    memset(out, 0, stride);
+                    continue;
+                }
+
+                float weights[4];
+                int taps;
+                int offset = shiftweights(filter, start + y * perrow, weights, taps);
+
+                //pixels that are in the source
+                int first = Clamp(-offset, 0, DW + taps - 1), last = Clamp(W - offset, first, DW + taps - 1);
+                const Byte *in = source + size_t(sy) * W * C;
+
+                if(filter == ResamplingFilter::Nearest) {
+                    memset(out, 0, first * C);
+                    if(last > first)
+                        memcpy(out + first * C, in + (first + offset) * C, (last - first) * C);
+                    memset(out + last * C, 0, (DW - last) * C);
+
+                    continue;
+                }
+
+                std::fill(row.begin(), row.begin() + first * C, 0.f);
+                if(last > first)
+                    internal::loadrow(in + (first + offset) * C, &row[first * C], (last - first) * C);
+                std::fill(row.begin() + last * C, row.end(), 0.f);
+
+                shiftrow(row.data(), result.data(), int(stride), C, weights, taps);
+                internal::storerow(result.data(), out, int(stride), true);
+            }
+        });
+    }
+
+    void ShearColumns(const Byte *source, const Geometry::Size &sourcesize, Byte *destination, const Geometry::Size &destinationsize, int channels,
+                      int columnoffset, Float start, Float percolumn, ResamplingFilter filter)
+    {
+        const int W = sourcesize.Width, H = sourcesize.Height;
+        const int DW = destinationsize.Width, DH = destinationsize.Height;
+
+        filter = fixedfilter(filter);
+
+        //weights and the first source row for every column, relative to the destination row
+        std::vector<float> weights(size_t(DW) * 4, 0.f);
+        std::vector<int> offsets(DW);
+        int taps = 1;
+
+        for(int x=0; x<DW; x++)
+            offsets[x] = shiftweights(filter, start + x * percolumn, &weights[x * 4], taps);
+
+        withchannels(channels, [&](auto CC) {
+            const int C = decltype(CC)::value;
+
+            forbands(DH, 64, long(DW) * DH * C * taps, [&](int y0, int y1) {
+                for(int y=y0; y<y1; y++) {
+                    Byte *out = destination + size_t(y) * DW * C;
+
+                    for(int x=0; x<DW; x++) {
+                        int sx = x + columnoffset;
+                        int sy = y + offsets[x];
+                        const float *w = &weights[x * 4];
+                        float acc[C] = {};
+
+                        if(sx >= 0 && sx < W) {
+                            for(int i=0; i<taps; i++) {
+                                if(sy + i < 0 || sy + i >= H)
+                                    continue;
+
+                                const Byte *p = source + (size_t(sy + i) * W + sx) * C;
+
+                                for(int c=0; c<C; c++)
+                                    acc[c] += w[i] * p[c];
+                            }
+                        }
+
+                        for(int c=0; c<C; c++)
+                            out[x * C + c] = Byte(Clamp(acc[c], 0.f, 255.f) + 0.5f);
+                    }
+                }
+            });
+        });
+    }
+
+    void Transform(const Byte *source, const Geometry::Size &sourcesize, Byte *destination, const Geometry::Size &destinationsize, int channels,
+                   const Geometry::Pointf &origin, const Geometry::Pointf &xstep, const Geometry::Pointf &ystep, ResamplingFilter filter)
+    {
+        const int W = sourcesize.Width, H = sourcesize.Height;
+        const int DW = destinationsize.Width, DH = destinationsize.Height;
+
+        filter = fixedfilter(filter);
+
+        const float *table = cubictable();
+        const int taps = filter == ResamplingFilter::Nearest ? 1 : filter == ResamplingFilter::Linear ? 2 : 4;
+
+        withchannels(channels, [&](auto CC) {
+            const int C = decltype(CC)::value;
+
+            forbands(DH, 32, long(DW) * DH * C * taps * taps, [&](int y0, int y1) {
+                for(int y=y0; y<y1; y++) {
+                    Byte *out = destination + size_t(y) * DW * C;
+
+                    for(int x=0; x<DW; x++) {
+                        Float xx = origin.X + x * xstep.X + y * ystep.X;
+                        Float yy = origin.Y + x * xstep.Y + y * ystep.Y;
+
+                        float wx[4], wy[4];
+                        int sx, sy;
+
+                        if(filter == ResamplingFilter::Nearest) {
+                            sx = (int)std::round(xx);
+                            sy = (int)std::round(yy);
+                            wx[0] = wy[0] = 1;
+                        }
+                        else {
+                            sx = (int)std::floor(xx);
+                            sy = (int)std::floor(yy);
+
+                            float fx = float(xx - sx), fy = float(yy - sy);
+
+                            if(filter == ResamplingFilter::Linear) {
+                                wx[0] = 1 - fx; wx[1] = fx;
+                                wy[0] = 1 - fy; wy[1] = fy;
+                            }
+                            else {
+                                const float *tx = table + int(fx * CubicSteps + 0.5f) * 4;
+                                const float *ty = table + int(fy * CubicSteps + 0.5f) * 4;
+
+                                for(int i=0; i<4; i++) {
+                                    wx[i] = tx[i];
+                                    wy[i] = ty[i];
+                                }
+
+                                sx--;
+                                sy--;
+                            }
+                        }
+
+                        float acc[C] = {};
+
+                        //pixels completely inside skip the bounds checks
+                        bool inside = sx >= 0 && sy >= 0 && sx + taps <= W && sy + taps <= H;
+
+                        for(int j=0; j<taps; j++) {
+                            if(!inside && (sy + j < 0 || sy + j >= H))
+                                continue;
+
+                            float row[C] = {};
+                            long base = (long(sy + j) * W + sx) * C;
+
+                            for(int i=0; i<taps; i++) {
+                                if(!inside && (sx + i < 0 || sx + i >= W))
+                                    continue;
+
+                                for(int c=0; c<C; c++)
+                                    row[c] += wx[i] * source[base + i * C + c];
+                            }
+
+                            for(int c=0; c<C; c++)
+                                acc[c] += wy[j] * row[c];
+                        }
+
+                        for(int c=0; c<C; c++)
+                            out[x * C + c] = Byte(Clamp(acc[c], 0.f, 255.f) + 0.5f);
+                    }
+                }
+            });
+        });
+    }
+
+} }
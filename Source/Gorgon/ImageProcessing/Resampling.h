@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../Types.h"
+#include "../Geometry/Point.h"
+#include "../Geometry/Size.h"
+
+#include <vector>
+
+namespace Gorgon { namespace ImageProcessing {
+
+    /// Filters that can be used for resampling
+    enum class ResamplingFilter {
+        /// Nearest source pixel is used
+        Nearest,
+
+        /// Each destination pixel is the average of the source pixels it covers, weighted by
+        /// the covered area
+        Box,
+
+        /// Triangle filter, bilinear interpolation while enlarging
+        Linear,
+
+        /// Keys cubic filter with a = -0.5, which is the filter used by the image functions
+        Cubic,
+
+        /// Lanczos filter with 3 lobes
+        Lanczos
+    };
+
+    /**
+     * Filter coefficients for resampling along one axis. For every destination position, the
+     * table stores the first source position and a fixed number of weights. While shrinking,
+     * the filter is widened to cover all the source pixels that fall into the destination
+     * pixel, therefore there is no need to shrink the image beforehand. Weights of the pixels
+     * outside the source are moved to the nearest edge pixel.
+     *
+     * Tables depend only on the sizes and the filter. If many images of the same size are
+     * scaled, such as tiles or thumbnails, the tables can be created once and reused.
+     */
+    class ResamplingTable {
+    public:
+        /// Creates an empty table
+        ResamplingTable() = default;
+
+        /// Creates the coefficients to resample source pixels to destination pixels. Pixel
+        /// centers are aligned.
+        ResamplingTable(int source, int destination, ResamplingFilter filter);
+
+        /// Returns the number of source pixels
+        int GetSourceSize() const {
+            return source;
+        }
+
+        /// Returns the number of destination pixels
+        int GetDestinationSize() const {
+            return int(starts.size());
+        }
+
+        /// Returns the number of weights for every destination pixel
+        int GetTaps() const {
+            return taps;
+        }
+
+        /// Returns the filter that is used to build this table
+        ResamplingFilter GetFilter() const {
+            return filter;
+        }
+
+        /// Returns the first source pixel that contributes to the given destination pixel
+        int GetStart(int index) const {
+            return starts[index];
+        }
+
+        /// Returns GetTaps() weights for the given destination pixel, weights are for the
+        /// consecutive source pixels starting from GetStart(index)
+        const float *GetWeights(int index) const {
+            return &weights[size_t(index) * taps];
+        }
+
+    private:
+        int source = 0;
+        int taps = 0;
+        ResamplingFilter filter = ResamplingFilter::Nearest;
+
+        std::vector<int> starts;
+        std::vector<float> weights;
+    };
+
+    /**
+     * Resamples the source pixels into the destination using the given tables. Source should
+     * contain horizontal.GetSourceSize() x vertical.GetSourceSize() pixels and destination
+     * should have room for horizontal.GetDestinationSize() x vertical.GetDestinationSize()
+     * pixels. Channels are interleaved, all channels are filtered in the same way. Rows are
+     * filtered horizontally and then combined vertically in bands, which are distributed to
+     * threads for large images. Source and destination cannot overlap.
+     */
+    void Resample(const Byte *source, Byte *destination, int channels, const ResamplingTable &horizontal, const ResamplingTable &vertical);
+
+    /// Resamples the source pixels into the destination using the given filter. See the other
+    /// variant for details.
+    void Resample(const Byte *source, const Geometry::Size &sourcesize, Byte *destination, const Geometry::Size &destinationsize, int channels, ResamplingFilter filter);
+
+    /**
+     * Shifts every row of the image by a fractional amount. Destination row y is sampled from
+     * source row y + rowoffset at horizontal position x + start + y * perrow. Pixels outside
+     * the source are 0. Only Nearest, Linear and Cubic filters are supported, other filters
+     * are treated as Cubic. Weights are calculated once for every row.
+     */
+    void ShearRows(const Byte *source, const Geometry::Size &sourcesize, Byte *destination, const Geometry::Size &destinationsize, int channels,
+                   int rowoffset, Float start, Float perrow, ResamplingFilter filter);
+
+    /**
+     * Shifts every column of the image by a fractional amount. Destination column x is
+     * sampled from source column x + columnoffset at vertical position y + start + x * percolumn.
+     * Pixels outside the source are 0. Only Nearest, Linear and Cubic filters are supported,
+     * other filters are treated as Cubic. Weights are calculated once for every column.
+     */
+    void ShearColumns(const Byte *source, const Geometry::Size &sourcesize, Byte *destination, const Geometry::Size &destinationsize, int channels,
+                      int columnoffset, Float start, Float percolumn, ResamplingFilter filter);
+
+    /**
+     * Samples the source at an affine transformed position for every destination pixel.
+     * Destination pixel (x, y) is sampled from origin + x * xstep + y * ystep. Pixels outside
+     * the source are 0. Only Nearest, Linear and Cubic filters are supported, other filters
+     * are treated as Cubic. Cubic weights are read from a precomputed table.
+     */
+    void Transform(const Byte *source, const Geometry::Size &sourcesize, Byte *destination, const Geometry::Size &destinationsize, int channels,
+                   const Geometry::Pointf &origin, const Geometry::Pointf &xstep, const Geometry::Pointf &ystep, ResamplingFilter filter);
+
+} }
@@ -1,6 +1,10 @@
 SET(Local
     Filters.h
+    Filters.cpp
     
     Kernel.h
     Kernel.cpp
+    
+    Resampling.h
+    Resampling.cpp
 )
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <thread>
 
 #include "Main.h"
@@ -7,9 +8,12 @@
 #include "Window.h"
 #include "OS.h"
 #include "Time.h"
+#include "Time/FramePacer.h"
 #include "Resource.h"
 #include "Audio.h"
 #include "Multimedia.h"
+#include "Threading.h"
+#include "Utils/TimerWheel.h"
 
 #ifdef SCRIPTING
 #	include "Scripting.h"
@@ -53,12 +57,8 @@ namespace Gorgon {
 	
 	Event<> BeforeFrameEvent;
     
-    std::mutex once_mtx;
-    std::vector<std::function<void()>> once;
-    
-    size_t timeind = 0; //used for timeouts and intervals
-    std::map<size_t, std::pair<unsigned long, std::function<void()>>> timeouts;
-    std::map<size_t, std::tuple<unsigned long, unsigned long, std::function<void()>>> intervals;
+    //timeouts and intervals, time of the wheel is advanced by the delta time of the frames
+    Utils::TimerWheel timers;
 
 	bool exiting = false;
 
@@ -94,59 +94,29 @@ namespace Gorgon {
 
 	void Tick() {
 		static bool inited=false;
-		auto ctime=Time::GetTime();
+		auto ctime=Time::GetPreciseTime();
 		if(!inited) {
-			Time::internal::framestart=ctime;
+			Time::internal::precisestart=ctime;
+			Time::internal::framestart=(unsigned long)(ctime/1000);
 			inited=true;
 		}
 
-		Time::internal::deltatime=ctime-Time::internal::framestart;
-		Time::internal::framestart=ctime;
+		//millisecond times are derived from the precise time, thus the fractions that are
+		//dropped from a delta are carried to the next one
+		Time::internal::precisedelta=ctime-Time::internal::precisestart;
+		Time::internal::precisestart=ctime;
+
+		Time::internal::deltatime=(unsigned long)(ctime/1000)-Time::internal::framestart;
+		Time::internal::framestart=(unsigned long)(ctime/1000);
+		
+		Time::FramePacer::Default().Accumulate(Time::internal::precisedelta);
 
 		Animation::Animate();
         
-        for(auto &fn : once) {
-            fn();
-        }
-        
-        once.clear();
-        
-        for(auto &p : timeouts) {
-            if(p.second.first <= Time::internal::deltatime) {
-                p.second.first = 0;
-                p.second.second();
-            }
-            else {
-                p.second.first -= Time::internal::deltatime;
-            }
-        }
-        
-        for(auto it=timeouts.begin(); it != timeouts.end(); ) {
-            if(it->second.first == 0 || it->second.first == -1) {
-                it= timeouts.erase(it);
-            } else {
-                ++it;
-            }
-        }
-        
-        for(auto &p : intervals) {
-            if(std::get<0>(p.second) <= Time::internal::deltatime) {
-                std::get<0>(p.second) = std::get<1>(p.second) + std::get<0>(p.second) - Time::internal::deltatime;
-                std::get<2>(p.second)();
-            }
-            else {
-                std::get<0>(p.second) -= Time::internal::deltatime;
-            }
-        }
-        
-        for(auto it=intervals.begin(); it != intervals.end(); ) {
-            if(std::get<0>(it->second) == -1) {
-                it= intervals.erase(it);
-            } else {
-                ++it;
-            }
-        }
+        Threading::ProcessMainQueue();
         
+        //only the timers that are due are touched
+        timers.Advance(timers.GetTime() + Time::internal::deltatime);
 	}
 
 	void Render() {
@@ -159,12 +129,7 @@ namespace Gorgon {
 		if(render)
             Render();
 
-		auto ctime=Time::GetTime();
-		auto currentdelta=ctime-Time::FrameStart();
-        
-		if(currentdelta<16) {
-			std::this_thread::sleep_for(std::chrono::duration<unsigned long, std::milli>(15-currentdelta));
-		}
+		Time::FramePacer::Default().Wait();
 
 		Tick();
 		
@@ -184,56 +149,52 @@ namespace Gorgon {
 	}
 	
 	void RegisterOnce(std::function<void()> fn) {
-        std::lock_guard<std::mutex> grd(once_mtx);
-
-        once.push_back(fn);
+        Threading::RunOnMain(std::move(fn));
     }
     
     size_t RegisterTimeout(unsigned long after, std::function<void()> fn) {
-        timeouts.insert({timeind, {after, fn}});
-        return timeind++; 
+        return timers.Add(timers.GetTime() + after, std::move(fn));
     }
     
     void AlterTimeout(size_t timeout, unsigned long after) {
-        if(timeouts.count(timeout)) {
-            timeouts[timeout].first = after;
+        if(TimeoutExists(timeout)) {
+            timers.Reschedule(timeout, timers.GetTime() + after);
         }
     }
     
     void DisableTimeout(size_t timeout) {
-        if(timeouts.count(timeout)) {
-            //mark for erasure to ensure it is not deleted while
-            //being iterated.
-            timeouts[timeout].first = -1;
+        if(TimeoutExists(timeout)) {
+            //the wheel allows cancelling a running timer
+            timers.Cancel(timeout);
         }
     }    
     
     bool TimeoutExists(size_t timeout) {
-        return timeouts.count(timeout) != 0;
+        return timers.Exists(timeout) && !timers.IsPeriodic(timeout);
     }
 
     
     size_t RegisterInterval(unsigned long after, std::function<void()> fn) {
-        intervals.insert({timeind, {after, after, fn}});
-        return timeind++; 
+        //an interval of 0 runs every frame
+        after = std::max(after, 1ul);
+        
+        return timers.Add(timers.GetTime() + after, std::move(fn), after);
     }
     
     void AlterInterval(size_t timeout, unsigned long after) {
-        if(intervals.count(timeout)) {
-            std::get<1>(intervals[timeout]) = after;
+        if(IntervalExists(timeout)) {
+            timers.SetPeriod(timeout, std::max(after, 1ul));
         }
     }
     
     void DisableInterval(size_t timeout) {
-        if(intervals.count(timeout)) {
-            //mark for erasure to ensure it is not deleted while
-            //being iterated.
-            std::get<0>(intervals[timeout]) = -1;
+        if(IntervalExists(timeout)) {
+            timers.Cancel(timeout);
         }
     }
     
     bool IntervalExists(size_t timeout) {
-        return intervals.count(timeout) != 0;
+        return timers.IsPeriodic(timeout);
     }
 
 }
@@ -49,16 +49,18 @@ namespace Gorgon {
 
     /// This function marks the end of current frame and starts the next one. This function calls
     /// the Tick function at start of the next frame. Additionally, this function calls end of
-    /// frame tasks such as rendering. Before starting the next frame, a certain delay is performed.
-    /// This delay aims to set each frame duration to 16ms, this duration sets the frames per second
-    /// to 62.5. This delay greatly reduces the system load of simple games/applications.
+    /// frame tasks such as rendering. Before starting the next frame, the default frame pacer
+    /// waits for the start of the next frame. By default, frame duration is 16ms, which sets the
+    /// frames per second to 62.5. This delay greatly reduces the system load of simple 
+    /// games/applications. Use Time::FramePacer::Default() to change the frame rate.
     void NextFrame(bool render = true);
 
     /// This method works similar to next frame, however, no delay is done. This function allows an
     /// application to update the display and perform OS tasks while still continuing operation.
     inline void UpdateFrame();
     
-    /// Registers a function to be run at the start of the next frame.
+    /// Registers a function to be run at the start of the next frame. Can be called from any
+    /// thread, the function is run on the main thread. See Threading::RunOnMain.
     void RegisterOnce(std::function<void()> fn);
 
     /// Registers a function to be run at the start of the next frame.
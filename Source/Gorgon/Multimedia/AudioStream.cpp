@@ -13,10 +13,6 @@
 
 namespace Gorgon { 
     
-namespace Audio { namespace internal {
-    extern std::mutex ControllerMtx;
-} }
-    
 namespace Multimedia {
     
 namespace internal {
@@ -408,19 +404,24 @@ namespace internal {
     }
     
     void AudioStream::loadbuffer(bufferdata &buffer, unsigned long startoff) {
-        auto loaded = streamer->LoadData(startoff, buffer.buffer);
+        //mark the buffer empty and wait for the mixers that might be reading it
+        bufferversion++;
+        buffer.end = buffer.beg;
+        bufferversion++;
         
-        std::lock_guard<std::mutex> g(Audio::internal::ControllerMtx);
+        while(bufferreaders)
+            std::this_thread::yield();
         
-        buffer.beg = startoff;
+        auto loaded = streamer->LoadData(startoff, buffer.buffer);
+        auto end    = std::min(totalsize, startoff + (loaded ? loaded : buffer.buffer.GetSize()));
         
-        if(loaded == 0) {
-            buffer.end = std::min(totalsize, startoff + buffer.buffer.GetSize());
+        if(loaded == 0)
             buffer.buffer.Clear();
-        }
-        else {
-            buffer.end = std::min(totalsize, startoff + loaded);
-        }
+        
+        bufferversion++;
+        buffer.beg = startoff;
+        buffer.end = end;
+        bufferversion++;
     }
 
     AudioStream::SeekResult AudioStream::StartSeeking(long unsigned int target) const {
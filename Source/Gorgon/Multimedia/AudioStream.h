@@ -10,6 +10,7 @@
 #include <thread>
 #include <mutex>
 #include <array>
+#include <atomic>
 
 namespace Gorgon { 
     
@@ -17,7 +18,7 @@ namespace Resource {
     class Sound;
 }
 namespace Audio { namespace internal {
-    class Loop;
+    class Mixer;
 } }
 
 namespace Multimedia {
@@ -61,7 +62,7 @@ namespace Multimedia {
      * from the old location.
      */
     class AudioStream : public Audio::Source, public Stream {
-        friend class Audio::internal::Loop;
+        friend class Audio::internal::Mixer;
     public:
         
         /// Constructor
@@ -240,6 +241,13 @@ namespace Multimedia {
         
         mutable std::mutex guard;
         
+        /// Odd while buffer ranges are being changed. Mixers read the buffers without
+        /// locking and retry if the version is changed while reading.
+        mutable std::atomic<unsigned> bufferversion{0};
+        
+        /// Number of mixers reading the buffers
+        mutable std::atomic<int> bufferreaders{0};
+        
         //internally used by audio loop
         int currentbuffer = 0;
         
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "../Containers/Collection.h"
 #include "../SGuid.h"
 
@@ -13,6 +15,7 @@ namespace Gorgon {
 	namespace Resource {
 
 		class File;
+		class Reader;
 
 		/// This class is the base for all Gorgon Resources. 
 		/// @warning This class is rather heavy and should not be used for small objects that are
@@ -145,6 +148,18 @@ namespace Gorgon {
 			/// Destroys the children of this resource
 			void destroychildren();
 
+			/// Returns whether this resource skipped its data while loading and will load it later
+			/// from its reader. File uses this to decode the data of resources in parallel.
+			virtual bool isdeferred() const { return false; }
+
+			/// Loads the skipped data using the given reader. The reader is a duplicate of the reader
+			/// of this resource and it is only used by the calling thread. This function should not
+			/// modify the reader of this resource, File calls loaded afterwards from its own thread.
+			virtual bool loaddeferred(std::shared_ptr<Reader>) { return false; }
+
+			/// Called after the skipped data is loaded to release the reader of this resource
+			virtual void loaded() { }
+
 			/// Sets the parent of an object to nullptr, provides access.
 			void setparenttonullptr(Base &base) { base.parent=nullptr; base.root=nullptr; }
 
@@ -1,6 +1,7 @@
 #include "Blob.h"
 #include "File.h"
 #include "../Encoding/LZMA.h"
+#include "../Encoding/LZ4.h"
 
 namespace Gorgon { namespace Resource {
 
@@ -30,23 +31,40 @@ namespace Gorgon { namespace Resource {
 		return data;
 	}
 
+	const Byte *Blob::GetMappedData() const {
+		if(isloaded || !reader || !dataentry)
+			return nullptr;
+
+		return reader->Map(dataentry, datasize);
+	}
+
 	bool Blob::Load() {
 		if(isloaded)			return true;
 		if(!reader)				return false;
 		if(!reader->TryOpen())	return false;
 
+		auto ret=loaddeferred(reader);
+
+		if(ret && isloaded) {
+			loaded();
+		}
+		
+		return true;
+	}
+
+	bool Blob::loaddeferred(std::shared_ptr<Reader> reader) {
 		reader->Seek(entrypoint-4);
 		
 		auto size=reader->ReadChunkSize();
 
-		auto ret=load(reader, size, true);
+		return load(reader, size, true);
+	}
 
-		if(ret && isloaded) {
+	void Blob::loaded() {
+		if(reader) {
 			reader->NoLongerNeeded();
 			reader.reset();
 		}
-		
-		return true;
 	}
 
 	bool Blob::load(std::shared_ptr<Reader> reader, unsigned long totalsize, bool forceload) {
@@ -67,7 +85,8 @@ namespace Gorgon { namespace Resource {
 				type=reader->ReadInt32();
 
 				lateloading=reader->ReadBool();
-				load=!lateloading || forceload;
+				load=(!lateloading && !reader->IsLazy()) || forceload;
+				datasize=uncompressed;
 				if(!load) {
 					reader->KeepOpen();
 					this->reader=reader;
@@ -75,16 +94,25 @@ namespace Gorgon { namespace Resource {
 			}
 			else if(gid==GID::Blob_Data) {
 				if(load) {
-					reader->ReadArray(&data[0], size);
+					data.resize(size);
+					reader->ReadArray(data.data(), size);
 
 					isloaded=true;
 				}
 				else {
+					//can be accessed directly if the file is mapped
+					dataentry=reader->Tell();
+					datasize=size;
+
 					reader->EatChunk(size);
 				}
 			} else if(gid==GID::Blob_Cmp_Data) {
 				if(load) {
-					if(size>0) {
+					if(compression==GID::LZ4) {
+						data.resize(uncompressed);
+						reader->ReadLZ4(data.data(), uncompressed, size);
+					}
+					else if(size>0) {
 						Encoding::Lzma.Decode(reader->GetStream(), data, nullptr, uncompressed);
 					}
 					
@@ -115,6 +143,8 @@ namespace Gorgon { namespace Resource {
 		writer.WriteBool(lateloading);
 		writer.WriteEnd(propstart);
 		
+		writer.SetCompression(compression);
+		
 		if(compression==GID::None) {
 			writer.WriteChunkHeader(GID::Blob_Data, (unsigned long)data.size());
 			writer.WriteVector(data);
@@ -124,6 +154,13 @@ namespace Gorgon { namespace Resource {
 			Encoding::Lzma.Encode(data, writer.GetStream());
 			writer.WriteEnd(datastart);
 		}
+		else if(compression==GID::LZ4) {
+			std::vector<Byte> encoded;
+			Encoding::Lz4.Encode(data, encoded);
+
+			writer.WriteChunkHeader(GID::Blob_Cmp_Data, (unsigned long)encoded.size());
+			writer.WriteVector(encoded);
+		}
 		else {
 			throw std::runtime_error("Unknown compression mode: "+String::From(compression));
 		}
@@ -11,7 +11,7 @@ namespace Gorgon { namespace Resource {
 	class Reader;
 	
 	////This is sound resource. It may contain 22kHz or 44kHz mono or stereo wave files.
-	/// Also supports LZMA compression. No native sound compression is supported.
+	/// Also supports LZMA and LZ4 compression. No native sound compression is supported.
 	class Blob : public Base {
 	public:
 
@@ -27,12 +27,24 @@ namespace Gorgon { namespace Resource {
 		/// 04010000h (Extended, Blob)
 		virtual GID::Type GetGID() const override { return GID::Blob; }
 
-		/// Size of the blob
-		unsigned long GetSize() const { return (unsigned long)data.size(); }
+		/// Size of the blob. If the blob is not loaded yet, this is the size it will have after loading
+		unsigned long GetSize() const { return isloaded || !reader ? (unsigned long)data.size() : datasize; }
 
 		/// Returns the type of the blob
 		Type GetType() const { return type; }
 
+		/// Changes the compression mode. It only works if this blob is saved along with a file. 
+		/// GID::None, GID::LZMA and GID::LZ4 are supported. LZ4 compresses less, however, it is
+		/// much faster to load.
+		void SetCompression(GID::Type compression) {
+			this->compression=compression;
+		}
+
+		/// Returns the compression mode of this blob
+		GID::Type GetCompression() const {
+			return compression;
+		}
+
 		/// Readies the blob for data writing. Erases previous data, sets current size and type. Also
 		/// marks blob as loaded. Returned vector which can be used to assign data to it. The returned
 		/// vector should not be resized even though it will work (for now). It also discards any
@@ -53,8 +65,20 @@ namespace Gorgon { namespace Resource {
 		bool IsLoaded() const { return isloaded; }
 		
 		/// Returns the data stored in this blob. It is safe to change its contents, even its size.
-		/// However, its better to use reset to adjust the size and the type of the blob
-		std::vector<Byte> &GetData() { return data; }
+		/// However, its better to use reset to adjust the size and the type of the blob. If the
+		/// blob is not loaded yet, it will be loaded first.
+		std::vector<Byte> &GetData() { 
+			if(!isloaded && reader)
+				Load();
+
+			return data; 
+		}
+
+		/// Returns the data of an uncompressed blob directly from a memory mapped file without loading
+		/// it. Returns nullptr if the blob is already loaded, compressed or its file is not mapped. 
+		/// The returned pointer is valid until the blob is loaded or destroyed. Size of the data is 
+		/// GetSize().
+		const Byte *GetMappedData() const;
 
 		/// Imports the given file as data without changing the type of the blob
 		bool ImportFile(const std::string &filename) { 
@@ -77,6 +101,12 @@ namespace Gorgon { namespace Resource {
 		
 		void save(Writer &writer) const override;
 
+		virtual bool isdeferred() const override { return !isloaded && reader; }
+
+		virtual bool loaddeferred(std::shared_ptr<Reader> reader) override;
+
+		virtual void loaded() override;
+
 		/// Entry point of this resource within the physical file. This value is stored for 
 		/// late loading purposes
 		unsigned long entrypoint = -1;
@@ -84,6 +114,12 @@ namespace Gorgon { namespace Resource {
 		/// Used to handle late loading
 		std::shared_ptr<Reader> reader;
 
+		/// Position of the uncompressed data in the file, 0 if the data is compressed
+		unsigned long dataentry = 0;
+
+		/// Size of the data after loading
+		unsigned long datasize = 0;
+
 		/// Whether this blob is loaded or not
 		bool isloaded = false;
 		
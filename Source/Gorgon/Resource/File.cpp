@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 #include "../Filesystem.h"
+#include "../Threading.h"
 #include "../Encoding/LZMA.h"
+#include "../Encoding/LZ4.h"
 
 #include "File.h"
 #include "Blob.h"
@@ -51,6 +57,19 @@ namespace Gorgon { namespace Resource {
 		return false;
 	}
 
+	void Resource::Reader::ReadLZ4(Byte *output, unsigned long outputsize, unsigned long size) {
+		//mapped files are decoded without copying
+		auto data=Map(Tell(), size);
+
+		if(data) {
+			Encoding::Lz4.Decode(data, size, output, outputsize);
+			EatChunk(size);
+		}
+		else {
+			Encoding::Lz4.Decode(GetStream(), size, output, outputsize);
+		}
+	}
+
 	Base *File::LoadChunk(Base &self, GID::Type gid, unsigned long size, bool skipobjects) {
 		ASSERT(reader, "Reader is not open");
 
@@ -116,27 +135,14 @@ namespace Gorgon { namespace Resource {
 		reader->KeepOpen();
 
 		try {
-			char sgn[7];
-
-			//Check file signature
-			reader->ReadArray(sgn, 6);
-			sgn[6]=0;
-			if(std::string("GORGON")!=sgn)
-				throw LoadError(LoadError::Signature);
-
-			//Check file version
-			fileversion=reader->ReadInt32();
-			if(fileversion>CurrentVersion)
-				throw LoadError(LoadError::VersionMismatch);
-
-			//Load file type
-			filetype=reader->ReadGID();
+			readheader();
 
 			//Check first element
 			if(reader->ReadGID()!=GID::Folder)
 				throw LoadError(LoadError::Containment);
 
 			unsigned long size=reader->ReadUInt32();
+			auto end=reader->Tell()+size;
 
 			//Load first element
 			delete root;
@@ -147,6 +153,15 @@ namespace Gorgon { namespace Resource {
 				root=new Folder(*this);
 				throw LoadError(LoadError::Containment);
 			}
+
+			//directory follows the root folder
+			directory.clear();
+			if(fileversion>=DirectoryVersion) {
+				reader->Seek(end);
+
+				if(reader->ReadGID()==GID::File_Directory)
+					readdirectory(reader->ReadChunkSize());
+			}
 		}
 		catch(...) {
 			delete root;
@@ -181,7 +196,84 @@ namespace Gorgon { namespace Resource {
 		root->Resolve(*this);
 	}
 
-	void File::createfilereader(std::string filename) {
+	void File::LoadParallel(const std::string &filename, ProgressNotification progress, unsigned threads) {
+		createfilereader(filename, true);
+
+		load(false, false);
+
+		//collect the resources that skipped their data
+		std::vector<Base*> pending;
+		std::vector<Containers::Collection<Base>::ConstIterator> openlist;
+		openlist.push_back(root->begin());
+
+		while(openlist.size()) {
+			if(!openlist.back().IsValid()) {
+				openlist.pop_back();
+				continue;
+			}
+
+			auto &obj=(*openlist.back());
+			openlist.back().Next();
+			if(obj.Children.GetCount()>0)
+				openlist.push_back(obj.begin());
+
+			if(obj.isdeferred())
+				pending.push_back(&obj);
+		}
+
+		if(pending.empty())
+			return;
+
+		if(threads==0)
+			threads=std::thread::hardware_concurrency();
+
+		threads=std::max(1u, std::min(threads, (unsigned)pending.size()));
+
+		//every thread reads from its own position
+		std::vector<std::shared_ptr<Reader>> readers;
+		for(unsigned i=0; i<threads; i++) {
+			readers.push_back(reader->Duplicate());
+			readers.back()->Open();
+		}
+
+		std::atomic<unsigned long> next(0);
+		unsigned long done=0;
+		std::mutex mtx;
+		std::exception_ptr error;
+
+		Threading::RunInParallel([&](int id, int) {
+			for(auto i=next++; i<pending.size(); i=next++) {
+				try {
+					pending[i]->loaddeferred(readers[id]);
+				}
+				catch(...) {
+					std::lock_guard<std::mutex> guard(mtx);
+					if(!error)
+						error=std::current_exception();
+
+					next=(unsigned long)pending.size();
+
+					return;
+				}
+
+				if(progress) {
+					std::lock_guard<std::mutex> guard(mtx);
+					progress(++done, (unsigned long)pending.size());
+				}
+			}
+		}, threads);
+
+		//readers of the resources are released from this thread
+		for(auto res : pending) {
+			if(!res->isdeferred())
+				res->loaded();
+		}
+
+		if(error)
+			std::rethrow_exception(error);
+	}
+
+	void File::createfilereader(std::string filename, bool mapped, bool lazy) {
 		reader.reset();
 
 		if(!Filesystem::IsFile(filename) && Filesystem::IsFile(filename+".lzma")) {
@@ -191,27 +283,166 @@ namespace Gorgon { namespace Resource {
 			Filesystem::Delete(filename+".lzma");
 		}
 
-		reader.reset(new FileReader(filename));
+		if(mapped)
+			reader.reset(new MappedReader(filename, lazy));
+		else
+			reader.reset(new FileReader(filename));
 	}
 	
 	void File::save() const {
 		writer->open(true);
 		
 		writer->WriteString("GORGON");
-		writer->WriteUInt32(0x00010000);
+		writer->WriteUInt32(CurrentVersion);
 		writer->WriteUInt32(filetype.AsInteger());
 		
+		writer->directory.clear();
 		this->root->save(*writer);		
 		
+		//directory is placed after the root and its position is written at the end of the file
+		auto directorypos=writer->Tell();
+		auto start=writer->WriteChunkStart(GID::File_Directory);
+		writer->WriteUInt32((unsigned long)writer->directory.size());
+		for(auto &entry : writer->directory) {
+			writer->WriteGuid(entry.Guid);
+			writer->WriteGID(entry.Type);
+			writer->WriteUInt32(entry.Offset);
+			writer->WriteUInt32(entry.Size);
+			writer->WriteGID(entry.Compression);
+			writer->WriteStringWithSize(entry.Name);
+		}
+		writer->WriteEnd(start);
+		writer->WriteUInt32(directorypos);
 		
 		writer->close();
 	}
+
+	void File::readheader() {
+		char sgn[7];
+
+		//Check file signature
+		reader->ReadArray(sgn, 6);
+		sgn[6]=0;
+		if(std::string("GORGON")!=sgn)
+			throw LoadError(LoadError::Signature);
+
+		//Check file version
+		fileversion=reader->ReadInt32();
+		if(fileversion>CurrentVersion)
+			throw LoadError(LoadError::VersionMismatch);
+
+		//Load file type
+		filetype=reader->ReadGID();
+	}
+
+	void File::readdirectory(unsigned long size) {
+		auto target=reader->Target(size);
+
+		auto count=reader->ReadUInt32();
+		directory.reserve(count);
+
+		for(unsigned long i=0; i<count && !target; i++) {
+			DirectoryEntry entry;
+
+			entry.Guid=reader->ReadGuid();
+			entry.Type=reader->ReadGID();
+			entry.Offset=reader->ReadUInt32();
+			entry.Size=reader->ReadUInt32();
+			entry.Compression=reader->ReadGID();
+			entry.Name=reader->ReadString();
+
+			directory.push_back(entry);
+		}
+
+		reader->Seek(target);
+	}
+
+	bool File::LoadDirectory(const std::string &filename) {
+		createfilereader(filename, true, false);
+
+		delete root;
+		root=new Folder(*this);
+		directory.clear();
+		mapping.clear();
+
+		reader->Open();
+		if(!reader->IsGood()) {
+			throw LoadError(LoadError::FileCannotBeOpened);
+		}
+
+		//the file is kept open until this object is destroyed or another file is loaded
+		reader->KeepOpen();
+
+		try {
+			readheader();
+
+			if(fileversion<DirectoryVersion)
+				return false;
+
+			//position of the directory is at the end of the file
+			reader->GetStream().seekg(-4, std::ios::end);
+			reader->Seek(reader->ReadUInt32());
+
+			if(reader->ReadGID()!=GID::File_Directory)
+				throw LoadError(LoadError::Containment, "Cannot find the directory of the file.");
+
+			readdirectory(reader->ReadChunkSize());
+		}
+		catch(...) {
+			reader.reset();
+
+			throw;
+		}
+
+		return true;
+	}
+
+	Base *File::LoadItem(const SGuid &guid) {
+		for(auto &entry : directory) {
+			if(entry.Guid==guid)
+				return loaditem(entry);
+		}
+
+		return nullptr;
+	}
+
+	Base *File::LoadItem(const std::string &name) {
+		for(auto &entry : directory) {
+			if(entry.Name==name)
+				return loaditem(entry);
+		}
+
+		return nullptr;
+	}
+
+	Base *File::loaditem(const DirectoryEntry &entry) {
+		if(!reader || !reader->TryOpen())
+			throw LoadError(LoadError::FileCannotBeOpened);
+
+		reader->Seek(entry.Offset);
+
+		auto gid=reader->ReadGID();
+		auto size=reader->ReadChunkSize();
+
+		if(gid!=entry.Type || size!=entry.Size)
+			throw LoadError(LoadError::Containment, "Directory does not match the contents of the file.");
+
+		auto obj=LoadChunk(gid, size);
+
+		if(obj)
+			obj->Resolve(*this);
+
+		return obj;
+	}
 	
 	/// Writes the start of an object. Should have a matching WriteEnd with the returned marker.
 	Writer::Marker Writer::WriteObjectStart(const Base &base) {
 		ASSERT(stream, "Writer is not opened.");
 		ASSERT(IsGood(), "Writer is failed.");
 
+		objects.push_back(directory.size());
+		directory.push_back({base.GetGuid(), base.GetGID(), Tell(), 0, GID::None, base.GetName()});
+
 		WriteGID(base.GetGID());
 		auto pos=Tell();
 		WriteChunkSize(-1);
@@ -235,6 +466,9 @@ namespace Gorgon { namespace Resource {
 		ASSERT(stream, "Writer is not opened.");
 		ASSERT(IsGood(), "Writer is failed.");
 
+		objects.push_back(directory.size());
+		directory.push_back({base.GetGuid(), type, Tell(), 0, GID::None, base.GetName()});
+
 		WriteGID(type);
 		auto pos=Tell();
 		WriteChunkSize(-1);
@@ -4,8 +4,10 @@
 #include <iostream>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "../Utils/Assert.h"
 #include "Base.h"
@@ -53,6 +55,10 @@ namespace Gorgon { namespace Resource {
 	class File {
 	public:
 
+		/// Progress notification for parallel loading. First parameter is the number of resources
+		/// that are decoded, second is the total number of resources to decode.
+		typedef std::function<void(unsigned long, unsigned long)> ProgressNotification;
+
 		/// Default constructor
 		File();
 
@@ -96,6 +102,7 @@ namespace Gorgon { namespace Resource {
 			root=new Folder(*this);
 			fileversion=0;
 			filetype=GID::None;
+			directory.clear();
 		}
 
 
@@ -111,6 +118,40 @@ namespace Gorgon { namespace Resource {
 			load(false, false); 
 		}
 
+		/// Loads the given file by mapping it to memory. Only the structure of the file is read while
+		/// loading, images, sounds and blobs load their data when they are first used, prepared or 
+		/// when their Load function is called. Uncompressed data is copied directly from the memory.
+		/// The file is kept mapped until all resources are loaded. Use this function for large
+		/// resource files where only some of the resources are needed at a time.
+		/// If the filename not found and there is a filename.lzma file, this function extracts the compressed
+		/// file and tries to load uncompressed version.
+		/// @throws LoadError
+		/// @throws std::runtime_error
+		void LoadMapped(const std::string &filename) { 
+			createfilereader(filename, true);
+
+			load(false, false); 
+		}
+
+		/// Loads the given file and decodes the data of images, sounds and blobs in parallel. The
+		/// structure of the file is read sequentially from the memory mapped file, then the data of
+		/// the resources are decoded by the given number of threads. If threads is 0, the number of
+		/// hardware threads is used. Progress is called after each resource is decoded, from the
+		/// decoding threads, one call at a time. Textures are not prepared, call Prepare from the
+		/// main thread after loading is completed.
+		/// @throws LoadError
+		/// @throws std::runtime_error
+		void LoadParallel(const std::string &filename, ProgressNotification progress = {}, unsigned threads = 0);
+
+		/// Loads the given file in the background using LoadParallel. This file and its resources
+		/// should not be accessed until the returned future is ready. Errors are thrown from the
+		/// get function of the future. Call Prepare from the main thread after loading is completed.
+		std::future<void> LoadAsync(const std::string &filename, ProgressNotification progress = {}, unsigned threads = 0) {
+			return std::async(std::launch::async, [this, filename, progress, threads] {
+				LoadParallel(filename, progress, threads);
+			});
+		}
+
 		/// Loads only the first object of the given file. Useful to retrieve header information.
 		/// If the filename not found and there is a filename.lzma file, this function extracts the compressed
 		/// file and tries to load uncompressed version.
@@ -137,6 +178,33 @@ namespace Gorgon { namespace Resource {
 			load(false, true);
 		}
 		
+		/// Reads the directory of the given file without loading any resources. Resources can then be
+		/// loaded one at a time using LoadItem, which costs a seek and reading of the resource. The
+		/// file is mapped to memory and kept open until another file is loaded or this object is
+		/// destroyed. Returns false if the file does not have a directory, which is the case for the 
+		/// files that are saved before version 1.1. Root of this file will be empty.
+		/// @throws LoadError
+		/// @throws std::runtime_error
+		bool LoadDirectory(const std::string &filename);
+
+		/// Returns the directory of the loaded file. Directory lists every object in the file in the 
+		/// order they are saved, including the root folder. It is empty if the file does not have a 
+		/// directory.
+		const std::vector<DirectoryEntry> &GetDirectory() const {
+			return directory;
+		}
+
+		/// Loads the object with the given guid from the loaded file using the directory. The object is
+		/// loaded along with its children. Ownership of the object is transferred to the caller, use
+		/// DeleteResource to destroy it. Returns nullptr if the object is not in the directory.
+		/// @throws LoadError
+		/// @throws std::runtime_error
+		Base *LoadItem(const SGuid &guid);
+
+		/// Loads the first object with the given name from the loaded file using the directory. See the
+		/// other variant for details.
+		Base *LoadItem(const std::string &name);
+		
 		/// Saves this file to the disk using the given filename. This operation will over write if the file exists.
 		/// May throw WriteError
 		void Save(const std::string &filename) {
@@ -188,6 +256,15 @@ namespace Gorgon { namespace Resource {
 		/// This function performs the save operation
 		void save() const;
 
+		/// Reads and checks the signature, version and type of the file
+		void readheader();
+
+		/// Reads the directory chunk with the given size
+		void readdirectory(unsigned long size);
+
+		/// Loads the object in the given directory entry
+		Base *loaditem(const DirectoryEntry &entry);
+
 		/// The root folder, root changes while loading a file
 		Folder *root;
 
@@ -198,17 +275,20 @@ namespace Gorgon { namespace Resource {
 		/// point to read more data.
 		bool keepopen=false;
 
-		/// Version of the loaded file. Currently there is only a single version. This version does not relate to
-		/// the versions of the resources in the resource file.
+		/// Version of the loaded file. This version does not relate to the versions of the resources in the
+		/// resource file.
 		unsigned long fileversion;
 
+		/// Directory of the loaded file
+		std::vector<DirectoryEntry> directory;
+
 		/// The reader that would be used to read the file
 		std::shared_ptr<Reader> reader;
 		
 		std::shared_ptr<Writer> writer;
 
 	private:
-		void createfilereader(std::string filename);
+		void createfilereader(std::string filename, bool mapped = false, bool lazy = true);
 		std::shared_ptr<File> self;
 	};
 } }
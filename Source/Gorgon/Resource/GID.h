@@ -10,8 +10,12 @@ namespace Gorgon {
 		/// Current resource system version. Used to determine file
 		/// capabilities. Note that this is different from versions of
 		/// each resource. This version tag will not easily change in the
-		/// future.
-		static const unsigned long CurrentVersion				=	0x00010000;
+		/// future. Version 1.1 adds a directory of the objects after the root
+		/// folder, files of version 1.0 can still be loaded.
+		static const unsigned long CurrentVersion				=	0x00010100;
+
+		/// First resource system version that contains a directory
+		static const unsigned long DirectoryVersion				=	0x00010100;
 		
 
 		//Gorgon IDs for known resource types
@@ -83,6 +87,9 @@ namespace Gorgon {
             /// File
 			constexpr Type File					{0x000000FF};
 
+			/// Directory of the objects in a file, stored after the root folder
+			constexpr Type File_Directory		{0x00000101};
+
 			/// Denotes this file is a game file
 			constexpr Type GameFile				{0x030100FF};
 
@@ -124,6 +131,8 @@ namespace Gorgon {
 			constexpr Type JPEG					{0xF0030300};
 			/// PNG compression
 			constexpr Type PNG					{0xF0030400};
+			/// LZ4 compression, fast to decode
+			constexpr Type LZ4					{0xF0030500};
 			/// @}
 			
 			/// @name Basic Resources
@@ -287,6 +296,7 @@ namespace Gorgon {
 				switch(value) {
 					case 0x00000000: return "None";
 					case 0x000000FF: return "File";
+					case 0x00000101: return "File Directory";
 					case 0x030100FF: return "GameFile";
 					case 0x01010000: return "Folder";
 					case 0x01010101: return "Folder Names";
@@ -302,6 +312,7 @@ namespace Gorgon {
 					case 0xF0040100: return "FLAC";
 					case 0xF0030300: return "JPEG";
 					case 0xF0030400: return "PNG";
+					case 0xF0030500: return "LZ4";
 					case 0x02010000: return "Text";
 					case 0x02010101: return "HTML";
 					case 0x02010102: return "URL";
@@ -2,6 +2,7 @@
 #include "File.h"
 #include "../Graphics/EmptyImage.h"
 #include "../Encoding/PNG.h"
+#include "../Encoding/LZ4.h"
 
 namespace Gorgon { namespace Resource {
 
@@ -32,11 +33,7 @@ namespace Gorgon { namespace Resource {
 		if(!reader->TryOpen())	return false;
 
 
-		reader->Seek(entrypoint-4);
-
-		auto size=reader->ReadChunkSize();
-
-		auto ret=load(reader, size, true);
+		auto ret=loaddeferred(reader);
 
 		if(ret && isloaded) {
 			loaded();
@@ -45,6 +42,14 @@ namespace Gorgon { namespace Resource {
 		return ret;
 	}
 
+	bool Image::loaddeferred(std::shared_ptr<Reader> reader) {
+		reader->Seek(entrypoint-4);
+
+		auto size=reader->ReadChunkSize();
+
+		return load(reader, size, true);
+	}
+
 	bool Image::load(std::shared_ptr<Reader> reader, unsigned long totalsize, bool forceload) {
 
 		auto target = reader->Target(totalsize);
@@ -69,7 +74,7 @@ namespace Gorgon { namespace Resource {
 				mode=reader->ReadEnum32<Graphics::ColorMode>();
 				compression=reader->ReadGID();
 
-				load=!reader->ReadBool() || forceload;
+				load=(!reader->ReadBool() && !reader->IsLazy()) || forceload;
 
 				if(!load) {
 					reader->KeepOpen();
@@ -105,6 +110,10 @@ namespace Gorgon { namespace Resource {
 						Encoding::Png.Decode(reader->GetStream(), *data);
                         data->ChangeMode(mode);
 					}
+					else if(compression==GID::LZ4) {
+						data->Resize({width, height}, mode);
+						reader->ReadLZ4(data->RawData(), data->GetTotalSize(), size);
+					}
 					else {
 						throw LoadError(LoadError::Unknown, "Unknown compression type.");
 					}
@@ -151,6 +160,8 @@ namespace Gorgon { namespace Resource {
 		writer.WriteBool(false);
 		writer.WriteEnd(propstart);
 		
+		writer.SetCompression(compression);
+		
 		if(compression==GID::None) {
 			writer.WriteChunkHeader(GID::Image_Data, data->GetTotalSize());
 			writer.WriteArray(data->RawData(), data->GetTotalSize());
@@ -160,6 +171,13 @@ namespace Gorgon { namespace Resource {
 			Encoding::Png.Encode(*data, writer.GetStream(), true);
 			writer.WriteEnd(cmpdat);
 		}
+		else if(compression==GID::LZ4) {
+			std::vector<Byte> encoded;
+			Encoding::Lz4.Encode(data->RawData(), data->GetTotalSize(), encoded);
+
+			writer.WriteChunkHeader(GID::Image_Cmp_Data, (unsigned long)encoded.size());
+			writer.WriteVector(encoded);
+		}
 		else {
 			throw std::runtime_error("Unknown compression mode: "+String::From(compression));
 		}
@@ -32,8 +32,8 @@ namespace Gorgon { namespace Resource {
 		virtual GID::Type GetGID() const override { return GID::Image; }
 		
 		
-		/// Changes the compression mode. It only works if this image is saved along with a file. Currently only GID::None
-		/// and GID::PNG works.
+		/// Changes the compression mode. It only works if this image is saved along with a file. Currently GID::None,
+		/// GID::PNG and GID::LZ4 works. LZ4 compresses less than PNG, however, it is much faster to load.
 		void SetCompression(GID::Type compression) {
 			this->compression=compression;
 		}
@@ -43,7 +43,13 @@ namespace Gorgon { namespace Resource {
 			return compression;
 		}
 
-		virtual void Prepare() override { Bitmap::Prepare(); }
+		/// Prepares the image to be drawn. If the image data is not loaded yet, it will be loaded first.
+		virtual void Prepare() override { 
+			if(!isloaded)
+				Load();
+
+			Bitmap::Prepare(); 
+		}
 
 		virtual void Discard() override { Bitmap::Discard(); }
 		
@@ -77,9 +83,11 @@ namespace Gorgon { namespace Resource {
 		
 		void save(Writer &writer) const override;
         
-        void loaded();
-		
-		//virtual void loaded() override { }
+		virtual bool isdeferred() const override { return !isloaded && reader; }
+
+		virtual bool loaddeferred(std::shared_ptr<Reader> reader) override;
+
+		virtual void loaded() override;
 
 		/// Compression mode
 		GID::Type compression = GID::PNG;
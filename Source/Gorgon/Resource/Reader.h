@@ -116,7 +116,7 @@ namespace Gorgon { namespace Resource {
 		/// to keep the stream open. If no object requires this reader, it is closed. Note that
 		/// some readers cannot be reopened.
 		void NoLongerNeeded() {
-			if(--keepopenrequests) {
+			if(--keepopenrequests == 0) {
 				close();
 				stream=nullptr;
 			}
@@ -157,6 +157,27 @@ namespace Gorgon { namespace Resource {
 		}
 
 
+		/// Returns whether the resources should defer loading their data until it is requested,
+		/// regardless of their late loading setting. Only the structure of the file is read
+		/// while loading.
+		bool IsLazy() const {
+			return lazy;
+		}
+
+		/// Returns the data at the given position directly from the memory if the whole file is
+		/// available in memory. Otherwise, or if the range is outside the file, returns nullptr.
+		/// Returned pointer is valid until the reader is closed.
+		virtual const Byte *Map(unsigned long position, unsigned long size) const {
+			return nullptr;
+		}
+
+		/// Creates a new reader that reads from the same source with its own position. Duplicates
+		/// can be used by different threads at the same time. Returns nullptr if the reader
+		/// cannot be duplicated.
+		virtual std::shared_ptr<Reader> Duplicate() const {
+			return nullptr;
+		}
+
 		/// This should be last resort, use if the actual stream is needed.
 		std::istream &GetStream() {
 			ASSERT(stream, "Reader is not opened.");
@@ -196,6 +217,11 @@ namespace Gorgon { namespace Resource {
 
 		bool ReadCommonChunk(Base &self, GID::Type gid, unsigned long size);
 
+		/// Reads size bytes of LZ4 compressed data and decodes it to the output, which should have 
+		/// room for exactly outputsize bytes. Mapped files are decoded directly from the memory.
+		/// @throws std::runtime_error if the data is corrupt
+		void ReadLZ4(Byte *output, unsigned long outputsize, unsigned long size);
+
 		/// @name Platform independent data readers
 		/// @{
 		/// These functions allow platform independent data reading capability. In worst case, where the platform
@@ -418,6 +444,9 @@ namespace Gorgon { namespace Resource {
 		/// can have specialized copies of this member.
 		std::istream *stream = nullptr;
 
+		/// Whether the resources should defer loading their data
+		bool lazy = false;
+
 	private:
 		int keepopenrequests = 0;
 	};
@@ -433,6 +462,9 @@ namespace Gorgon { namespace Resource {
 			catch(...) {}
 		}
 
+		virtual std::shared_ptr<Reader> Duplicate() const override {
+			return std::make_shared<FileReader>(filename);
+		}
 
 	protected:
 		virtual void close() override {
@@ -461,4 +493,101 @@ namespace Gorgon { namespace Resource {
 		std::ifstream file;
 	};
 
+	/// This reader maps the file to memory instead of reading it through a file stream. Seeking
+	/// does not cost anything and the pages of the file are only read when they are accessed. If
+	/// lazy is set, images, sounds and blobs skip their data while the file is loaded and load it
+	/// when they are first used. Uncompressed data can be accessed directly from the memory.
+	class MappedReader : public Reader {
+	public:
+		/// Constructor requires a file to be opened later.
+		MappedReader(const std::string &filename, bool lazy = true) : filename(filename) {
+			this->lazy = lazy;
+
+			try {
+				this->filename=Filesystem::Canonical(filename);
+			}
+			catch(...) {}
+		}
+
+		virtual const Byte *Map(unsigned long position, unsigned long size) const override {
+			if(!file || (unsigned long long)position + size > file->GetSize())
+				return nullptr;
+
+			return (const Byte*)file->GetData() + position;
+		}
+
+		/// Duplicates share the mapping of this reader, if it is open.
+		virtual std::shared_ptr<Reader> Duplicate() const override {
+			auto dup = std::make_shared<MappedReader>(filename, lazy);
+			dup->file = file;
+
+			return dup;
+		}
+
+	protected:
+		virtual void close() override {
+			file.reset();
+			buffer.set(nullptr, 0);
+		}
+
+		virtual bool open(bool thrw) override {
+			if(!file) {
+				try {
+					file = std::make_shared<Filesystem::MappedFile>(filename);
+				}
+				catch(const Filesystem::PathNotFoundError &) {
+					if(thrw) {
+						throw LoadError(LoadError::FileNotFound, "Cannot open file: "+filename);
+					}
+
+					return false;
+				}
+			}
+
+			buffer.set(file->GetData(), file->GetSize());
+			mapped.clear();
+
+			stream = &mapped;
+
+			return true;
+		}
+
+	private:
+		/// Stream buffer that reads from the mapped memory
+		class mappedbuffer : public std::streambuf {
+		public:
+			void set(const char *data, unsigned long long size) {
+				auto ptr = const_cast<char*>(data);
+
+				setg(ptr, ptr, ptr + size);
+			}
+
+		protected:
+			virtual pos_type seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode) override {
+				off_type base = 0;
+
+				if(dir == std::ios::cur)
+					base = gptr() - eback();
+				else if(dir == std::ios::end)
+					base = egptr() - eback();
+
+				if(base + off < 0 || base + off > egptr() - eback())
+					return pos_type(off_type(-1));
+
+				setg(eback(), eback() + (base + off), egptr());
+
+				return pos_type(base + off);
+			}
+
+			virtual pos_type seekpos(pos_type pos, std::ios::openmode which) override {
+				return seekoff(off_type(pos), std::ios::beg, which);
+			}
+		};
+
+		std::string filename;
+		std::shared_ptr<Filesystem::MappedFile> file;
+		mappedbuffer buffer;
+		std::istream mapped{&buffer};
+	};
+
 } }
@@ -20,18 +20,28 @@ namespace Gorgon { namespace Resource {
 		if(!reader)				return false;
 		if(!reader->TryOpen())	return false;
 
+		auto ret=loaddeferred(reader);
+
+		if(ret && isloaded) {
+			loaded();
+		}
+
+		return true;
+	}
+
+	bool Sound::loaddeferred(std::shared_ptr<Reader> reader) {
 		reader->Seek(entrypoint-4);
 
 		auto size=reader->ReadChunkSize();
 
-		auto ret=load(reader, size, true);
+		return load(reader, size, true);
+	}
 
-		if(ret && isloaded) {
+	void Sound::loaded() {
+		if(reader) {
 			reader->NoLongerNeeded();
 			reader.reset();
 		}
-
-		return true;
 	}
 
 	bool Sound::load(std::shared_ptr<Reader> reader, unsigned long totalsize, bool forceload) {
@@ -59,7 +69,7 @@ namespace Gorgon { namespace Resource {
 				bits = reader->ReadUInt8();
 				lateloading=reader->ReadBool();
 
-				load=!lateloading || forceload;
+				load=(!lateloading && !reader->IsLazy()) || forceload;
 				if(!load) {
 					reader->KeepOpen();
 					this->reader=reader;
@@ -174,6 +184,8 @@ namespace Gorgon { namespace Resource {
 		}
 		writer.WriteEnd(propstart);
 
+		writer.SetCompression(compression);
+
 		if(compression==GID::None) {
 			if(pcm) {
 				writer.WriteChunkHeader(
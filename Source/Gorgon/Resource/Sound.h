@@ -25,11 +25,22 @@ namespace Gorgon {
 			/// 04010000h (Extended, Sound)
 			virtual GID::Type GetGID() const override { return GID::Sound; }
 
+			/// Returns the wave data of this sound. If the sound is not loaded yet, it will be loaded
+			/// first. Loading modifies the sound, therefore, this function should not be called from
+			/// multiple threads before the sound is loaded.
 			const Containers::Wave &GetWave() const {
+				if(!isloaded && reader)
+					const_cast<Sound &>(*this).Load();
+
 				return data;
 			}
 
+			/// Returns the wave data of this sound. If the sound is not loaded yet, it will be loaded
+			/// first.
 			Containers::Wave &GetWave() {
+				if(!isloaded && reader)
+					Load();
+
 				return data;
 			}
 
@@ -112,6 +123,12 @@ namespace Gorgon {
 
 			void save(Writer &writer) const override;
 
+			virtual bool isdeferred() const override { return !isloaded && reader; }
+
+			virtual bool loaddeferred(std::shared_ptr<Reader> reader) override;
+
+			virtual void loaded() override;
+
 			/// Checks if the format of the file is well-formed
 			void checkfmt() const;
 
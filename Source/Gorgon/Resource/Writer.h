@@ -5,6 +5,7 @@
 #include <fstream>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "../Utils/Assert.h"
 #include "../Filesystem.h"
@@ -51,6 +52,28 @@ namespace Gorgon { namespace Resource {
 		static const std::string ErrorStrings[3];
 	};
 	
+	/// An entry in the directory of a resource file. Directory lists every object in the file,
+	/// allowing a single object to be loaded without reading the rest of the file.
+	struct DirectoryEntry {
+		/// Guid of the object
+		SGuid Guid;
+
+		/// GID of the object chunk
+		GID::Type Type;
+
+		/// Position of the object chunk in the file, the chunk starts with its GID
+		unsigned long Offset = 0;
+
+		/// Size of the object chunk, excluding its GID and size
+		unsigned long Size = 0;
+
+		/// Compression of the data in the object, GID::None if the object is not compressed
+		GID::Type Compression = GID::None;
+
+		/// Name of the object
+		std::string Name;
+	};
+
 	/**
 	* This class allows resource objects to save their data to a stream. It provides functionality
 	* to write data platform independently. This class also allows back and forth writing to easy
@@ -384,9 +407,21 @@ namespace Gorgon { namespace Resource {
 			Seek(marker.pos);
 			WriteChunkSize(size);
 			Seek(pos);
+
+			if(!objects.empty() && directory[objects.back()].Offset==marker.pos-4) {
+				directory[objects.back()].Size=size;
+				objects.pop_back();
+			}
 			
 			marker.pos=-1;
 		}
+
+		/// Sets the compression of the object that is being written. This information is stored
+		/// in the directory of the file.
+		void SetCompression(GID::Type compression) {
+			if(!objects.empty())
+				directory[objects.back()].Compression=compression;
+		}
 		
 	protected:
 		/// This function should close the stream. The pointer will be unset
@@ -402,6 +437,12 @@ namespace Gorgon { namespace Resource {
 		/// can have specialized copies of this member.
 		std::ostream *stream = nullptr;
 
+		/// Objects that are written so far, it will be written after the root folder
+		std::vector<DirectoryEntry> directory;
+
+		/// Indexes of the directory entries of the objects that are not ended yet
+		std::vector<std::size_t> objects;
+
 	};
 	
 	
@@ -197,9 +197,11 @@ namespace Scripting {
 			return v;
 		}
 
+		//references are wrapped so that std::bind does not copy the objects, const references
+		//point to the parameter data, which outlives the call
 		template<int P_>
 		inline typename TMP::Choose<
-		is_nontmpref<param<P_>>::value && !extractvector<param<P_>>::isvector,
+		(is_nontmpref<param<P_>>::value || std::is_reference<param<P_>>::value) && !extractvector<param<P_>>::isvector,
 			std::reference_wrapper<typename std::remove_reference<param<P_>>::type>,
 			typename TMP::Choose<extractvector<param<P_>>::isvector,
 				typename std::remove_const<typename std::remove_reference<param<P_>>::type>::type,
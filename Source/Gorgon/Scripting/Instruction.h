@@ -92,6 +92,11 @@ namespace Gorgon { namespace Scripting {
 			/// Used for temporary results
 			Byte Result;
 			
+			/// Slot of a variable or an identifier in the scope that contains the instruction. Slots
+			/// are assigned by the scope when the instruction is saved. Values without a slot are
+			/// looked up using their names.
+			int Slot=-1;
+			
 			void SetLiteral(const Scripting::Type *type, Any value) {
 				Type=ValueType::Literal;
 				Literal={type, value};
@@ -110,11 +115,13 @@ namespace Gorgon { namespace Scripting {
 			void SetVariable(const std::string &name) {
 				Type=ValueType::Variable;
 				Name=name;
+				Slot=-1;
 			}
 			
 			void SetIdentifier(const std::string &name) {
 				Type=ValueType::Identifier;
 				Name=name;
+				Slot=-1;
 			}
 			
 			void SetTemp(Byte index) {
@@ -135,6 +142,42 @@ namespace Gorgon { namespace Scripting {
 			}
 		};
 		
+		/// @cond INTERNAL
+		/// Function and overload that are selected the last time an instruction is executed.
+		/// Overload resolution only depends on the function and the types of the arguments,
+		/// therefore, while they are the same, the selected overload can be reused. Similarly,
+		/// member functions are reused while the type of the object stays the same.
+		struct OverloadCache {
+			/// Type, constness and referenceness of an argument
+			struct Argument {
+				const Type *type;
+				bool constant;
+				bool reference;
+				
+				bool operator ==(const Argument &other) const {
+					return type==other.type && constant==other.constant && reference==other.reference;
+				}
+			};
+			
+			/// Member function that is found in the type of the first parameter
+			const Function *member = nullptr;
+			
+			/// Type that the member function is found in
+			const Type *membertype = nullptr;
+			
+			const Function *function = nullptr;
+			
+			const Function::Overload *overload = nullptr;
+			
+			/// Number of overloads and methods of the function, changes when overloads are declared
+			int count = 0;
+			
+			bool method = false;
+			
+			std::vector<Argument> arguments;
+		};
+		/// @endcond
+		
 		/**
 		 * A single instruction. An instruction can either be a function call or an assignment.
 		 *
@@ -174,5 +217,9 @@ namespace Gorgon { namespace Scripting {
 				Byte Store;
 				int JumpOffset=0;
 			};
+			
+			/// Used by the VM to skip overload resolution for function calls. Not copied. Written
+			/// while executing, therefore, a scope cannot run on two threads at once.
+			mutable OverloadCache Cache;
 		};
 } }
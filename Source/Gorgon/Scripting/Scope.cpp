@@ -50,6 +50,7 @@ namespace Gorgon { namespace Scripting {
 				
 				for(unsigned i=(unsigned)parser->List.size()-compiled;i<parser->List.size();i++) {
 					lines.push_back({parser->List[i], pline});
+					resolve(lines.back().instruction);
 				}
 				
 				parser->List.erase(parser->List.end()-compiled, parser->List.end());
@@ -59,6 +60,36 @@ namespace Gorgon { namespace Scripting {
 		}
 	}
 	
+	void Scope::resolve(Value &value) {
+		if(value.Type!=ValueType::Variable && value.Type!=ValueType::Identifier)
+			return;
+		
+		//special identifiers and namespace members are not stored in variables
+		if(value.Name.empty() || value.Name.find_first_of("@%!$:")!=value.Name.npos) {
+			value.Slot=-1;
+			
+			return;
+		}
+		
+		auto slot=slots.find(value.Name);
+		if(slot==slots.end())
+			slot=slots.insert(std::make_pair(value.Name, (int)slots.size())).first;
+		
+		value.Slot=slot->second;
+	}
+	
+	void Scope::resolve(Instruction &inst) {
+		//overload declarations are evaluated once, while declaring the function
+		if(inst.Type==InstructionType::DeclOverload)
+			return;
+		
+		resolve(inst.Name);
+		resolve(inst.RHS);
+		
+		for(auto &param : inst.Parameters)
+			resolve(param);
+	}
+	
 	Scope::Scope(InputProvider &provider, const std::string &name, bool terminal) : provider(&provider), name(name), terminal(terminal) {
 		switch(provider.GetDialect()) {
 			case InputProvider::Intermediate:
@@ -58,6 +58,10 @@ namespace Gorgon { namespace Scripting {
 	 * A new scope is created automatically when a new input source or a function like construct
 	 * is created. Scopes can be linked to each other. There are two methods to supply codes to
 	 * a scope: from an InputProvider and directly registering instructions to it.
+	 *
+	 * A scope must not be executed on more than one thread at the same time, even by different
+	 * virtual machines. Instructions are read from the input provider as they are reached and
+	 * function calls save the selected overloads to their instructions.
 	 */
 	class Scope {
 		friend class ScopeInstance;
@@ -101,6 +105,7 @@ namespace Gorgon { namespace Scripting {
 		/// Saves an instruction to the scope
 		void SaveInstruction(Instruction inst, long pline) {
 			lines.push_back({inst, pline});
+			resolve(lines.back().instruction);
 		}
 		
 		/// Saves a list of instructions to this scope
@@ -108,9 +113,15 @@ namespace Gorgon { namespace Scripting {
 			long pline=0;
 			for(auto &inst : insts) {
 				lines.push_back({inst, pline});
+				resolve(lines.back().instruction);
 			}
 		}
 		
+		/// Returns the number of variable slots that are assigned in this scope
+		int GetSlotCount() const {
+			return (int)slots.size();
+		}
+		
 		/// Returns if this scope is terminal scope. If a scope is terminal, variable lookup to the parent 
 		/// scopes terminates at this scope
 		bool IsTerminal() const {
@@ -149,6 +160,10 @@ namespace Gorgon { namespace Scripting {
 		}
 		
 		void SetVariable(const std::string &name, const Data &data) {
+			//a new static variable hides the variables of the parent scopes
+			if(!variables.count(name))
+				generation++;
+			
 			variables[name]={name, data};
 		}
 		
@@ -157,6 +172,8 @@ namespace Gorgon { namespace Scripting {
 			
 			if( var !=variables.end() ) {
 				variables.erase(var);
+				generation++;
+				
 				return true;
 			}
 			else
@@ -181,6 +198,13 @@ namespace Gorgon { namespace Scripting {
 		}
 		
 	private:
+		/// Assigns slots to the variables and identifiers of the given instruction so that
+		/// scope instances can bind them to their variables once instead of looking them up
+		/// by name every time the instruction is executed.
+		void resolve(Instruction &inst);
+		
+		void resolve(Value &value);
+		
 		std::string name;
 		
 		int nextid=1;
@@ -200,6 +224,14 @@ namespace Gorgon { namespace Scripting {
 		//-unordered map
 		std::map<std::string, Variable, String::CaseInsensitiveLess> variables;
 		
+		/// Slots of the names used in this scope
+		std::map<std::string, int, String::CaseInsensitiveLess> slots;
+		
+		/// Changes whenever a static variable of this scope is added or removed, invalidating
+		/// the slots that are bound by the instances of this scope. Slots are only bound to the
+		/// variables of this scope and its instances, changes in other scopes do not affect them.
+		unsigned long generation = 0;
+		
 		/// Every logical line at least up until current execution point. They are kept so that
 		/// it is possible to jump back. Logical lines do not contain comments.
 		std::vector<Line> lines;
@@ -294,14 +326,54 @@ namespace Gorgon { namespace Scripting {
 		}
 		
 		void SetVariable(const std::string &name, const Data &data) {
+			//a new local variable hides the names that are not bound to a variable
+			if(!variables.count(name))
+				bindings.clear();
+			
 			variables[name]={name, data};
 		}
 		
+		/// Returns the variable that the given slot of the scope is bound to. Slots are bound to
+		/// the local variables of this instance and the static variables of the scope. For other
+		/// names nullptr is returned and they should be looked up by name. local is set to true
+		/// if the variable is a local variable.
+		Variable *GetSlot(int slot, const std::string &name, bool &local) {
+			if(generation!=scope.generation) {
+				bindings.clear();
+				generation=scope.generation;
+			}
+			
+			if(slot>=(int)bindings.size())
+				bindings.resize(scope.GetSlotCount());
+			
+			auto &binding=bindings[slot];
+			if(!binding.bound) {
+				auto varit=variables.find(name);
+				
+				if(varit!=variables.end()) {
+					binding.variable=&varit->second;
+					binding.local=true;
+				}
+				else {
+					binding.variable=scope.GetVariable(name);
+					binding.local=false;
+				}
+				
+				binding.bound=true;
+			}
+			
+			local=binding.local;
+			
+			return binding.variable;
+		}
+		
 		bool UnsetVariable(const std::string &name) {
 			auto var=variables.find(name);
 			
 			if( var !=variables.end() ) {
 				variables.erase(var);
+				bindings.clear();
+				
 				return true;
 			}
 			
@@ -417,6 +489,19 @@ namespace Gorgon { namespace Scripting {
 		
 		//-unordered map
 		std::map<std::string, Variable, String::CaseInsensitiveLess> variables;
+		
+		/// A slot of the scope bound to a variable
+		struct slotbinding {
+			Variable *variable = nullptr;
+			bool bound = false;
+			bool local = false;
+		};
+		
+		/// Bound slots, unbound slots are bound when they are first used
+		std::vector<slotbinding> bindings;
+		
+		/// Scope generation that the slots are bound in
+		unsigned long generation = 0;
 
 		ScopeInstance *parent = nullptr;
 		
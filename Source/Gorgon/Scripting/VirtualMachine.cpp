@@ -9,7 +9,7 @@ namespace Gorgon {
 	
 	namespace Scripting {		
 		
-		Containers::Hashmap<std::thread::id, VirtualMachine> VirtualMachine::activevms;
+		thread_local VirtualMachine *VirtualMachine::active = nullptr;
 		Type *ParameterTemplateType();
 		Library &FilesystemLib();
 		extern Library Math;
@@ -370,16 +370,7 @@ namespace Gorgon {
 			
 			//if found
 			if(var) {
-				if(ref) var->ref=true;
-				
-				if(var->IsValid() && var->IsReference() && var->ref && !var->GetType().IsReferenceType()) {
-					fixparameter(data, var->GetType(), false, "");
-					
-					var->SetReferenceable(data);
-				}
-				else {
-					var->Set(data);
-				}
+				assign(*var, data, ref);
 				
 				return;
 			}
@@ -392,6 +383,38 @@ namespace Gorgon {
 			}
 		}
 		
+		void VirtualMachine::assign(Variable &var, Data data, bool ref) {
+			if(ref) var.ref=true;
+			
+			if(var.IsValid() && var.IsReference() && var.ref && !var.GetType().IsReferenceType()) {
+				fixparameter(data, var.GetType(), false, "");
+				
+				var.SetReferenceable(data);
+			}
+			else {
+				var.Set(data);
+			}
+		}
+		
+		void VirtualMachine::setvariable(const Value &name, const Data &data, bool ref) {
+			bool local;
+			Variable *var=boundvariable(name, local);
+			
+			if(var) {
+				assign(*var, data, ref);
+			}
+			else {
+				SetVariable(name.Name, data, ref);
+			}
+		}
+		
+		Variable *VirtualMachine::boundvariable(const Value &val, bool &local) {
+			if(val.Slot<0)
+				return nullptr;
+			
+			return scopeinstances.back()->GetSlot(val.Slot, val.Name, local);
+		}
+		
 		void VirtualMachine::UnsetVariable(const std::string &name) {
 			ASSERT(scopeinstances.size(), "No scope instance is active");
 			
@@ -449,8 +472,13 @@ namespace Gorgon {
 			}
 			
 			case ValueType::Variable: {
+				bool local;
+				Variable *var=boundvariable(val, local);
+				
 				if(reference) {
-					Variable *var=getvarref(val.Name);
+					if(!var)
+						var=getvarref(val.Name);
+					
 					if(var) {
 						return var->GetReference();
 					}
@@ -465,11 +493,28 @@ namespace Gorgon {
 					}
 				}
 				else {
+					if(var)
+						return *var;
+					
 					return GetVariable(val.Name);
 				}
 			}
 			
 			case ValueType::Identifier: {
+				bool local;
+				Variable *var=boundvariable(val, local);
+				
+				//same as FindSymbol, static variables are never returned as references
+				if(var) {
+					Data data=(reference && local) ? var->GetReference() : Data(*var);
+					
+					if(data.IsReference() && !data.GetData().Pointer()) {
+						throw SymbolNotFoundException(val.Name, SymbolType::Identifier, val.Name+" is null");
+					}
+					
+					return data;
+				}
+				
 				return FindSymbol(val.Name, reference);
 			}
 			default:
@@ -477,8 +522,68 @@ namespace Gorgon {
 			}
 		}	
 		
-		/// Calls the given function with the given values.
-		Data VirtualMachine::callfunction(const Function *fn, bool method, const std::vector<Value> &incomingparams) {
+		/// Checks the type of the value without copying it. Flags are the same as the data
+		/// getvalue would return, copies keep constness only for references.
+		bool VirtualMachine::getargument(const Value &val, OverloadCache::Argument &argument) {
+			const Data *data=nullptr;
+			
+			switch(val.Type) {
+			case ValueType::Literal:
+				data=&val.Literal;
+				break;
+				
+			case ValueType::Temp:
+				data=&temporaries[val.Result+tempbase];
+				
+				if(!data->IsValid())
+					return false;
+				
+				break;
+				
+			case ValueType::Variable:
+			case ValueType::Identifier: {
+				bool local;
+				data=boundvariable(val, local);
+				
+				if(!data && val.Type==ValueType::Variable && !val.Name.empty() && 
+					val.Name[0]!='@' && val.Name[0]!='%' && val.Name[0]!='!' && val.Name[0]!='$') 
+				{
+					data=getvarref(val.Name);
+				}
+				
+				if(data && val.Type==ValueType::Identifier && data->IsReference() && !data->GetData().Pointer())
+					return false;
+				
+				break;
+			}
+			
+			default:
+				return false;
+			}
+			
+			if(data) {
+				argument={&data->GetType(), data->IsReference() && data->IsConstant(), data->IsReference()};
+				
+				return true;
+			}
+			
+			//special and unbound symbols are resolved every time, variable parameters might not 
+			//exist yet, such arguments are not cached
+			try {
+				Data found=getvalue(val);
+				
+				argument={&found.GetType(), found.IsConstant(), found.IsReference()};
+				
+				return true;
+			}
+			catch(const SymbolNotFoundException &) {
+				return false;
+			}
+		}
+		
+		/// Calls the given function with the given values. If a cache is given, selected overload
+		/// is saved to it and reused while the types of the values stay the same.
+		Data VirtualMachine::callfunction(const Function *fn, bool method, const std::vector<Value> &incomingparams, OverloadCache *cache) {
 			const Function::Overload *var=nullptr;
 			
 			int count=fn->Overloads.GetCount()+fn->Methods.GetCount();
@@ -506,6 +611,21 @@ namespace Gorgon {
 				return callvariant(fn, &fn->Methods[0], method, incomingparams);
 			}
 			
+			if(cache && cache->function==fn && cache->count==count && cache->method==method && 
+				cache->arguments.size()==incomingparams.size()) 
+			{
+				bool hit=true;
+				OverloadCache::Argument argument;
+				
+				for(unsigned i=0; i<incomingparams.size() && hit; i++) {
+					hit=getargument(incomingparams[i], argument) && argument==cache->arguments[i];
+				}
+				
+				if(hit) {
+					return callvariant(fn, cache->overload, method, incomingparams);
+				}
+			}
+			
 			
 			//find correct variant
 			std::multimap<int, const Function::Overload*> variantlist;
@@ -712,6 +832,23 @@ namespace Gorgon {
 				throw SymbolNotFoundException(fn->GetName(), SymbolType::Function, "For these arguments.");
 			}
 			
+			if(cache) {
+				cache->function=nullptr;
+				cache->arguments.resize(incomingparams.size());
+				
+				bool valid=true;
+				for(unsigned i=0; i<incomingparams.size() && valid; i++) {
+					valid=getargument(incomingparams[i], cache->arguments[i]);
+				}
+				
+				if(valid) {
+					cache->function=fn;
+					cache->overload=var;
+					cache->count=count;
+					cache->method=method;
+				}
+			}
+			
 			return callvariant(fn, var, method, incomingparams);
 		}
 		
@@ -719,6 +856,7 @@ namespace Gorgon {
 			auto pin=incomingparams.begin();
 			
 			std::vector<Data> params;
+			params.reserve(incomingparams.size());
 			
 			if(fn->IsMember() && !fn->IsStatic()) {
 				if(pin!=incomingparams.end()) {
@@ -1013,7 +1151,10 @@ namespace Gorgon {
 					Data member;
 					//try library functions
 					try {
-						member=FindSymbol(functionname, true);
+						if(inst->Name.Type==ValueType::Identifier)
+							member=getvalue(inst->Name, true);
+						else
+							member=FindSymbol(functionname, true);
 						//if not found, try member functions
 					}
 					catch(const SymbolNotFoundException &) {
@@ -1086,6 +1227,9 @@ namespace Gorgon {
 					std::copy(params->begin()+1, params->end(), temp.begin());
 					params=&temp;
 				}
+				else if(inst->Cache.member && inst->Cache.membertype==&data.GetType()) {
+					fn=inst->Cache.member;
+				}
 				else {
 					auto fnit=data.GetType().Members.Find(functionname);
 					
@@ -1116,12 +1260,15 @@ namespace Gorgon {
 						throw SymbolNotFoundException(functionname, SymbolType::Function, 
 							functionname+" is not a non-static member function, use `Type::functionname(...)` to access static functions");
 					}
+					
+					inst->Cache.member=fn;
+					inst->Cache.membertype=&data.GetType();
 				}
 			}
 			}
 			
 			// call it
-			Data ret=callfunction(fn, method, *params);
+			Data ret=callfunction(fn, method, *params, &inst->Cache);
 
 			//if requested
 			if(inst->Store) {
@@ -1160,7 +1307,7 @@ namespace Gorgon {
 					v=v.DeReference();
 				}
 				
-				SetVariable(inst->Name.Name, v, inst->Reference);
+				setvariable(inst->Name, v, inst->Reference);
 			}
 			
 			else if(inst->Type==InstructionType::SaveToTemp) {
@@ -1242,7 +1389,7 @@ namespace Gorgon {
 					ASSERT(inst->Name.Type==ValueType::Identifier || inst->Name.Type==ValueType::Variable, 
 						   "Member to variable instruction requires a variable identifier in Name field");
 					
-					SetVariable(inst->Name.Name, member->Get(thisptr), inst->Reference);
+					setvariable(inst->Name, member->Get(thisptr), inst->Reference);
 				}
 				else {
 					temporaries[inst->Store+tempbase]=member->Get(thisptr);
@@ -41,7 +41,8 @@ namespace Gorgon {
         extern Library Reflection, Integrals, Keywords, Math;
 
 		
-		/// This class defines a virtual environment for scripts to run.
+		/// This class defines a virtual environment for scripts to run. Virtual machines running
+		/// on different threads should not execute the same scope at the same time, see Scope.
 		class VirtualMachine {
 		public:
 
@@ -107,16 +108,16 @@ namespace Gorgon {
 
 			/// Returns the current VM for this thread.
 			static VirtualMachine &Get() {
-				if(!activevms.Exists(std::this_thread::get_id())) {
+				if(!active) {
 					throw std::runtime_error("No active VMs for this thread.");
 				}
 
-				return activevms[std::this_thread::get_id()];
+				return *active;
 			}
 
 			/// Returns the current VM for this thread.
 			static bool Exists() {
-				return activevms.Exists(std::this_thread::get_id());
+				return active!=nullptr;
 			}
 
 			bool IsVariableSet(const std::string &name);
@@ -167,7 +168,7 @@ namespace Gorgon {
 			/// Activate this VM for this thread. This VM will automatically activate when Start
 			/// is issued, therefore, this is mostly used for debugging
 			void Activate() {
-				activevms.Add(std::this_thread::get_id(), this);
+				active=this;
 			}
 
 			/// Returns the number of active execution scopes. If this number is 0, VM cannot be started without
@@ -223,9 +224,13 @@ namespace Gorgon {
 
 		private:
 			void execute(const Instruction* inst);
-			Data callfunction(const Function *fn, bool method, const std::vector<Value> &params);
+			Data callfunction(const Function *fn, bool method, const std::vector<Value> &params, OverloadCache *cache=nullptr);
 			Data callvariant(const Function *fn, const Function::Overload *variant, bool method, const std::vector<Value> &params);
 			Data getvalue(const Value &val, bool reference=false);
+			bool getargument(const Value &val, OverloadCache::Argument &argument);
+			Variable *boundvariable(const Value &val, bool &local);
+			void setvariable(const Value &name, const Data &data, bool ref);
+			void assign(Variable &var, Data data, bool ref);
 			void functioncall(const Instruction *inst, bool memberonly, bool method);
 			void activatescopeinstance(std::shared_ptr<ScopeInstance> instance);
 			void addsymbol(const StaticMember &symbol);
@@ -268,9 +273,10 @@ namespace Gorgon {
 			std::shared_ptr<ScopeInstance> toplevel;
 			
 			
-			/// List of active VMs. A VM can be active on more than one thread. But it cannot
-			/// execute two different contexts.
-			static Containers::Hashmap<std::thread::id, VirtualMachine> activevms;
+			/// Active VM of the current thread. A VM can be active on more than one thread. But it
+			/// cannot execute two different contexts. Data copies check the active VM for reference
+			/// counting, therefore, it should be found without a lookup.
+			static thread_local VirtualMachine *active;
 		};
 		
 		
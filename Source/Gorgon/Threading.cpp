@@ -0,0 +1,228 @@
+#include "Threading.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Gorgon { namespace Threading {
+
+	namespace {
+		//the scheduler and the queue of the current worker thread
+		thread_local Scheduler *currentscheduler = nullptr;
+		thread_local unsigned currentworker = 0;
+
+		std::mutex mainmtx;
+		std::vector<std::function<void()>> mainqueue;
+	}
+
+	Scheduler::Scheduler(unsigned threads) {
+		if(threads == 0)
+			threads = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1;
+
+		for(unsigned i=0; i<=threads; i++)
+			queues.emplace_back(new queue);
+
+		for(unsigned i=1; i<=threads; i++)
+			workers.emplace_back([this, i] { work(i); });
+	}
+
+	Scheduler::~Scheduler() {
+		{
+			std::lock_guard<std::mutex> guard(sleepmtx);
+			stopping = true;
+		}
+		wake.notify_all();
+
+		for(auto &t : workers)
+			t.join();
+	}
+
+	bool Scheduler::RunPending() {
+		task t;
+
+		if(!pop(currentscheduler == this ? currentworker : 0, t))
+			return false;
+
+		run(t);
+
+		return true;
+	}
+
+	void Scheduler::push(task t) {
+		//workers use their own queue
+		auto &q = *queues[currentscheduler == this ? currentworker : 0];
+
+		{
+			std::lock_guard<std::mutex> guard(q.mtx);
+			q.tasks.push_back(std::move(t));
+		}
+
+		pending++;
+
+		//a worker that is about to sleep either sees pending or is woken up
+		if(sleeping > 0) {
+			{ std::lock_guard<std::mutex> guard(sleepmtx); }
+
+			wake.notify_one();
+		}
+	}
+
+	bool Scheduler::pop(unsigned id, task &t) {
+		if(pending <= 0)
+			return false;
+
+		//own queue, newest first
+		if(id != 0) {
+			auto &q = *queues[id];
+			std::lock_guard<std::mutex> guard(q.mtx);
+
+			if(!q.tasks.empty()) {
+				t = std::move(q.tasks.back());
+				q.tasks.pop_back();
+				pending--;
+
+				return true;
+			}
+		}
+
+		//shared queue and the other workers, oldest first
+		unsigned N = (unsigned)queues.size();
+
+		for(unsigned i=0; i<N; i++) {
+			unsigned victim = (id + i) % N;
+
+			if(victim == id && id != 0)
+				continue;
+
+			auto &q = *queues[victim];
+			std::lock_guard<std::mutex> guard(q.mtx);
+
+			if(!q.tasks.empty()) {
+				t = std::move(q.tasks.front());
+				q.tasks.pop_front();
+				pending--;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void Scheduler::run(task &t) {
+		//exceptions of the tasks without a group are not caught, like a thread
+		if(!t.group) {
+			t.fn();
+
+			return;
+		}
+
+		std::exception_ptr error;
+
+		try {
+			t.fn();
+		}
+		catch(...) {
+			error = std::current_exception();
+		}
+
+		//release the function before the group is notified as it might refer to the group
+		t.fn = nullptr;
+
+		t.group->finished(error);
+	}
+
+	void Scheduler::work(unsigned id) {
+		currentscheduler = this;
+		currentworker = id;
+
+		while(true) {
+			task t;
+
+			if(pop(id, t)) {
+				run(t);
+
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleepmtx);
+
+			sleeping++;
+			wake.wait(lock, [this] { return stopping || pending > 0; });
+			sleeping--;
+
+			if(stopping)
+				return;
+		}
+	}
+
+	void TaskGroup::Then(std::function<void()> fn) {
+		{
+			std::lock_guard<std::mutex> guard(mtx);
+
+			if(count > 0) {
+				continuations.push_back(std::move(fn));
+
+				return;
+			}
+		}
+
+		Run(std::move(fn));
+	}
+
+	void TaskGroup::wait() {
+		while(count > 0) {
+			if(scheduler.RunPending())
+				continue;
+
+			//tasks are running on other threads, new tasks might be scheduled meanwhile
+			std::unique_lock<std::mutex> lock(mtx);
+			done.wait_for(lock, std::chrono::microseconds(200), [this] { return count == 0; });
+		}
+
+		//ensure the last task has left finished
+		std::lock_guard<std::mutex> guard(mtx);
+	}
+
+	void TaskGroup::finished(std::exception_ptr e) {
+		std::vector<std::function<void()>> next;
+		auto &sch = scheduler;
+
+		{
+			std::lock_guard<std::mutex> guard(mtx);
+
+			if(e && !error)
+				error = e;
+
+			//continuations are part of the group, count cannot reach 0 before they are added
+			if(count == 1 && !continuations.empty()) {
+				next.swap(continuations);
+				count += (int)next.size();
+			}
+
+			if(--count == 0)
+				done.notify_all();
+		}
+
+		for(auto &fn : next)
+			sch.push({std::move(fn), this});
+	}
+
+	void RunOnMain(std::function<void()> fn) {
+		std::lock_guard<std::mutex> guard(mainmtx);
+
+		mainqueue.push_back(std::move(fn));
+	}
+
+	void ProcessMainQueue() {
+		std::vector<std::function<void()>> queue;
+
+		{
+			std::lock_guard<std::mutex> guard(mainmtx);
+			queue.swap(mainqueue);
+		}
+
+		for(auto &fn : queue)
+			fn();
+	}
+
+} }
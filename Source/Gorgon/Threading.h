@@ -2,7 +2,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -11,21 +18,180 @@ namespace Gorgon {
 	/// Contains multi-threading functions and objects.
 	/// For thread and mutex @see std::thread and std::mutex
 	namespace Threading {
-		
+
+		class TaskGroup;
+
+		/// Persistent pool of threads that run short tasks. Every worker thread has its own
+		/// queue, tasks that are scheduled from a worker are placed to its queue and run in
+		/// last in first out order to keep the data in cache. Workers without tasks steal the
+		/// oldest tasks from the other workers. Tasks scheduled from other threads are placed
+		/// to a shared queue. Threads that wait for a TaskGroup run the pending tasks while
+		/// waiting. Idle workers sleep until a task is scheduled. Tasks should not block for
+		/// long periods, use RunAsync for such work.
+		class Scheduler {
+			friend class TaskGroup;
+		public:
+			/// Creates a scheduler with the given number of worker threads. If threads is 0,
+			/// one less than the number of hardware threads is used as the thread that waits
+			/// takes part in the work. There is always at least one worker.
+			explicit Scheduler(unsigned threads = 0);
+
+			/// Stops the workers, tasks that are not started are not run.
+			~Scheduler();
+
+			Scheduler(const Scheduler &) = delete;
+
+			Scheduler &operator =(const Scheduler &) = delete;
+
+			/// Schedules the given function to be run on a worker. There is no way to wait for
+			/// it, use TaskGroup if waiting is necessary.
+			void Schedule(std::function<void()> fn) {
+				push({std::move(fn), nullptr});
+			}
+
+			/// Runs a pending task on the calling thread. Returns false if there are no tasks.
+			bool RunPending();
+
+			/// Returns the number of worker threads.
+			unsigned GetWorkerCount() const {
+				return (unsigned)workers.size();
+			}
+
+			/// Returns the scheduler that is shared by the system.
+			static Scheduler &Default() {
+				static Scheduler def;
+
+				return def;
+			}
+
+		private:
+			struct task {
+				std::function<void()> fn;
+				TaskGroup *group;
+			};
+
+			struct queue {
+				std::mutex mtx;
+				std::deque<task> tasks;
+			};
+
+			void push(task t);
+
+			/// Takes a task for the given queue, own queue is used from back, others from front
+			bool pop(unsigned id, task &t);
+
+			void run(task &t);
+
+			void work(unsigned id);
+
+			//0 is shared, the rest belongs to the workers
+			std::vector<std::unique_ptr<queue>> queues;
+			std::vector<std::thread> workers;
+
+			std::atomic<int> pending{0};
+			std::atomic<int> sleeping{0};
+
+			std::mutex sleepmtx;
+			std::condition_variable wake;
+			bool stopping = false;
+		};
+
+		/// Tracks a set of tasks that are run on a scheduler. Wait function returns when all
+		/// tasks and continuations of the group are finished. The thread that waits runs the
+		/// pending tasks of the scheduler while waiting, therefore, groups can be nested. If
+		/// a task throws, the first exception is rethrown by Wait. A group can be reused
+		/// after Wait returns. Destroying a group waits for its tasks.
+		///
+		/// *Example:*
+		/// @code
+		///     Threading::TaskGroup group;
+		///
+		///     for(auto &file : files)
+		///         group.Run([&file] { file.Load(); });
+		///
+		///     group.Then([] { Threading::RunOnMain([] { /* upload to GPU */ }); });
+		///
+		///     group.Wait();
+		/// @endcode
+		class TaskGroup {
+			friend class Scheduler;
+		public:
+			/// Creates a new group that uses the given scheduler.
+			explicit TaskGroup(Scheduler &scheduler = Scheduler::Default()) : scheduler(scheduler) {
+			}
+
+			/// Waits for the tasks, exceptions are not rethrown.
+			~TaskGroup() {
+				wait();
+			}
+
+			TaskGroup(const TaskGroup &) = delete;
+
+			TaskGroup &operator =(const TaskGroup &) = delete;
+
+			/// Runs the given function as a part of this group.
+			void Run(std::function<void()> fn) {
+				count++;
+
+				scheduler.push({std::move(fn), this});
+			}
+
+			/// Adds a continuation that will run as a part of this group after all tasks that
+			/// are currently in the group are finished. If the group is already finished, the
+			/// continuation is scheduled immediately.
+			void Then(std::function<void()> fn);
+
+			/// Waits until all tasks and continuations are finished. Rethrows the first
+			/// exception thrown by the tasks.
+			void Wait() {
+				wait();
+
+				if(error) {
+					auto e = error;
+					error = nullptr;
+
+					std::rethrow_exception(e);
+				}
+			}
+
+			/// Returns if all tasks and continuations are finished.
+			bool IsDone() const {
+				return count == 0;
+			}
+
+		private:
+			void wait();
+
+			/// Called by the scheduler after a task of this group is finished
+			void finished(std::exception_ptr e);
+
+			Scheduler &scheduler;
+
+			std::atomic<int> count{0};
+
+			std::mutex mtx;
+			std::condition_variable done;
+			std::vector<std::function<void()>> continuations;
+			std::exception_ptr error;
+		};
 
 		/// Executes a function asynchronously. This function starts the thread immediately.
-		/// There is no way to wait for the thread, stop or query its execution.
+		/// There is no way to wait for the thread, stop or query its execution. A new thread
+		/// is created for every call, therefore, this function is suitable for long running
+		/// work. Use Scheduler::Schedule or TaskGroup for short tasks.
 		/// @param fn the function to be executed.
 		inline void RunAsync(std::function<void()> fn) {
 			std::thread t(fn);
 			t.detach();
 		}
-		
+
 		/// Runs a function specified amount of times in parallel. threads parameter controls
-		/// the amount of parallel executions. This function will return when all threads it
-		/// controls finishes. The following example performs an operation over the data vector 
-		/// using 4 threads. If the threads parameter is omitted, the number of threads supported
-		/// by hardware is used.
+		/// the amount of parallel executions. This function will return when all executions
+		/// finish. The following example performs an operation over the data vector using 4
+		/// executions. If the threads parameter is omitted, the number of threads supported
+		/// by hardware is used. Executions are run on the default scheduler and the calling
+		/// thread, thus no threads are created. Executions might not run at the same time,
+		/// therefore, they should not wait for each other.
 		/// @code
 		/// std::vector<int> data(1000);
 		/// RunInParallel([&data](int threadid, int threads) {
@@ -38,18 +204,76 @@ namespace Gorgon {
 		///        thread id, second is the number of threads. See the example.
 		/// @param threads the number of threads to be executed.
 		inline void RunInParallel(std::function<void(int, int)> fn, unsigned threads=0) {
-			std::vector<std::thread> thrds;
-
 			if(threads==0) threads=std::thread::hardware_concurrency();
-			
-			for(int id=0;id<threads;id++) {
-				thrds.emplace_back(fn, id, threads);
+			if(threads==0) threads=1;
+
+			TaskGroup group;
+
+			for(int id=1;id<(int)threads;id++) {
+				group.Run([&fn, id, threads] { fn(id, threads); });
 			}
-			
-			for(int id=0;id<threads;id++) {
-				thrds[id].join();
+
+			fn(0, threads);
+
+			group.Wait();
+		}
+
+		/// Calls fn(first, last) for the ranges of [begin, end) in parallel. Ranges are
+		/// split in halves until they are not longer than grain, halves are scheduled as
+		/// tasks, which allows idle workers to steal large portions of the work. If grain
+		/// is 0, it is selected to make 8 ranges per thread. Returns when all ranges are
+		/// processed.
+		/// @code
+		/// ParallelFor(0, (int)data.size(), 1024, [&data](int first, int last) {
+		///     for(int i=first; i<last; i++)
+		///         data[i] *= 2;
+		/// });
+		/// @endcode
+		template<class F_>
+		void ParallelFor(int begin, int end, int grain, F_ fn, Scheduler &scheduler = Scheduler::Default()) {
+			if(end <= begin)
+				return;
+
+			if(grain <= 0)
+				grain = std::max(1, int((end - begin) / (8 * (scheduler.GetWorkerCount() + 1))));
+
+			if(end - begin <= grain) {
+				fn(begin, end);
+
+				return;
 			}
+
+			//split should outlive the group as the group waits for its tasks when fn throws
+			std::function<void(int, int)> split;
+
+			TaskGroup group(scheduler);
+
+			split = [&](int first, int last) {
+				while(last - first > grain) {
+					int mid = first + (last - first) / 2;
+
+					group.Run([&split, mid, last] { split(mid, last); });
+
+					last = mid;
+				}
+
+				fn(first, last);
+			};
+
+			split(begin, end);
+
+			group.Wait();
 		}
+
+		/// Queues the given function to be run on the main thread. Functions are run in the
+		/// order they are queued at the start of the next frame. Use this for the work that
+		/// should be done on the main thread such as OpenGL calls. Can be called from any
+		/// thread.
+		void RunOnMain(std::function<void()> fn);
+
+		/// Runs the functions queued by RunOnMain. Functions that are queued while running
+		/// are run in the next call. This function is called by Tick.
+		void ProcessMainQueue();
 	}
-	
-}
\ No newline at end of file
+
+}
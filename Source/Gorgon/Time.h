@@ -235,17 +235,25 @@ namespace Gorgon {
             return out;
         }
         
-		/// Returns current time in milliseconds. 
+		/// Returns current time in milliseconds. The time is monotonic and does not
+		/// change with the wall clock. Its starting point is unspecified.
 		/// @warning FrameStart should be used unless exact time is required.
 		/// This function works slower and changes during a frame, which may
 		/// cause synchronization issues.
 		unsigned long GetTime();
 		
+		/// Returns current time in microseconds from the same monotonic clock as GetTime.
+		/// GetTime is equal to this value divided by 1000.
+		unsigned long long GetPreciseTime();
+		
 		
 		///@cond INTERNAL
 		namespace internal {
 			extern unsigned long framestart;
 			extern unsigned long deltatime;
+			
+			extern unsigned long long precisestart;
+			extern unsigned long long precisedelta;
 		}
 		///@endcond
 
@@ -263,6 +271,17 @@ namespace Gorgon {
 			return internal::deltatime;
 		}
 		
+		/// Returns start time of the current frame in microseconds.
+		inline unsigned long long PreciseFrameStart() {
+			return internal::precisestart;
+		}
+		
+		/// Returns the time passed since the last frame in microseconds. Sum of the
+		/// delta times in milliseconds is equal to the sum of these values divided by 1000.
+		inline unsigned long long PreciseDeltaTime() {
+			return internal::precisedelta;
+		}
+		
 		
 	}
 }
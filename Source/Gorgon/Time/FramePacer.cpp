@@ -0,0 +1,33 @@
+#include "FramePacer.h"
+#include "../Time.h"
+
+#include <chrono>
+#include <thread>
+
+namespace Gorgon { namespace Time {
+	
+	void FramePacer::Wait() {
+		if(!duration)
+			return;
+		
+		auto now = GetPreciseTime();
+		
+		//start or restart the schedule
+		if(next == 0 || now >= next + duration) {
+			next = now + duration;
+			
+			return;
+		}
+		
+		if(now < next) {
+			if(next - now > spin)
+				std::this_thread::sleep_for(std::chrono::microseconds(next - now - spin));
+			
+			while(GetPreciseTime() < next)
+				std::this_thread::yield();
+		}
+		
+		next += duration;
+	}
+	
+} }
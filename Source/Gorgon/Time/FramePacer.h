@@ -0,0 +1,149 @@
+///@file FramePacer.h contains frame pacer
+
+#pragma once
+
+namespace Gorgon { namespace Time {
+
+	/// Paces the frames to a target rate and keeps a fixed time step accumulator for
+	/// simulations. Frame deadlines are kept on an absolute schedule, therefore, errors
+	/// do not accumulate. While waiting, the pacer sleeps until shortly before the deadline
+	/// and spins for the rest, as sleeping usually wakes up late. NextFrame uses the
+	/// default pacer, whose accumulator is filled by the delta time at every Tick.
+	/// 
+	/// *Example:*
+	/// @code
+	///     auto &pacer = Time::FramePacer::Default();
+	///     pacer.SetTargetRate(144);
+	///     pacer.SetFixedStep(10000); //100 steps per second
+	///     
+	///     while(running) {
+	///         while(pacer.Step())
+	///             simulate(pacer.GetFixedStep());
+	///         
+	///         draw(pacer.GetAlpha()); //interpolate between the last two states
+	///         
+	///         NextFrame();
+	///     }
+	/// @endcode
+	class FramePacer {
+	public:
+		/// Creates a new pacer with the given frames per second, 0 disables pacing.
+		explicit FramePacer(double rate = 62.5) {
+			SetTargetRate(rate);
+		}
+		
+		/// Changes the target frames per second, 0 disables pacing.
+		void SetTargetRate(double rate) {
+			SetFrameDuration(rate > 0 ? (unsigned long long)(1000000 / rate + 0.5) : 0);
+		}
+		
+		/// Returns the target frames per second, 0 if pacing is disabled.
+		double GetTargetRate() const {
+			return duration ? 1000000.0 / duration : 0;
+		}
+		
+		/// Changes the duration of a frame in microseconds, 0 disables pacing.
+		void SetFrameDuration(unsigned long long value) {
+			duration = value;
+			
+			Reset();
+		}
+		
+		/// Returns the duration of a frame in microseconds.
+		unsigned long long GetFrameDuration() const {
+			return duration;
+		}
+		
+		/// Sets the time in microseconds that will be spent spinning at the end of the wait.
+		/// Spinning is precise but keeps a core busy. 0 disables spinning. Default value is
+		/// 1500us.
+		void SetSpinTime(unsigned long long value) {
+			spin = value;
+		}
+		
+		/// Returns the time in microseconds that will be spent spinning at the end of the wait.
+		unsigned long long GetSpinTime() const {
+			return spin;
+		}
+		
+		/// Waits until the start of the next frame. A frame that is late by less than a frame
+		/// duration shortens the next frame. If a whole frame is missed, the schedule is
+		/// restarted from now. The first call starts the schedule and does not wait.
+		void Wait();
+		
+		/// Restarts the schedule, the next call to Wait will not wait.
+		void Reset() {
+			next = 0;
+		}
+		
+		/// Sets the fixed time step in microseconds, 0 disables the accumulator.
+		void SetFixedStep(unsigned long long value) {
+			step = value;
+			accumulator = 0;
+		}
+		
+		/// Returns the fixed time step in microseconds.
+		unsigned long long GetFixedStep() const {
+			return step;
+		}
+		
+		/// Sets the maximum number of steps that can be accumulated. Time that exceeds this
+		/// limit is dropped, this prevents the simulation falling behind more after every
+		/// slow frame. 0 removes the limit. Default value is 8.
+		void SetMaximumSteps(unsigned value) {
+			maxsteps = value;
+		}
+		
+		/// Returns the maximum number of steps that can be accumulated.
+		unsigned GetMaximumSteps() const {
+			return maxsteps;
+		}
+		
+		/// Adds the given time in microseconds to the accumulator.
+		void Accumulate(unsigned long long delta) {
+			if(!step)
+				return;
+			
+			accumulator += delta;
+			
+			if(maxsteps && accumulator > step * maxsteps)
+				accumulator = step * maxsteps;
+		}
+		
+		/// Consumes a fixed step from the accumulator. Returns false if there is not
+		/// enough time for a step.
+		bool Step() {
+			if(!step || accumulator < step)
+				return false;
+			
+			accumulator -= step;
+			
+			return true;
+		}
+		
+		/// Returns the fraction of a step left in the accumulator. This value should be used
+		/// to interpolate between the last two states of the simulation.
+		double GetAlpha() const {
+			return step ? double(accumulator) / step : 0;
+		}
+		
+		/// Returns the pacer used by NextFrame.
+		static FramePacer &Default() {
+			static FramePacer def;
+			
+			return def;
+		}
+		
+	private:
+		unsigned long long duration = 0;
+		unsigned long long spin = 1500;
+		
+		//deadline of the next frame, 0 if not started
+		unsigned long long next = 0;
+		
+		unsigned long long step = 0;
+		unsigned long long accumulator = 0;
+		unsigned maxsteps = 8;
+	};
+	
+} }
@@ -32,9 +32,13 @@ namespace Gorgon { namespace Time {
 	}
 		
 	unsigned long GetTime() { 
-		timeval tv;
-		gettimeofday(&tv, 0 );
-		return tv.tv_usec/1000+tv.tv_sec*1000;
+		return (unsigned long)(GetPreciseTime()/1000);
+	}
+	
+	unsigned long long GetPreciseTime() {
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (unsigned long long)ts.tv_sec*1000000 + ts.tv_nsec/1000;
 	}
 
 		
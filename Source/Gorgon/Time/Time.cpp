@@ -13,7 +13,9 @@
 namespace Gorgon { namespace Time {
 	
 	void Initialize() {
-		internal::framestart=GetTime();
+		internal::precisestart=GetPreciseTime();
+		internal::precisedelta=0;
+		internal::framestart=(unsigned long)(internal::precisestart/1000);
 		internal::deltatime =0;
 	}
 	
@@ -417,6 +419,9 @@ namespace Gorgon { namespace Time {
 	namespace internal {
 		unsigned long framestart=0;
 		unsigned long deltatime=0;
+		
+		unsigned long long precisestart=0;
+		unsigned long long precisedelta=0;
 	}
 	
 	void Timer::ShowDialog(const std::string &name, const std::string &title) const { 
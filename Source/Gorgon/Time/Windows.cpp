@@ -4,7 +4,22 @@
 namespace Gorgon { namespace Time {
 
 	unsigned long GetTime() {
-		return timeGetTime();
+		return (unsigned long)(GetPreciseTime()/1000);
+	}
+	
+	unsigned long long GetPreciseTime() {
+		static LARGE_INTEGER frequency = [] {
+			LARGE_INTEGER f;
+			QueryPerformanceFrequency(&f);
+			return f;
+		}();
+		
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		
+		//split to avoid overflow
+		return (unsigned long long)(counter.QuadPart / frequency.QuadPart) * 1000000 + 
+		       (unsigned long long)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
 	}
 
 	Date GetDate() {
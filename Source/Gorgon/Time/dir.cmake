@@ -1,5 +1,7 @@
 SET(Local
 	../Time.h
+	FramePacer.h
+	FramePacer.cpp
 	Time.cpp
 	Timer.h
 )
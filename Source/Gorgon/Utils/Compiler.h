@@ -9,6 +9,30 @@
 #	define WEAKINIT __attribute__((weak))
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#	define GORGON_X86
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define GORGON_SSE2
+#endif
+
+/// Marks a function that uses AVX2 and FMA instructions. Such functions should only be called
+/// if Utils::SupportsAVX2 returns true.
+#ifdef _MSC_VER
+#	define TARGET_AVX2
+#else
+#	define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+/// Marks a function that uses SSSE3 instructions. Such functions should only be called if
+/// Utils::SupportsSSSE3 returns true.
+#ifdef _MSC_VER
+#	define TARGET_SSSE3
+#else
+#	define TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+
 namespace Gorgon { namespace Utils {
 		
 		/// @cond INTERNAL
@@ -29,5 +53,14 @@ namespace Gorgon { namespace Utils {
 		inline std::string GetTypeName(const std::type_info &inf) {
 			return demangle(inf.name());
 		}
+		
+		/// Returns whether the processor and the operating system support AVX2 and FMA 
+		/// instructions. Functions marked with TARGET_AVX2 can be used if this function 
+		/// returns true.
+		bool SupportsAVX2();
+		
+		/// Returns whether the processor supports SSSE3 instructions. Functions marked with
+		/// TARGET_SSSE3 can be used if this function returns true.
+		bool SupportsSSSE3();
 	
 } }
\ No newline at end of file
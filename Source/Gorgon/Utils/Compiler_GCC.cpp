@@ -21,4 +21,32 @@ namespace Gorgon { namespace Utils {
 		}
 	}
 	
-} }
+	bool SupportsAVX2() {
+#ifdef GORGON_X86
+		static bool supported = [] {
+			__builtin_cpu_init();
+			
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+		}();
+		
+		return supported;
+#else
+		return false;
+#endif
+	}
+	
+	bool SupportsSSSE3() {
+#ifdef GORGON_X86
+		static bool supported = [] {
+			__builtin_cpu_init();
+			
+			return __builtin_cpu_supports("ssse3");
+		}();
+		
+		return supported;
+#else
+		return false;
+#endif
+	}
+	
+} }
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include <string>
+#include <intrin.h>
+
+#include "Compiler.h"
 
 namespace Gorgon { namespace Utils {
 		
@@ -6,4 +9,49 @@ namespace Gorgon { namespace Utils {
 			return name;
 		}
 
+		bool SupportsAVX2() {
+#ifdef GORGON_X86
+			static bool supported = [] {
+				int info[4];
+				
+				__cpuid(info, 0);
+				if(info[0] < 7)
+					return false;
+				
+				//OSXSAVE, AVX and FMA
+				__cpuid(info, 1);
+				if((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (info[2] & (1 << 12)) == 0)
+					return false;
+				
+				//operating system should save YMM registers
+				if((_xgetbv(0) & 6) != 6)
+					return false;
+				
+				__cpuidex(info, 7, 0);
+				
+				return (info[1] & (1 << 5)) != 0;
+			}();
+			
+			return supported;
+#else
+			return false;
+#endif
+		}
+
+		bool SupportsSSSE3() {
+#ifdef GORGON_X86
+			static bool supported = [] {
+				int info[4];
+				
+				__cpuid(info, 1);
+				
+				return (info[2] & (1 << 9)) != 0;
+			}();
+			
+			return supported;
+#else
+			return false;
+#endif
+		}
+
 } }
\ No newline at end of file
@@ -0,0 +1,329 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+namespace Gorgon { namespace Utils {
+
+	TimerWheel::TimerWheel(unsigned long now) : current(now), target(now) {
+		std::fill(heads, heads + SlotCount, -1);
+		std::fill(tails, tails + SlotCount, -1);
+	}
+
+	size_t TimerWheel::Add(unsigned long due, std::function<void()> fn, unsigned long period) {
+		int ind;
+
+		if(spare.empty()) {
+			ind = (int)timers.size();
+			timers.emplace_back();
+		}
+		else {
+			ind = spare.back();
+			spare.pop_back();
+		}
+
+		auto &t = timers[ind];
+
+		t.id          = nextid++;
+		t.due         = due;
+		t.period      = period;
+		t.fn          = std::move(fn);
+		t.status      = waiting;
+		t.rescheduled = false;
+
+		ids[t.id] = ind;
+
+		insert(ind, current + 1);
+
+		return t.id;
+	}
+
+	bool TimerWheel::Reschedule(size_t id, unsigned long due) {
+		int ind = find(id);
+
+		if(ind == -1)
+			return false;
+
+		auto &t = timers[ind];
+
+		t.due = due;
+
+		//running timers are placed after they return
+		if(t.status == running) {
+			t.rescheduled = true;
+		}
+		else {
+			unlink(ind);
+			insert(ind, current + 1);
+		}
+
+		return true;
+	}
+
+	bool TimerWheel::SetPeriod(size_t id, unsigned long period) {
+		int ind = find(id);
+
+		if(ind == -1)
+			return false;
+
+		timers[ind].period = period;
+
+		return true;
+	}
+
+	bool TimerWheel::Cancel(size_t id) {
+		int ind = find(id);
+
+		if(ind == -1)
+			return false;
+
+		auto &t = timers[ind];
+
+		//running timers are released after they return
+		if(t.status == running) {
+			t.status = cancelled;
+			ids.erase(id);
+		}
+		else {
+			unlink(ind);
+			release(ind);
+		}
+
+		return true;
+	}
+
+	bool TimerWheel::IsPeriodic(size_t id) const {
+		int ind = find(id);
+
+		return ind != -1 && timers[ind].period != 0;
+	}
+
+	void TimerWheel::Advance(unsigned long now) {
+		target = std::max(now, current);
+
+		//move overdue timers to another slot so that the timers that become overdue while
+		//running are called in the next Advance
+		while(heads[Overdue] != -1) {
+			int ind = heads[Overdue];
+
+			unlink(ind);
+
+			timers[ind].slot = Firing;
+			timers[ind].prev = tails[Firing];
+			timers[ind].next = -1;
+
+			if(tails[Firing] != -1)
+				timers[tails[Firing]].next = ind;
+			else
+				heads[Firing] = ind;
+
+			tails[Firing] = ind;
+		}
+
+		fire(Firing);
+
+		while(current < now) {
+			//nothing to do until now
+			if(ids.empty()) {
+				current = now;
+				break;
+			}
+
+			//no timers in the first level, skip to its end
+			if(firstlevel == 0) {
+				unsigned long end = current | (FirstSlots - 1);
+
+				if(end >= now) {
+					current = now;
+					break;
+				}
+
+				current = end;
+			}
+
+			current++;
+
+			//when the first level wraps, the next slot of the upper levels are moved down. Upper
+			//levels should be moved first as their timers might end up in the lower levels.
+			if((current & (FirstSlots - 1)) == 0) {
+				int level = 1;
+
+				while(level < Levels - 1 && ((current >> (FirstBits + (level - 1) * LevelBits)) & (LevelSlots - 1)) == 0)
+					level++;
+
+				for(; level >= 1; level--)
+					cascade(FirstSlots + (level - 1) * LevelSlots + ((current >> (FirstBits + (level - 1) * LevelBits)) & (LevelSlots - 1)));
+			}
+
+			fire(current & (FirstSlots - 1));
+		}
+	}
+
+	void TimerWheel::Clear() {
+		std::fill(heads, heads + SlotCount, -1);
+		std::fill(tails, tails + SlotCount, -1);
+
+		spare.clear();
+		firstlevel = 0;
+
+		for(int i=0; i<(int)timers.size(); i++) {
+			auto &t = timers[i];
+
+			if(t.status == running) {
+				t.status = cancelled;
+			}
+			else {
+				t.status = idle;
+				t.slot   = -1;
+				t.fn     = nullptr;
+
+				spare.push_back(i);
+			}
+		}
+
+		ids.clear();
+	}
+
+	void TimerWheel::insert(int ind, unsigned long overdue) {
+		auto &t = timers[ind];
+
+		int slot;
+
+		if(t.due < overdue) {
+			slot = Overdue;
+		}
+		else {
+			unsigned long due   = t.due;
+			unsigned long delta = due - current;
+
+			if(delta < FirstSlots) {
+				slot = due & (FirstSlots - 1);
+			}
+			else {
+				//timers that are out of range are placed to the furthest slot, they will be
+				//placed again when that slot is reached.
+				if(delta >= (1ul << (FirstBits + (Levels - 1) * LevelBits)))
+					due = current + (1ul << (FirstBits + (Levels - 1) * LevelBits)) - 1;
+
+				int level = 1;
+
+				while(due - current >= (1ul << (FirstBits + level * LevelBits)))
+					level++;
+
+				slot = FirstSlots + (level - 1) * LevelSlots + ((due >> (FirstBits + (level - 1) * LevelBits)) & (LevelSlots - 1));
+			}
+		}
+
+		if(slot < FirstSlots)
+			firstlevel++;
+
+		t.slot = slot;
+		t.prev = tails[slot];
+		t.next = -1;
+
+		if(tails[slot] != -1)
+			timers[tails[slot]].next = ind;
+		else
+			heads[slot] = ind;
+
+		tails[slot] = ind;
+	}
+
+	void TimerWheel::unlink(int ind) {
+		auto &t = timers[ind];
+
+		if(t.slot == -1)
+			return;
+
+		if(t.prev != -1)
+			timers[t.prev].next = t.next;
+		else
+			heads[t.slot] = t.next;
+
+		if(t.next != -1)
+			timers[t.next].prev = t.prev;
+		else
+			tails[t.slot] = t.prev;
+
+		if(t.slot < FirstSlots)
+			firstlevel--;
+
+		t.slot = -1;
+		t.prev = -1;
+		t.next = -1;
+	}
+
+	void TimerWheel::cascade(int slot) {
+		int ind = heads[slot];
+
+		heads[slot] = -1;
+		tails[slot] = -1;
+
+		while(ind != -1) {
+			int next = timers[ind].next;
+
+			//timers that are due now are placed into the current slot of the first level
+			insert(ind, current);
+
+			ind = next;
+		}
+	}
+
+	void TimerWheel::fire(int slot) {
+		//timers that are added while running cannot be placed into this slot
+		while(heads[slot] != -1) {
+			int ind = heads[slot];
+			auto &t = timers[ind];
+
+			unlink(ind);
+
+			t.status      = running;
+			t.rescheduled = false;
+
+			t.fn();
+
+			if(t.status == cancelled) {
+				release(ind);
+			}
+			else if(t.rescheduled) {
+				t.status = waiting;
+				insert(ind, current + 1);
+			}
+			else if(t.period) {
+				t.status = waiting;
+				t.due   += t.period;
+
+				//skip the periods that are missed or would be called again in this advance
+				if(t.due <= target)
+					t.due += ((target - t.due) / t.period + 1) * t.period;
+
+				insert(ind, current + 1);
+			}
+			else {
+				release(ind);
+			}
+		}
+	}
+
+	void TimerWheel::release(int ind) {
+		auto &t = timers[ind];
+
+		//cancelled timers are already removed
+		if(t.status != cancelled)
+			ids.erase(t.id);
+
+		t.status = idle;
+		t.fn     = nullptr;
+
+		spare.push_back(ind);
+	}
+
+	int TimerWheel::find(size_t id) const {
+		auto it = ids.find(id);
+
+		if(it == ids.end())
+			return -1;
+
+		return it->second;
+	}
+
+} }
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Gorgon { namespace Utils {
+
+	/**
+	 * Hierarchical timer wheel that schedules functions at absolute times in milliseconds.
+	 * The wheel has its own monotonic time that is moved forward using Advance function.
+	 * The first level has 256 slots of 1ms, the following three levels have 64 slots that
+	 * are 64 times wider than the slots of the previous level. Timers are placed into the
+	 * level that covers their due time and moved to the lower levels as the time passes.
+	 * Adding, cancelling and rescheduling a timer are O(1). Advancing only touches the timers
+	 * that are due and the timers that are moved down, which happens at most 3 times for each
+	 * timer. While the first level is empty, time skips to the end of it. Timers that are
+	 * further than the range of the wheel (about 18 hours) are kept in the last level until
+	 * they are in range.
+	 *
+	 * Timers are allowed to add, cancel or reschedule timers, including themselves, while
+	 * they are running. This class is not thread safe.
+	 */
+	class TimerWheel {
+	public:
+		/// Creates an empty wheel that starts at the given time.
+		explicit TimerWheel(unsigned long now = 0);
+
+		TimerWheel(const TimerWheel &) = delete;
+
+		TimerWheel &operator =(const TimerWheel &) = delete;
+
+		/// Adds a function to be called when the time reaches due. If due is not in the future,
+		/// the function is called in the next Advance. If period is not 0, the timer is
+		/// repeated after the given amount of milliseconds. Returns the id of the timer, ids
+		/// are not reused.
+		size_t Add(unsigned long due, std::function<void()> fn, unsigned long period = 0);
+
+		/// Changes the time the timer will be fired. Returns false if the timer does not exist.
+		bool Reschedule(size_t id, unsigned long due);
+
+		/// Changes the period of a repeating timer. The change will be effective after the
+		/// timer fires next time. Setting period to 0 stops repetition. Returns false if the
+		/// timer does not exist.
+		bool SetPeriod(size_t id, unsigned long period);
+
+		/// Removes the given timer. Returns false if the timer does not exist.
+		bool Cancel(size_t id);
+
+		/// Returns whether the given timer exists
+		bool Exists(size_t id) const {
+			return ids.count(id) != 0;
+		}
+
+		/// Returns whether the given timer exists and repeats
+		bool IsPeriodic(size_t id) const;
+
+		/// Moves the time of the wheel to now and calls the timers that are due in the order
+		/// of their due time. Timers that are due at the same time are called in the order they
+		/// are added or rescheduled. A repeating timer is called at most once in a single call
+		/// to this function, the periods that are missed are skipped.
+		void Advance(unsigned long now);
+
+		/// Removes all timers
+		void Clear();
+
+		/// Returns the current time of the wheel
+		unsigned long GetTime() const {
+			return current;
+		}
+
+		/// Returns the number of timers
+		size_t GetSize() const {
+			return ids.size();
+		}
+
+		/// Returns if there are no timers
+		bool IsEmpty() const {
+			return ids.empty();
+		}
+
+	private:
+		enum {
+			FirstBits  = 8,
+			LevelBits  = 6,
+			Levels     = 4,
+			FirstSlots = 1 << FirstBits,
+			LevelSlots = 1 << LevelBits,
+
+			//timers that are due before the current time are kept in this slot
+			Overdue    = FirstSlots + (Levels - 1) * LevelSlots,
+
+			//overdue timers are moved here before they are called
+			Firing,
+
+			SlotCount
+		};
+
+		enum state {
+			idle,
+			waiting,
+			running,
+			cancelled
+		};
+
+		struct timer {
+			size_t id;
+			unsigned long due;
+			unsigned long period;
+			std::function<void()> fn;
+
+			//the slot the timer is in, and its neighbours in the slot list
+			int slot = -1;
+			int prev = -1;
+			int next = -1;
+
+			state status = idle;
+			bool rescheduled = false;
+		};
+
+		/// Places the timer into its slot. Timers that are due before the given time are placed
+		/// into the overdue slot.
+		void insert(int ind, unsigned long overdue);
+
+		/// Removes the timer from its slot
+		void unlink(int ind);
+
+		/// Moves the timers in the given slot to the lower levels
+		void cascade(int slot);
+
+		/// Calls the timers in the given slot
+		void fire(int slot);
+
+		/// Releases the given timer
+		void release(int ind);
+
+		/// Returns the index of the given timer, -1 if it does not exist
+		int find(size_t id) const;
+
+		//deque keeps the timers in place while a timer function adds new timers
+		std::deque<timer> timers;
+		std::vector<int> spare;
+
+		//first and last timer of each slot
+		int heads[SlotCount];
+		int tails[SlotCount];
+
+		std::unordered_map<size_t, int> ids;
+
+		//number of timers in the first level
+		int firstlevel = 0;
+
+		unsigned long current;
+
+		//the time Advance is moving to
+		unsigned long target;
+
+		size_t nextid = 0;
+	};
+
+} }
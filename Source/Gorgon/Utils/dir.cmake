@@ -4,6 +4,8 @@ SET(Local
 	Logging.h
 	RefCounter.h
 	ScopeGuard.h
+	TimerWheel.h
+	TimerWheel.cpp
 )
 
 
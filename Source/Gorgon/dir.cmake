@@ -49,6 +49,7 @@ SET(Local
 	Struct.h
 	
 	Threading.h
+	Threading.cpp
 	
 	TMP.h
 	
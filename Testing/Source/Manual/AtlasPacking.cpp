@@ -0,0 +1,124 @@
+//Compares packing efficiency and speed of AtlasPacker against Bitmap::CreateLinearAtlas.
+//Does not require a window or a GL context.
+
+#include <Gorgon/Graphics/Bitmap.h>
+#include <Gorgon/Graphics/Atlas.h>
+#include <Gorgon/Containers/Collection.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace Graphics = Gorgon::Graphics;
+namespace Geometry = Gorgon::Geometry;
+
+struct result {
+    double ms;
+    float efficiency;
+};
+
+result linear(const std::vector<Geometry::Size> &sizes) {
+    std::vector<Graphics::Bitmap> storage;
+    Gorgon::Containers::Collection<const Graphics::Bitmap> bitmaps;
+
+    storage.reserve(sizes.size());
+    for(auto &s : sizes) {
+        storage.emplace_back(s, Graphics::ColorMode::Alpha);
+        bitmaps.Push(storage.back());
+    }
+
+    Graphics::Bitmap atlas;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    //also copies the pixels to the atlas
+    atlas.CreateLinearAtlas(std::move(bitmaps));
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    long used = 0;
+    for(auto &s : sizes) used += s.Area();
+
+    return {
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0,
+        float(used) / atlas.GetSize().Area()
+    };
+}
+
+result maxrects(const std::vector<Geometry::Size> &sizes, bool sorted) {
+    auto list = sizes;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if(sorted) {
+        std::sort(list.begin(), list.end(), [](const Geometry::Size &l, const Geometry::Size &r) {
+            return l.Area() > r.Area();
+        });
+    }
+
+    //start from the smallest square that could fit all images, grow until everything fits
+    long area = 0;
+    for(auto &s : list) area += s.Area();
+
+    int side = (int)std::ceil(std::sqrt(float(area)));
+    
+    while(true) {
+        Graphics::AtlasPacker packer({side, side});
+        Geometry::Bounds location;
+
+        bool failed = false;
+        for(auto &s : list) {
+            if(!packer.Place(s, location)) {
+                failed = true;
+                break;
+            }
+        }
+
+        if(!failed) {
+            auto end = std::chrono::high_resolution_clock::now();
+
+            return {
+                std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0,
+                float(area) / packer.GetExtent().Area()
+            };
+        }
+
+        side += side / 16 + 1;
+    }
+}
+
+int main() {
+    std::mt19937 random(42);
+
+    struct scenario {
+        std::string name;
+        int count;
+        std::uniform_int_distribution<int> width, height;
+    };
+
+    std::vector<scenario> scenarios = {
+        {"glyphs",  500,  std::uniform_int_distribution<int>(4, 16),  std::uniform_int_distribution<int>(12, 16)},
+        {"icons",   300,  std::uniform_int_distribution<int>(16, 48), std::uniform_int_distribution<int>(16, 48)},
+        {"skins",   200,  std::uniform_int_distribution<int>(4, 128), std::uniform_int_distribution<int>(4, 64)},
+        {"mixed",   2000, std::uniform_int_distribution<int>(2, 64),  std::uniform_int_distribution<int>(2, 64)},
+    };
+
+    std::cout << "scenario\tmethod\t\ttime (ms)\tefficiency" << std::endl;
+
+    for(auto &s : scenarios) {
+        std::vector<Geometry::Size> sizes;
+        for(int i=0; i<s.count; i++) {
+            sizes.push_back({s.width(random), s.height(random)});
+        }
+
+        auto l  = linear(sizes);
+        auto m  = maxrects(sizes, false);
+        auto ms = maxrects(sizes, true);
+
+        std::cout << s.name << "\tlinear\t\t" << l.ms << "\t\t" << l.efficiency * 100 << "%" << std::endl;
+        std::cout << s.name << "\tmaxrects\t" << m.ms << "\t\t" << m.efficiency * 100 << "%" << std::endl;
+        std::cout << s.name << "\tmaxrects sort\t" << ms.ms << "\t\t" << ms.efficiency * 100 << "%" << std::endl;
+    }
+
+    return 0;
+}
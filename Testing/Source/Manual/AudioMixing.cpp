@@ -0,0 +1,225 @@
+//Mixes many voices with the offline renderer and reports how many voices a single core can
+//mix in real time. Results are compared against a per sample mix. Does not require a window
+//or an audio device.
+
+#include <Gorgon/Audio.h>
+#include <Gorgon/Audio/Offline.h>
+#include <Gorgon/Audio/Controllers.h>
+#include <Gorgon/Containers/Wave.h>
+#include <Gorgon/Multimedia/Wave.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace Audio = Gorgon::Audio;
+namespace Containers = Gorgon::Containers;
+namespace Multimedia = Gorgon::Multimedia;
+
+using Audio::Channel;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+const Audio::Device device("null", "Null device", 48000, Audio::Format::Float, false, {Channel::FrontLeft, Channel::FrontRight});
+
+std::unique_ptr<Multimedia::Wave> generate(int rate, std::vector<Channel> channels, float seconds, int seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+
+    auto wave = new Containers::Wave(int(rate * seconds), rate, channels);
+
+    //noise over a tone so that interpolation errors are visible
+    for(unsigned long i=0; i<wave->GetSize(); i++)
+        for(unsigned c=0; c<channels.size(); c++)
+            (*wave)(i, c) = 0.5f * std::sin(i * 0.05f * (c + 1)) + 0.1f * dist(random);
+
+    return std::unique_ptr<Multimedia::Wave>(new Multimedia::Wave(*wave, true));
+}
+
+//Mixes a non-positional wave one sample at a time, as the audio loop did before the mixer
+void reference(const Multimedia::Wave &wave, double position, float volume, bool looping, std::vector<float> &out, int samples) {
+    const auto &data = wave.GetData();
+    double step = (double)data.GetSampleRate() / device.GetSampleRate();
+    double pos  = position * data.GetSampleRate();
+    unsigned long total = data.GetSize();
+
+    for(int s=0; s<samples; s++) {
+        if((unsigned long)pos >= total) {
+            if(!looping)
+                return;
+
+            pos -= total;
+        }
+
+        unsigned long x1 = (unsigned long)pos, x2 = x1 + 1;
+        double f = pos - x1;
+
+        for(unsigned ch=0; ch<data.GetChannelCount(); ch++) {
+            double a = data.Get(x1, ch);
+            double b = x2 < total ? data.Get(x2, ch) : (looping ? data.Get(0, ch) : 0);
+            double v = volume * ((1 - f) * a + f * b);
+
+            if(data.GetChannelType(ch) == Channel::Mono) {
+                out[s*2]     += float(v);
+                out[s*2 + 1] += float(v);
+            }
+            else {
+                out[s*2 + (data.GetChannelType(ch) == Channel::FrontRight)] += float(v);
+            }
+        }
+
+        pos += step;
+    }
+}
+
+int main() {
+    const int buffer = 512;
+
+    std::vector<std::unique_ptr<Multimedia::Wave>> waves;
+    waves.push_back(generate(44100, {Channel::Mono}, 1.3f, 1));
+    waves.push_back(generate(48000, {Channel::FrontLeft, Channel::FrontRight}, 0.7f, 2));
+    waves.push_back(generate(22050, {Channel::Mono}, 0.2f, 3));
+    waves.push_back(generate(48000, {Channel::Mono}, 2.1f, 4));
+
+    const char *names[] = {"mono 44.1k", "stereo 48k", "mono 22k", "mono 48k"};
+
+    //correctness, a single voice at a time, long enough to loop or finish a few times
+    std::cout << "Maximum difference from per sample mixing:" << std::endl;
+
+    for(int w=0; w<(int)waves.size(); w++) {
+        for(bool looping : {false, true}) {
+            Audio::BasicController controller(*waves[w]);
+            controller.SetVolume(0.7f);
+            controller.Seek(0.13f);
+
+            if(looping)
+                controller.Loop();
+            else
+                controller.Play();
+
+            const int samples = buffer * 300;
+            std::vector<float> expected(samples * 2);
+
+            reference(*waves[w], 0.13f, 0.7f, looping, expected, samples);
+
+            Audio::OfflineRenderer renderer(device, buffer);
+            Containers::Wave actual;
+            renderer.Render(actual, samples);
+
+            float diff = 0;
+            for(int i=0; i<samples*2; i++)
+                diff = std::max(diff, std::abs(expected[i] - actual.RawData()[i]));
+
+            std::cout << "  " << names[w] << (looping ? " looping: " : ": ") << diff << std::endl;
+        }
+    }
+
+    //throughput with many voices
+    std::cout << std::endl << "Voices per core at 48k stereo, " << buffer << " sample buffers:" << std::endl;
+
+    {
+        std::vector<float> out(buffer * 2);
+
+        const int buffers = 200;
+        auto start = Clock::now();
+        for(int i=0; i<buffers; i++)
+            for(int v=0; v<256; v++)
+                reference(*waves[v % waves.size()], 0.001 * (i % 100), 1.f, true, out, buffer);
+        double elapsed = ms(start);
+
+        double audio = 1000.0 * buffers * buffer / device.GetSampleRate();
+
+        std::cout << "  256 basic voices, per sample: " << elapsed / buffers << " ms per buffer, "
+                  << int(256 * audio / elapsed) << " voices per core" << std::endl;
+    }
+
+    for(bool positional : {false, true}) {
+        for(int count : {64, 256, 1024}) {
+            std::vector<std::unique_ptr<Audio::BasicController>> controllers;
+
+            for(int i=0; i<count; i++) {
+                auto &wave = *waves[i % waves.size()];
+
+                if(positional) {
+                    auto c = new Audio::PositionalController(wave);
+                    c->Move(Gorgon::Geometry::Point3D{float(i % 17) - 8, float(i % 11) - 5, 0});
+                    controllers.emplace_back(c);
+                }
+                else {
+                    controllers.emplace_back(new Audio::BasicController(wave));
+                }
+
+                controllers.back()->Loop();
+                controllers.back()->SetVolume(1.f / count);
+            }
+
+            Audio::OfflineRenderer renderer(device, buffer);
+
+            const int buffers = 2000;
+            auto start = Clock::now();
+            renderer.Advance(buffers * buffer);
+            double elapsed = ms(start);
+
+            double audio = 1000.0 * buffers * buffer / device.GetSampleRate();
+
+            std::cout << "  " << count << (positional ? " positional" : " basic") << " voices: "
+                      << elapsed / buffers << " ms per buffer, "
+                      << int(count * audio / elapsed) << " voices per core" << std::endl;
+        }
+    }
+
+    //controllers are added and removed by another thread while mixing, mixer should never wait
+    std::vector<std::unique_ptr<Audio::BasicController>> controllers;
+    for(int i=0; i<256; i++) {
+        controllers.emplace_back(new Audio::BasicController(*waves[i % waves.size()]));
+        controllers.back()->Loop();
+    }
+
+    std::cout << std::endl << "256 voices while controllers change:" << std::endl;
+
+    std::atomic<bool> done{false};
+    std::thread changer([&] {
+        std::mt19937 random(5);
+        int changes = 0;
+
+        while(!done) {
+            Audio::BasicController controller(*waves[random() % waves.size()]);
+            controller.Play();
+
+            controllers[random() % controllers.size()]->SetData(*waves[random() % waves.size()]);
+            changes++;
+        }
+
+        std::cout << "  " << changes << " controller changes" << std::endl;
+    });
+
+    Audio::OfflineRenderer renderer(device, buffer);
+
+    double worst = 0, total = 0;
+    const int buffers = 2000;
+
+    for(int i=0; i<buffers; i++) {
+        auto start = Clock::now();
+        renderer.Advance(buffer);
+        double elapsed = ms(start);
+
+        worst  = std::max(worst, elapsed);
+        total += elapsed;
+    }
+
+    done = true;
+    changer.join();
+    std::cout << "  average " << total / buffers << " ms, worst " << worst << " ms per buffer" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+//Draws thousands of small surfaces and reports batch and draw call counts
+//with batching enabled and disabled. Can be run on Mesa llvmpipe.
+
+#include <Gorgon/Window.h>
+#include <Gorgon/Main.h>
+#include <Gorgon/Graphics.h>
+#include <Gorgon/Graphics/Layer.h>
+#include <Gorgon/Graphics/Bitmap.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace Graphics = Gorgon::Graphics;
+
+int main() {
+    Gorgon::Initialize("Batching-test");
+
+    Gorgon::Window wind({800, 600}, "batchingtest", true);
+    Graphics::Initialize();
+
+    wind.ClosingEvent.Register([] { exit(0); });
+
+    Graphics::Layer l;
+    wind.Add(l);
+
+    Graphics::Bitmap icon({8, 8}, Graphics::ColorMode::RGBA);
+    icon.ForAllPixels([&](int x, int y) {
+        icon.SetRGBAAt(x, y, Graphics::RGBA(Graphics::Color::White, (x+y)%2 ? 1.f : 0.5f));
+    });
+    icon.Prepare();
+
+    Graphics::Bitmap glyph({6, 10}, Graphics::ColorMode::Alpha);
+    glyph.ForAllPixels([&](int x, int y) {
+        glyph(x, y, 0) = x == 0 || y == 0 ? 255 : 0;
+    });
+    glyph.Prepare();
+
+    auto fill = [&] {
+        l.Clear();
+        
+        //runs of the same texture, as in text followed by icons
+        for(int y=0; y<60; y++) {
+            for(int x=0; x<80; x++) {
+                if(x < 60)
+                    glyph.Draw(l, x*10, y*10, Graphics::RGBAf(0.8f, 1.f, 1.f));
+                else if(x < 70)
+                    icon.Draw(l, x*10, y*10);
+                else
+                    l.Draw(x*10.f, y*10.f, 8.f, 8.f, Graphics::RGBAf(0.2f, 0.4f, 0.8f));
+            }
+        }
+    };
+
+    fill();
+
+    for(bool batching : {false, true}) {
+        Graphics::SetBatching(batching);
+
+        //warm up, shaders are compiled on first use
+        Gorgon::NextFrame();
+
+        Graphics::ResetRenderStatistics();
+
+        const int frames = 100;
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for(int i=0; i<frames; i++) {
+            Gorgon::NextFrame();
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+        auto stats = Graphics::GetRenderStatistics();
+
+        std::cout << (batching ? "Batched:   " : "Unbatched: ")
+                  << stats.Surfaces / frames << " surfaces, "
+                  << stats.Batches / frames << " batches, "
+                  << stats.DrawCalls / frames << " draw calls, "
+                  << elapsed / frames / 1000.0 << " ms per frame" << std::endl;
+    }
+
+    while(true) {
+        Gorgon::NextFrame();
+    }
+
+    return 0;
+}
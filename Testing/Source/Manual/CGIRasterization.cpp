@@ -0,0 +1,271 @@
+//Compares the speed and quality of the subdivision and analytic coverage rasterizers of
+//Polyfill on circles, bezier strokes and large polygons. Quality is measured against a slow
+//reference that finds the exact horizontal coverage of 64 sample rows per pixel. Does not
+//require a window.
+
+#include <Gorgon/CGI/Polygon.h>
+#include <Gorgon/CGI/Line.h>
+#include <Gorgon/CGI/Bezier.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace CGI = Gorgon::CGI;
+namespace Geometry = Gorgon::Geometry;
+namespace Containers = Gorgon::Containers;
+namespace Graphics = Gorgon::Graphics;
+
+using Geometry::Pointf;
+using Geometry::PointList;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+const int width = 1024, height = 768;
+
+PointList<> circle(Pointf center, float radius) {
+    PointList<> points;
+
+    int n = std::max(16, int(radius * 2));
+    for(int i=0; i<n; i++) {
+        float ang = i * 2 * Gorgon::PI / n;
+        points.Push(center + Pointf(radius * std::cos(ang), radius * std::sin(ang)));
+    }
+
+    return points;
+}
+
+struct Scene {
+    std::string name;
+
+    std::vector<PointList<>> circles;
+
+    std::vector<PointList<>> strokes;
+
+    std::vector<PointList<>> polygons;
+};
+
+Scene circles() {
+    Scene scene{"300 circles"};
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> x(0, width), y(0, height), r(4, 60);
+
+    for(int i=0; i<300; i++)
+        scene.circles.push_back(circle({x(random), y(random)}, r(random)));
+
+    return scene;
+}
+
+Scene strokes() {
+    Scene scene{"150 bezier strokes"};
+
+    std::mt19937 random(2);
+    std::uniform_real_distribution<float> x(0, width), y(0, height);
+
+    for(int i=0; i<150; i++) {
+        CGI::Bezier curve({x(random), y(random)}, {x(random), y(random)}, {x(random), y(random)}, {x(random), y(random)});
+
+        scene.strokes.push_back(curve.Flatten(0.25f));
+    }
+
+    return scene;
+}
+
+Scene polygons() {
+    Scene scene{"large polygons"};
+
+    //a star with many spikes and a self intersecting star covering most of the image
+    PointList<> spikes;
+    for(int i=0; i<1000; i++) {
+        float ang = i * 2 * Gorgon::PI / 1000;
+        float r   = i % 2 ? 370.f : 120.f + 10 * std::sin(i * 0.1f);
+
+        spikes.Push({width / 2 + r * std::cos(ang), height / 2 + r * std::sin(ang)});
+    }
+
+    PointList<> pentagram;
+    for(int i=0; i<5; i++) {
+        float ang = i * 4 * Gorgon::PI / 5 - Gorgon::PI / 2;
+
+        pentagram.Push({width / 2 + 380 * std::cos(ang) + 0.3f, height / 2 + 380 * std::sin(ang) + 0.7f});
+    }
+
+    scene.polygons.push_back(std::move(spikes));
+    scene.polygons.push_back(std::move(pentagram));
+
+    return scene;
+}
+
+//Fills the given paths with 64 sample rows per pixel, crossings of each row are found
+//exactly and coverage is the length of the filled parts in a pixel.
+void reference(Containers::Image &target, const std::vector<PointList<>> &paths, int winding, Graphics::RGBA color) {
+    const int rows = 64;
+
+    float top = (float)height, bottom = 0, left = (float)width, right = 0;
+    for(const auto &p : paths) {
+        for(auto pnt : p) {
+            top    = std::min(top,    pnt.Y);
+            bottom = std::max(bottom, pnt.Y);
+            left   = std::min(left,   pnt.X);
+            right  = std::max(right,  pnt.X);
+        }
+    }
+
+    int y0 = std::max(0, (int)std::floor(top)),  y1 = std::min(height, (int)std::ceil(bottom));
+    int x0 = std::max(0, (int)std::floor(left)), x1 = std::min(width,  (int)std::ceil(right));
+
+    if(y1 <= y0 || x1 <= x0)
+        return;
+
+    std::vector<float> coverage(x1 - x0);
+    std::vector<std::pair<double, int>> crossings;
+
+    for(int y=y0; y<y1; y++) {
+        std::fill(coverage.begin(), coverage.end(), 0.f);
+
+        for(int r=0; r<rows; r++) {
+            double sy = y + (r + 0.5) / rows;
+
+            crossings.clear();
+            for(const auto &p : paths) {
+                for(int i=0; i<(int)p.GetSize(); i++) {
+                    auto l = p.GetLine(i);
+
+                    if((l.Start.Y <= sy) == (l.End.Y <= sy))
+                        continue;
+
+                    double x = l.Start.X + (sy - l.Start.Y) * (l.End.X - l.Start.X) / (l.End.Y - l.Start.Y);
+                    crossings.push_back({x, l.Start.Y < l.End.Y ? 1 : -1});
+                }
+            }
+
+            std::sort(crossings.begin(), crossings.end());
+
+            int w = 0;
+            for(int i=0; i+1<(int)crossings.size(); i++) {
+                w = winding == 0 ? w + crossings[i].second : !w;
+
+                if(w == 0)
+                    continue;
+
+                double a = std::max<double>(crossings[i].first, x0), b = std::min<double>(crossings[i+1].first, x1);
+
+                for(int x=(int)std::floor(a); x<b; x++) {
+                    double l = std::max<double>(a, x), r = std::min<double>(b, x + 1);
+
+                    if(r > l)
+                        coverage[x - x0] += float((r - l) / rows);
+                }
+            }
+        }
+
+        for(int x=x0; x<x1; x++) {
+            if(coverage[x - x0] > 0) {
+                auto col = target.GetRGBAAt(x, y);
+                col.Blend(color, std::min(coverage[x - x0], 1.f));
+                target.SetRGBAAt(x, y, col);
+            }
+        }
+    }
+}
+
+template<int S_>
+void draw(Containers::Image &target, const Scene &scene) {
+    for(const auto &p : scene.circles)
+        CGI::Polyfill<S_>(target, p, CGI::SolidFill<>(Graphics::RGBA(255, 255, 255, 200)));
+
+    for(const auto &p : scene.strokes)
+        CGI::DrawLines<S_>(target, p, 3.f, CGI::SolidFill<>(Graphics::RGBA(255, 255, 255, 200)));
+
+    for(const auto &p : scene.polygons)
+        CGI::Polyfill<S_>(target, p, CGI::SolidFill<>(Graphics::RGBA(255, 255, 255, 200)));
+}
+
+std::vector<PointList<>> single(const PointList<> &p) {
+    std::vector<PointList<>> list;
+    list.push_back(p.Duplicate());
+
+    return list;
+}
+
+void drawreference(Containers::Image &target, const Scene &scene) {
+    for(const auto &p : scene.circles)
+        reference(target, single(p), 1, Graphics::RGBA(255, 255, 255, 200));
+
+    for(const auto &p : scene.strokes)
+        reference(target, CGI::LinesToPolygons(p, 3.f), 0, Graphics::RGBA(255, 255, 255, 200));
+
+    for(const auto &p : scene.polygons)
+        reference(target, single(p), 1, Graphics::RGBA(255, 255, 255, 200));
+}
+
+int main() {
+    Containers::Image expected({width, height}, Graphics::ColorMode::RGBA);
+    Containers::Image image({width, height}, Graphics::ColorMode::RGBA);
+
+    const int runs = 3;
+
+    std::cout << "Best of " << runs << " runs, " << width << "x" << height << " RGBA:" << std::endl;
+
+    std::vector<Scene> scenes;
+    scenes.push_back(circles());
+    scenes.push_back(strokes());
+    scenes.push_back(polygons());
+
+    for(auto &scene : scenes) {
+        std::cout << "  " << scene.name << ":" << std::endl;
+
+        expected.Clear();
+        drawreference(expected, scene);
+
+        auto test = [&](const char *name, std::function<void()> fn) {
+            double best = 0;
+
+            for(int r=0; r<runs; r++) {
+                image.Clear();
+
+                auto start = Clock::now();
+                fn();
+                double elapsed = ms(start);
+
+                if(r == 0 || elapsed < best)
+                    best = elapsed;
+            }
+
+            //alpha difference on the pixels that are touched by either image
+            double total = 0;
+            int maxdiff = 0, count = 0;
+
+            for(int y=0; y<height; y++) {
+                for(int x=0; x<width; x++) {
+                    int a = image.GetAlphaAt(x, y), b = expected.GetAlphaAt(x, y);
+
+                    if(a == 0 && b == 0)
+                        continue;
+
+                    total  += std::abs(a - b);
+                    maxdiff = std::max(maxdiff, std::abs(a - b));
+                    count++;
+                }
+            }
+
+            std::cout << "    " << name << ": " << best << " ms, mean alpha error "
+                      << (count ? total / count : 0) << ", max " << maxdiff << std::endl;
+        };
+
+        test("S_=4    ", [&] { draw<4>(image, scene); });
+        test("S_=8    ", [&] { draw<8>(image, scene); });
+        test("analytic", [&] { draw<CGI::AnalyticCoverage>(image, scene); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+//Draws a procedural UI skin and a map grid overlay directly and through a tiled render list
+//and reports the time taken and the largest difference between the results. Does not require
+//a window.
+
+#include <Gorgon/CGI/RenderList.h>
+#include <Gorgon/CGI/Bezier.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace CGI = Gorgon::CGI;
+namespace Geometry = Gorgon::Geometry;
+namespace Containers = Gorgon::Containers;
+namespace Graphics = Gorgon::Graphics;
+
+using Geometry::Pointf;
+using Geometry::PointList;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+const int width = 1920, height = 1080;
+
+PointList<> roundedrectangle(Pointf topleft, Pointf size, float radius) {
+    PointList<> points;
+
+    Pointf centers[] = {
+        topleft + Pointf(size.X - radius, radius),
+        topleft + Pointf(size.X - radius, size.Y - radius),
+        topleft + Pointf(radius, size.Y - radius),
+        topleft + Pointf(radius, radius),
+    };
+
+    for(int c=0; c<4; c++) {
+        for(int i=0; i<=8; i++) {
+            float ang = (c - 1 + i / 8.f) * Gorgon::PI / 2;
+            points.Push(centers[c] + Pointf(radius * std::cos(ang), radius * std::sin(ang)));
+        }
+    }
+
+    return points;
+}
+
+//Records or draws the same scene, D_ is either a render list or a function that draws directly
+template<int S_, class D_>
+void skin(D_ &&draw) {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> x(-50, width), y(-50, height), s(20, 300), r(3, 40);
+    std::uniform_int_distribution<int> c(0, 255);
+
+    auto color = [&](int a) { return CGI::SolidFill<>(Graphics::RGBA(Gorgon::Byte(c(random)), Gorgon::Byte(c(random)), Gorgon::Byte(c(random)), Gorgon::Byte(a))); };
+
+    for(int i=0; i<1500; i++) {
+        Pointf tl{x(random), y(random)}, size{s(random), s(random) / 2};
+
+        draw.template Polyfill<S_>(roundedrectangle(tl, size, std::min(8.f, size.Y / 3)), color(220));
+        draw.template DrawLines<S_>(roundedrectangle(tl, size, std::min(8.f, size.Y / 3)), 1.5f, color(255));
+    }
+
+    for(int i=0; i<500; i++)
+        draw.template Circle<S_>(Pointf{x(random), y(random)}, r(random), color(180));
+
+    for(int i=0; i<200; i++) {
+        CGI::Bezier curve({x(random), y(random)}, {x(random), y(random)}, {x(random), y(random)}, {x(random), y(random)});
+
+        draw.template DrawLines<S_>(curve.Flatten(0.25f), 2.f, color(200));
+    }
+
+    //grid overlay, similar to the bounds of the tiles of a map
+    for(int ty=0; ty<height/32; ty++) {
+        for(int tx=0; tx<width/32; tx++) {
+            PointList<> tile = {{tx * 32.f, ty * 32.f}, {tx * 32.f, ty * 32.f + 32}, {tx * 32.f + 32, ty * 32.f + 32}, {tx * 32.f + 32, ty * 32.f}, {tx * 32.f, ty * 32.f}};
+
+            draw.template DrawLines<S_>(tile, 1.f, CGI::SolidFill<>(Graphics::RGBA(0, 0, 0, 128)));
+        }
+    }
+}
+
+//Draws directly to an image with the same interface as the render list
+struct Direct {
+    Containers::Image &target;
+
+    template<int S_, class F_>
+    void Polyfill(const PointList<> &p, F_ fill) { CGI::Polyfill<S_>(target, p, fill); }
+
+    template<int S_, class F_>
+    void DrawLines(const PointList<> &p, float w, F_ fill) { CGI::DrawLines<S_>(target, p, w, fill); }
+
+    template<int S_, class F_>
+    void Circle(Pointf p, float r, F_ fill) { CGI::Circle<S_>(target, p, r, fill); }
+};
+
+template<int S_>
+void run(const char *name) {
+    Containers::Image direct({width, height}, Graphics::ColorMode::RGBA);
+    Containers::Image tiled({width, height}, Graphics::ColorMode::RGBA);
+
+    std::cout << "  " << name << ":" << std::endl;
+
+    double best = 0;
+    for(int r=0; r<3; r++) {
+        direct.Clear();
+
+        auto start = Clock::now();
+        skin<S_>(Direct{direct});
+        double elapsed = ms(start);
+
+        if(r == 0 || elapsed < best)
+            best = elapsed;
+    }
+
+    std::cout << "    direct: " << best << " ms" << std::endl;
+
+    CGI::RenderList list;
+
+    auto start = Clock::now();
+    skin<S_>(list);
+    std::cout << "    recording " << list.GetSize() << " operations: " << ms(start) << " ms" << std::endl;
+
+    for(unsigned threads : {1u, 2u, 4u, std::max(1u, std::thread::hardware_concurrency())}) {
+        best = 0;
+
+        for(int r=0; r<3; r++) {
+            tiled.Clear();
+
+            auto start = Clock::now();
+            list.Render(tiled, threads);
+            double elapsed = ms(start);
+
+            if(r == 0 || elapsed < best)
+                best = elapsed;
+        }
+
+        int diff = 0;
+        for(unsigned long i=0; i<direct.GetTotalSize(); i++)
+            diff = std::max(diff, std::abs(direct.RawData()[i] - tiled.RawData()[i]));
+
+        std::cout << "    render list, " << threads << " threads: " << best << " ms, max difference " << diff << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "Best of 3 runs, " << width << "x" << height << " RGBA, "
+              << std::thread::hardware_concurrency() << " hardware threads:" << std::endl;
+
+    run<8>("S_=8");
+    run<CGI::AnalyticCoverage>("analytic");
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+//Compares the convolution engine against a direct implementation of the convolution
+//sum in speed and in results. Does not require a window or a GL context.
+
+#include <Gorgon/ImageProcessing/Filters.h>
+#include <Gorgon/Containers/Image.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace Containers = Gorgon::Containers;
+namespace Graphics = Gorgon::Graphics;
+
+using namespace Gorgon::ImageProcessing;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+//Convolution as it was done before the engine: every tap of every pixel is bounds checked
+//and read through the image accessor. Out of range values are clamped.
+Containers::Image reference(const Containers::Image &input, const Kernel &kernel, OutOfBoundsPolicy outofbounds) {
+    int C = input.GetChannelsPerPixel();
+    int W = input.GetWidth(), H = input.GetHeight();
+    int w = kernel.GetWidth(), h = kernel.GetHeight();
+
+    Containers::Image output(input.GetSize(), input.GetMode());
+
+    for(int y=0; y<H; y++) {
+        for(int x=0; x<W; x++) {
+            std::array<float, 4> values = {};
+            float weightsum = 0;
+
+            for(int i=0; i<w; i++) {
+                for(int j=0; j<h; j++) {
+                    int cx = x - i + w/2;
+                    int cy = y - j + h/2;
+
+                    if(cx < 0 || cx >= W || cy < 0 || cy >= H) {
+                        if(outofbounds == OutOfBoundsPolicy::PartialSum || outofbounds == OutOfBoundsPolicy::FixedColor)
+                            continue;
+
+                        if(outofbounds == OutOfBoundsPolicy::Cyclic) {
+                            cx = Gorgon::PositiveMod(cx, W);
+                            cy = Gorgon::PositiveMod(cy, H);
+                        }
+                        else {
+                            cx = Gorgon::Clamp(cx, 0, W - 1);
+                            cy = Gorgon::Clamp(cy, 0, H - 1);
+                        }
+                    }
+
+                    for(int c=0; c<C; c++)
+                        values[c] += input(cx, cy, c) * kernel(i, j);
+
+                    weightsum += kernel(i, j);
+                }
+            }
+
+            for(int c=0; c<C; c++) {
+                float v = outofbounds == OutOfBoundsPolicy::PartialSum ? values[c] / weightsum : values[c];
+
+                output(x, y, c) = (Gorgon::Byte)Gorgon::Clamp(v, 0.f, 255.f);
+            }
+        }
+    }
+
+    return output;
+}
+
+int difference(const Containers::Image &l, const Containers::Image &r) {
+    int diff = 0;
+
+    for(int i=0; i<l.GetSize().Area() * (int)l.GetChannelsPerPixel(); i++)
+        diff = std::max(diff, std::abs(l.RawData()[i] - r.RawData()[i]));
+
+    return diff;
+}
+
+Containers::Image generate(Gorgon::Geometry::Size size) {
+    std::mt19937 random(42);
+
+    Containers::Image img(size, Graphics::ColorMode::RGBA);
+
+    //smooth gradients with noise, similar to photographs
+    for(int y=0; y<size.Height; y++) {
+        for(int x=0; x<size.Width; x++) {
+            img(x, y, 0) = Gorgon::Byte((x * 255 / size.Width + random() % 32) % 256);
+            img(x, y, 1) = Gorgon::Byte((y * 255 / size.Height + random() % 32) % 256);
+            img(x, y, 2) = Gorgon::Byte(random() % 256);
+            img(x, y, 3) = Gorgon::Byte(255 - random() % 16);
+        }
+    }
+
+    return img;
+}
+
+int main() {
+    //correctness over all out of bounds policies on a small image, results may differ by
+    //one due to the different order of summation
+    auto small = generate({123, 77});
+
+    const OutOfBoundsPolicy policies[] = {
+        OutOfBoundsPolicy::NearestNeighbor, OutOfBoundsPolicy::Cyclic,
+        OutOfBoundsPolicy::PartialSum
+    };
+
+    const char *names[] = {"Nearest", "Cyclic", "Partial"};
+
+    std::cout << "Maximum difference from direct convolution:" << std::endl;
+
+    for(int p=0; p<3; p++) {
+        auto blur = Kernel::BoxFilter(7);
+        auto edge = Kernel::EdgeDetection(5);
+        auto sobel = Kernel::SobelFilter(Gorgon::Axis::X);
+
+        std::cout << "  " << names[p]
+                  << "\tbox: "   << difference(reference(small, blur, policies[p]), Convolution(small, blur, policies[p]))
+                  << "\tedge: "  << difference(reference(small, edge, policies[p]), Convolution(small, edge, policies[p]));
+
+        //weights of sobel filter add up to zero, partial sum is not defined
+        if(policies[p] != OutOfBoundsPolicy::PartialSum)
+            std::cout << "\tsobel: " << difference(reference(small, sobel, policies[p]), Convolution(small, sobel, policies[p]));
+
+        std::cout << std::endl;
+    }
+
+    auto img = generate({3840, 2160});
+
+    std::cout << std::endl << "3840x2160 RGBA:" << std::endl;
+
+    auto measure = [&](const char *name, Kernel kernel, bool runreference) {
+        auto start = Clock::now();
+        auto result = Convolution(img, kernel);
+        double engine = ms(start);
+
+        std::cout << "  " << name << ": " << engine << " ms";
+
+        if(runreference) {
+            start = Clock::now();
+            auto expected = reference(img, kernel, OutOfBoundsPolicy::NearestNeighbor);
+
+            std::cout << ", direct: " << ms(start) << " ms, difference: " << difference(expected, result);
+        }
+
+        std::cout << std::endl;
+    };
+
+    measure("Gaussian X, sigma 4 ", Kernel::GaussianFilter(4, Gorgon::Axis::X), true);
+    measure("Box 9x9             ", Kernel::BoxFilter(9), true);
+    measure("Edge detection 5x5  ", Kernel::EdgeDetection(5), true);
+    measure("Sobel X             ", Kernel::SobelFilter(Gorgon::Axis::X), true);
+    measure("Box 31x31           ", Kernel::BoxFilter(31), false);
+
+    //full gaussian blur in two passes against a single separable convolution
+    auto gx = Kernel::GaussianFilter(8, Gorgon::Axis::X);
+    auto gy = Kernel::GaussianFilter(8, Gorgon::Axis::Y);
+
+    auto start = Clock::now();
+    auto twopass = Convolution(Convolution(img, gx), gy);
+    std::cout << "  Gaussian, sigma 8, two calls:      " << ms(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    auto separable = SeparableConvolution(img, gx, gy);
+    std::cout << "  Gaussian, sigma 8, separable call: " << ms(start) << " ms, difference: "
+              << difference(twopass, separable) << std::endl;
+
+    return 0;
+}
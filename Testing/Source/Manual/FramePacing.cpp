@@ -0,0 +1,79 @@
+//Measures the frame durations produced by the millisecond sleep that NextFrame used to do and
+//by the frame pacer at 60 and 144 frames per second. Does not require a window.
+
+#include <Gorgon/Time.h>
+#include <Gorgon/Time/FramePacer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace Time = Gorgon::Time;
+
+const int frames = 300;
+
+//simulates 2 to 5ms of work in a frame
+void work(int frame) {
+    auto start = Time::GetPreciseTime();
+
+    while(Time::GetPreciseTime() - start < 2000ull + (frame * 7919) % 3000)
+        ;
+}
+
+void report(const char *name, double target, std::function<void()> wait) {
+    std::vector<double> durations;
+
+    wait();
+    auto prev = Time::GetPreciseTime();
+
+    for(int i=0; i<frames; i++) {
+        work(i);
+        wait();
+
+        auto now = Time::GetPreciseTime();
+        durations.push_back((now - prev) / 1000.0);
+        prev = now;
+    }
+
+    double mean = 0, deviation = 0, worst = 0;
+    for(auto d : durations) {
+        mean += d / frames;
+        worst = std::max(worst, std::abs(d - target));
+    }
+
+    for(auto d : durations)
+        deviation += (d - target) * (d - target) / frames;
+
+    std::cout << "  " << name << ": mean " << mean << " ms (" << 1000 / mean << " fps), rms error "
+              << std::sqrt(deviation) << " ms, worst error " << worst << " ms" << std::endl;
+}
+
+int main() {
+    std::cout << frames << " frames with 2-5ms of work:" << std::endl;
+
+    //the delay NextFrame used to perform
+    unsigned long framestart = Time::GetTime();
+    report("millisecond sleep, 16ms", 16, [&] {
+        auto currentdelta = Time::GetTime() - framestart;
+
+        if(currentdelta < 16)
+            std::this_thread::sleep_for(std::chrono::milliseconds(15 - currentdelta));
+
+        framestart = Time::GetTime();
+    });
+
+    Time::FramePacer pacer(62.5);
+    report("frame pacer, 62.5 fps  ", 16, [&] { pacer.Wait(); });
+
+    pacer.SetTargetRate(144);
+    report("frame pacer, 144 fps   ", 1000 / 144.0, [&] { pacer.Wait(); });
+
+    pacer.SetSpinTime(0);
+    report("144 fps without spin   ", 1000 / 144.0, [&] { pacer.Wait(); });
+
+    return 0;
+}
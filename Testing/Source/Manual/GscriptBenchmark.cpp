@@ -0,0 +1,162 @@
+//Runs a set of scripts that stress the virtual machine with loops, function calls and array
+//operations and reports the interpreted throughput. Each script is run a few times and the
+//best time is reported. Does not require a window.
+
+#include <Gorgon/Scripting/VirtualMachine.h>
+#include <Gorgon/Scripting/Embedding.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace Gorgon::Scripting;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+struct Benchmark {
+    const char *name;
+
+    //number of loop iterations the script performs, used to report throughput
+    int iterations;
+
+    std::string code;
+
+    //output of the script, checked to ensure fast paths do not change the results
+    std::string expected;
+};
+
+const Benchmark benchmarks[] = {
+    {"Loop with arithmetic", 100000,
+        "s = 0\n"
+        "i = 0\n"
+        "while i < 100000\n"
+        "\ts = s + i\n"
+        "\ti = i + 1\n"
+        "end\n"
+        "echo s\n",
+        "704982704"
+    },
+
+    {"Nested loops", 100000,
+        "s = 0\n"
+        "i = 0\n"
+        "while i < 100\n"
+        "\tj = 0\n"
+        "\twhile j < 1000\n"
+        "\t\ts += j\n"
+        "\t\tj += 1\n"
+        "\tend\n"
+        "\ti += 1\n"
+        "end\n"
+        "echo s\n",
+        "49950000"
+    },
+
+    {"Function calls", 20000,
+        "function add(a, b)\n"
+        "\treturn a + b\n"
+        "end function\n"
+        "s = 0\n"
+        "i = 0\n"
+        "while i < 20000\n"
+        "\ts = add(s, i)\n"
+        "\ti += 1\n"
+        "end\n"
+        "echo s\n",
+        "199990000"
+    },
+
+    {"Recursive calls", 21891,
+        "function fib(n)\n"
+        "\tif n < 2\n"
+        "\t\treturn n\n"
+        "\tend\n"
+        "\treturn fib(n - 1) + fib(n - 2)\n"
+        "end function\n"
+        "echo fib(20)\n",
+        "6765"
+    },
+
+    {"Array push and index", 20000,
+        "a = Range(0, 0)\n"
+        "i = 0\n"
+        "while i < 10000\n"
+        "\ta.Push(i * 2)\n"
+        "\ti += 1\n"
+        "end\n"
+        "s = 0\n"
+        "i = 0\n"
+        "while i < a.Size\n"
+        "\ts = s + a[i]\n"
+        "\ti += 1\n"
+        "end\n"
+        "echo s\n",
+        "99990000"
+    },
+
+    {"Array iteration", 20000,
+        "a = Range(0, 20000)\n"
+        "s = 0\n"
+        "for x in a\n"
+        "\ts = s + x\n"
+        "end\n"
+        "echo s\n",
+        "199990000"
+    },
+};
+
+int main() {
+    VirtualMachine vm;
+    vm.Activate();
+
+    const int runs = 5;
+
+    std::cout << "Best of " << runs << " runs:" << std::endl;
+
+    for(auto &benchmark : benchmarks) {
+        double best = 0;
+        std::string output;
+
+        for(int r=0; r<runs; r++) {
+            std::stringstream code(benchmark.code), out;
+            StreamInput input(code, InputProvider::Programming, benchmark.name);
+
+            vm.SetOutput(out);
+
+            auto start = Clock::now();
+
+            try {
+                vm.Begin(input);
+                vm.Run();
+            }
+            catch(const Exception &ex) {
+                out << "Error at line " << ex.GetLine() << ": " << ex.GetMessage();
+            }
+
+            double elapsed = ms(start);
+            if(r == 0 || elapsed < best)
+                best = elapsed;
+
+            output = out.str();
+        }
+
+        vm.ResetOutput();
+
+        output.erase(std::remove(output.begin(), output.end(), '\n'), output.end());
+
+        std::cout << "  " << benchmark.name << ": " << best << " ms, "
+                  << int(benchmark.iterations / best * 1000) << " iterations/s";
+
+        if(output != benchmark.expected)
+            std::cout << ", WRONG RESULT: " << output << " expected " << benchmark.expected;
+
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,284 @@
+//Compares the previous A* implementation with the current one, jump point
+//search and hierarchical path finding on generated maze and open field maps
+//and reports query times and path lengths. Batch queries are also measured
+//on the shared worker pool.
+
+#include <Gorgon/Game/Pathfinding/AStar.h>
+#include <Gorgon/Game/Pathfinding/JumpPoint.h>
+#include <Gorgon/Game/Pathfinding/Hierarchical.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace Pathfinding = Gorgon::Game::Pathfinding;
+namespace Geometry = Gorgon::Geometry;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+//A* as it was before the node pool and binary heap, used as a reference
+class LegacyPathFinder {
+public:
+    void SetSize(Geometry::Size size) {
+        worldsize = size;
+    }
+
+    void SetDiagonalMovement(bool enable) {
+        directions = enable ? 8 : 4;
+    }
+
+    void AddBlock(Geometry::Point p) {
+        walls.Push(p);
+    }
+
+    Pathfinding::CoordinateList FindPath(Geometry::Point source, Geometry::Point target) {
+        Pathfinding::TileNode *current = nullptr;
+        Pathfinding::NodeSet openset, closedset;
+        openset.push_back(new Pathfinding::TileNode(source));
+
+        while(!openset.empty()) {
+            auto current_it = openset.begin();
+            current = *current_it;
+
+            for(auto it = openset.begin(); it != openset.end(); it++) {
+                if((*it)->get_score() <= current->get_score()) {
+                    current = *it;
+                    current_it = it;
+                }
+            }
+
+            if(current->coordinates == target)
+                break;
+
+            closedset.push_back(current);
+            openset.erase(current_it);
+
+            for(int i = 0; i < directions; ++i) {
+                Geometry::Point next(current->coordinates + direction[i]);
+                if(collides(next) || find(closedset, next))
+                    continue;
+
+                uint cost = current->G + ((i < 4) ? 10 : 14);
+
+                auto successor = find(openset, next);
+                if(successor == nullptr) {
+                    successor = new Pathfinding::TileNode(next, current);
+                    successor->G = cost;
+                    successor->H = Pathfinding::AStar::Heuristic::manhattan(next, target);
+                    openset.push_back(successor);
+                }
+                else if(cost < successor->G) {
+                    successor->parent = current;
+                    successor->G = cost;
+                }
+            }
+        }
+
+        Pathfinding::CoordinateList path;
+        if(current && current->coordinates == target) {
+            while(current != nullptr) {
+                path.Push(current->coordinates);
+                current = current->parent;
+            }
+        }
+
+        for(auto n : openset)
+            delete n;
+        for(auto n : closedset)
+            delete n;
+
+        return path;
+    }
+
+private:
+    bool collides(Geometry::Point p) {
+        return p.X < 0 || p.X >= worldsize.Width || p.Y < 0 || p.Y >= worldsize.Height ||
+               std::find(walls.begin(), walls.end(), p) != walls.end();
+    }
+
+    Pathfinding::TileNode *find(Pathfinding::NodeSet &nodes, Geometry::Point p) {
+        for(auto node : nodes) {
+            if(node->coordinates == p)
+                return node;
+        }
+        return nullptr;
+    }
+
+    Geometry::Point direction[8] = {
+        { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, 0 },
+        { -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }
+    };
+    Pathfinding::CoordinateList walls;
+    Geometry::Size worldsize;
+    int directions = 4;
+};
+
+//walls are on odd cells, passages are carved with a randomized depth first search
+std::vector<bool> maze(int size, std::mt19937 &rng) {
+    std::vector<bool> blocked(size * size, true);
+    std::vector<Geometry::Point> stack = {{0, 0}};
+    blocked[0] = false;
+
+    while(!stack.empty()) {
+        auto c = stack.back();
+        Geometry::Point options[4];
+        int count = 0;
+
+        for(auto d : {Geometry::Point{2, 0}, {-2, 0}, {0, 2}, {0, -2}}) {
+            auto n = c + d;
+            if(n.X >= 0 && n.Y >= 0 && n.X < size && n.Y < size && blocked[n.X + n.Y * size])
+                options[count++] = n;
+        }
+
+        if(count == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        auto n = options[rng() % count];
+        blocked[n.X + n.Y * size] = false;
+        blocked[(c.X + n.X) / 2 + (c.Y + n.Y) / 2 * size] = false;
+        stack.push_back(n);
+    }
+
+    return blocked;
+}
+
+std::vector<bool> openfield(int size, std::mt19937 &rng) {
+    std::vector<bool> blocked(size * size);
+    for(int i = 0; i < size * size; i++)
+        blocked[i] = rng() % 5 == 0;
+
+    return blocked;
+}
+
+struct result {
+    double elapsed = 0;
+    long length = 0;
+    int found = 0;
+};
+
+template<class F_>
+result measure(const std::vector<Pathfinding::PathQuery> &pairs, F_ find) {
+    result r;
+    auto start = Clock::now();
+    for(auto &p : pairs) {
+        auto path = find(p.first, p.second);
+        r.length += path.GetSize();
+        r.found += path.GetSize() != 0;
+    }
+    r.elapsed = ms(start);
+
+    return r;
+}
+
+void report(const char *name, const result &r, const result &reference, int queries) {
+    std::cout << "    " << name << ": " << r.elapsed / queries << " ms per query, "
+              << r.found << "/" << queries << " found, average length "
+              << (r.found ? r.length / r.found : 0) << ", "
+              << r.elapsed / reference.elapsed << "x time of A*" << std::endl;
+
+    if(r.found != reference.found)
+        std::cout << "    Reachability does not match!" << std::endl;
+}
+
+void run(const char *name, int size, const std::vector<bool> &blocked, bool legacy, std::mt19937 &rng) {
+    Pathfinding::AStar::PathFinder current;
+    Pathfinding::JumpPoint::PathFinder jps;
+    Pathfinding::Hierarchical::PathFinder hpa;
+    LegacyPathFinder old;
+
+    current.SetSize({size, size});
+    jps.SetSize({size, size});
+    hpa.SetSize({size, size});
+    old.SetSize({size, size});
+    current.SetDiagonalMovement(true);
+    jps.SetDiagonalMovement(true);
+    hpa.SetDiagonalMovement(true);
+    old.SetDiagonalMovement(true);
+    current.SetHeuristic(&Pathfinding::AStar::Heuristic::octagonal);
+
+    std::vector<Geometry::Point> open;
+    for(int y = 0; y < size; y++) {
+        for(int x = 0; x < size; x++) {
+            if(blocked[x + y * size]) {
+                current.AddBlock({x, y});
+                jps.AddBlock({x, y});
+                hpa.AddBlock({x, y});
+                if(legacy)
+                    old.AddBlock({x, y});
+            }
+            else {
+                open.push_back({x, y});
+            }
+        }
+    }
+
+    const int queries = legacy ? 10 : 100;
+    std::vector<Pathfinding::PathQuery> pairs;
+    for(int i = 0; i < queries; i++)
+        pairs.push_back({open[rng() % open.size()], open[rng() % open.size()]});
+
+    std::cout << name << " " << size << "x" << size << std::endl;
+
+    //abstract graph is built on the first query
+    auto start = Clock::now();
+    hpa.FindPath(pairs[0].first, pairs[0].second);
+    std::cout << "    HPA* graph built in " << ms(start) << " ms" << std::endl;
+
+    auto astar = measure(pairs, [&](auto s, auto t) { return current.FindPath(s, t); });
+    report("A*      ", astar, astar, queries);
+    report("JPS     ", measure(pairs, [&](auto s, auto t) { return jps.FindPath(s, t); }), astar, queries);
+    report("HPA*    ", measure(pairs, [&](auto s, auto t) { return hpa.FindPath(s, t); }), astar, queries);
+
+    auto threads = Pathfinding::WorkerPool::Default().GetThreadCount();
+    std::vector<Pathfinding::CoordinateList> results;
+
+    start = Clock::now();
+    current.FindPaths(pairs, results);
+    std::cout << "    A* batch on " << threads << " threads: " << ms(start) / queries << " ms per query" << std::endl;
+
+    start = Clock::now();
+    jps.FindPaths(pairs, results);
+    std::cout << "    JPS batch on " << threads << " threads: " << ms(start) / queries << " ms per query" << std::endl;
+
+    start = Clock::now();
+    hpa.FindPaths(pairs, results);
+    std::cout << "    HPA* batch on " << threads << " threads: " << ms(start) / queries << " ms per query" << std::endl;
+
+    if(legacy)
+        report("Previous", measure(pairs, [&](auto s, auto t) { return old.FindPath(s, t); }), astar, queries);
+
+    //changing a block only rebuilds the clusters around it
+    start = Clock::now();
+    for(int i = 0; i < 100; i++) {
+        Geometry::Point p = open[rng() % open.size()];
+        hpa.AddBlock(p);
+        hpa.FindPath(pairs[0].first, pairs[0].second);
+        hpa.RemoveBlock(p);
+    }
+    std::cout << "    HPA* block change and query: " << ms(start) / 100 << " ms" << std::endl;
+}
+
+int main() {
+    std::mt19937 rng(42);
+
+    for(int size : {31, 63, 127}) {
+        run("Maze      ", size, maze(size, rng), true, rng);
+        run("Open field", size, openfield(size, rng), true, rng);
+    }
+
+    //previous implementation takes too long on larger maps
+    for(int size : {511, 1023}) {
+        run("Maze      ", size, maze(size, rng), false, rng);
+        run("Open field", size, openfield(size, rng), false, rng);
+    }
+
+    return 0;
+}
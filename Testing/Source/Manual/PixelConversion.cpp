@@ -0,0 +1,153 @@
+//Measures the pixel converters for every pair of color modes against a per pixel conversion
+//that branches on the color modes and checks that their results are the same. Does not
+//require a window or a GL context.
+
+#include <Gorgon/Graphics/PixelConversion.h>
+#include <Gorgon/Containers/Image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace Graphics = Gorgon::Graphics;
+
+using Gorgon::Byte;
+using Graphics::ColorMode;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+const ColorMode modes[] = {
+    ColorMode::RGB, ColorMode::BGR, ColorMode::RGBA, ColorMode::BGRA,
+    ColorMode::Grayscale, ColorMode::Grayscale_Alpha, ColorMode::Alpha
+};
+
+const char *names[] = {"RGB", "BGR", "RGBA", "BGRA", "Gray", "GrayA", "Alpha"};
+
+//Conversion as it was done before the converters, one pixel at a time through RGBA
+void reference(const Byte *source, ColorMode from, Byte *destination, ColorMode to, long count) {
+    int sc = Graphics::GetChannelsPerPixel(from), dc = Graphics::GetChannelsPerPixel(to);
+    bool gray = from == ColorMode::Grayscale || from == ColorMode::Grayscale_Alpha || from == ColorMode::Alpha;
+
+    for(long i=0; i<count; i++) {
+        const Byte *p = source + i * sc;
+        Graphics::RGBA c;
+
+        switch(from) {
+        case ColorMode::RGB:             c = {p[0], p[1], p[2], 255};  break;
+        case ColorMode::BGR:             c = {p[2], p[1], p[0], 255};  break;
+        case ColorMode::RGBA:            c = {p[0], p[1], p[2], p[3]}; break;
+        case ColorMode::BGRA:            c = {p[2], p[1], p[0], p[3]}; break;
+        case ColorMode::Grayscale:       c = {p[0], p[0], p[0], 255};  break;
+        case ColorMode::Grayscale_Alpha: c = {p[0], p[0], p[0], p[1]}; break;
+        default:                         c = {255, 255, 255, p[0]};    break;
+        }
+
+        auto values = c.Convert(to);
+
+        //grayscale images keep their values instead of recomputing luminance
+        if(gray && (to == ColorMode::Grayscale || to == ColorMode::Grayscale_Alpha))
+            values[0] = c.R;
+
+        for(int j=0; j<dc; j++)
+            destination[i * dc + j] = values[j];
+    }
+}
+
+int main() {
+    std::mt19937 random(42);
+
+    const long pixels = 3840 * 2160;
+    std::vector<Byte> source(pixels * 4 + 64), expected(pixels * 4 + 64), actual(pixels * 4 + 64);
+
+    for(auto &b : source)
+        b = Byte(random());
+
+    //odd counts and offsets exercise the remainders of the vectorized loops
+    int failures = 0;
+    for(auto &from : modes) {
+        for(auto &to : modes) {
+            for(long count : {1L, 7L, 15L, 16L, 17L, 31L, 33L, 100L, 1001L}) {
+                for(int offset : {0, 1, 3}) {
+                    reference(source.data() + offset, from, expected.data(), to, count);
+                    Graphics::ConvertPixels(source.data() + offset, from, actual.data(), to, count);
+
+                    if(!std::equal(expected.begin(), expected.begin() + count * Graphics::GetChannelsPerPixel(to), actual.begin())) {
+                        std::cout << "Mismatch: " << names[&from - modes] << " -> " << names[&to - modes]
+                                  << ", " << count << " pixels" << std::endl;
+                        failures++;
+                    }
+                }
+            }
+
+            //in place conversion between modes of the same size
+            if(Graphics::GetChannelsPerPixel(from) == Graphics::GetChannelsPerPixel(to)) {
+                std::vector<Byte> inplace(source.begin(), source.begin() + 1003 * 4);
+
+                reference(source.data(), from, expected.data(), to, 1003);
+                Graphics::ConvertPixels(inplace.data(), from, inplace.data(), to, 1003);
+
+                if(!std::equal(expected.begin(), expected.begin() + 1003 * Graphics::GetChannelsPerPixel(to), inplace.begin())) {
+                    std::cout << "In place mismatch: " << names[&from - modes] << " -> " << names[&to - modes] << std::endl;
+                    failures++;
+                }
+            }
+        }
+    }
+
+    std::cout << "Correctness: " << failures << " failures" << std::endl << std::endl;
+
+    std::cout << "3840x2160, per pixel / converter:" << std::endl << "        ";
+    for(auto name : names)
+        std::cout << std::setw(16) << name;
+    std::cout << std::endl;
+
+    const int repeat = 5;
+
+    for(auto &from : modes) {
+        std::cout << std::setw(8) << names[&from - modes];
+
+        for(auto &to : modes) {
+            auto start = Clock::now();
+            for(int i=0; i<repeat; i++)
+                reference(source.data(), from, expected.data(), to, pixels);
+            double scalar = ms(start) / repeat;
+
+            auto converter = Graphics::GetPixelConverter(from, to);
+
+            start = Clock::now();
+            for(int i=0; i<repeat; i++)
+                converter(source.data(), actual.data(), pixels);
+            double converted = ms(start) / repeat;
+
+            std::cout << std::setw(8) << std::fixed << std::setprecision(1) << scalar << "/" << std::setw(7) << converted;
+        }
+
+        std::cout << std::endl;
+    }
+
+    //typical uses through the image
+    Gorgon::Containers::Image img({3840, 2160}, ColorMode::RGB);
+    std::vector<Byte> buffer(pixels * 4);
+    std::vector<unsigned long> icon(pixels);
+
+    auto start = Clock::now();
+    img.CopyToRGBABuffer(buffer.data());
+    std::cout << std::endl << "CopyToRGBABuffer from RGB: " << ms(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    img.CopyToBGRABufferLong(icon.data());
+    std::cout << "CopyToBGRABufferLong from RGB: " << ms(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    img.ConvertToRGBA();
+    std::cout << "ConvertToRGBA from RGB: " << ms(start) << " ms" << std::endl;
+
+    return 0;
+}
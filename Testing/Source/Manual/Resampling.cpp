@@ -0,0 +1,293 @@
+//Compares the resampling functions against the per pixel implementations that were used
+//before the coefficient tables in speed and in results. Does not require a window or a GL
+//context.
+
+#include <Gorgon/ImageProcessing/Resampling.h>
+#include <Gorgon/Containers/Image.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace Containers = Gorgon::Containers;
+namespace Graphics = Gorgon::Graphics;
+
+using namespace Gorgon::ImageProcessing;
+using Containers::InterpolationMethod;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+float cubic(float x) {
+    const float a = -0.5f;
+    x = std::abs(x);
+
+    if(x < 1)
+        return (a+2) * x*x*x - (a+3) * x*x + 1;
+    else if(x < 2)
+        return a * x*x*x - 5*a * x*x + 8*a * x - 4*a;
+    else
+        return 0;
+}
+
+//Scaling with the weights of the tables, but one pixel at a time in double precision
+Containers::Image scalereference(const Containers::Image &input, const ResamplingTable &h, const ResamplingTable &v) {
+    int C = input.GetChannelsPerPixel();
+    Containers::Image output({h.GetDestinationSize(), v.GetDestinationSize()}, input.GetMode());
+
+    for(int y=0; y<v.GetDestinationSize(); y++) {
+        for(int x=0; x<h.GetDestinationSize(); x++) {
+            for(int c=0; c<C; c++) {
+                double sum = 0;
+
+                for(int j=0; j<v.GetTaps(); j++)
+                    for(int i=0; i<h.GetTaps(); i++)
+                        sum += h.GetWeights(x)[i] * v.GetWeights(y)[j] * input(h.GetStart(x) + i, v.GetStart(y) + j, c);
+
+                output(x, y, c) = (Gorgon::Byte)Gorgon::Clamp(std::round(sum), 0.0, 255.0);
+            }
+        }
+    }
+
+    return output;
+}
+
+//Cubic scaling as it was done before, weights are computed for every pixel
+Containers::Image oldscale(const Containers::Image &input, Gorgon::Geometry::Size newsize) {
+    int C = input.GetChannelsPerPixel();
+    auto size = input.GetSize();
+    Containers::Image output(newsize, input.GetMode());
+
+    float fx = (float)size.Width / newsize.Width;
+    float fy = (float)size.Height / newsize.Height;
+
+    float yy = 0;
+    for(int y=0; y<newsize.Height; y++) {
+        float xx = 0;
+        for(int x=0; x<newsize.Width; x++) {
+            for(int c=0; c<C; c++) {
+                float v = 0;
+                for(int j=0; j<4; j++) {
+                    for(int i=0; i<4; i++) {
+                        v += cubic(xx - (int)xx + 1 - i) * cubic(yy - (int)yy + 1 - j) *
+                             input(Gorgon::Clamp((int)xx-1 + i, 0, size.Width-1), Gorgon::Clamp((int)yy-1 + j, 0, size.Height-1), c);
+                    }
+                }
+
+                output(x, y, c) = (Gorgon::Byte)Gorgon::Clamp(std::round(v), 0.f, 255.f);
+            }
+
+            xx += fx;
+        }
+
+        yy += fy;
+    }
+
+    return output;
+}
+
+//Cubic rotation as it was done before, pixels outside the image are 0
+Containers::Image oldrotate(const Containers::Image &input, float angle, Gorgon::Geometry::Pointf origin) {
+    int C = input.GetChannelsPerPixel();
+
+    Gorgon::Geometry::Boundsf bnds = {0,0, Gorgon::Geometry::Sizef(input.GetSize())};
+    Gorgon::Geometry::Rotate(bnds, angle, origin);
+    Gorgon::Geometry::Bounds b{
+        (int)std::floor(bnds.Left)-1, (int)std::floor(bnds.Top)-1,
+        (int)std::ceil(bnds.Right)+1, (int)std::ceil(bnds.Bottom)+1,
+    };
+
+    Containers::Image output(b.GetSize(), input.GetMode());
+
+    float cosa = std::cos(-angle);
+    float sina = std::sin(-angle);
+
+    for(int y=0; y<b.Height(); y++) {
+        float yn = y - origin.Y + b.Top;
+
+        for(int x=0; x<b.Width(); x++) {
+            float xn = x - origin.X + b.Left;
+
+            float xx = xn * cosa - yn * sina + origin.X;
+            float yy = xn * sina + yn * cosa + origin.Y;
+
+            int x1 = (int)std::floor(xx), y1 = (int)std::floor(yy);
+
+            for(int c=0; c<C; c++) {
+                float v = 0;
+                for(int j=0; j<4; j++)
+                    for(int i=0; i<4; i++)
+                        v += cubic(xx - x1 + 1 - i) * cubic(yy - y1 + 1 - j) * input.Get(x1-1 + i, y1-1 + j, c);
+
+                output(x, y, c) = (Gorgon::Byte)Gorgon::Clamp(std::round(v), 0.f, 255.f);
+            }
+        }
+    }
+
+    return output;
+}
+
+//Linear skew as it was done before, origin is 0, 0
+Containers::Image oldskewx(const Containers::Image &input, float perpixel) {
+    int C = input.GetChannelsPerPixel();
+
+    Gorgon::Geometry::Boundsf bnds = {0,0, Gorgon::Geometry::Sizef(input.GetSize())};
+    Gorgon::Geometry::SkewX(bnds, perpixel, {0.f, 0.f});
+    Gorgon::Geometry::Bounds b{
+        (int)std::floor(bnds.Left)-1, (int)std::floor(bnds.Top)-1,
+        (int)std::ceil(bnds.Right)+1, (int)std::ceil(bnds.Bottom)+1,
+    };
+
+    Containers::Image output(b.GetSize(), input.GetMode());
+
+    for(int y=0; y<b.Height(); y++) {
+        float yn = float(y + b.Top);
+
+        for(int x=0; x<b.Width(); x++) {
+            float xx = x + b.Left - yn * perpixel;
+            int x1 = (int)std::floor(xx);
+            float l = xx - x1;
+
+            for(int c=0; c<C; c++)
+                output(x, y, c) = (Gorgon::Byte)std::round((1-l) * input.Get(x1, y, c) + l * input.Get(x1+1, y, c));
+        }
+    }
+
+    return output;
+}
+
+int difference(const Containers::Image &l, const Containers::Image &r) {
+    if(l.GetSize() != r.GetSize())
+        return 256;
+
+    int diff = 0;
+
+    for(int i=0; i<l.GetSize().Area() * (int)l.GetChannelsPerPixel(); i++)
+        diff = std::max(diff, std::abs(l.RawData()[i] - r.RawData()[i]));
+
+    return diff;
+}
+
+Containers::Image generate(Gorgon::Geometry::Size size, Graphics::ColorMode mode = Graphics::ColorMode::RGBA) {
+    std::mt19937 random(42);
+
+    Containers::Image img(size, mode);
+
+    //smooth gradients with noise, similar to photographs
+    for(int y=0; y<size.Height; y++) {
+        for(int x=0; x<size.Width; x++) {
+            for(int c=0; c<(int)img.GetChannelsPerPixel(); c++)
+                img(x, y, c) = Gorgon::Byte(((x + y) * 255 / (size.Width + size.Height) + c * 64 + random() % 32) % 256);
+        }
+    }
+
+    return img;
+}
+
+int main() {
+    //correctness on small images with every channel count, results may differ by one due
+    //to the summation in single precision
+    const ResamplingFilter filters[] = {
+        ResamplingFilter::Nearest, ResamplingFilter::Box, ResamplingFilter::Linear,
+        ResamplingFilter::Cubic, ResamplingFilter::Lanczos
+    };
+
+    const char *names[] = {"Nearest", "Box", "Linear", "Cubic", "Lanczos"};
+
+    const Graphics::ColorMode modes[] = {
+        Graphics::ColorMode::Alpha, Graphics::ColorMode::Grayscale_Alpha,
+        Graphics::ColorMode::RGB, Graphics::ColorMode::RGBA
+    };
+
+    const Gorgon::Geometry::Size sizes[] = {{1, 1}, {7, 3}, {45, 31}, {64, 64}, {100, 37}, {301, 211}};
+
+    std::cout << "Maximum difference from per pixel scaling:" << std::endl;
+
+    for(int f=0; f<5; f++) {
+        int diff = 0;
+
+        for(auto mode : modes) {
+            auto small = generate({123, 77}, mode);
+
+            for(auto size : sizes) {
+                ResamplingTable h(123, size.Width, filters[f]), v(77, size.Height, filters[f]);
+
+                Containers::Image result;
+                small.Scale(result, h, v);
+
+                diff = std::max(diff, difference(scalereference(small, h, v), result));
+            }
+        }
+
+        std::cout << "  " << names[f] << ": " << diff << std::endl;
+    }
+
+    auto small = generate({123, 77});
+
+    std::cout << std::endl << "Maximum difference from the previous implementation:" << std::endl;
+    std::cout << "  Rotate cubic: " << difference(oldrotate(small, 0.3f, {61.5f, 38.5f}), small.Rotate(0.3f)) << std::endl;
+    std::cout << "  Skew X linear: " << difference(oldskewx(small, 0.35f), small.SkewX(0.35f, InterpolationMethod::Linear)) << std::endl;
+
+    auto img = generate({3840, 2160});
+
+    std::cout << std::endl << "3840x2160 RGBA:" << std::endl;
+
+    auto start = Clock::now();
+    auto expected = oldscale(img, {2000, 1200});
+    std::cout << "  Cubic to 2000x1200, per pixel: " << ms(start) << " ms";
+
+    start = Clock::now();
+    auto scaled = img.Scale({2000, 1200});
+    std::cout << ", tables: " << ms(start) << " ms" << std::endl;
+
+    for(int f=0; f<5; f++) {
+        start = Clock::now();
+        auto thumb = img.Scale({256, 144},
+            filters[f] == ResamplingFilter::Box ? InterpolationMethod::Area :
+            filters[f] == ResamplingFilter::Lanczos ? InterpolationMethod::Lanczos :
+            filters[f] == ResamplingFilter::Linear ? InterpolationMethod::Linear :
+            filters[f] == ResamplingFilter::Cubic ? InterpolationMethod::Cubic : InterpolationMethod::NearestNeighbor
+        );
+
+        std::cout << "  " << names[f] << " thumbnail 256x144: " << ms(start) << " ms" << std::endl;
+    }
+
+    auto tile = generate({512, 512});
+
+    start = Clock::now();
+    expected = oldrotate(tile, 0.3f, {256, 256});
+    std::cout << "  Rotate 512x512 cubic, per pixel: " << ms(start) << " ms";
+
+    start = Clock::now();
+    auto rotated = tile.Rotate(0.3f);
+    std::cout << ", table: " << ms(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    expected = oldskewx(img, 0.2f);
+    std::cout << "  Skew X linear, per pixel: " << ms(start) << " ms";
+
+    start = Clock::now();
+    auto skewed = img.SkewX(0.2f, InterpolationMethod::Linear);
+    std::cout << ", row weights: " << ms(start) << " ms" << std::endl;
+
+    //zooming many tiles of the same size into the same target, as done for zoomed tilesets
+    const int tiles = 200;
+    Containers::Image target;
+
+    start = Clock::now();
+    for(int i=0; i<tiles; i++)
+        auto zoomed = tile.Scale({1024, 1024}, InterpolationMethod::Linear);
+    std::cout << "  " << tiles << " tiles 512 to 1024 linear, new images: " << ms(start) << " ms";
+
+    ResamplingTable zoom(512, 1024, ResamplingFilter::Linear);
+
+    start = Clock::now();
+    for(int i=0; i<tiles; i++)
+        tile.Scale(target, zoom, zoom);
+    std::cout << ", reused target and tables: " << ms(start) << " ms" << std::endl;
+
+    return 0;
+}
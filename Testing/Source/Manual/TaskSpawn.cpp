@@ -0,0 +1,114 @@
+//Measures the overhead of starting work on other threads: a thread per task as RunAsync does,
+//the thread per call RunInParallel used to do, and the tasks of the persistent scheduler. Does
+//not require a window.
+
+#include <Gorgon/Threading.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace Threading = Gorgon::Threading;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double us(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+//The previous implementation of RunInParallel
+void threadpercall(std::function<void(int, int)> fn, unsigned threads) {
+    std::vector<std::thread> thrds;
+
+    for(unsigned id=0; id<threads; id++)
+        thrds.emplace_back(fn, id, threads);
+
+    for(auto &t : thrds)
+        t.join();
+}
+
+int main() {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    const int tasks = 2000, calls = 1000;
+
+    std::cout << threads << " hardware threads, " << Threading::Scheduler::Default().GetWorkerCount()
+              << " workers:" << std::endl;
+
+    std::atomic<int> done{0};
+
+    //a detached thread per task, waiting using a counter
+    auto start = Clock::now();
+    for(int i=0; i<tasks; i++)
+        Threading::RunAsync([&] { done++; });
+
+    while(done < tasks)
+        std::this_thread::yield();
+
+    std::cout << "  RunAsync, thread per task:         " << us(start) / tasks << " us per task" << std::endl;
+
+    done = 0;
+    start = Clock::now();
+    {
+        Threading::TaskGroup group;
+
+        for(int i=0; i<tasks; i++)
+            group.Run([&] { done++; });
+
+        group.Wait();
+    }
+
+    std::cout << "  TaskGroup::Run:                    " << us(start) / tasks << " us per task" << std::endl;
+
+    done = 0;
+    start = Clock::now();
+    for(int i=0; i<tasks; i++)
+        Threading::Scheduler::Default().Schedule([&] { done++; });
+
+    while(done < tasks)
+        std::this_thread::yield();
+
+    std::cout << "  Scheduler::Schedule:               " << us(start) / tasks << " us per task" << std::endl;
+
+    //small parallel loops, as done every frame
+    std::vector<float> data(1 << 14, 1.f);
+
+    auto loop = [&](int id, int count) {
+        for(size_t i=id; i<data.size(); i+=count)
+            data[i] *= 1.0001f;
+    };
+
+    start = Clock::now();
+    for(int i=0; i<calls; i++)
+        threadpercall(loop, threads);
+
+    std::cout << "  RunInParallel, thread per call:    " << us(start) / calls << " us per call" << std::endl;
+
+    start = Clock::now();
+    for(int i=0; i<calls; i++)
+        Threading::RunInParallel(loop, threads);
+
+    std::cout << "  RunInParallel, scheduler:          " << us(start) / calls << " us per call" << std::endl;
+
+    start = Clock::now();
+    for(int i=0; i<calls; i++) {
+        Threading::ParallelFor(0, (int)data.size(), 2048, [&](int first, int last) {
+            for(int j=first; j<last; j++)
+                data[j] *= 1.0001f;
+        });
+    }
+
+    std::cout << "  ParallelFor, grain 2048:           " << us(start) / calls << " us per call" << std::endl;
+
+    start = Clock::now();
+    for(int i=0; i<calls; i++) {
+        for(auto &d : data)
+            d *= 1.0001f;
+    }
+
+    std::cout << "  serial loop:                       " << us(start) / calls << " us per call" << std::endl;
+
+    return 0;
+}
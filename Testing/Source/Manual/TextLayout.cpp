@@ -0,0 +1,158 @@
+//Prints a 10k line document and reports the time spent by the printers when
+//the text is laid out on every call, when layouts are kept in the LRU cache
+//of the printer and when a TextLayout is held by the caller.
+
+#include <Gorgon/Window.h>
+#include <Gorgon/Main.h>
+#include <Gorgon/Graphics.h>
+#include <Gorgon/Graphics/Layer.h>
+#include <Gorgon/Graphics/Font.h>
+#include <Gorgon/Graphics/FreeType.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Graphics = Gorgon::Graphics;
+
+using Clock = std::chrono::high_resolution_clock;
+
+const int Lines = 10000;
+const int Width = 780;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+std::vector<std::string> generate() {
+    const char *words[] = {
+        "lorem", "ipsum", "dolor", "sit", "amet", "AVATAR", "Wave", "to", "jumps", "over",
+        "the", "lazy", "dog", "quick", "brown", "fox", "\tindented", "kerning", "Type", "yoke"
+    };
+
+    std::vector<std::string> lines;
+
+    for(int i=0; i<Lines; i++) {
+        std::string line;
+
+        //some lines are long enough to wrap
+        int count = 4 + (i * 7) % 23;
+        for(int j=0; j<count; j++) {
+            if(j)
+                line += " ";
+
+            line += words[(i * 13 + j * 7) % 20];
+        }
+
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+template<class P_>
+void measure(const char *name, P_ &printer, Graphics::Layer &l, const std::vector<std::string> &lines, const std::string &document) {
+    const int frames = 10;
+
+    auto lineheight = (int)printer.GetGlyphRenderer().GetLineGap();
+
+    auto run = [&](const char *mode, auto print) {
+        //warm up, glyphs are loaded on first use
+        l.Clear();
+        print();
+
+        auto start = Clock::now();
+        for(int i=0; i<frames; i++) {
+            l.Clear();
+            print();
+        }
+
+        std::cout << name << " " << mode << ms(start) / frames << " ms per frame" << std::endl;
+    };
+
+    auto printlines = [&] {
+        int y = 0;
+        for(auto &line : lines) {
+            printer.Print(l, line, 0, y);
+            y += lineheight;
+        }
+    };
+
+    auto printdocument = [&] {
+        printer.Print(l, document, 0, 0, Width);
+    };
+
+    printer.SetLayoutCacheSize(0);
+    run("lines, no cache:     ", printlines);
+    run("document, no cache:  ", printdocument);
+
+    printer.SetLayoutCacheSize(Lines);
+    run("lines, LRU cache:    ", printlines);
+    run("document, LRU cache: ", printdocument);
+
+    std::vector<Graphics::TextLayout> layouts(lines.size());
+    Graphics::TextLayout doclayout;
+
+    run("lines, held layout:  ", [&] {
+        int y = 0;
+        for(size_t i=0; i<lines.size(); i++) {
+            printer.Update(layouts[i], lines[i]);
+            printer.Print(l, layouts[i], {0, y});
+            y += lineheight;
+        }
+    });
+
+    run("document, held:      ", [&] {
+        printer.Update(doclayout, document, Width, Graphics::TextAlignment::Left);
+        printer.Print(l, doclayout, {0, 0});
+    });
+
+    printer.SetLayoutCacheSize(64);
+}
+
+int main() {
+    Gorgon::Initialize("TextLayout-test");
+
+    Gorgon::Window wind({800, 600}, "textlayouttest", true);
+    Graphics::Initialize();
+
+    wind.ClosingEvent.Register([] { exit(0); });
+
+    Graphics::Layer l;
+    wind.Add(l);
+
+    Graphics::FreeType f;
+#ifdef WIN32
+    f.LoadFile("C:/Windows/Fonts/tahoma.ttf", 14);
+#else
+    f.LoadFile("Boxy-Bold.ttf", 14);
+#endif
+
+    auto lines = generate();
+
+    std::string document;
+    for(auto &line : lines) {
+        document += line;
+        document += "\n";
+    }
+
+    std::cout << Lines << " lines, " << document.size() << " bytes" << std::endl;
+
+    measure("Basic ", f, l, lines, document);
+
+    Graphics::StyledPrinter styled(f);
+    styled.SetUnderline(true);
+    styled.JustifyLeft();
+    styled.SetLetterSpacing(1);
+
+    measure("Styled", styled, l, lines, document);
+
+    while(true) {
+        l.Clear();
+        styled.Print(l, document, 10, 10, Width);
+        Gorgon::NextFrame();
+    }
+
+    return 0;
+}
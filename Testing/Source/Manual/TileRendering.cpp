@@ -0,0 +1,194 @@
+//Generates a large .tmx map and reports the time spent decoding layer data
+//and the average frame time of the standard tile renderer when drawing the
+//entire map, only the visible tiles and the cached static chunks.
+
+#include <Gorgon/Window.h>
+#include <Gorgon/Main.h>
+#include <Gorgon/Graphics.h>
+#include <Gorgon/Graphics/Layer.h>
+#include <Gorgon/Graphics/Bitmap.h>
+#include <Gorgon/Game/Map/TiledMap.h>
+#include <Gorgon/Game/Renderer/Tiled/Renderer.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Graphics = Gorgon::Graphics;
+namespace Tiled = Gorgon::Game::Map::Tiled;
+
+using Clock = std::chrono::high_resolution_clock;
+
+const int MapSize  = 200;
+const int TileSize = 16;
+const int Layers   = 3;
+const int Tiles    = 64;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+void generate(const std::string &tileset, const std::string &filename) {
+    Graphics::Bitmap bmp({TileSize * 8, TileSize * Tiles / 8}, Graphics::ColorMode::RGBA);
+    bmp.ForAllPixels([&](int x, int y) {
+        int t = x / TileSize + y / TileSize * 8;
+        bmp.SetRGBAAt(x, y, Graphics::RGBA(t * 4, 255 - t * 4, (x + y) % TileSize * 16, 255));
+    });
+    bmp.ExportPNG(tileset);
+
+    std::ofstream out(filename);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<map version=\"1.10\" orientation=\"orthogonal\" width=\"" << MapSize << "\" height=\"" << MapSize
+        << "\" tilewidth=\"" << TileSize << "\" tileheight=\"" << TileSize << "\">\n"
+        << " <tileset firstgid=\"1\" name=\"generated\" tilewidth=\"" << TileSize << "\" tileheight=\"" << TileSize
+        << "\" tilecount=\"" << Tiles << "\" columns=\"8\">\n"
+        << "  <image source=\"" << tileset << "\" width=\"" << TileSize * 8 << "\" height=\"" << TileSize * Tiles / 8 << "\"/>\n"
+        << " </tileset>\n";
+
+    for(int l=0; l<Layers; l++) {
+        out << " <layer id=\"" << l + 1 << "\" name=\"Layer " << l + 1 << "\" width=\"" << MapSize << "\" height=\"" << MapSize << "\">\n"
+            << "  <data encoding=\"csv\">\n";
+
+        for(int y=0; y<MapSize; y++) {
+            for(int x=0; x<MapSize; x++) {
+                //upper layers are sparse
+                int gid = l == 0 || (x * 7 + y * 13 + l) % (l * 4) == 0 ? (x + y * 3 + l) % Tiles + 1 : 0;
+                out << gid;
+
+                if(x != MapSize - 1 || y != MapSize - 1)
+                    out << ",";
+            }
+            out << "\n";
+        }
+
+        out << "</data>\n </layer>\n";
+    }
+
+    out << "</map>\n";
+}
+
+//Parsing as it was done before layer data was cached, used as a reference
+std::vector<int> parsecsv(const std::string &csv) {
+    std::stringstream ss;
+    ss << csv;
+    std::vector<int> ret;
+    for(std::string line; getline(ss, line);) {
+        if(line.empty())
+            continue;
+        std::stringstream cs;
+        cs << line;
+        for(std::string gid; getline(cs, gid, ',');) {
+            ret.push_back(std::stoi(gid));
+        }
+    }
+    return ret;
+}
+
+int main() {
+    Gorgon::Initialize("TileRendering-test");
+
+    Gorgon::Window wind({800, 600}, "tilerenderingtest", true);
+    Graphics::Initialize();
+
+    wind.ClosingEvent.Register([] { exit(0); });
+
+    generate("tilerendering.png", "tilerendering.tmx");
+
+    auto start = Clock::now();
+    Tiled::Map map("tilerendering.tmx");
+    std::cout << "Map loaded and decoded in " << ms(start) << " ms" << std::endl;
+
+    //rebuild the csv strings to measure what every frame used to cost
+    std::vector<std::string> csv;
+    for(const auto &layer : map.GetLayers()) {
+        std::stringstream ss;
+        for(const auto &row : layer.map_data_2d()) {
+            for(auto gid : row)
+                ss << gid << ",";
+            ss << "\n";
+        }
+        csv.push_back(ss.str());
+    }
+
+    const int iterations = 20;
+
+    start = Clock::now();
+    long sum = 0;
+    for(int i=0; i<iterations; i++) {
+        for(const auto &data : csv) {
+            for(auto gid : parsecsv(data))
+                sum += gid;
+        }
+    }
+    std::cout << "Parsing layers every frame: " << ms(start) / iterations << " ms per frame" << std::endl;
+
+    start = Clock::now();
+    for(int i=0; i<iterations; i++) {
+        for(const auto &layer : map.GetLayers()) {
+            for(auto gid : layer.GetTiles())
+                sum -= gid;
+        }
+    }
+    std::cout << "Cached layers:              " << ms(start) / iterations << " ms per frame" << std::endl;
+
+    if(sum != 0)
+        std::cout << "Decoded data does not match!" << std::endl;
+
+    Graphics::Layer l;
+    wind.Add(l);
+
+    Gorgon::Game::Rendering::Tiled::StandardRenderer renderer(l, {map});
+    renderer.Prepare();
+
+    const int frames = 100;
+
+    auto measure = [&](const char *name) {
+        //warm up, shaders are compiled and chunks are drawn on first use
+        l.Clear();
+        renderer.Render(0, 0);
+        Gorgon::NextFrame();
+
+        double rendering = 0;
+
+        auto start = Clock::now();
+        for(int i=0; i<frames; i++) {
+            auto s = Clock::now();
+
+            l.Clear();
+            renderer.Render(-i, -i);
+            rendering += ms(s);
+
+            Gorgon::NextFrame();
+        }
+
+        std::cout << name << ": "
+                  << rendering / frames << " ms in renderer, "
+                  << ms(start) / frames << " ms per frame" << std::endl;
+    };
+
+    std::cout << MapSize << "x" << MapSize << " map, " << Layers << " layers" << std::endl;
+
+    //camera covering the entire map draws every tile
+    renderer.SetCamera({0, 0, MapSize * TileSize, MapSize * TileSize});
+    measure("Entire map      ");
+
+    renderer.ResetCamera();
+    measure("Visible tiles   ");
+
+    for(const auto &layer : map.GetLayers())
+        renderer.SetStaticLayer(layer.id);
+    measure("Static chunks   ");
+
+    //changing a tile redraws only the chunk that contains it
+    renderer.SetTile(1, 10, 10, 1);
+    measure("After tile edit ");
+
+    while(true) {
+        l.Clear();
+        renderer.Render(0, 0);
+        Gorgon::NextFrame();
+    }
+
+    return 0;
+}
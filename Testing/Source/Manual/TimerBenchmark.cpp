@@ -0,0 +1,140 @@
+//Runs 100k active timers through the timer wheel that is used for timeouts and intervals and
+//through the map based scheduler it replaced, which walks every timer on every frame. Reports
+//the time spent per frame. Does not require a window.
+
+#include <Gorgon/Utils/TimerWheel.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <tuple>
+
+using Clock = std::chrono::high_resolution_clock;
+
+double ms(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+}
+
+const int timercount = 100000;
+const int intervalcount = 1000;
+const int frames = 3000;
+const unsigned long frametime = 16;
+
+//The previous implementation of timeouts and intervals
+struct MapScheduler {
+    size_t timeind = 0;
+    std::map<size_t, std::pair<unsigned long, std::function<void()>>> timeouts;
+    std::map<size_t, std::tuple<unsigned long, unsigned long, std::function<void()>>> intervals;
+
+    size_t Timeout(unsigned long after, std::function<void()> fn) {
+        timeouts.insert({timeind, {after, fn}});
+        return timeind++;
+    }
+
+    size_t Interval(unsigned long after, std::function<void()> fn) {
+        intervals.insert({timeind, std::make_tuple(after, after, fn)});
+        return timeind++;
+    }
+
+    void Tick(unsigned long deltatime) {
+        for(auto &p : timeouts) {
+            if(p.second.first <= deltatime) {
+                p.second.first = 0;
+                p.second.second();
+            }
+            else {
+                p.second.first -= deltatime;
+            }
+        }
+
+        for(auto it=timeouts.begin(); it != timeouts.end(); ) {
+            if(it->second.first == 0 || it->second.first == -1)
+                it = timeouts.erase(it);
+            else
+                ++it;
+        }
+
+        for(auto &p : intervals) {
+            if(std::get<0>(p.second) <= deltatime) {
+                std::get<0>(p.second) = std::get<1>(p.second) + std::get<0>(p.second) - deltatime;
+                std::get<2>(p.second)();
+            }
+            else {
+                std::get<0>(p.second) -= deltatime;
+            }
+        }
+    }
+};
+
+struct WheelScheduler {
+    Gorgon::Utils::TimerWheel wheel;
+
+    size_t Timeout(unsigned long after, std::function<void()> fn) {
+        return wheel.Add(wheel.GetTime() + after, std::move(fn));
+    }
+
+    size_t Interval(unsigned long after, std::function<void()> fn) {
+        return wheel.Add(wheel.GetTime() + after, std::move(fn), after);
+    }
+
+    void Tick(unsigned long deltatime) {
+        wheel.Advance(wheel.GetTime() + deltatime);
+    }
+};
+
+//Gameplay timers between 1 and 60 seconds, every timer that fires registers a new one to
+//keep the number of active timers constant.
+template<class S_>
+void run(const char *name) {
+    S_ scheduler;
+
+    std::mt19937 random(1);
+    std::uniform_int_distribution<unsigned long> after(1000, 60000);
+
+    long fired = 0;
+
+    std::function<void()> refire = [&] {
+        fired++;
+        scheduler.Timeout(after(random), refire);
+    };
+
+    auto start = Clock::now();
+
+    for(int i=0; i<timercount; i++)
+        scheduler.Timeout(after(random), refire);
+
+    for(int i=0; i<intervalcount; i++)
+        scheduler.Interval(100 + i % 900, [&] { fired++; });
+
+    double registration = ms(start);
+
+    double total = 0, worst = 0;
+
+    for(int f=0; f<frames; f++) {
+        auto start = Clock::now();
+
+        scheduler.Tick(frametime);
+
+        double elapsed = ms(start);
+
+        total += elapsed;
+        worst  = std::max(worst, elapsed);
+    }
+
+    std::cout << "  " << name << ": registration " << registration << " ms, per frame "
+              << total / frames << " ms average, " << worst << " ms worst, "
+              << fired << " calls" << std::endl;
+}
+
+int main() {
+    std::cout << timercount << " timeouts and " << intervalcount << " intervals, "
+              << frames << " frames of " << frametime << "ms:" << std::endl;
+
+    run<MapScheduler>("map        ");
+    run<WheelScheduler>("timer wheel");
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#define CATCH_CONFIG_MAIN
+
+#define WINDOWS_LEAN_AND_MEAN
+
+#include <catch.h>
+
+#include <Gorgon/Graphics/Atlas.h>
+
+#include <vector>
+
+using namespace Gorgon;
+using Gorgon::Graphics::AtlasPacker;
+
+static bool overlaps(const Geometry::Bounds &l, const Geometry::Bounds &r) {
+	return l.Left < r.Right && r.Left < l.Right && l.Top < r.Bottom && r.Top < l.Bottom;
+}
+
+static bool valid(const AtlasPacker &packer, const std::vector<Geometry::Bounds> &placed) {
+	for(unsigned i=0; i<placed.size(); i++) {
+		auto &b = placed[i];
+
+		if(b.Left < 0 || b.Top < 0 || b.Right > packer.GetSize().Width || b.Bottom > packer.GetSize().Height)
+			return false;
+
+		for(unsigned j=i+1; j<placed.size(); j++)
+			if(overlaps(b, placed[j]))
+				return false;
+	}
+
+	return true;
+}
+
+TEST_CASE("Atlas placement", "[Atlas]") {
+	AtlasPacker packer({100, 100});
+	Geometry::Bounds location;
+
+	REQUIRE(packer.Place({60, 60}, location));
+	REQUIRE(location == Geometry::Bounds(0, 0, 60, 60));
+
+	//right strip leaves 2px along the short side, bottom strip leaves 30px
+	REQUIRE(packer.Place({38, 10}, location));
+	REQUIRE(location == Geometry::Bounds(60, 0, 98, 10));
+
+	REQUIRE(packer.Place({95, 39}, location));
+	REQUIRE(location == Geometry::Bounds(0, 60, 95, 99));
+
+	REQUIRE(packer.GetUsedArea() == 60*60 + 38*10 + 95*39);
+	REQUIRE(packer.GetExtent() == Geometry::Size(98, 99));
+
+	//same sized rectangles fill the area completely
+	AtlasPacker grid({100, 100});
+	std::vector<Geometry::Bounds> placed;
+
+	for(int i=0; i<25; i++) {
+		REQUIRE(grid.Place({20, 20}, location));
+		REQUIRE(location.GetSize() == Geometry::Size(20, 20));
+
+		placed.push_back(location);
+	}
+
+	REQUIRE(valid(grid, placed));
+	REQUIRE(grid.GetOccupancy() == 1.f);
+	REQUIRE(grid.GetExtent() == Geometry::Size(100, 100));
+}
+
+TEST_CASE("Atlas overflow", "[Atlas]") {
+	AtlasPacker packer({64, 32});
+	Geometry::Bounds location = {1, 2, 3, 4};
+
+	//larger than the page
+	REQUIRE_FALSE(packer.Place({65, 1}, location));
+	REQUIRE_FALSE(packer.Place({1, 33}, location));
+	REQUIRE(location == Geometry::Bounds(1, 2, 3, 4));
+
+	REQUIRE(packer.Place({64, 32}, location));
+	REQUIRE_FALSE(packer.Place({1, 1}, location));
+
+	//page full of mixed sizes
+	packer.Reset();
+	std::vector<Geometry::Bounds> placed;
+
+	while(packer.Place({int(placed.size()%3)*4 + 5, 7}, location))
+		placed.push_back(location);
+
+	REQUIRE(placed.size() > 20);
+	REQUIRE(valid(packer, placed));
+	REQUIRE(packer.GetOccupancy() > 0.5f);
+	REQUIRE(packer.GetOccupancy() <= 1.f);
+
+	//the manager refuses images that do not fit a page with margins
+	Graphics::AtlasManager atlas({64, 64}, 2);
+
+	REQUIRE(atlas.CanPlace({60, 60}));
+	REQUIRE_FALSE(atlas.CanPlace({61, 60}));
+	REQUIRE(atlas.GetPageCount() == 0);
+}
+
+TEST_CASE("Atlas freeing", "[Atlas]") {
+	AtlasPacker packer({100, 100});
+	std::vector<Geometry::Bounds> placed;
+	Geometry::Bounds location;
+
+	for(int i=0; i<100; i++) {
+		REQUIRE(packer.Place({10, 10}, location));
+		placed.push_back(location);
+	}
+
+	REQUIRE_FALSE(packer.Place({10, 10}, location));
+
+	//freed area is reused
+	packer.Free(placed[42]);
+	REQUIRE(packer.GetUsedArea() == 99*100);
+	REQUIRE_FALSE(packer.Place({11, 10}, location));
+	REQUIRE(packer.Place({10, 10}, location));
+	REQUIRE(location == placed[42]);
+
+	//adjacent freed areas are merged
+	Geometry::Bounds first, second;
+	for(auto &b : placed) {
+		if(b.TopLeft() == Geometry::Point(0, 0))
+			first = b;
+		else if(b.TopLeft() == Geometry::Point(10, 0))
+			second = b;
+	}
+
+	packer.Free(first);
+	packer.Free(second);
+
+	REQUIRE(packer.Place({20, 10}, location));
+	REQUIRE(location == Geometry::Bounds(0, 0, 20, 10));
+
+	//freeing everything empties the packer
+	packer.Free(location);
+	for(auto &b : placed) {
+		if(b != first && b != second)
+			packer.Free(b);
+	}
+
+	REQUIRE(packer.GetUsedArea() == 0);
+	REQUIRE(packer.Place({100, 100}, location));
+}
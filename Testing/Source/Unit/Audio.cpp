@@ -0,0 +1,216 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.h>
+
+#include <Gorgon/Audio/Offline.h>
+#include <Gorgon/Audio/Controllers.h>
+#include <Gorgon/Multimedia/Wave.h>
+
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <thread>
+
+using namespace Gorgon;
+
+using Audio::Channel;
+
+//a ramp makes the interpolated values easy to predict
+Multimedia::Wave *ramp(unsigned long size, unsigned rate, std::vector<Channel> channels = {Channel::Mono}) {
+    auto wave = new Containers::Wave(size, rate, channels);
+
+    for(unsigned long i=0; i<size; i++)
+        for(unsigned c=0; c<channels.size(); c++)
+            (*wave)(i, c) = (c + 1) * float(i) / size;
+
+    return new Multimedia::Wave(*wave, true);
+}
+
+TEST_CASE("Offline rendering of a mono wave", "[Audio]") {
+    std::unique_ptr<Multimedia::Wave> wave(ramp(1000, 48000));
+
+    Audio::OfflineRenderer renderer(48000, Audio::StandardChannels(2), false, 256);
+    Audio::BasicController controller(*wave);
+
+    controller.SetVolume(0.5f);
+    controller.Play();
+
+    auto out = renderer.Render(1200.f / 48000);
+
+    REQUIRE(out.GetSize() == 1200);
+    REQUIRE(out.GetChannelCount() == 2);
+    REQUIRE(out.GetSampleRate() == 48000);
+
+    //mono is distributed to all channels, playback stops at the end
+    for(unsigned long i=0; i<1200; i++) {
+        float expected = i < 1000 ? 0.5f * i / 1000 : 0;
+
+        REQUIRE(std::abs(out(i, 0) - expected) < 1e-6);
+        REQUIRE(std::abs(out(i, 1) - expected) < 1e-6);
+    }
+
+    REQUIRE_FALSE(controller.IsPlaying());
+}
+
+TEST_CASE("Offline rendering loops and resamples", "[Audio]") {
+    std::unique_ptr<Multimedia::Wave> wave(ramp(300, 24000, {Channel::FrontLeft, Channel::FrontRight}));
+
+    Audio::OfflineRenderer renderer(48000, Audio::StandardChannels(2), false, 100);
+    Audio::BasicController controller(*wave);
+
+    controller.Loop();
+
+    Containers::Wave out;
+    renderer.Render(out, 1500);
+
+    //two output samples for every source sample, last sample is interpolated towards the first
+    for(unsigned long i=0; i<1500; i++) {
+        unsigned long x = (i / 2) % 300;
+        float f = (i % 2) * 0.5f;
+
+        float next = x + 1 < 300 ? (x + 1) / 300.f : 0;
+        float expected = (1 - f) * x / 300.f + f * next;
+
+        REQUIRE(std::abs(out(i, 0) - expected) < 1e-5);
+        REQUIRE(std::abs(out(i, 1) - (2 * expected)) < 1e-5);
+    }
+
+    REQUIRE(controller.IsPlaying());
+    REQUIRE(renderer.GetRenderedSamples() == 1500);
+}
+
+TEST_CASE("Offline rendering of positional sources", "[Audio]") {
+    std::unique_ptr<Multimedia::Wave> wave(ramp(4800, 48000));
+
+    Audio::OfflineRenderer renderer(48000, Audio::StandardChannels(2));
+    Audio::PositionalController left(*wave), right(*wave);
+
+    left.Move(Geometry::Point3D{-2, 1, 0});
+    right.Move(Geometry::Point3D{2, 1, 0});
+
+    left.Loop();
+
+    auto l = renderer.Render(0.05f);
+
+    left.Pause();
+    right.Loop();
+    right.Reset();
+
+    auto r = renderer.Render(0.05f);
+
+    //mirrored sources should give mirrored channels
+    float leftsum = 0, rightsum = 0;
+    for(unsigned long i=0; i<l.GetSize(); i++) {
+        REQUIRE(std::abs(l(i, 0) - r(i, 1)) < 1e-5);
+        REQUIRE(std::abs(l(i, 1) - r(i, 0)) < 1e-5);
+
+        leftsum  += l(i, 0);
+        rightsum += l(i, 1);
+    }
+
+    REQUIRE(leftsum > rightsum);
+}
+
+TEST_CASE("Offline rendering to WAV", "[Audio]") {
+    std::unique_ptr<Multimedia::Wave> wave(ramp(480, 48000));
+
+    Audio::OfflineRenderer renderer(48000, {Channel::Mono});
+    Audio::BasicController controller(*wave);
+
+    controller.Play();
+
+    std::stringstream file;
+    REQUIRE(renderer.Render(0.01f).ExportWav(file, 16));
+
+    file.seekg(0);
+
+    Containers::Wave imported;
+    REQUIRE(imported.ImportWav(file));
+
+    REQUIRE(imported.GetSize() == 480);
+    REQUIRE(imported.GetSampleRate() == 48000);
+
+    for(unsigned long i=0; i<479; i++)
+        REQUIRE(std::abs(imported(i, 0) - (i / 480.f)) < 1.f / 16384);
+}
+
+TEST_CASE("Gain changes are ramped", "[Audio]") {
+    auto data = new Containers::Wave(4800, 48000, {Channel::Mono});
+    for(unsigned long i=0; i<data->GetSize(); i++)
+        (*data)(i, 0) = 1;
+
+    Multimedia::Wave wave(*data, true);
+
+    Audio::OfflineRenderer renderer(48000, Audio::StandardChannels(2), false, 100);
+    Audio::BasicController controller(wave);
+
+    controller.Loop();
+
+    auto before = renderer.Render(100.f / 48000);
+
+    controller.SetVolume(0.f);
+
+    auto after = renderer.Render(200.f / 48000);
+
+    REQUIRE(std::abs(before(99, 0) - 1) < 1e-6);
+
+    //volume goes down linearly in the first block, then stays at 0
+    for(unsigned long i=0; i<100; i++)
+        REQUIRE(std::abs(after(i, 0) - (1 - i / 100.f)) < 1e-5);
+
+    for(unsigned long i=100; i<200; i++)
+        REQUIRE(after(i, 0) == 0);
+}
+
+TEST_CASE("Controller data changes while mixing", "[Audio]") {
+    std::unique_ptr<Multimedia::Wave> mono(ramp(4800, 48000));
+    std::unique_ptr<Multimedia::Wave> surround(ramp(4800, 44100, Audio::StandardChannels(6)));
+
+    Audio::OfflineRenderer renderer(48000, Audio::StandardChannels(2), false, 64);
+    Audio::BasicController basic(*mono);
+    Audio::PositionalController positional(*surround);
+
+    basic.Loop();
+    positional.Loop();
+
+    //mixer keeps using the published sources until it receives the new list
+    std::atomic<bool> done(false);
+    std::atomic<int>  blocks(0);
+    std::thread mixing([&] {
+        while(!done) {
+            renderer.Advance(640);
+            blocks++;
+        }
+    });
+
+    for(int i=0; i<2000 || blocks<500; i++) {
+        switch(i % 3) {
+        case 0:
+            basic.SetData(*surround);
+            positional.ReleaseData();
+            break;
+        case 1:
+            basic.ReleaseData();
+            positional.SetData(*mono);
+            break;
+        default:
+            basic.SetData(*mono);
+            positional.SetData(*surround);
+            break;
+        }
+
+        basic.Loop();
+        positional.Loop();
+    }
+
+    done = true;
+    mixing.join();
+
+    positional.ReleaseData();
+    basic.SetData(*mono);
+    basic.Reset();
+
+    auto out = renderer.Render(100.f / 48000);
+
+    for(unsigned long i=0; i<100; i++)
+        REQUIRE(std::abs(out(i, 0) - i / 4800.f) < 1e-6);
+}
@@ -0,0 +1,258 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.h>
+
+#include <Gorgon/CGI/Polygon.h>
+#include <Gorgon/CGI/RenderList.h>
+
+#include <cmath>
+#include <random>
+
+using namespace Gorgon;
+
+using Geometry::Pointf;
+using Geometry::PointList;
+
+const int A = CGI::AnalyticCoverage;
+
+Containers::Image transparent(int w, int h) {
+    Containers::Image img({w, h}, Graphics::ColorMode::RGBA);
+    img.Clear();
+
+    return img;
+}
+
+float alpha(const Containers::Image &img, int x, int y) {
+    return img.GetRGBAAt(x, y).A / 255.f;
+}
+
+TEST_CASE("Analytic coverage of a rectangle", "[CGI]") {
+    auto img = transparent(10, 10);
+
+    CGI::Polyfill<A>(img, PointList<>{{2.25f, 1.5f}, {7.75f, 1.5f}, {7.75f, 6}, {2.25f, 6}}, CGI::SolidFill<>(Graphics::Color::White));
+
+    for(int y=0; y<10; y++) {
+        float cy = y == 1 ? 0.5f : (y >= 2 && y < 6 ? 1.f : 0.f);
+
+        for(int x=0; x<10; x++) {
+            float cx = (x == 2 || x == 7) ? 0.75f : (x > 2 && x < 7 ? 1.f : 0.f);
+
+            REQUIRE(std::abs(alpha(img, x, y) - cx * cy) < 1.5f / 255);
+        }
+    }
+}
+
+TEST_CASE("Analytic coverage adds up to the area", "[CGI]") {
+    auto img = transparent(64, 64);
+
+    //a convex polygon, coverage is below 1 only on the edges, thus blending does not lose area
+    PointList<> circle;
+    for(int i=0; i<37; i++) {
+        float ang = i * 2 * PI / 37;
+        circle.Push({32.3f + 25.1f * std::cos(ang), 31.8f + 25.1f * std::sin(ang)});
+    }
+
+    float area = 0;
+    for(int i=0; i<(int)circle.GetSize(); i++) {
+        auto l = circle.GetLine(i);
+        area += (l.Start.X * l.End.Y - l.End.X * l.Start.Y) / 2;
+    }
+
+    CGI::Polyfill<A>(img, circle, CGI::SolidFill<>(Graphics::Color::White));
+
+    float total = 0;
+    for(int y=0; y<64; y++)
+        for(int x=0; x<64; x++)
+            total += alpha(img, x, y);
+
+    //each edge pixel can lose up to 1/255 due to truncation
+    REQUIRE(std::abs(total - std::abs(area)) < 2 * PI * 26 / 255);
+}
+
+TEST_CASE("Analytic coverage winding rules", "[CGI]") {
+    //two squares in the same direction overlapping in the middle
+    std::vector<PointList<>> squares;
+    squares.push_back({{0, 0}, {6, 0}, {6, 6}, {0, 6}});
+    squares.push_back({{3, 3}, {9, 3}, {9, 9}, {3, 9}});
+
+    auto nonzero = transparent(10, 10);
+    CGI::Polyfill<A, 0>(nonzero, squares, CGI::SolidFill<>(Graphics::Color::White));
+
+    auto odd = transparent(10, 10);
+    CGI::Polyfill<A, 1>(odd, squares, CGI::SolidFill<>(Graphics::Color::White));
+
+    auto perpath = transparent(10, 10);
+    CGI::Polyfill<A, 2>(perpath, squares, CGI::SolidFill<>(Graphics::Color::White));
+
+    REQUIRE(alpha(nonzero, 4, 4) == 1);
+    REQUIRE(alpha(odd, 4, 4) == 0);
+    REQUIRE(alpha(perpath, 4, 4) == 0);
+
+    REQUIRE(alpha(nonzero, 1, 1) == 1);
+    REQUIRE(alpha(odd, 1, 1) == 1);
+    REQUIRE(alpha(perpath, 7, 7) == 1);
+
+    //a path that overlaps itself is non-zero within the path for rule 2
+    std::vector<PointList<>> twice;
+    twice.push_back({{0, 0}, {6, 0}, {6, 6}, {0, 6}, {0, 0}, {6, 0}, {6, 6}, {0, 6}});
+
+    auto self = transparent(10, 10);
+    CGI::Polyfill<A, 2>(self, twice, CGI::SolidFill<>(Graphics::Color::White));
+
+    REQUIRE(alpha(self, 3, 3) == 1);
+}
+
+TEST_CASE("Analytic coverage is clipped", "[CGI]") {
+    auto img = transparent(8, 8);
+
+    CGI::Polyfill<A>(img, PointList<>{{-5.5f, -3}, {4.5f, -3}, {4.5f, 20}, {-5.5f, 20}}, CGI::SolidFill<>(Graphics::Color::White));
+
+    //a slanted edge that leaves the image from the right
+    CGI::Polyfill<A>(img, PointList<>{{6, -3}, {30, -3}, {30, 20}, {7, 20}}, CGI::SolidFill<>(Graphics::Color::White));
+
+    for(int y=0; y<8; y++) {
+        for(int x=0; x<4; x++)
+            REQUIRE(alpha(img, x, y) == 1);
+
+        REQUIRE(std::abs(alpha(img, 4, y) - 0.5f) < 1.5f / 255);
+        REQUIRE(alpha(img, 5, y) == 0);
+
+        REQUIRE(alpha(img, 7, y) == 1);
+    }
+}
+
+TEST_CASE("Analytic circles", "[CGI]") {
+    auto img = transparent(64, 64);
+
+    auto total = [&] {
+        float sum = 0;
+        for(int y=0; y<64; y++)
+            for(int x=0; x<64; x++)
+                sum += alpha(img, x, y);
+
+        return sum;
+    };
+
+    CGI::Circle<A>(img, Pointf{32.4f, 31.7f}, 20.3f, CGI::SolidFill<>(Graphics::Color::White));
+
+    REQUIRE(std::abs(total() - PI * 20.3f * 20.3f) < 2);
+    REQUIRE(alpha(img, 32, 31) == 1.f);
+    REQUIRE(alpha(img, 12, 31) > 0.f);
+    REQUIRE(alpha(img, 12, 31) < 1.f);
+    REQUIRE(alpha(img, 3, 3) == 0.f);
+
+    //ring leaves the inside empty
+    img.Clear();
+    CGI::Circle<A>(img, Pointf{32.4f, 31.7f}, 15.f, 4.f, CGI::SolidFill<>(Graphics::Color::White));
+
+    REQUIRE(std::abs(total() - PI * (19.f * 19.f - 15.f * 15.f)) < 3);
+    REQUIRE(alpha(img, 32, 31) == 0.f);
+    REQUIRE(alpha(img, 32, 48) == 1.f);
+
+    //fills receive the location relative to the center as in other modes
+    float error = 0;
+    int count = 0;
+    CGI::Circle<A>(img, Pointf{32.4f, 31.7f}, 10.f, [&](Pointf rel, Geometry::Point p, Graphics::RGBA underlying, float a) {
+        error = std::max(error, std::abs(rel.X - (p.X + 0.5f - 32.4f)) + std::abs(rel.Y - (p.Y + 0.5f - 31.7f)));
+        count++;
+
+        underlying.Blend(Graphics::Color::White, a);
+        return underlying;
+    });
+
+    REQUIRE(count > 300);
+    REQUIRE(error < 1e-4f);
+}
+
+TEST_CASE("Solid fill spans blend as RGBA::Blend", "[CGI]") {
+    std::mt19937 random(7);
+
+    for(auto mode : {Graphics::ColorMode::RGBA, Graphics::ColorMode::BGRA}) {
+        Containers::Image fast({50, 50}, mode), reference({50, 50}, mode);
+
+        for(int y=0; y<50; y++) {
+            for(int x=0; x<50; x++) {
+                Graphics::RGBA col = {Byte(random()), Byte(random()), Byte(random()), Byte(random() % 4 ? random() : 0)};
+
+                fast.SetRGBAAt(x, y, col);
+                reference.SetRGBAAt(x, y, col);
+            }
+        }
+
+        PointList<> star;
+        for(int i=0; i<11; i++) {
+            float ang = i * 4 * PI / 11;
+            star.Push({25 + 23.7f * std::cos(ang), 25.2f + 23.3f * std::sin(ang)});
+        }
+
+        Graphics::RGBA color(200, 100, 50, 180);
+
+        CGI::Polyfill<A>(fast, star, CGI::SolidFill<>(color));
+
+        //a fill that is not SolidFill uses the per pixel path
+        CGI::Polyfill<A>(reference, star, [&](Pointf, Geometry::Point, Graphics::RGBA underlying, float a) {
+            underlying.Blend(color, a);
+            return underlying;
+        });
+
+        for(int y=0; y<50; y++)
+            for(int x=0; x<50; x++)
+                REQUIRE(fast.GetRGBAAt(x, y) == reference.GetRGBAAt(x, y));
+    }
+}
+
+TEST_CASE("Render list draws as direct drawing", "[CGI]") {
+    auto direct = transparent(200, 150), tiled = transparent(200, 150);
+
+    std::vector<PointList<>> shapes;
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> dist(-20, 220);
+
+    for(int i=0; i<20; i++) {
+        PointList<> p;
+
+        for(int j=0; j<5; j++)
+            p.Push({dist(random), dist(random) * 0.75f});
+
+        shapes.push_back(std::move(p));
+    }
+
+    CGI::RenderList list(32);
+
+    for(int i=0; i<(int)shapes.size(); i++) {
+        Graphics::RGBA color(Byte(50 * i), 200, Byte(255 - 10 * i), 160);
+
+        if(i % 2) {
+            CGI::Polyfill<A>(direct, shapes[i], CGI::SolidFill<>(color));
+            list.Polyfill<A>(shapes[i], CGI::SolidFill<>(color));
+        }
+        else {
+            CGI::DrawLines<A>(direct, shapes[i], 3.f, CGI::SolidFill<>(color));
+            list.DrawLines<A>(shapes[i], 3.f, CGI::SolidFill<>(color));
+        }
+    }
+
+    //absolute coordinates passed to the fill should not depend on the tile
+    auto checker = [](Pointf, Geometry::Point p, Graphics::RGBA underlying, float a) {
+        underlying.Blend(((p.X / 8 + p.Y / 8) % 2) ? Graphics::Color::Red : Graphics::Color::Blue, a);
+
+        return underlying;
+    };
+
+    CGI::Circle<A>(direct, Pointf{100.5f, 70.25f}, 40.f, 5.f, checker);
+    list.Circle<A>(Pointf{100.5f, 70.25f}, 40.f, 5.f, checker);
+
+    REQUIRE(list.GetSize() == 21);
+
+    list.Render(tiled, 3);
+
+    for(int y=0; y<150; y++) {
+        for(int x=0; x<200; x++) {
+            auto a = direct.GetRGBAAt(x, y), b = tiled.GetRGBAAt(x, y);
+
+            REQUIRE(std::abs(a.R - b.R) <= 1);
+            REQUIRE(std::abs(a.G - b.G) <= 1);
+            REQUIRE(std::abs(a.B - b.B) <= 1);
+            REQUIRE(std::abs(a.A - b.A) <= 1);
+        }
+    }
+}
@@ -523,3 +523,49 @@ TEST_CASE( "Load - PathNotFoundError", "[Load][PathNotFoundError") {
 }
 
 
+
+TEST_CASE( "MappedFile - Mapping binary file", "[Save][MappedFile]") {	
+	std::string teststring="This is a test\n";
+	teststring.push_back(0);
+	teststring.push_back('x');
+	fs::Save("test.bin", teststring);	
+	
+	fs::MappedFile file("test.bin");
+	
+	REQUIRE( file.IsOpen() );
+	REQUIRE( file.GetSize() == teststring.size() );
+	REQUIRE( std::string(file.GetData(), (size_t)file.GetSize()) == teststring );
+	
+	fs::MappedFile moved = std::move(file);
+	
+	REQUIRE_FALSE( file.IsOpen() );
+	REQUIRE( moved.IsOpen() );
+	REQUIRE( moved.GetData()[16] == 'x' );
+	
+	moved.Close();
+	
+	REQUIRE_FALSE( moved.IsOpen() );
+	REQUIRE( moved.GetData() == nullptr );
+	
+	remove("test.bin");
+}
+
+TEST_CASE( "MappedFile - Empty file", "[Save][MappedFile]") {	
+	fs::Save("test.bin", "");	
+	
+	fs::MappedFile file("test.bin");
+	
+	REQUIRE( file.IsOpen() );
+	REQUIRE( file.GetSize() == 0 );
+	
+	file.Close();
+	
+	remove("test.bin");
+}
+
+TEST_CASE( "MappedFile - PathNotFoundError", "[MappedFile][PathNotFoundError]") {	
+	REQUIRE_THROWS_AS( 
+		fs::MappedFile("thisfiledoesnotexists/iamsureofit.neverever"), 
+		fs::PathNotFoundError 
+	);
+}
@@ -0,0 +1,93 @@
+#define CATCH_CONFIG_MAIN
+
+#define WINDOWS_LEAN_AND_MEAN
+
+#include <catch.h>
+
+#include <Gorgon/Time.h>
+#include <Gorgon/Time/FramePacer.h>
+
+using namespace Gorgon::Time;
+
+TEST_CASE("Precise time", "[FramePacer]") {
+	auto start = GetPreciseTime();
+	auto ms    = GetTime();
+
+	REQUIRE(ms >= start / 1000);
+
+	auto prev = start;
+	for(int i=0; i<1000; i++) {
+		auto t = GetPreciseTime();
+
+		REQUIRE(t >= prev);
+
+		prev = t;
+	}
+}
+
+TEST_CASE("Frame pacing", "[FramePacer]") {
+	FramePacer pacer(200);
+
+	REQUIRE(pacer.GetFrameDuration() == 5000);
+	REQUIRE(pacer.GetTargetRate() == 200);
+
+	//first wait starts the schedule
+	pacer.Wait();
+	auto start = GetPreciseTime();
+
+	for(int i=0; i<10; i++)
+		pacer.Wait();
+
+	auto elapsed = GetPreciseTime() - start;
+	REQUIRE(elapsed >= 10 * 5000);
+
+	//missing a frame restarts the schedule
+	auto late = GetPreciseTime();
+	while(GetPreciseTime() - late < 12000)
+		;
+
+	late = GetPreciseTime();
+	pacer.Wait();
+
+	elapsed = GetPreciseTime() - late;
+	REQUIRE(elapsed < 5000);
+
+	FramePacer unlimited(0);
+	unlimited.Wait();
+	unlimited.Wait();
+	REQUIRE(unlimited.GetTargetRate() == 0);
+}
+
+TEST_CASE("Fixed step accumulator", "[FramePacer]") {
+	FramePacer pacer;
+
+	REQUIRE_FALSE(pacer.Step());
+
+	pacer.SetFixedStep(10000);
+
+	pacer.Accumulate(25000);
+
+	int steps = 0;
+	while(pacer.Step())
+		steps++;
+
+	REQUIRE(steps == 2);
+	REQUIRE(pacer.GetAlpha() == Approx(0.5));
+
+	pacer.Accumulate(4000);
+	REQUIRE_FALSE(pacer.Step());
+	REQUIRE(pacer.GetAlpha() == Approx(0.9));
+
+	pacer.Accumulate(1000);
+	REQUIRE(pacer.Step());
+	REQUIRE(pacer.GetAlpha() == 0);
+
+	//a long frame is limited to the maximum number of steps
+	pacer.Accumulate(1000000);
+
+	steps = 0;
+	while(pacer.Step())
+		steps++;
+
+	REQUIRE(steps == (int)pacer.GetMaximumSteps());
+}
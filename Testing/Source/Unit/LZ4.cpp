@@ -0,0 +1,84 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.h>
+
+#include <Gorgon/Encoding/LZ4.h>
+
+#include <random>
+#include <stdexcept>
+
+using namespace Gorgon;
+
+std::vector<Byte> generate(std::size_t size, int period) {
+    std::mt19937 random(size);
+    std::vector<Byte> data(size);
+
+    //repeats with occasional noise, period 0 is random
+    for(std::size_t i=0; i<size; i++) {
+        if(period == 0 || i < (std::size_t)period || random() % 16 == 0)
+            data[i] = Byte(random());
+        else
+            data[i] = data[i - period];
+    }
+
+    return data;
+}
+
+TEST_CASE("LZ4 round trip", "[LZ4]") {
+    for(int period : {0, 1, 3, 8, 100, 40000}) {
+        for(std::size_t size : {0, 1, 5, 12, 13, 16, 100, 1000, 65536, 200000}) {
+            auto data = generate(size, period);
+
+            std::vector<Byte> encoded;
+            Encoding::Lz4.Encode(data, encoded);
+
+            REQUIRE(encoded.size() <= Encoding::LZ4::MaximumEncodedSize(size));
+
+            std::vector<Byte> decoded(size);
+            Encoding::Lz4.Decode(encoded.data(), encoded.size(), decoded.data(), size);
+
+            REQUIRE(decoded == data);
+        }
+    }
+}
+
+TEST_CASE("LZ4 compresses repeating data", "[LZ4]") {
+    std::vector<Byte> data(100000, 42);
+
+    std::vector<Byte> encoded;
+    Encoding::Lz4.Encode(data, encoded);
+
+    REQUIRE(encoded.size() < 1000);
+}
+
+TEST_CASE("LZ4 appends to output", "[LZ4]") {
+    auto data = generate(5000, 7);
+
+    std::vector<Byte> encoded = {1, 2, 3};
+    Encoding::Lz4.Encode(data, encoded);
+
+    REQUIRE(encoded[0] == 1);
+
+    std::vector<Byte> decoded(data.size());
+    Encoding::Lz4.Decode(encoded.data() + 3, encoded.size() - 3, decoded.data(), decoded.size());
+
+    REQUIRE(decoded == data);
+}
+
+TEST_CASE("LZ4 rejects invalid data", "[LZ4]") {
+    auto data = generate(10000, 5);
+
+    std::vector<Byte> encoded;
+    Encoding::Lz4.Encode(data, encoded);
+
+    std::vector<Byte> decoded(data.size());
+
+    //wrong size
+    REQUIRE_THROWS_AS(Encoding::Lz4.Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size() - 1), std::runtime_error);
+
+    //truncated
+    REQUIRE_THROWS_AS(Encoding::Lz4.Decode(encoded.data(), encoded.size() / 2, decoded.data(), decoded.size()), std::runtime_error);
+
+    //offset before the start of the output
+    std::vector<Byte> invalid = {0x10, 'a', 0x05, 0x00, 0x00};
+    REQUIRE_THROWS_AS(Encoding::Lz4.Decode(invalid.data(), invalid.size(), decoded.data(), 10), std::runtime_error);
+}
@@ -0,0 +1,163 @@
+#define CATCH_CONFIG_MAIN
+
+#define WINDOWS_LEAN_AND_MEAN
+
+#include <catch.h>
+
+#include <Gorgon/Game/ObjectFinding/FindObject.h>
+#include <Gorgon/Game/ObjectFinding/ObjectIndex.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Gorgon;
+using namespace Gorgon::Game::ObjectFinding::Tiled;
+using Gorgon::Game::Map::Tiled::Object;
+
+static Object makeobject(int id, int gid, float x, float y, int width, int height, std::string name = "", std::string type = "") {
+	Object o;
+	o.id = id;
+	o.gid = gid;
+	o.x = x;
+	o.y = y;
+	o.width = width;
+	o.height = height;
+	o.name = name;
+	o.type = type;
+
+	return o;
+}
+
+static std::vector<int> ids(const std::vector<Object> &objects, std::vector<size_t> indices) {
+	std::vector<int> ret;
+
+	for(auto i : indices)
+		ret.push_back(objects[i].id);
+
+	std::sort(ret.begin(), ret.end());
+
+	return ret;
+}
+
+static std::vector<int> ids(const std::vector<Object> &objects) {
+	std::vector<int> ret;
+
+	for(auto &o : objects)
+		ret.push_back(o.id);
+
+	std::sort(ret.begin(), ret.end());
+
+	return ret;
+}
+
+static std::vector<Object> testobjects() {
+	return {
+		makeobject(1, 0, 10, 10, 20, 20, "door", "trigger"),
+		makeobject(2, 3, 100, 132, 32, 32, "chest", "item"),
+		makeobject(3, 3, 300, 64, 32, 32, "", "item"),
+		makeobject(4, 0, -50, -50, 400, 10, "wall", "solid"),
+		makeobject(5, 7, 500.5f, 500, 16, 16, "coin", "item"),
+	};
+}
+
+TEST_CASE("Object index bounds", "[ObjectIndex]") {
+	auto objects = testobjects();
+	ObjectIndex index(objects, 32);
+
+	//tile objects are anchored at their bottom left
+	REQUIRE(ObjectIndex::GetBounds(objects[1]) == Geometry::Bounds(100, 100, 132, 132));
+	REQUIRE(ObjectIndex::GetBounds(objects[0]) == Geometry::Bounds(10, 10, 30, 30));
+
+	//position search matches the linear search
+	FindObject finder;
+	for(auto area : {Geometry::Bounds(0, 0, 200, 200), Geometry::Bounds(-100, -100, 600, 600), Geometry::Bounds(250, 0, 520, 520), Geometry::Bounds(1000, 1000, 2000, 2000)}) {
+		auto expected = ids(finder.SearchArea(objects, area.TopLeft(), area.BottomRight()));
+
+		REQUIRE(ids(objects, index.SearchArea(area.TopLeft(), area.BottomRight())) == expected);
+	}
+
+	REQUIRE((ids(objects, index.SearchArea({0, 0}, {200, 200})) == std::vector<int>{1, 2}));
+
+	//the wall starts outside of the area but spans into it
+	std::vector<size_t> found;
+	index.ForEachOverlapping({200, -45, 320, 70}, [&](size_t i) { found.push_back(i); });
+	REQUIRE((ids(objects, found) == std::vector<int>{3, 4}));
+
+	index.SearchAt({115, 110}, found);
+	REQUIRE((ids(objects, found) == std::vector<int>{2}));
+
+	index.SearchAt({5000, 5000}, found);
+	REQUIRE(found.empty());
+}
+
+TEST_CASE("Object index lookup", "[ObjectIndex]") {
+	auto objects = testobjects();
+	ObjectIndex index(objects);
+
+	REQUIRE(index.FindId(3) == 2);
+	REQUIRE(index.FindId(42) == -1);
+
+	auto span = [&](std::span<const size_t> s) {
+		return ids(objects, std::vector<size_t>(s.begin(), s.end()));
+	};
+
+	REQUIRE((span(index.SearchName("chest")) == std::vector<int>{2}));
+	REQUIRE((span(index.SearchName("")) == std::vector<int>{3}));
+	REQUIRE(index.SearchName("dragon").empty());
+
+	REQUIRE((span(index.SearchType("item")) == std::vector<int>{2, 3, 5}));
+	REQUIRE(index.SearchType("enemy").empty());
+
+	REQUIRE((span(index.SearchTileGid(3)) == std::vector<int>{2, 3}));
+	REQUIRE((span(index.SearchBySize({32, 32})) == std::vector<int>{2, 3}));
+	REQUIRE((span(index.SearchBetweenSize({10, 10}, {30, 30})) == std::vector<int>{1, 5}));
+
+	//finder overloads return the same objects as the linear versions
+	FindObject finder;
+
+	REQUIRE(ids(finder.SearchName(index, "coin")) == ids(finder.SearchName(objects, "coin")));
+	REQUIRE(ids(finder.SearchType(index, "item")) == ids(finder.SearchType(objects, "item")));
+	REQUIRE(ids(finder.SearchTileGid(index, 3)) == ids(finder.SearchTileGid(objects, 3)));
+	REQUIRE(ids(finder.SearchTileId(index, 4)) == ids(finder.SearchTileId(objects, 4)));
+	REQUIRE(ids(finder.SearchBySize(index, {16, 16})) == ids(finder.SearchBySize(objects, {16, 16})));
+	REQUIRE(ids(finder.SearchBetweenSize(index, {40, 40}, {10, 10})) == ids(finder.SearchBetweenSize(objects, {40, 40}, {10, 10})));
+}
+
+TEST_CASE("Object index rebuild", "[ObjectIndex]") {
+	auto objects = testobjects();
+	ObjectIndex index(objects);
+
+	REQUIRE(index.GetSize() == 5);
+
+	//plain lists are rebuilt manually
+	objects.push_back(makeobject(6, 0, 1000, 1000, 8, 8, "flag", "goal"));
+	objects[0].x = 2000;
+	objects[0].y = 2000;
+	index.Rebuild();
+
+	REQUIRE(index.GetSize() == 6);
+	REQUIRE(index.FindId(6) == 5);
+	REQUIRE(index.SearchName("flag").size() == 1);
+	REQUIRE((ids(objects, index.SearchArea({990, 990}, {3000, 3000})) == std::vector<int>{1, 6}));
+	REQUIRE((ids(objects, index.SearchArea({0, 0}, {50, 50})).empty()));
+
+	//indexes over groups track the changes of the group
+	Game::Map::Tiled::ObjectGroup group;
+	group.SetObjects(testobjects());
+
+	ObjectIndex groupindex(group);
+	FindObject finder;
+
+	REQUIRE_FALSE(groupindex.IsOutdated());
+	REQUIRE(finder.SearchName(groupindex, "door").size() == 1);
+
+	group.SetObjects({makeobject(9, 0, 5, 5, 4, 4, "door", "trigger"), makeobject(10, 0, 50, 50, 4, 4, "door", "trigger")});
+
+	REQUIRE(groupindex.IsOutdated());
+
+	//finder updates the index
+	REQUIRE((ids(finder.SearchName(groupindex, "door")) == std::vector<int>{9, 10}));
+	REQUIRE_FALSE(groupindex.IsOutdated());
+	REQUIRE(groupindex.FindId(1) == -1);
+	REQUIRE((ids(finder.SearchArea(groupindex, {0, 0}, {20, 20})) == std::vector<int>{9}));
+}
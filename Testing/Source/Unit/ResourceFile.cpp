@@ -0,0 +1,234 @@
+#define CATCH_CONFIG_MAIN
+
+#define WINDOWS_LEAN_AND_MEAN
+
+#include <catch.h>
+
+#include <Gorgon/Resource/File.h>
+#include <Gorgon/Resource/Folder.h>
+#include <Gorgon/Resource/Blob.h>
+#include <Gorgon/Resource/Sound.h>
+#include <Gorgon/Filesystem.h>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace Gorgon;
+
+namespace R = Gorgon::Resource;
+
+static std::vector<Byte> content(int seed, unsigned long size) {
+	std::vector<Byte> data(size);
+
+	for(unsigned long i=0; i<size; i++)
+		data[i] = Byte(i * seed + i / 7);
+
+	return data;
+}
+
+static R::Blob *makeblob(const std::string &name, int seed, R::GID::Type compression) {
+	auto blob = new R::Blob;
+
+	blob->SetName(name);
+	blob->SetCompression(compression);
+	blob->Ready(1000 + seed) = content(seed, 1000 + seed);
+
+	return blob;
+}
+
+//root contains two blobs and a folder with another blob
+static void savetestfile(const std::string &filename, SGuid &folderguid) {
+	R::File file;
+
+	file.Root().Add(makeblob("first", 1, R::GID::None));
+	file.Root().Add(makeblob("second", 2, R::GID::LZ4));
+
+	auto folder = new R::Folder;
+	folder->SetName("folder");
+	folder->Add(makeblob("inner", 3, R::GID::LZMA));
+	file.Root().Add(folder);
+
+	file.Save(filename);
+
+	//guids are assigned while saving
+	folderguid = folder->GetGuid();
+}
+
+static std::vector<char> readall(const std::string &filename) {
+	std::ifstream in(filename, std::ios::binary);
+
+	return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+static void writeall(const std::string &filename, const std::vector<char> &data) {
+	std::ofstream out(filename, std::ios::binary);
+
+	out.write(data.data(), data.size());
+}
+
+static void checktree(R::Folder &root) {
+	REQUIRE(root.GetCount() == 3);
+
+	auto &first = root.Get<R::Blob>(0);
+	REQUIRE(first.GetName() == "first");
+	REQUIRE(first.GetData() == content(1, 1001));
+
+	auto &second = root.Get<R::Blob>(1);
+	REQUIRE(second.GetData() == content(2, 1002));
+
+	auto &folder = root.Get<R::Folder>(2);
+	REQUIRE(folder.GetCount() == 1);
+	REQUIRE(folder.Get<R::Blob>(0).GetData() == content(3, 1003));
+}
+
+TEST_CASE("Resource file directory", "[Resource]") {
+	SGuid folderguid;
+	savetestfile("directory.gor", folderguid);
+
+	//whole file
+	{
+		R::File file;
+		file.LoadFile("directory.gor");
+
+		checktree(file.Root());
+
+		//root, three blobs and the folder
+		REQUIRE(file.GetDirectory().size() == 5);
+	}
+
+	R::File file;
+	REQUIRE(file.LoadDirectory("directory.gor"));
+
+	REQUIRE(file.Root().GetCount() == 0);
+
+	auto &dir = file.GetDirectory();
+	REQUIRE(dir.size() == 5);
+
+	bool found = false;
+	for(auto &entry : dir) {
+		if(entry.Name == "second") {
+			REQUIRE(entry.Type == R::GID::Blob);
+			REQUIRE(entry.Compression == R::GID::LZ4);
+			found = true;
+		}
+	}
+	REQUIRE(found);
+
+	//items can be loaded in any order
+	auto inner = dynamic_cast<R::Blob*>(file.LoadItem("inner"));
+	REQUIRE(inner != nullptr);
+	REQUIRE(inner->GetData() == content(3, 1003));
+	inner->DeleteResource();
+
+	auto second = dynamic_cast<R::Blob*>(file.LoadItem("second"));
+	REQUIRE(second != nullptr);
+	REQUIRE(second->GetData() == content(2, 1002));
+	second->DeleteResource();
+
+	//folders are loaded with their children
+	auto folder = dynamic_cast<R::Folder*>(file.LoadItem(folderguid));
+	REQUIRE(folder != nullptr);
+	REQUIRE(folder->GetName() == "folder");
+	REQUIRE(folder->GetCount() == 1);
+	REQUIRE(folder->Get<R::Blob>(0).GetData() == content(3, 1003));
+	folder->DeleteResource();
+
+	REQUIRE(file.LoadItem("missing") == nullptr);
+
+	Filesystem::Delete("directory.gor");
+}
+
+TEST_CASE("Resource file version 1.0", "[Resource]") {
+	SGuid folderguid;
+	savetestfile("old.gor", folderguid);
+
+	//version 1.0 files end right after the root folder, remove the directory and the
+	//position of it, then change the version
+	auto data = readall("old.gor");
+	REQUIRE(data.size() > 14);
+
+	auto pos = [&](std::size_t at) {
+		return (unsigned long)(Byte)data[at] | (unsigned long)(Byte)data[at+1] << 8 |
+			(unsigned long)(Byte)data[at+2] << 16 | (unsigned long)(Byte)data[at+3] << 24;
+	};
+
+	REQUIRE(pos(6) == R::CurrentVersion);
+
+	auto directorypos = pos(data.size() - 4);
+	REQUIRE(directorypos < data.size());
+	REQUIRE(pos(directorypos) == R::GID::File_Directory.AsInteger());
+
+	data.resize(directorypos);
+	data[6] = 0x00;
+	data[7] = 0x00;
+	data[8] = 0x01;
+	data[9] = 0x00;
+
+	writeall("old.gor", data);
+
+	{
+		R::File file;
+		file.LoadFile("old.gor");
+
+		checktree(file.Root());
+		REQUIRE(file.GetDirectory().empty());
+	}
+
+	{
+		R::File file;
+		file.LoadMapped("old.gor");
+
+		checktree(file.Root());
+	}
+
+	R::File file;
+	REQUIRE_FALSE(file.LoadDirectory("old.gor"));
+	REQUIRE(file.GetDirectory().empty());
+	REQUIRE(file.LoadItem("first") == nullptr);
+
+	Filesystem::Delete("old.gor");
+}
+
+TEST_CASE("Resource file mapped sound", "[Resource]") {
+	{
+		Containers::Wave wave(500, 22050);
+		for(unsigned long i=0; i<wave.GetSize(); i++)
+			wave(i, 0) = float(i % 100) / 100 - 0.5f;
+
+		auto sound = new R::Sound;
+		sound->SetName("sound");
+		sound->SetCompression(R::GID::None);
+		sound->Assume(wave);
+
+		R::File file;
+		file.Root().Add(sound);
+		file.Save("sound.gor");
+	}
+
+	R::File file;
+	file.LoadMapped("sound.gor");
+
+	REQUIRE(file.Root().GetCount() == 1);
+
+	//data is not read until it is requested
+	const auto &sound = file.Root().Get<R::Sound>(0);
+	REQUIRE_FALSE(sound.IsLoaded());
+
+	const auto &wave = sound.GetWave();
+	REQUIRE(sound.IsLoaded());
+	REQUIRE(wave.GetSize() == 500);
+	REQUIRE(wave.GetSampleRate() == 22050);
+
+	//saved as 16 bit PCM
+	bool same = true;
+	for(unsigned long i=0; i<wave.GetSize(); i++)
+		if(std::abs(wave(i, 0) - (float(i % 100) / 100 - 0.5f)) > 1.f / 32767)
+			same = false;
+
+	REQUIRE(same);
+
+	Filesystem::Delete("sound.gor");
+}
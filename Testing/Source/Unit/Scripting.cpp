@@ -5,11 +5,14 @@
 #include <catch.h>
 
 #include <Gorgon/Scripting/Embedding.h>
+#include <Gorgon/Scripting/VirtualMachine.h>
 #include <Gorgon/Geometry/Point.h>
 #include <Gorgon/Filesystem/Iterator.h>
 #include <Gorgon/Filesystem.h>
 #include <Gorgon/Geometry.h>
 
+#include <sstream>
+
 
 using namespace Gorgon::Scripting;
 using namespace Gorgon;
@@ -412,3 +415,86 @@ TEST_CASE("Reference counting", "[Data]") {
 	data=Data::Invalid();
 	REQUIRE(bcount == 0);
 }
+
+static std::string runscript(const std::string &code) {
+	auto &vm=VirtualMachine::Get();
+	
+	std::stringstream codestream(code), output;
+	StreamInput input(codestream, InputProvider::Programming, "test");
+	
+	vm.SetOutput(output);
+	vm.Begin(input);
+	vm.Run();
+	vm.ResetOutput();
+	
+	return output.str();
+}
+
+TEST_CASE("Variable slots", "[Scope]") {
+	//slot of x is bound to the variable of the parent, then a local is created
+	REQUIRE(runscript(
+		"x = 1\n"
+		"function f() returns nothing\n"
+		"\techo x\n"
+		"\tunset x\n"
+		"\tx = 2\n"
+		"\techo x\n"
+		"end function\n"
+		"f()\n"
+		"x = 7\n"
+		"echo x\n"
+	) == "1\n2\n7\n");
+	
+	//slot of c is bound to a static variable which is then replaced by a local
+	REQUIRE(runscript(
+		"function count()\n"
+		"\tstatic c = 0\n"
+		"\tc = c + 1\n"
+		"\tif c = 2\n"
+		"\t\tunset c\n"
+		"\t\tc = 10\n"
+		"\tend\n"
+		"\treturn c\n"
+		"end function\n"
+		"echo count()\n"
+		"echo count()\n"
+		"echo count()\n"
+	) == "1\n10\n1\n");
+	
+	//bound local is unset and created again with another type
+	REQUIRE(runscript(
+		"a = 3\n"
+		"i = 0\n"
+		"while i < 4\n"
+		"\techo a\n"
+		"\tif i = 1\n"
+		"\t\tunset a\n"
+		"\t\ta = \"str\"\n"
+		"\tend\n"
+		"\ti += 1\n"
+		"end\n"
+	) == "3\n3\nstr\nstr\n");
+}
+
+TEST_CASE("Overload cache", "[Scope]") {
+	//the same call is resolved again when the type of the argument changes
+	REQUIRE(runscript(
+		"function h(a as int)\n"
+		"\treturn a * 2\n"
+		"end function\n"
+		"function h(a as string)\n"
+		"\treturn a + \"!\"\n"
+		"end function\n"
+		"v = 1\n"
+		"i = 0\n"
+		"while i < 3\n"
+		"\techo h(v)\n"
+		"\tif i = 0\n"
+		"\t\tv = \"s\"\n"
+		"\telse\n"
+		"\t\tv = 4\n"
+		"\tend\n"
+		"\ti += 1\n"
+		"end\n"
+	) == "2\ns!\n8\n");
+}
@@ -0,0 +1,177 @@
+#define CATCH_CONFIG_MAIN
+
+#define WINDOWS_LEAN_AND_MEAN
+
+#include <catch.h>
+
+#include <Gorgon/Graphics/Font.h>
+
+#include <string>
+#include <vector>
+
+using namespace Gorgon;
+using namespace Gorgon::Graphics;
+
+//fixed width glyphs without any graphics
+class TestRenderer : public GlyphRenderer {
+public:
+	explicit TestRenderer(int advance, unsigned long revision = 0) : advance(advance), revision(revision) { }
+
+	virtual void Render(Glyph, TextureTarget &, Geometry::Pointf, RGBAf) const override { }
+
+	virtual Geometry::Point GetOffset(Glyph) const override { return {0, 0}; }
+
+	virtual Geometry::Size GetSize(Glyph) const override { return {advance, 10}; }
+
+	virtual float GetCursorAdvance(Glyph) const override { return (float)advance; }
+
+	virtual bool Exists(Glyph) const override { return true; }
+
+	virtual bool IsASCII() const override { return true; }
+
+	virtual bool IsFixedWidth() const override { return true; }
+
+	virtual Geometry::Pointf KerningDistance(Glyph, Glyph) const override { return {0, 0}; }
+
+	virtual int GetEMSize() const override { return advance; }
+
+	virtual int GetMaxWidth() const override { return advance; }
+
+	virtual int GetHeight() const override { return 10; }
+
+	virtual std::pair<int, int> GetLetterHeight(bool) const override { return {0, 10}; }
+
+	virtual int GetDigitWidth() const override { return advance; }
+
+	virtual float GetBaseLine() const override { return 8; }
+
+	virtual float GetLineGap() const override { return 12; }
+
+	virtual float GetLineThickness() const override { return 1; }
+
+	virtual int GetUnderlineOffset() const override { return 9; }
+
+	virtual unsigned long GetRevision() const override { return revision; }
+
+	int advance;
+	unsigned long revision;
+};
+
+TEST_CASE("Text layout reuse", "[TextLayout]") {
+	TestRenderer renderer(5);
+	StyledPrinter printer(renderer);
+
+	TextLayout layout;
+
+	REQUIRE(printer.Update(layout, "hello"));
+	REQUIRE(layout.GetGlyphs().size() == 5);
+	REQUIRE(layout.GetGlyphs()[4].location.X == 20);
+
+	//nothing changed
+	REQUIRE_FALSE(printer.Update(layout, "hello"));
+	REQUIRE(layout.IsValid(printer, "hello", 0, TextAlignment::Left, false));
+
+	REQUIRE(printer.Update(layout, "hello!"));
+	REQUIRE(layout.GetGlyphs().size() == 6);
+
+	REQUIRE(printer.Update(layout, "hello!", 100, TextAlignment::Right));
+	REQUIRE_FALSE(printer.Update(layout, "hello!", 100, TextAlignment::Right));
+	REQUIRE(layout.GetGlyphs()[0].location.X == 70);
+
+	//printer settings
+	printer.SetLetterSpacing(1);
+	REQUIRE(printer.Update(layout, "hello!", 100, TextAlignment::Right));
+	REQUIRE_FALSE(printer.Update(layout, "hello!", 100, TextAlignment::Right));
+
+	//glyph renderer reports a change
+	renderer.advance = 6;
+	renderer.revision++;
+	REQUIRE(printer.Update(layout, "hello!", 100, TextAlignment::Right));
+
+	//layouts belong to the printer that created them
+	StyledPrinter other(renderer);
+	REQUIRE_FALSE(layout.IsValid(other, "hello!", 100, TextAlignment::Right, true));
+
+	layout.Clear();
+	REQUIRE_FALSE(layout.IsValid(printer, "hello!", 100, TextAlignment::Right, true));
+}
+
+TEST_CASE("Text layout glyph renderer change", "[TextLayout]") {
+	TestRenderer first(5, 1), second(7, 0);
+
+	StyledPrinter printer(first);
+
+	TextLayout layout;
+	printer.Layout(layout, "abc");
+	REQUIRE(layout.GetGlyphs()[2].location.X == 10);
+
+	//the revision of the printer increases by one while the revision of the renderer
+	//decreases by one
+	printer.SetGlyphRenderer(second);
+
+	REQUIRE_FALSE(layout.IsValid(printer, "abc", 0, TextAlignment::Left, false));
+	REQUIRE(printer.Update(layout, "abc"));
+	REQUIRE(layout.GetGlyphs()[2].location.X == 14);
+
+	BasicPrinter basic(first);
+
+	REQUIRE(basic.Update(layout, "abc"));
+	REQUIRE_FALSE(basic.Update(layout, "abc"));
+	REQUIRE(layout.GetGlyphs()[2].location.X == 10);
+}
+
+TEST_CASE("Text layout cache", "[TextLayout]") {
+	TestRenderer renderer(5);
+	BasicPrinter printer(renderer);
+
+	TextLayoutCache cache(2);
+
+	std::vector<std::string> created;
+
+	auto get = [&](const std::string &text) -> const TextLayout & {
+		return cache.Get(printer, text, 0, TextAlignment::Left, false, [&](TextLayout &layout) {
+			created.push_back(text);
+			printer.Layout(layout, text);
+		});
+	};
+
+	REQUIRE(get("a").GetText() == "a");
+	get("b");
+	get("a");
+	REQUIRE(cache.GetSize() == 2);
+	REQUIRE((created == std::vector<std::string>{"a", "b"}));
+
+	//b is the least recently used
+	get("c");
+	REQUIRE(cache.GetSize() == 2);
+
+	get("a");
+	REQUIRE((created == std::vector<std::string>{"a", "b", "c"}));
+
+	get("b");
+	REQUIRE((created == std::vector<std::string>{"a", "b", "c", "b"}));
+
+	//c was evicted
+	get("a");
+	get("c");
+	REQUIRE((created == std::vector<std::string>{"a", "b", "c", "b", "c"}));
+
+	//layouts are recreated when they are no longer valid
+	renderer.revision++;
+	get("c");
+	REQUIRE(created.size() == 6);
+
+	//different width or alignment is a different layout
+	cache.Get(printer, "c", 50, TextAlignment::Left, true, [&](TextLayout &layout) { created.push_back("c50"); printer.Layout(layout, "c", 50, TextAlignment::Left); });
+	REQUIRE(created.back() == "c50");
+
+	cache.SetCapacity(1);
+	REQUIRE(cache.GetSize() == 1);
+
+	cache.SetCapacity(0);
+	REQUIRE(cache.GetSize() == 0);
+
+	get("c");
+	get("c");
+	REQUIRE(created.size() == 9);
+}
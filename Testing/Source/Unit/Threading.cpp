@@ -0,0 +1,208 @@
+#define CATCH_CONFIG_MAIN
+
+#define WINDOWS_LEAN_AND_MEAN
+
+#include <catch.h>
+
+#include <Gorgon/Threading.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Gorgon::Threading;
+
+TEST_CASE("Task group", "[Threading]") {
+	std::atomic<int> count{0};
+
+	TaskGroup group;
+
+	for(int i=0; i<1000; i++)
+		group.Run([&] { count++; });
+
+	group.Wait();
+
+	REQUIRE(count == 1000);
+	REQUIRE(group.IsDone());
+
+	//groups can be reused and nested
+	std::vector<int> sums(10);
+
+	for(int i=0; i<10; i++) {
+		group.Run([&sums, i] {
+			std::atomic<int> sum{0};
+			TaskGroup inner;
+
+			for(int j=0; j<100; j++)
+				inner.Run([&sum, j] { sum += j; });
+
+			inner.Wait();
+
+			sums[i] = sum;
+		});
+	}
+
+	group.Wait();
+
+	for(auto s : sums)
+		REQUIRE(s == 4950);
+}
+
+TEST_CASE("Task group exceptions", "[Threading]") {
+	std::atomic<int> count{0};
+
+	TaskGroup group;
+
+	for(int i=0; i<100; i++) {
+		group.Run([&, i] {
+			count++;
+
+			if(i == 50)
+				throw std::runtime_error("task");
+		});
+	}
+
+	REQUIRE_THROWS(group.Wait());
+	REQUIRE(count == 100);
+
+	//error is cleared after it is thrown
+	group.Run([] {});
+	REQUIRE_NOTHROW(group.Wait());
+}
+
+TEST_CASE("Continuations", "[Threading]") {
+	std::atomic<int> count{0};
+	std::atomic<int> seen{-1}, chained{-1};
+
+	TaskGroup group;
+
+	for(int i=0; i<200; i++)
+		group.Run([&] { count++; });
+
+	group.Then([&] {
+		seen = count.load();
+
+		//a continuation added from a continuation runs after it
+		group.Then([&] { chained = seen.load(); });
+	});
+
+	group.Wait();
+
+	REQUIRE(seen == 200);
+	REQUIRE(chained == 200);
+
+	//continuation of a finished group runs immediately
+	bool run = false;
+	group.Then([&] { run = true; });
+	group.Wait();
+
+	REQUIRE(run);
+}
+
+TEST_CASE("ParallelFor", "[Threading]") {
+	std::vector<int> data(100003);
+
+	for(int grain : {1, 7, 1000, 0, 200000}) {
+		std::fill(data.begin(), data.end(), 0);
+
+		std::atomic<int> calls{0}, longest{0};
+
+		//catch is not thread safe, results are checked after the loop
+		ParallelFor(0, (int)data.size(), grain, [&](int first, int last) {
+			int len = last - first;
+			int cur = longest;
+
+			while(len > cur && !longest.compare_exchange_weak(cur, len))
+				;
+
+			for(int i=first; i<last; i++)
+				data[i]++;
+
+			calls++;
+		});
+
+		for(auto d : data)
+			REQUIRE(d == 1);
+
+		REQUIRE(calls > 0);
+
+		if(grain > 0)
+			REQUIRE(longest <= grain);
+	}
+
+	ParallelFor(5, 5, 1, [](int, int) { FAIL("empty range"); });
+}
+
+TEST_CASE("ParallelFor exceptions", "[Threading]") {
+	Scheduler scheduler(2);
+
+	std::vector<int> data(10000);
+
+	std::atomic<int> ranges{0};
+	ParallelFor(0, (int)data.size(), 10, [&](int, int) { ranges++; }, Scheduler::Default());
+
+	for(int i=0; i<20; i++) {
+		std::atomic<int> calls{0};
+
+		//the range on the calling thread throws while other ranges are queued or running
+		REQUIRE_THROWS_AS(ParallelFor(0, (int)data.size(), 10, [&](int first, int last) {
+			calls++;
+
+			if(first == 0)
+				throw std::runtime_error("range");
+
+			for(int j=first; j<last; j++)
+				data[j]++;
+		}, scheduler), std::runtime_error);
+
+		//remaining ranges are run before the exception leaves
+		REQUIRE(calls == ranges);
+	}
+
+	//a range that is run as a task
+	REQUIRE_THROWS_AS(ParallelFor(0, (int)data.size(), 10, [&](int first, int) {
+		if(first == 5000)
+			throw std::runtime_error("task");
+	}, scheduler), std::runtime_error);
+}
+
+TEST_CASE("RunInParallel", "[Threading]") {
+	std::vector<std::atomic<int>> ids(8);
+	std::atomic<int> wrong{0};
+
+	RunInParallel([&](int id, int threads) {
+		if(threads != 8)
+			wrong++;
+
+		ids[id]++;
+	}, 8);
+
+	REQUIRE(wrong == 0);
+
+	for(auto &id : ids)
+		REQUIRE(id == 1);
+}
+
+TEST_CASE("Main queue", "[Threading]") {
+	std::vector<int> order;
+
+	TaskGroup group;
+
+	group.Run([&] { RunOnMain([&] { order.push_back(1); }); });
+	group.Wait();
+
+	RunOnMain([&] {
+		order.push_back(2);
+
+		//runs in the next call
+		RunOnMain([&] { order.push_back(3); });
+	});
+
+	REQUIRE(order.empty());
+
+	ProcessMainQueue();
+	REQUIRE((order == std::vector<int>{1, 2}));
+
+	ProcessMainQueue();
+	REQUIRE((order == std::vector<int>{1, 2, 3}));
+}
@@ -0,0 +1,152 @@
+#define CATCH_CONFIG_MAIN
+
+#define WINDOWS_LEAN_AND_MEAN
+
+#include <catch.h>
+
+#include <Gorgon/Utils/TimerWheel.h>
+
+#include <random>
+#include <vector>
+
+using namespace Gorgon::Utils;
+
+TEST_CASE("TimerWheel timeouts", "[TimerWheel]") {
+	TimerWheel wheel(1000);
+
+	std::vector<int> fired;
+
+	wheel.Add(1010, [&] { fired.push_back(1); });
+	wheel.Add(1005, [&] { fired.push_back(2); });
+	auto c = wheel.Add(1007, [&] { fired.push_back(3); });
+	wheel.Add(1005, [&] { fired.push_back(4); });
+
+	REQUIRE(wheel.GetSize() == 4);
+	REQUIRE(wheel.Cancel(c));
+	REQUIRE_FALSE(wheel.Exists(c));
+	REQUIRE_FALSE(wheel.Cancel(c));
+
+	wheel.Advance(1004);
+	REQUIRE(fired.empty());
+
+	wheel.Advance(1009);
+	REQUIRE((fired == std::vector<int>{2, 4}));
+
+	wheel.Advance(2000);
+	REQUIRE((fired == std::vector<int>{2, 4, 1}));
+	REQUIRE(wheel.IsEmpty());
+
+	//due times that are not in the future are called in the next advance
+	wheel.Add(1500, [&] { fired.push_back(5); });
+	wheel.Add(2000, [&] { fired.push_back(6); });
+	wheel.Advance(2000);
+	REQUIRE((fired == std::vector<int>{2, 4, 1, 5, 6}));
+}
+
+TEST_CASE("TimerWheel intervals", "[TimerWheel]") {
+	TimerWheel wheel;
+
+	int count = 0;
+	auto id = wheel.Add(10, [&] { count++; }, 10);
+
+	REQUIRE(wheel.IsPeriodic(id));
+
+	for(int t=1; t<=100; t++)
+		wheel.Advance(t);
+
+	REQUIRE(count == 10);
+
+	//missed periods are skipped, phase is kept
+	wheel.Advance(155);
+	REQUIRE(count == 11);
+
+	wheel.Advance(159);
+	REQUIRE(count == 11);
+
+	wheel.Advance(160);
+	REQUIRE(count == 12);
+
+	wheel.SetPeriod(id, 100);
+	wheel.Advance(170);
+	REQUIRE(count == 13);
+
+	wheel.Advance(269);
+	REQUIRE(count == 13);
+
+	wheel.Advance(270);
+	REQUIRE(count == 14);
+
+	REQUIRE(wheel.Cancel(id));
+	wheel.Advance(1000);
+	REQUIRE(count == 14);
+}
+
+TEST_CASE("TimerWheel changes from timers", "[TimerWheel]") {
+	TimerWheel wheel;
+
+	std::vector<int> fired;
+	size_t self = 0, other = 0, again = 0;
+
+	//cancels itself and another timer that is due at the same time
+	self = wheel.Add(5, [&] {
+		fired.push_back(1);
+		wheel.Cancel(self);
+		wheel.Cancel(other);
+	}, 5);
+
+	other = wheel.Add(5, [&] { fired.push_back(2); });
+
+	//reschedules itself and adds a new timer
+	again = wheel.Add(7, [&] {
+		fired.push_back(3);
+
+		if(fired.size() < 4) {
+			wheel.Reschedule(again, wheel.GetTime() + 3);
+			wheel.Add(wheel.GetTime(), [&] { fired.push_back(4); });
+		}
+	});
+
+	wheel.Advance(8);
+	REQUIRE((fired == std::vector<int>{1, 3}));
+	REQUIRE_FALSE(wheel.Exists(self));
+	REQUIRE(wheel.Exists(again));
+
+	wheel.Advance(9);
+	REQUIRE((fired == std::vector<int>{1, 3, 4}));
+
+	wheel.Advance(20);
+	REQUIRE((fired == std::vector<int>{1, 3, 4, 3}));
+	REQUIRE(wheel.IsEmpty());
+}
+
+TEST_CASE("TimerWheel long timers", "[TimerWheel]") {
+	std::mt19937 random(5);
+	std::uniform_int_distribution<unsigned long> after(0, 30000000);
+
+	TimerWheel wheel(12345);
+
+	std::vector<unsigned long> due, firedat;
+
+	for(int i=0; i<2000; i++) {
+		due.push_back(12345 + after(random));
+		firedat.push_back(0);
+
+		wheel.Add(due.back(), [&, i] { firedat[i] = wheel.GetTime(); });
+	}
+
+	//a timer further than the range of the wheel
+	unsigned long far = 12345 + 70000000, farfired = 0;
+	wheel.Add(far, [&] { farfired = wheel.GetTime(); });
+
+	//advance in uneven steps, timers see the time they are due
+	unsigned long t = 12345;
+	while(!wheel.IsEmpty()) {
+		t += 1 + t % 9000;
+		wheel.Advance(t);
+	}
+
+	for(int i=0; i<2000; i++)
+		REQUIRE(firedat[i] == due[i]);
+
+	REQUIRE(farfired == far);
+}
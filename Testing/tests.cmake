@@ -3,16 +3,31 @@ CMAKE_MINIMUM_REQUIRED(VERSION 3.25)
 SET(ManualTests
 	AdvancedText
 	Animation
+	AtlasPacking
+	Batching
 	Clipboard
+	Convolution
 	CGI
+	CGIRasterization
+	CGIRenderList
 	DnD
 	Filesystem
+	FramePacing
 	FreeType
 	Gscript
+	GscriptBenchmark
 	Generic
 	Audio
+	AudioMixing
 	PDParser
+	Pathfinding
+	PixelConversion
+	Resampling
 	Scene
+	TaskSpawn
+	TextLayout
+	TimerBenchmark
+	TileRendering
 	Window
 	Font
 	HTMLRenderer
@@ -22,26 +37,42 @@ SET(ManualTests
 )
 
 SET(UnitTests
+	Atlas
+	CGI
 	Enum
 	Event
 	Filesystem
 	FLAC
+	FramePacer
 	GarbageCollection
 	Geometry
 	Hashmap
 	KeyRepeater
 	Layer
 	Logging
+	LZ4
 	EncodingImage
+	ObjectIndex
 	Property
+	ResourceFile
 	Scene
 	ScopeGuard
 	String
+	TextLayout
+	Threading
+	TimerWheel
 	URI
 	IO
 )
 
 
+#Tests that include Game module require C++20
+SET(CXX20Tests
+	ObjectIndex
+	Pathfinding
+	TileRendering
+)
+
 option(UNIT_TESTS "Enable all unit tests." OFF)
 
 IF(${SCRIPTING})
@@ -49,3 +80,9 @@ IF(${SCRIPTING})
 		Scripting
 	)
 ENDIF()
+
+IF(${AUDIO})
+	LIST(APPEND UnitTests
+		Audio
+	)
+ENDIF()